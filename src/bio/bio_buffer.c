@@ -26,7 +26,7 @@ dma_free_chunk(struct bio_dma_chunk *chunk)
 }
 
 static struct bio_dma_chunk *
-dma_alloc_chunk(unsigned int cnt)
+dma_alloc_chunk(unsigned int cnt, unsigned int numa_node)
 {
 	struct bio_dma_chunk *chunk;
 	ssize_t bytes = (ssize_t)cnt << BIO_DMA_PAGE_SHIFT;
@@ -46,7 +46,7 @@ dma_alloc_chunk(unsigned int cnt)
 
 	if (bio_spdk_inited) {
 		chunk->bdc_ptr = spdk_dma_malloc_socket(bytes, BIO_DMA_PAGE_SZ, NULL,
-							bio_numa_node);
+							numa_node);
 	} else {
 		rc = posix_memalign(&chunk->bdc_ptr, BIO_DMA_PAGE_SZ, bytes);
 		if (rc)
@@ -58,10 +58,97 @@ dma_alloc_chunk(unsigned int cnt)
 		return NULL;
 	}
 	D_INIT_LIST_HEAD(&chunk->bdc_link);
+	chunk->bdc_pg_cnt = cnt;
 
 	return chunk;
 }
 
+/*
+ * Huge chunks serving single huge IOV are kept in a small per-xstream cache after
+ * I/O completion, so that the following huge I/O can reuse both the DMA buffer and
+ * the bulk handle registered on it, instead of allocating and registering it again.
+ */
+#define DMA_HUGE_CACHE_CHKS	2
+
+static void
+dma_free_huge_chunk(struct bio_dma_chunk *chunk)
+{
+	bulk_huge_chunk_fini(chunk);
+	dma_free_chunk(chunk);
+}
+
+static inline void
+dma_huge_cache_stats(struct bio_dma_buffer *bdb)
+{
+	if (bdb->bdb_stats.bds_huge_cached)
+		d_tm_set_gauge(bdb->bdb_stats.bds_huge_cached,
+			       (uint64_t)bdb->bdb_huge_pgs << BIO_DMA_PAGE_SHIFT);
+}
+
+static struct bio_dma_chunk *
+dma_huge_chunk_get(struct bio_dma_buffer *bdb, unsigned int pg_cnt)
+{
+	struct bio_dma_chunk	*chunk;
+
+	/* Don't waste more than half of the cached chunk */
+	d_list_for_each_entry(chunk, &bdb->bdb_huge_list, bdc_link) {
+		if (chunk->bdc_pg_cnt < pg_cnt || chunk->bdc_pg_cnt > pg_cnt * 2)
+			continue;
+
+		d_list_del_init(&chunk->bdc_link);
+		D_ASSERT(bdb->bdb_huge_pgs >= chunk->bdc_pg_cnt);
+		bdb->bdb_huge_pgs -= chunk->bdc_pg_cnt;
+		dma_huge_cache_stats(bdb);
+		if (bdb->bdb_stats.bds_huge_hits)
+			d_tm_inc_counter(bdb->bdb_stats.bds_huge_hits, 1);
+		return chunk;
+	}
+
+	/* Round up to chunk size to improve the chance of being reused */
+	return dma_alloc_chunk(roundup(pg_cnt, bio_chk_sz), bdb->bdb_numa_node);
+}
+
+static void
+dma_huge_chunk_put(struct bio_dma_buffer *bdb, struct bio_dma_chunk *chunk)
+{
+	struct bio_dma_chunk	*victim;
+	unsigned int		 max_pgs = bio_chk_sz * DMA_HUGE_CACHE_CHKS;
+
+	D_ASSERT(d_list_empty(&chunk->bdc_link));
+	if (chunk->bdc_pg_cnt > max_pgs) {
+		dma_free_huge_chunk(chunk);
+		return;
+	}
+
+	/* Evict the least recently used ones */
+	while (bdb->bdb_huge_pgs + chunk->bdc_pg_cnt > max_pgs) {
+		D_ASSERT(!d_list_empty(&bdb->bdb_huge_list));
+		victim = d_list_entry(bdb->bdb_huge_list.prev, struct bio_dma_chunk, bdc_link);
+		d_list_del_init(&victim->bdc_link);
+		D_ASSERT(bdb->bdb_huge_pgs >= victim->bdc_pg_cnt);
+		bdb->bdb_huge_pgs -= victim->bdc_pg_cnt;
+		dma_free_huge_chunk(victim);
+	}
+
+	d_list_add(&chunk->bdc_link, &bdb->bdb_huge_list);
+	bdb->bdb_huge_pgs += chunk->bdc_pg_cnt;
+	dma_huge_cache_stats(bdb);
+}
+
+static void
+dma_huge_cache_purge(struct bio_dma_buffer *bdb)
+{
+	struct bio_dma_chunk	*chunk, *tmp;
+
+	d_list_for_each_entry_safe(chunk, tmp, &bdb->bdb_huge_list, bdc_link) {
+		d_list_del_init(&chunk->bdc_link);
+		D_ASSERT(bdb->bdb_huge_pgs >= chunk->bdc_pg_cnt);
+		bdb->bdb_huge_pgs -= chunk->bdc_pg_cnt;
+		dma_free_huge_chunk(chunk);
+	}
+	D_ASSERT(bdb->bdb_huge_pgs == 0);
+}
+
 static void
 dma_buffer_shrink(struct bio_dma_buffer *buf, unsigned int cnt)
 {
@@ -91,7 +178,7 @@ dma_buffer_grow(struct bio_dma_buffer *buf, unsigned int cnt)
 	D_ASSERT((buf->bdb_tot_cnt + cnt) <= bio_chk_cnt_max);
 
 	for (i = 0; i < cnt; i++) {
-		chunk = dma_alloc_chunk(bio_chk_sz);
+		chunk = dma_alloc_chunk(bio_chk_sz, buf->bdb_numa_node);
 		if (chunk == NULL) {
 			rc = -DER_NOMEM;
 			break;
@@ -106,6 +193,168 @@ dma_buffer_grow(struct bio_dma_buffer *buf, unsigned int cnt)
 	return rc;
 }
 
+static struct bio_dma_pool	dma_pool;
+
+int
+dma_pool_init(unsigned int tgt_nr)
+{
+	D_ASSERT(dma_pool.bdp_slots == NULL);
+
+	if (!bio_dma_pool_enabled)
+		return 0;
+
+	/* Lent chunks never exceed the sum of per-xstream upper bounds */
+	D_ALLOC_ARRAY(dma_pool.bdp_slots, tgt_nr * bio_chk_cnt_max);
+	if (dma_pool.bdp_slots == NULL)
+		return -DER_NOMEM;
+
+	dma_pool.bdp_slot_cnt = tgt_nr * bio_chk_cnt_max;
+	atomic_store_relaxed(&dma_pool.bdp_chk_cnt, 0);
+	atomic_store_relaxed(&dma_pool.bdp_hint, 0);
+
+	return 0;
+}
+
+void
+dma_pool_fini(void)
+{
+	struct bio_dma_chunk	*chunk;
+	unsigned int		 i;
+
+	if (dma_pool.bdp_slots == NULL)
+		return;
+
+	for (i = 0; i < dma_pool.bdp_slot_cnt; i++) {
+		chunk = atomic_exchange(&dma_pool.bdp_slots[i], NULL);
+		if (chunk != NULL)
+			dma_free_chunk(chunk);
+	}
+
+	D_FREE(dma_pool.bdp_slots);
+	dma_pool.bdp_slot_cnt = 0;
+	atomic_store_relaxed(&dma_pool.bdp_chk_cnt, 0);
+}
+
+static bool
+dma_pool_put(struct bio_dma_chunk *chunk)
+{
+	struct bio_dma_chunk	*empty;
+	unsigned int		 i, idx, start;
+
+	if (dma_pool.bdp_slot_cnt == 0)
+		return false;
+
+	start = atomic_fetch_add_relaxed(&dma_pool.bdp_hint, 1);
+	for (i = 0; i < dma_pool.bdp_slot_cnt; i++) {
+		idx = (start + i) % dma_pool.bdp_slot_cnt;
+		empty = NULL;
+		if (atomic_compare_exchange_strong(&dma_pool.bdp_slots[idx], &empty, chunk)) {
+			atomic_fetch_add_relaxed(&dma_pool.bdp_chk_cnt, 1);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+static struct bio_dma_chunk *
+dma_pool_get(void)
+{
+	struct bio_dma_chunk	*chunk;
+	unsigned int		 i, idx, start;
+
+	if (dma_pool.bdp_slot_cnt == 0 || atomic_load_relaxed(&dma_pool.bdp_chk_cnt) == 0)
+		return NULL;
+
+	start = atomic_load_relaxed(&dma_pool.bdp_hint);
+	for (i = 0; i < dma_pool.bdp_slot_cnt; i++) {
+		idx = (start + i) % dma_pool.bdp_slot_cnt;
+		if (atomic_load_relaxed(&dma_pool.bdp_slots[idx]) == NULL)
+			continue;
+
+		chunk = atomic_exchange(&dma_pool.bdp_slots[idx], NULL);
+		if (chunk != NULL) {
+			atomic_fetch_sub_relaxed(&dma_pool.bdp_chk_cnt, 1);
+			return chunk;
+		}
+	}
+
+	return NULL;
+}
+
+/* Borrow an idle chunk from the shared pool, the chunk is put on idle list */
+int
+dma_buffer_borrow(struct bio_dma_buffer *buf)
+{
+	struct bio_dma_chunk *chunk;
+
+	chunk = dma_pool_get();
+	if (chunk == NULL)
+		return -DER_AGAIN;
+
+	D_ASSERT(chunk->bdc_ref == 0 && chunk->bdc_pg_idx == 0);
+	d_list_add_tail(&chunk->bdc_link, &buf->bdb_idle_list);
+	buf->bdb_tot_cnt++;
+	if (buf->bdb_stats.bds_chks_tot)
+		d_tm_set_gauge(buf->bdb_stats.bds_chks_tot, buf->bdb_tot_cnt);
+	if (buf->bdb_stats.bds_chks_borrowed)
+		d_tm_inc_counter(buf->bdb_stats.bds_chks_borrowed, 1);
+
+	return 0;
+}
+
+/*
+ * Lend an idle chunk to the shared pool. The chunk still holding a bulk handle registered
+ * by current xstream is kept, since the handle can't be used by other xstreams.
+ */
+static bool
+dma_buffer_lend_one(struct bio_dma_buffer *buf, struct bio_dma_chunk *chunk)
+{
+	if (chunk->bdc_bulk_hdl != NULL)
+		return false;
+
+	d_list_del_init(&chunk->bdc_link);
+	if (!dma_pool_put(chunk)) {
+		d_list_add_tail(&chunk->bdc_link, &buf->bdb_idle_list);
+		return false;
+	}
+
+	D_ASSERT(buf->bdb_tot_cnt > 0);
+	buf->bdb_tot_cnt--;
+	if (buf->bdb_stats.bds_chks_tot)
+		d_tm_set_gauge(buf->bdb_stats.bds_chks_tot, buf->bdb_tot_cnt);
+	if (buf->bdb_stats.bds_chks_lent)
+		d_tm_inc_counter(buf->bdb_stats.bds_chks_lent, 1);
+
+	return true;
+}
+
+#define	DMA_LEND_INTVL	1	/* seconds */
+
+/*
+ * Called periodically by the xstream, return the chunks borrowed beyond the per-xstream
+ * upper bound, and lend out idle chunks when the xstream has no DMA activity.
+ */
+void
+dma_buffer_lend(struct bio_dma_buffer *buf, uint64_t now)
+{
+	struct bio_dma_chunk	*chunk, *tmp;
+	unsigned int		 keep_cnt = bio_chk_cnt_max;
+
+	if (dma_pool.bdp_slot_cnt == 0 || (buf->bdb_lend_ts + DMA_LEND_INTVL) > now)
+		return;
+
+	buf->bdb_lend_ts = now;
+	if (buf->bdb_active_iods == 0 && buf->bdb_queued_iods == 0)
+		keep_cnt = bio_chk_cnt_init;
+
+	d_list_for_each_entry_safe(chunk, tmp, &buf->bdb_idle_list, bdc_link) {
+		if (buf->bdb_tot_cnt <= keep_cnt)
+			break;
+		dma_buffer_lend_one(buf, chunk);
+	}
+}
+
 void
 dma_buffer_destroy(struct bio_dma_buffer *buf)
 {
@@ -114,6 +363,7 @@ dma_buffer_destroy(struct bio_dma_buffer *buf)
 	D_ASSERT(buf->bdb_queued_iods == 0);
 
 	bulk_cache_destroy(buf);
+	dma_huge_cache_purge(buf);
 	dma_buffer_shrink(buf, buf->bdb_tot_cnt);
 
 	D_ASSERT(buf->bdb_tot_cnt == 0);
@@ -199,6 +449,43 @@ dma_metrics_init(struct bio_dma_buffer *bdb, int tgt_id)
 			     "transactions", "dmabuff/wal_waiters/tgt_%d", tgt_id);
 	if (rc)
 		D_WARN("Failed to create WAL waiters telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->bds_wal_batch, D_TM_STATS_GAUGE, "WAL group commit batch size",
+			     "transactions", "dmabuff/wal_batch/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create WAL batch telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->bds_wal_lat, D_TM_STATS_GAUGE, "WAL commit latency",
+			     "us", "dmabuff/wal_lat/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create WAL latency telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->bds_chks_borrowed, D_TM_COUNTER,
+			     "Chunks borrowed from shared pool", "chunk",
+			     "dmabuff/borrowed_chunks/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create borrowed_chunks telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->bds_chks_lent, D_TM_COUNTER,
+			     "Chunks lent to shared pool", "chunk",
+			     "dmabuff/lent_chunks/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create lent_chunks telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->bds_fifo_wait, D_TM_STATS_GAUGE, "DMA buffer wait time",
+			     "us", "dmabuff/fifo_wait/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create fifo_wait telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->bds_huge_hits, D_TM_COUNTER, "Huge chunk cache hits",
+			     "chunk", "dmabuff/huge_hits/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create huge_hits telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->bds_huge_cached, D_TM_GAUGE, "Cached huge chunks",
+			     "bytes", "dmabuff/huge_cached/tgt_%d", tgt_id);
+	if (rc)
+		D_WARN("Failed to create huge_cached telemetry: "DF_RC"\n", DP_RC(rc));
 }
 
 struct bio_dma_buffer *
@@ -213,9 +500,15 @@ dma_buffer_create(unsigned int init_cnt, int tgt_id)
 
 	D_INIT_LIST_HEAD(&buf->bdb_idle_list);
 	D_INIT_LIST_HEAD(&buf->bdb_used_list);
+	D_INIT_LIST_HEAD(&buf->bdb_huge_list);
 	buf->bdb_tot_cnt = 0;
 	buf->bdb_active_iods = 0;
 
+	/* Allocate chunks from the NUMA node which current xstream is running on */
+	buf->bdb_numa_node = bio_numa_node;
+	if (bio_spdk_inited && bio_numa_node == SPDK_ENV_SOCKET_ID_ANY)
+		buf->bdb_numa_node = spdk_env_get_socket_id(sched_getcpu());
+
 	rc = ABT_mutex_create(&buf->bdb_mutex);
 	if (rc != ABT_SUCCESS) {
 		D_FREE(buf);
@@ -405,7 +698,7 @@ iod_release_buffer(struct bio_desc *biod)
 			chunk->bdc_type);
 
 		if (dma_chunk_is_huge(chunk)) {
-			dma_free_chunk(chunk);
+			dma_huge_chunk_put(bdb, chunk);
 		} else if (chunk->bdc_ref == 0) {
 			chunk->bdc_pg_idx = 0;
 			D_ASSERT(bdb->bdb_used_cnt[chunk->bdc_type] > 0);
@@ -417,6 +710,9 @@ iod_release_buffer(struct bio_desc *biod)
 			if (chunk == bdb->bdb_cur_chk[chunk->bdc_type])
 				bdb->bdb_cur_chk[chunk->bdc_type] = NULL;
 			d_list_move_tail(&chunk->bdc_link, &bdb->bdb_idle_list);
+			/* Return the borrowed chunk beyond upper bound */
+			if (bdb->bdb_tot_cnt > bio_chk_cnt_max)
+				dma_buffer_lend_one(bdb, chunk);
 		}
 		rsrvd_dma->brd_dma_chks[i] = NULL;
 	}
@@ -624,7 +920,11 @@ chunk_get_idle(struct bio_dma_buffer *bdb, struct bio_dma_chunk **chk_ptr)
 	int rc;
 
 	if (d_list_empty(&bdb->bdb_idle_list)) {
-		/* Try grow buffer first */
+		/* Try to borrow an idle chunk lent by other xstreams */
+		if (dma_buffer_borrow(bdb) == 0)
+			goto done;
+
+		/* Try grow buffer then */
 		if (bdb->bdb_tot_cnt < bio_chk_cnt_max) {
 			rc = dma_buffer_grow(bdb, 1);
 			if (rc == 0)
@@ -864,20 +1164,22 @@ dma_map_one(struct bio_desc *biod, struct bio_iov *biov, void *arg)
 	/*
 	 * For huge IOV, we'll bypass our per-xstream DMA buffer cache and
 	 * allocate chunk from the SPDK reserved huge pages directly, this
-	 * kind of huge chunk will be freed immediately on I/O completion.
+	 * kind of huge chunk will be put in a small huge chunk cache on I/O
+	 * completion, the cached one will be reused (along with the bulk
+	 * handle registered on it) by following huge IOV.
 	 *
 	 * We assume the contiguous huge IOV is quite rare, so there won't
 	 * be high contention over the SPDK huge page cache.
 	 */
 	if (pg_cnt > bio_chk_sz) {
-		chk = dma_alloc_chunk(pg_cnt);
+		chk = dma_huge_chunk_get(bdb, pg_cnt);
 		if (chk == NULL)
 			return -DER_NOMEM;
 
 		chk->bdc_type = biod->bd_chk_type;
 		rc = iod_add_chunk(biod, chk);
 		if (rc) {
-			dma_free_chunk(chk);
+			dma_huge_chunk_put(bdb, chk);
 			return rc;
 		}
 		bio_iov_set_raw_buf(biov, chk->bdc_ptr + pg_off);
@@ -1356,6 +1658,7 @@ static int
 iod_map_iovs(struct bio_desc *biod, void *arg)
 {
 	struct bio_dma_buffer	*bdb;
+	uint64_t		 wait_start = 0;
 	int			 rc, retry_cnt = 0;
 
 	/* NVMe context isn't allocated */
@@ -1364,6 +1667,8 @@ iod_map_iovs(struct bio_desc *biod, void *arg)
 	else
 		bdb = iod_dma_buf(biod);
 
+	if (bdb != NULL && bdb->bdb_queued_iods != 0)
+		wait_start = daos_getutime();
 	iod_fifo_in(biod, bdb);
 retry:
 	rc = iterate_biov(biod, arg ? bulk_map_one : dma_map_one, arg);
@@ -1395,6 +1700,8 @@ retry:
 		}
 
 		retry_cnt++;
+		if (wait_start == 0)
+			wait_start = daos_getutime();
 		D_DEBUG(DB_IO, "IOD %p waits for active IODs. %d\n", biod, retry_cnt);
 
 		iod_fifo_wait(biod, bdb);
@@ -1408,6 +1715,8 @@ retry:
 	if (retry_cnt && bdb->bdb_stats.bds_grab_retries)
 		d_tm_set_gauge(bdb->bdb_stats.bds_grab_retries, retry_cnt);
 out:
+	if (wait_start != 0 && bdb->bdb_stats.bds_fifo_wait)
+		d_tm_set_gauge(bdb->bdb_stats.bds_fifo_wait, daos_getutime() - wait_start);
 	iod_fifo_out(biod, bdb);
 	return rc;
 }
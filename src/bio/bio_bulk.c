@@ -285,8 +285,8 @@ bulk_create_hdl(struct bio_dma_chunk *chk, struct bio_bulk_args *arg)
 
 	sgl.sg_nr_out = sgl.sg_nr;
 	sgl.sg_iovs[0].iov_buf = chk->bdc_ptr;
-	sgl.sg_iovs[0].iov_buf_len = (bio_chk_sz << BIO_DMA_PAGE_SHIFT);
-	sgl.sg_iovs[0].iov_len = (bio_chk_sz << BIO_DMA_PAGE_SHIFT);
+	sgl.sg_iovs[0].iov_buf_len = ((size_t)chk->bdc_pg_cnt << BIO_DMA_PAGE_SHIFT);
+	sgl.sg_iovs[0].iov_len = ((size_t)chk->bdc_pg_cnt << BIO_DMA_PAGE_SHIFT);
 
 	rc = bulk_create_fn(arg->ba_bulk_ctxt, &sgl, arg->ba_bulk_perm,
 			    &chk->bdc_bulk_hdl);
@@ -362,6 +362,10 @@ bulk_grp_grow(struct bio_dma_buffer *bdb, struct bio_bulk_group *bbg,
 	if (!d_list_empty(&bdb->bdb_idle_list))
 		goto populate;
 
+	/* Try to borrow an idle chunk lent by other xstreams */
+	if (dma_buffer_borrow(bdb) == 0)
+		goto populate;
+
 	/* Grow DMA buffer when not reaching DMA upper bound */
 	if (bdb->bdb_tot_cnt < bio_chk_cnt_max) {
 		rc = dma_buffer_grow(bdb, 1);
@@ -452,7 +456,9 @@ bulk_hdl2len(struct bio_bulk_hdl *hdl)
 
 	D_ASSERT(chk != NULL);
 	bbg = chk->bdc_bulk_grp;
-	D_ASSERT(bbg != NULL);
+	/* Dedicated huge chunk */
+	if (bbg == NULL)
+		return chk->bdc_pg_cnt << BIO_DMA_PAGE_SHIFT;
 
 	return bbg->bbg_bulk_pgs << BIO_DMA_PAGE_SHIFT;
 }
@@ -536,9 +542,6 @@ bypass_bulk_cache(struct bio_desc *biod, struct bio_iov *biov,
 	/* Hole, no RDMA */
 	if (bio_addr_is_hole(&biov->bi_addr))
 		return true;
-	/* Huge IOV, allocate DMA buffer & create bulk handle on-the-fly */
-	if (pg_cnt > bio_chk_sz)
-		return true;
 	/* Get buffer operation */
 	if (biod->bd_type == BIO_IOD_TYPE_GETBUF)
 		return false;
@@ -604,6 +607,71 @@ roundup_pgs(unsigned int pgs)
 	return bio_chk_sz / (bio_chk_sz / pgs);
 }
 
+/*
+ * Huge IOV is mapped to a dedicated huge chunk, register the whole chunk as bulk
+ * handle, so that the RDMA transfer can be done directly against the DMA buffer.
+ * The bulk handle is kept with the chunk and reused when the chunk is reused from
+ * the huge chunk cache. Return NULL on failure, caller will fallback to create the
+ * bulk handle on-the-fly.
+ */
+static struct bio_bulk_hdl *
+bulk_get_huge_hdl(struct bio_desc *biod, struct bio_iov *biov, unsigned int pg_off,
+		  struct bio_bulk_args *arg)
+{
+	struct bio_rsrvd_dma	*rsrvd_dma = &biod->bd_rsrvd;
+	struct bio_dma_chunk	*chk;
+	struct bio_bulk_hdl	*hdl;
+	int			 rc;
+
+	D_ASSERT(rsrvd_dma->brd_chk_cnt > 0);
+	chk = rsrvd_dma->brd_dma_chks[rsrvd_dma->brd_chk_cnt - 1];
+	D_ASSERT(chk != NULL && chk->bdc_bulk_grp == NULL);
+	D_ASSERT(chk->bdc_pg_cnt > bio_chk_sz);
+
+	if (chk->bdc_bulk_hdl == NULL) {
+		rc = bulk_create_hdl(chk, arg);
+		if (rc)
+			return NULL;
+	}
+
+	if (chk->bdc_bulks == NULL) {
+		D_ALLOC_PTR(chk->bdc_bulks);
+		if (chk->bdc_bulks == NULL)
+			return NULL;
+		D_INIT_LIST_HEAD(&chk->bdc_bulks->bbh_link);
+		chk->bdc_bulks->bbh_chunk = chk;
+	}
+
+	hdl = chk->bdc_bulks;
+	D_ASSERT(hdl->bbh_inuse == 0);
+	hdl->bbh_pg_idx = 0;
+	/* biov->bi_prefix_len is for csum, not included in bulk transfer */
+	hdl->bbh_bulk_off = pg_off + biov->bi_prefix_len;
+	hdl->bbh_inuse = 1;
+
+	return hdl;
+}
+
+void
+bulk_huge_chunk_fini(struct bio_dma_chunk *chk)
+{
+	int	rc;
+
+	D_ASSERT(chk->bdc_bulk_grp == NULL);
+	if (chk->bdc_bulks != NULL) {
+		D_ASSERT(chk->bdc_bulks->bbh_inuse == 0);
+		D_FREE(chk->bdc_bulks);
+	}
+
+	if (chk->bdc_bulk_hdl != NULL) {
+		rc = bulk_free_fn(chk->bdc_bulk_hdl);
+		if (rc)
+			D_ERROR("Failed to free bulk hdl %p "DF_RC"\n",
+				chk->bdc_bulk_hdl, DP_RC(rc));
+		chk->bdc_bulk_hdl = NULL;
+	}
+}
+
 int
 bulk_map_one(struct bio_desc *biod, struct bio_iov *biov, void *data)
 {
@@ -641,6 +709,14 @@ bulk_map_one(struct bio_desc *biod, struct bio_iov *biov, void *data)
 	}
 	D_ASSERT(!BIO_ADDR_IS_DEDUP(&biov->bi_addr));
 
+	/* Huge IOV, allocate dedicated DMA buffer, bulk handle is cached along with it */
+	if (pg_cnt > bio_chk_sz) {
+		rc = dma_map_one(biod, biov, NULL);
+		if (rc == 0)
+			hdl = bulk_get_huge_hdl(biod, biov, pg_off, arg);
+		goto done;
+	}
+
 	hdl = bulk_get_hdl(biod, biov, roundup_pgs(pg_cnt), pg_off, arg);
 	if (hdl == NULL) {
 		if (biod->bd_retry)
@@ -692,7 +768,14 @@ bulk_iod_release(struct bio_desc *biod)
 		if (hdl == NULL)
 			continue;
 
-		bulk_hdl_unhold(hdl);
+		/* Dedicated huge chunk, the bulk handle stays with the chunk */
+		if (hdl->bbh_chunk->bdc_bulk_grp == NULL) {
+			D_ASSERT(hdl->bbh_inuse == 1);
+			hdl->bbh_inuse = 0;
+			hdl->bbh_bulk_off = 0;
+		} else {
+			bulk_hdl_unhold(hdl);
+		}
 		biod->bd_bulk_hdls[i] = NULL;
 	}
 
@@ -12,6 +12,7 @@
 #include <daos_srv/smd.h>
 #include <gurt/telemetry_common.h>
 #include <gurt/telemetry_producer.h>
+#include <gurt/atomic.h>
 #include <spdk/env.h>
 #include <spdk/bdev.h>
 #include <spdk/thread.h>
@@ -83,6 +84,8 @@ struct bio_dma_chunk {
 	unsigned int	 bdc_ref;
 	/* Chunk type */
 	unsigned int	 bdc_type;
+	/* Chunk size in 4K pages */
+	unsigned int	 bdc_pg_cnt;
 	/* == Bulk handle caching related fields == */
 	struct bio_bulk_group	*bdc_bulk_grp;
 	struct bio_bulk_hdl	*bdc_bulks;
@@ -113,6 +116,13 @@ struct bio_dma_stats {
 	struct d_tm_node_t	*bds_wal_sz;
 	struct d_tm_node_t	*bds_wal_qd;
 	struct d_tm_node_t	*bds_wal_waiters;
+	struct d_tm_node_t	*bds_wal_batch;
+	struct d_tm_node_t	*bds_wal_lat;
+	struct d_tm_node_t	*bds_chks_borrowed;
+	struct d_tm_node_t	*bds_chks_lent;
+	struct d_tm_node_t	*bds_fifo_wait;
+	struct d_tm_node_t	*bds_huge_hits;
+	struct d_tm_node_t	*bds_huge_cached;
 };
 
 /*
@@ -133,6 +143,23 @@ struct bio_dma_buffer {
 	struct bio_bulk_cache	 bdb_bulk_cache;
 	struct bio_dma_stats	 bdb_stats;
 	uint64_t		 bdb_dump_ts;
+	uint64_t		 bdb_lend_ts;
+	unsigned int		 bdb_numa_node;
+	/* Idle huge chunks (and their registered bulk handles) kept for reuse */
+	d_list_t		 bdb_huge_list;
+	unsigned int		 bdb_huge_pgs;
+};
+
+/*
+ * Engine wide pool of idle DMA chunks shared by all the xstreams on the socket, idle
+ * xstreams lend chunks into it and busy xstreams borrow from it. Each slot is claimed
+ * by atomic exchange, so lending and borrowing don't need any lock.
+ */
+struct bio_dma_pool {
+	struct bio_dma_chunk * ATOMIC	*bdp_slots;
+	unsigned int			 bdp_slot_cnt;
+	ATOMIC unsigned int		 bdp_chk_cnt;
+	ATOMIC unsigned int		 bdp_hint;
 };
 
 #define BIO_PROTO_NVME_STATS_LIST					\
@@ -541,9 +568,13 @@ extern bool		bio_scm_rdma;
 extern bool		bio_spdk_inited;
 extern unsigned int	bio_chk_sz;
 extern unsigned int	bio_chk_cnt_max;
+extern unsigned int	bio_chk_cnt_init;
 extern unsigned int	bio_numa_node;
 extern unsigned int	bio_spdk_max_unmap_cnt;
 extern unsigned int	bio_max_async_sz;
+extern unsigned int	bio_wal_grp_max;
+extern unsigned int	bio_wal_grp_window;
+extern bool		bio_dma_pool_enabled;
 
 int xs_poll_completion(struct bio_xs_context *ctxt, unsigned int *inflights,
 		       uint64_t timeout);
@@ -580,6 +611,10 @@ int iod_add_region(struct bio_desc *biod, struct bio_dma_chunk *chk,
 		   unsigned int chk_pg_idx, unsigned int chk_off, uint64_t off,
 		   uint64_t end, uint8_t media);
 int dma_buffer_grow(struct bio_dma_buffer *buf, unsigned int cnt);
+int dma_buffer_borrow(struct bio_dma_buffer *buf);
+void dma_buffer_lend(struct bio_dma_buffer *buf, uint64_t now);
+int dma_pool_init(unsigned int tgt_nr);
+void dma_pool_fini(void);
 void iod_dma_wait(struct bio_desc *biod);
 
 static inline struct bio_dma_buffer *
@@ -622,6 +657,7 @@ ioc2d_bdev(struct bio_io_context *ioc)
 /* bio_bulk.c */
 int bulk_map_one(struct bio_desc *biod, struct bio_iov *biov, void *data);
 void bulk_iod_release(struct bio_desc *biod);
+void bulk_huge_chunk_fini(struct bio_dma_chunk *chk);
 int bulk_cache_create(struct bio_dma_buffer *bdb);
 void bulk_cache_destroy(struct bio_dma_buffer *bdb);
 int bulk_reclaim_chunk(struct bio_dma_buffer *bdb,
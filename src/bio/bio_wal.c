@@ -683,6 +683,13 @@ struct wal_tx_desc {
 	uint32_t		 td_blks;		/* Blocks used by this tx */
 	int			 td_error;
 	unsigned int		 td_wal_complete:1;	/* Indicating WAL I/O completed */
+	/* Group commit only, transaction details used by the batch leader on submit */
+	d_list_t		 td_batch_link;		/* Link to wal_tx_batch::tb_members */
+	struct umem_wal_tx	*td_tx;
+	struct data_csum_array	*td_dc_arr;
+	struct wal_blks_desc	*td_bd;
+	struct bio_desc		*td_data_iod;		/* Async data IOD passed by caller */
+	ABT_eventual		 td_done;		/* Eventual for tx completion */
 };
 
 static inline struct wal_tx_desc *
@@ -771,8 +778,13 @@ wal_tx_completion(struct wal_tx_desc *wal_tx, bool complete_next)
 	if (stats->bds_wal_qd)
 		d_tm_dec_gauge(stats->bds_wal_qd, 1);
 
-	/* The ABT_eventual could be NULL if WAL I/O IOD failed on DMA mapping in bio_iod_prep() */
-	if (biod_tx->bd_dma_done != ABT_EVENTUAL_NULL)
+	/*
+	 * The ABT_eventual could be NULL if WAL I/O IOD failed on DMA mapping in bio_iod_prep().
+	 * Batched transactions share the WAL I/O IOD, each of them waits on its own eventual.
+	 */
+	if (wal_tx->td_done != ABT_EVENTUAL_NULL)
+		ABT_eventual_set(wal_tx->td_done, NULL, 0);
+	else if (biod_tx->bd_dma_done != ABT_EVENTUAL_NULL)
 		ABT_eventual_set(biod_tx->bd_dma_done, NULL, 0);
 
 	/*
@@ -921,28 +933,387 @@ wait_tx_committed(struct wal_tx_desc *wal_tx)
 	D_ASSERT(d_list_empty(&wal_tx->td_link));
 }
 
+/* Setup the bsgl for the WAL region starting from @start_id and spanning @blks blocks */
+static int
+wal_region_init(struct wal_super_info *si, struct bio_sglist *bsgl, uint64_t start_id,
+		unsigned int blks)
+{
+	unsigned int	tot_blks = si->si_header.wh_tot_blks;
+	unsigned int	blk_bytes = si->si_header.wh_blk_bytes;
+	unsigned int	start_off = id2off(start_id);
+	unsigned int	iov_blks;
+	bio_addr_t	addr = { 0 };
+	int		iov_nr, rc;
+
+	D_ASSERT(start_off < tot_blks);
+	if ((start_off + blks) <= tot_blks) {
+		iov_nr = 1;
+		iov_blks = blks;
+	} else {
+		iov_nr = 2;
+		iov_blks = (tot_blks - start_off);
+	}
+
+	rc = bio_sgl_init(bsgl, iov_nr);
+	if (rc)
+		return rc;
+
+	bio_addr_set(&addr, DAOS_MEDIA_NVME, off2lba(si, start_off));
+	bio_iov_set(&bsgl->bs_iovs[0], addr, (uint64_t)iov_blks * blk_bytes);
+	if (iov_nr == 2) {
+		bio_addr_set(&addr, DAOS_MEDIA_NVME, off2lba(si, 0));
+		iov_blks = blks - iov_blks;
+		bio_iov_set(&bsgl->bs_iovs[1], addr, (uint64_t)iov_blks * blk_bytes);
+	}
+	bsgl->bs_nr_out = iov_nr;
+
+	return 0;
+}
+
+/*
+ * WAL group commit.
+ *
+ * Transactions committed concurrently by different ULTs of the same target are coalesced
+ * into a batch, and the WAL blocks of all transactions in the batch are written to the WAL
+ * blob by a single NVMe I/O. The WAL layout isn't changed, each transaction still has its
+ * own header, entries, payload and tail, so replay is unaware of the batching.
+ *
+ * The first transaction of a batch (leader) is responsible for submitting the batch. When
+ * the WAL device is idle, the leader submits immediately; otherwise, it holds the batch open
+ * for an adaptive window (scaled by the WAL I/O queue depth and the observed WAL I/O latency)
+ * to let more transactions (followers) join.
+ */
+struct wal_tx_batch {
+	d_list_t		 tb_members;	/* wal_tx_desc(s) in ID order */
+	struct wal_super_info	*tb_si;
+	struct bio_desc		*tb_biod;	/* IOD for the coalesced WAL I/O */
+	uint64_t		 tb_id;		/* ID of the first transaction */
+	uint64_t		 tb_submit_ts;	/* WAL I/O submit time, in usecs */
+	uint32_t		 tb_blks;	/* Total blocks used by the batch */
+	uint32_t		 tb_nr;		/* Number of transactions in the batch */
+	uint32_t		 tb_ref;	/* Transactions not returned yet */
+};
+
+#define WAL_GRP_MAX_BLKS	WAL_MAX_TRANS_BLKS
+
+static inline bool
+wal_batch_joinable(struct wal_tx_batch *batch, struct wal_tx_desc *wal_tx)
+{
+	struct wal_super_info	*si = batch->tb_si;
+
+	return (batch->tb_nr < bio_wal_grp_max) &&
+	       (batch->tb_blks + wal_tx->td_blks) <= WAL_GRP_MAX_BLKS &&
+	       (wal_next_id(si, batch->tb_id, batch->tb_blks) == si->si_unused_id);
+}
+
+static void
+wal_batch_add(struct wal_tx_batch *batch, struct wal_tx_desc *wal_tx)
+{
+	struct wal_super_info	*si = batch->tb_si;
+	struct bio_dma_stats	*stats = ioc2dma_stats(batch->tb_biod->bd_ctxt);
+	struct wal_blks_desc	*bd = wal_tx->td_bd;
+
+	if (batch->tb_nr == 0)
+		batch->tb_id = si->si_unused_id;
+
+	wal_tx->td_id = si->si_unused_id;
+	wal_tx->td_si = si;
+	wal_tx->td_biod_tx = batch->tb_biod;
+	wal_tx->td_biod_data = NULL;
+	/* Track in pending list from now on, since it will yield for batch submit */
+	d_list_add_tail(&wal_tx->td_link, &si->si_pending_list);
+	d_list_add_tail(&wal_tx->td_batch_link, &batch->tb_members);
+	batch->tb_blks += wal_tx->td_blks;
+	batch->tb_nr++;
+	batch->tb_ref++;
+
+	if (stats->bds_wal_qd)
+		d_tm_inc_gauge(stats->bds_wal_qd, 1);
+	if (stats->bds_wal_sz)
+		d_tm_set_gauge(stats->bds_wal_sz, (bd->bd_blks - 1) * si->si_header.wh_blk_bytes +
+			       bd->bd_tail_off);
+
+	/* Update next unused ID */
+	si->si_unused_id = wal_next_id(si, si->si_unused_id, wal_tx->td_blks);
+}
+
+static struct wal_tx_batch *
+wal_batch_alloc(struct bio_meta_context *mc)
+{
+	struct wal_tx_batch	*batch;
+
+	D_ALLOC_PTR(batch);
+	if (batch == NULL)
+		return NULL;
+
+	batch->tb_biod = bio_iod_alloc(mc->mc_wal, NULL, 1, BIO_IOD_TYPE_UPDATE);
+	if (batch->tb_biod == NULL) {
+		D_FREE(batch);
+		return NULL;
+	}
+	D_INIT_LIST_HEAD(&batch->tb_members);
+	batch->tb_si = &mc->mc_wal_info;
+
+	return batch;
+}
+
+static void
+wal_batch_put(struct wal_tx_batch *batch)
+{
+	D_ASSERT(batch->tb_ref > 0);
+	batch->tb_ref--;
+	if (batch->tb_ref > 0)
+		return;
+
+	D_ASSERT(batch->tb_si->si_open_batch != batch);
+	bio_iod_free(batch->tb_biod);
+	D_FREE(batch);
+}
+
+/* Adaptive coalescing window in usecs */
+static uint64_t
+wal_grp_window(struct wal_super_info *si)
+{
+	uint64_t	window;
+
+	/* WAL device is idle, submit immediately to not add any latency */
+	if (si->si_grp_inflights == 0)
+		return 0;
+
+	/*
+	 * New WAL I/O will be queued behind the in-flight ones anyway, hold the batch open
+	 * for a portion of the observed WAL I/O latency, the portion grows with queue depth.
+	 */
+	window = si->si_grp_lat * si->si_grp_inflights / (si->si_grp_inflights + 1);
+
+	return min(window, (uint64_t)bio_wal_grp_window);
+}
+
+/* Coalesced WAL I/O completion */
+static void
+wal_batch_completion(void *arg, int err)
+{
+	struct wal_tx_batch	*batch = arg;
+	struct wal_super_info	*si = batch->tb_si;
+	struct wal_tx_desc	*wal_tx, *tmp;
+	uint64_t		 lat;
+
+	D_ASSERT(si->si_grp_inflights > 0);
+	si->si_grp_inflights--;
+
+	lat = daos_getutime() - batch->tb_submit_ts;
+	/* Moving average with 1/8 weight for the latest sample */
+	si->si_grp_lat = si->si_grp_lat == 0 ? lat : (si->si_grp_lat * 7 + lat) / 8;
+
+	d_list_for_each_entry_safe(wal_tx, tmp, &batch->tb_members, td_batch_link)
+		wal_completion(wal_tx, err);
+}
+
+/* Build the view of a batched transaction on the DMA buffer of the batch */
+static void
+wal_batch_tx_view(struct bio_sglist *bsgl, unsigned int blk_off, unsigned int blks,
+		  unsigned int blk_bytes, struct bio_sglist *view)
+{
+	struct bio_iov	*biov = &bsgl->bs_iovs[0];
+	struct bio_iov	*view_iov;
+	unsigned int	 iov_blks = bio_iov2len(biov) / blk_bytes, cnt;
+
+	view->bs_nr_out = 0;
+	if (blk_off < iov_blks) {
+		cnt = min(blks, iov_blks - blk_off);
+		view_iov = &view->bs_iovs[view->bs_nr_out++];
+		*view_iov = *biov;
+		view_iov->bi_buf = biov->bi_buf + (uint64_t)blk_off * blk_bytes;
+		view_iov->bi_data_len = (uint64_t)cnt * blk_bytes;
+		view_iov->bi_addr.ba_off += (uint64_t)blk_off * blk_bytes;
+		blks -= cnt;
+		blk_off = 0;
+	} else {
+		blk_off -= iov_blks;
+	}
+
+	if (blks > 0) {
+		D_ASSERT(bsgl->bs_nr_out == 2);
+		biov = &bsgl->bs_iovs[1];
+		view_iov = &view->bs_iovs[view->bs_nr_out++];
+		*view_iov = *biov;
+		view_iov->bi_buf = biov->bi_buf + (uint64_t)blk_off * blk_bytes;
+		view_iov->bi_data_len = (uint64_t)blks * blk_bytes;
+		view_iov->bi_addr.ba_off += (uint64_t)blk_off * blk_bytes;
+	}
+	view->bs_nr = view->bs_nr_out;
+}
+
+static void
+wal_batch_submit(struct bio_meta_context *mc, struct wal_tx_batch *batch)
+{
+	struct wal_super_info	*si = &mc->mc_wal_info;
+	struct bio_desc		*biod = batch->tb_biod;
+	struct bio_desc		*biod_data;
+	struct bio_dma_stats	*stats = ioc2dma_stats(mc->mc_wal);
+	struct bio_sglist	*bsgl;
+	struct bio_sglist	 view;
+	struct bio_iov		 view_iovs[2];
+	struct wal_tx_desc	*wal_tx, *tmp;
+	unsigned int		 blk_off = 0;
+	unsigned int		 blk_bytes = si->si_header.wh_blk_bytes;
+	int			 rc;
+
+	bsgl = bio_iod_sgl(biod, 0);
+	rc = wal_region_init(si, bsgl, batch->tb_id, batch->tb_blks);
+	if (rc)
+		goto failed;
+
+	/*
+	 * Map the WAL regions to DMA buffer, bio_iod_prep() can guarantee FIFO order
+	 * when it has to yield and wait for DMA buffer.
+	 */
+	rc = bio_iod_prep(biod, BIO_CHK_TYPE_LOCAL, NULL, 0);
+	if (rc) {
+		D_ERROR("WAL IOD prepare failed. "DF_RC"\n", DP_RC(rc));
+		goto failed;
+	}
+
+	/* Fill DMA buffer with entries of each transaction */
+	view.bs_iovs = &view_iovs[0];
+	d_list_for_each_entry(wal_tx, &batch->tb_members, td_batch_link) {
+		wal_batch_tx_view(bsgl, blk_off, wal_tx->td_blks, blk_bytes, &view);
+		fill_trans_blks(mc, &view, wal_tx->td_tx, wal_tx->td_dc_arr, blk_bytes,
+				wal_tx->td_bd);
+		blk_off += wal_tx->td_blks;
+
+		/* Set proper completion callback for data I/O */
+		biod_data = wal_tx->td_data_iod;
+		if (biod_data == NULL)
+			continue;
+
+		if (biod_data->bd_inflights == 0) {
+			if (wal_tx->td_error == 0)
+				wal_tx->td_error = biod_data->bd_result;
+		} else {
+			biod_data->bd_completion = data_completion;
+			biod_data->bd_comp_arg = wal_tx;
+			wal_tx->td_biod_data = biod_data;
+		}
+	}
+	D_ASSERT(blk_off == batch->tb_blks);
+
+	if (stats->bds_wal_batch)
+		d_tm_set_gauge(stats->bds_wal_batch, batch->tb_nr);
+
+	D_DEBUG(DB_IO, "Submit WAL batch ID:"DF_U64" txs:%u blks:%u\n",
+		batch->tb_id, batch->tb_nr, batch->tb_blks);
+
+	biod->bd_completion = wal_batch_completion;
+	biod->bd_comp_arg = batch;
+	batch->tb_submit_ts = daos_getutime();
+	si->si_grp_inflights++;
+
+	rc = bio_iod_post_async(biod, 0);
+	if (rc)
+		D_ERROR("WAL batch commit failed. "DF_RC"\n", DP_RC(rc));
+	return;
+failed:
+	d_list_for_each_entry_safe(wal_tx, tmp, &batch->tb_members, td_batch_link)
+		wal_completion(wal_tx, rc);
+}
+
+static void
+wait_grp_tx_committed(struct wal_tx_desc *wal_tx)
+{
+	struct bio_xs_context	*xs_ctxt = wal_tx->td_biod_tx->bd_ctxt->bic_xs_ctxt;
+	int			 rc;
+
+	D_ASSERT(xs_ctxt != NULL);
+	/* Poll and yield in turn to allow other ULTs committing (and batching) meanwhile */
+	if (xs_ctxt->bxc_self_polling) {
+		while (!d_list_empty(&wal_tx->td_link)) {
+			spdk_thread_poll(xs_ctxt->bxc_thread, 0, 0);
+			if (!d_list_empty(&wal_tx->td_link))
+				bio_yield(NULL);
+		}
+	}
+
+	rc = ABT_eventual_wait(wal_tx->td_done, NULL);
+	if (rc != ABT_SUCCESS)
+		D_ERROR("ABT_eventual_wait failed. %d\n", rc);
+	/* The completion must have been called */
+	D_ASSERT(d_list_empty(&wal_tx->td_link));
+}
+
+static int
+wal_grp_commit(struct bio_meta_context *mc, struct wal_tx_desc *wal_tx)
+{
+	struct wal_super_info	*si = &mc->mc_wal_info;
+	struct wal_tx_batch	*batch = si->si_open_batch;
+	uint64_t		 start, window;
+	int			 rc;
+
+	rc = ABT_eventual_create(0, &wal_tx->td_done);
+	if (rc != ABT_SUCCESS)
+		return -DER_NOMEM;
+
+	/* Join the open batch as follower */
+	if (batch != NULL && wal_batch_joinable(batch, wal_tx)) {
+		wal_batch_add(batch, wal_tx);
+		goto wait;
+	}
+
+	/* Start a new batch as leader */
+	batch = wal_batch_alloc(mc);
+	if (batch == NULL) {
+		ABT_eventual_free(&wal_tx->td_done);
+		return -DER_NOMEM;
+	}
+	wal_batch_add(batch, wal_tx);
+	si->si_open_batch = batch;
+
+	window = wal_grp_window(si);
+	if (window > 0) {
+		start = daos_getutime();
+		do {
+			bio_yield(NULL);
+		} while (si->si_open_batch == batch && batch->tb_nr < bio_wal_grp_max &&
+			 si->si_grp_inflights > 0 && (daos_getutime() - start) < window);
+	}
+
+	/* Close the batch, later transactions will start a new batch */
+	if (si->si_open_batch == batch)
+		si->si_open_batch = NULL;
+
+	wal_batch_submit(mc, batch);
+wait:
+	/* Wait for WAL commit completion */
+	wait_grp_tx_committed(wal_tx);
+	rc = wal_tx->td_error;
+
+	ABT_eventual_free(&wal_tx->td_done);
+	wal_batch_put(batch);
+
+	return rc;
+}
+
 int
 bio_wal_commit(struct bio_meta_context *mc, struct umem_wal_tx *tx, struct bio_desc *biod_data)
 {
 	struct wal_super_info	*si = &mc->mc_wal_info;
 	struct bio_desc		*biod = NULL;
 	struct bio_sglist	*bsgl;
-	bio_addr_t		 addr = { 0 };
 	struct wal_tx_desc	 wal_tx = { 0 };
 	struct wal_blks_desc	 blk_desc = { 0 };
 	struct data_csum_array	 dc_arr;
-	unsigned int		 blks, unused_off;
-	unsigned int		 tot_blks = si->si_header.wh_tot_blks;
 	unsigned int		 blk_bytes = si->si_header.wh_blk_bytes;
 	uint64_t		 tx_id = tx->utx_id;
+	uint64_t		 start_ts;
 	struct bio_dma_stats	*stats;
-	int			 iov_nr, rc;
+	int			 rc;
 
 	/* Bypass WAL commit, used for performance evaluation only */
 	if (daos_io_bypass & IOBP_WAL_COMMIT) {
 		bio_yield(NULL);
 		return 0;
 	}
+	start_ts = daos_getutime();
 
 	D_DEBUG(DB_IO, "MC:%p WAL commit ID:"DF_U64" seq:%u off:%u, biod_data:%p inflights:%u\n",
 		mc, tx_id, id2seq(tx_id), id2off(tx_id), biod_data,
@@ -965,6 +1336,17 @@ bio_wal_commit(struct bio_meta_context *mc, struct umem_wal_tx *tx, struct bio_d
 		goto out;
 	}
 
+	D_ASSERT(wal_id_cmp(si, tx_id, si->si_unused_id) == 0);
+	if (bio_wal_grp_max > 1) {
+		wal_tx.td_tx = tx;
+		wal_tx.td_dc_arr = &dc_arr;
+		wal_tx.td_bd = &blk_desc;
+		wal_tx.td_data_iod = biod_data;
+		wal_tx.td_blks = blk_desc.bd_blks;
+		rc = wal_grp_commit(mc, &wal_tx);
+		goto out;
+	}
+
 	biod = bio_iod_alloc(mc->mc_wal, NULL, 1, BIO_IOD_TYPE_UPDATE);
 	if (biod == NULL) {
 		rc = -DER_NOMEM;
@@ -972,31 +1354,11 @@ bio_wal_commit(struct bio_meta_context *mc, struct umem_wal_tx *tx, struct bio_d
 	}
 
 	/* Figure out the regions in WAL for this transaction */
-	D_ASSERT(wal_id_cmp(si, tx_id, si->si_unused_id) == 0);
-	unused_off = id2off(si->si_unused_id);
-	D_ASSERT(unused_off < tot_blks);
-	if ((unused_off + blk_desc.bd_blks) <= tot_blks) {
-		iov_nr = 1;
-		blks = blk_desc.bd_blks;
-	} else {
-		iov_nr = 2;
-		blks = (tot_blks - unused_off);
-	}
-
 	bsgl = bio_iod_sgl(biod, 0);
-	rc = bio_sgl_init(bsgl, iov_nr);
+	rc = wal_region_init(si, bsgl, si->si_unused_id, blk_desc.bd_blks);
 	if (rc)
 		goto out;
 
-	bio_addr_set(&addr, DAOS_MEDIA_NVME, off2lba(si, unused_off));
-	bio_iov_set(&bsgl->bs_iovs[0], addr, (uint64_t)blks * blk_bytes);
-	if (iov_nr == 2) {
-		bio_addr_set(&addr, DAOS_MEDIA_NVME, off2lba(si, 0));
-		blks = blk_desc.bd_blks - blks;
-		bio_iov_set(&bsgl->bs_iovs[1], addr, (uint64_t)blks * blk_bytes);
-	}
-	bsgl->bs_nr_out = iov_nr;
-
 	wal_tx.td_id = si->si_unused_id;
 	wal_tx.td_si = si;
 	wal_tx.td_biod_tx = biod;
@@ -1053,6 +1415,10 @@ out:
 	free_data_csum(&dc_arr);
 	if (biod != NULL)
 		bio_iod_free(biod);
+
+	stats = ioc2dma_stats(mc->mc_wal);
+	if (stats->bds_wal_lat)
+		d_tm_set_gauge(stats->bds_wal_lat, daos_getutime() - start_ts);
 	return rc;
 }
 
@@ -1147,7 +1513,7 @@ bio_wal_flush_header(struct bio_meta_context *mc)
 }
 
 static int
-load_wal(struct bio_meta_context *mc, char *buf, unsigned int max_blks, uint64_t tx_id)
+load_wal(struct bio_meta_context *mc, char *buf, unsigned int max_blks, unsigned int off)
 {
 	struct wal_super_info	*si = &mc->mc_wal_info;
 	unsigned int		 tot_blks = si->si_header.wh_tot_blks;
@@ -1156,7 +1522,7 @@ load_wal(struct bio_meta_context *mc, char *buf, unsigned int max_blks, uint64_t
 	struct bio_iov		*biov;
 	d_sg_list_t		 sgl;
 	d_iov_t			 iov;
-	unsigned int		 nr_blks, blks, off;
+	unsigned int		 nr_blks, blks;
 	bio_addr_t		 addr = { 0 };
 	int			 iov_nr, rc;
 
@@ -1173,7 +1539,6 @@ load_wal(struct bio_meta_context *mc, char *buf, unsigned int max_blks, uint64_t
 	if (rc)
 		return rc;
 
-	off = id2off(tx_id);
 	while (max_blks > 0) {
 		biov = &bsgl.bs_iovs[bsgl.bs_nr_out];
 
@@ -1199,6 +1564,76 @@ load_wal(struct bio_meta_context *mc, char *buf, unsigned int max_blks, uint64_t
 	return rc;
 }
 
+/*
+ * WAL replay pipeline: while transactions in the current window are being verified
+ * and replayed, the next window is prefetched by a helper ULT into the adjacent buffer.
+ */
+struct wal_prefetch {
+	struct bio_meta_context	*wp_mc;
+	char			*wp_buf;
+	unsigned int		 wp_off;
+	unsigned int		 wp_blks;
+	int			 wp_rc;
+	ABT_thread		 wp_ult;
+	bool			 wp_pending;
+};
+
+static void
+wal_prefetch_ult(void *arg)
+{
+	struct wal_prefetch	*wp = arg;
+
+	wp->wp_rc = load_wal(wp->wp_mc, wp->wp_buf, wp->wp_blks, wp->wp_off);
+}
+
+static void
+wal_prefetch_start(struct wal_prefetch *wp, char *buf, unsigned int off)
+{
+	ABT_thread	self;
+	ABT_pool	pool;
+	int		rc;
+
+	D_ASSERT(!wp->wp_pending);
+	wp->wp_buf = buf;
+	wp->wp_off = off;
+	wp->wp_rc = 0;
+	wp->wp_ult = ABT_THREAD_NULL;
+	wp->wp_pending = true;
+
+	/* Run in the caller's pool, the first main pool of engine xstreams is for network poll */
+	rc = ABT_thread_self(&self);
+	if (rc == ABT_SUCCESS)
+		rc = ABT_thread_get_last_pool(self, &pool);
+	if (rc == ABT_SUCCESS)
+		rc = ABT_thread_create(pool, wal_prefetch_ult, wp, ABT_THREAD_ATTR_NULL,
+				       &wp->wp_ult);
+	if (rc != ABT_SUCCESS) {
+		/* Fallback to synchronous load on wait */
+		D_DEBUG(DB_IO, "Failed to create WAL prefetch ULT, rc:%d\n", rc);
+		wp->wp_ult = ABT_THREAD_NULL;
+	}
+}
+
+static int
+wal_prefetch_wait(struct wal_prefetch *wp, uint64_t *wait_us)
+{
+	uint64_t	start_us = daos_getutime();
+
+	if (!wp->wp_pending)
+		return 0;
+
+	if (wp->wp_ult != ABT_THREAD_NULL) {
+		ABT_thread_join(wp->wp_ult);
+		ABT_thread_free(&wp->wp_ult);
+	} else {
+		wal_prefetch_ult(wp);
+	}
+	wp->wp_pending = false;
+	*wait_us += daos_getutime() - start_us;
+
+	return wp->wp_rc;
+}
+
 /* Check if a tx_id is known to be committed */
 static bool
 tx_known_committed(struct wal_super_info *si, uint64_t tx_id)
@@ -1662,19 +2097,28 @@ bio_wal_replay(struct bio_meta_context *mc, struct bio_wal_rp_stats *wrs,
 	struct wal_super_info	*si = &mc->mc_wal_info;
 	struct wal_trans_head	*hdr;
 	unsigned int		 blk_bytes = si->si_header.wh_blk_bytes;
+	unsigned int		 tot_blks = si->si_header.wh_tot_blks;
 	struct wal_blks_desc	 blk_desc = { 0 };
-	char			*buf, *dbuf = NULL;
+	struct wal_prefetch	 wp = { 0 };
+	char			*buf, *dbuf = NULL, *win[2];
 	struct umem_action	*act;
-	unsigned int		 max_blks = WAL_MAX_TRANS_BLKS, blk_off;
-	unsigned int		 nr_replayed = 0, tight_loop, dbuf_len = 0;
+	unsigned int		 max_blks = WAL_MAX_TRANS_BLKS, blk_off, win_off, tail_blks;
+	unsigned int		 nr_replayed = 0, tight_loop = 0, dbuf_len = 0, cur = 0;
 	uint64_t		 tx_id, start_id, unmap_start, unmap_end;
+	uint64_t		 win_bytes = (uint64_t)max_blks * blk_bytes;
 	int			 rc;
 	uint64_t		 total_bytes = 0, rpl_entries = 0, total_tx = 0;
-	uint64_t                 s_us = 0;
+	uint64_t                 s_us = 0, io_wait = 0, rd_bytes = 0;
 
-	D_ALLOC(buf, max_blks * blk_bytes);
+	/*
+	 * Two adjacent WAL windows, preceded by a spare window for the head part of
+	 * transaction straddling the second window and the first window.
+	 */
+	D_ALLOC(buf, win_bytes * 3);
 	if (buf == NULL)
 		return -DER_NOMEM;
+	win[0] = buf + win_bytes;
+	win[1] = buf + win_bytes * 2;
 
 	D_ALLOC(act, sizeof(*act) + UMEM_ACT_PAYLOAD_MAX_LEN);
 	if (act == NULL) {
@@ -1689,14 +2133,19 @@ bio_wal_replay(struct bio_meta_context *mc, struct bio_wal_rp_stats *wrs,
 	if (wrs != NULL)
 		s_us = daos_getutime();
 
-load_wal:
-	tight_loop = 0;
+	wp.wp_mc = mc;
+	wp.wp_blks = max_blks;
 	blk_off = 0;
-	rc = load_wal(mc, buf, max_blks, tx_id);
+	win_off = id2off(tx_id);
+
+	wal_prefetch_start(&wp, win[cur], win_off);
+	rc = wal_prefetch_wait(&wp, &io_wait);
 	if (rc) {
 		D_ERROR("Failed to load WAL. "DF_RC"\n", DP_RC(rc));
 		goto out;
 	}
+	rd_bytes += win_bytes;
+	wal_prefetch_start(&wp, win[cur ^ 1], (win_off + max_blks) % tot_blks);
 
 	while (1) {
 		/* Something went wrong, it's impossible to replay the whole WAL */
@@ -1706,21 +2155,35 @@ load_wal:
 			break;
 		}
 
-		hdr = (struct wal_trans_head *)(buf + blk_off * blk_bytes);
+		D_ASSERT(blk_off < max_blks);
+		hdr = (struct wal_trans_head *)(win[cur] + blk_off * blk_bytes);
 		rc = verify_tx_hdr(si, hdr, tx_id);
 		if (rc)
 			break;
 
 		calc_trans_blks(hdr->th_tot_ents, hdr->th_tot_payload, blk_bytes, &blk_desc);
 
+		if (blk_desc.bd_blks > max_blks) {
+			D_ERROR("Too large tx, the WAL is corrupted\n");
+			rc = -DER_INVAL;
+			break;
+		}
+
+		/* The transaction spans into next window, wait for the prefetch */
 		if (blk_off + blk_desc.bd_blks > max_blks) {
-			if (blk_off == 0) {
-				D_ERROR("Too large tx, the WAL is corrupted\n");
-				rc = -DER_INVAL;
+			rc = wal_prefetch_wait(&wp, &io_wait);
+			if (rc) {
+				D_ERROR("Failed to load WAL. "DF_RC"\n", DP_RC(rc));
 				break;
 			}
-			memset(buf, 0, max_blks * blk_bytes);
-			goto load_wal;
+			rd_bytes += win_bytes;
+
+			/* Move the head part ahead of the next window to make it contiguous */
+			if (cur == 1) {
+				tail_blks = max_blks - blk_off;
+				memcpy(win[0] - tail_blks * blk_bytes, hdr, tail_blks * blk_bytes);
+				hdr = (struct wal_trans_head *)(win[0] - tail_blks * blk_bytes);
+			}
 		}
 
 		rc = verify_tx(mc, (char *)hdr, &blk_desc, &dbuf, &dbuf_len);
@@ -1749,9 +2212,20 @@ load_wal:
 		}
 		tx_id = wal_next_id(si, tx_id, blk_desc.bd_blks);
 
-		if (blk_off == max_blks) {
-			memset(buf, 0, max_blks * blk_bytes);
-			goto load_wal;
+		/* Switch to next window, and start prefetching the one after it */
+		if (blk_off >= max_blks) {
+			if (wp.wp_pending) {
+				rc = wal_prefetch_wait(&wp, &io_wait);
+				if (rc) {
+					D_ERROR("Failed to load WAL. "DF_RC"\n", DP_RC(rc));
+					break;
+				}
+				rd_bytes += win_bytes;
+			}
+			blk_off -= max_blks;
+			cur ^= 1;
+			win_off = (win_off + max_blks) % tot_blks;
+			wal_prefetch_start(&wp, win[cur ^ 1], (win_off + max_blks) % tot_blks);
 		}
 
 		if (tight_loop >= 20) {
@@ -1759,6 +2233,9 @@ load_wal:
 			bio_yield(NULL);
 		}
 	}
+	/* The outstanding prefetch is useless when replay is done */
+	if (wp.wp_pending)
+		wal_prefetch_wait(&wp, &io_wait);
 out:
 	if (rc >= 0) {
 		D_DEBUG(DB_IO, "Replayed %u WAL transactions\n", nr_replayed);
@@ -1797,6 +2274,8 @@ out:
 			wrs->wrs_sz = total_bytes;
 			wrs->wrs_entries = rpl_entries;
 			wrs->wrs_tx_cnt = total_tx;
+			wrs->wrs_io_wait = io_wait;
+			wrs->wrs_rd_sz = rd_bytes;
 		}
 	} else {
 		D_ERROR("WAL replay failed, "DF_RC"\n", DP_RC(rc));
@@ -1883,6 +2362,7 @@ wal_close(struct bio_meta_context *mc)
 
 	D_ASSERT(d_list_empty(&si->si_pending_list));
 	D_ASSERT(si->si_tx_failed == 0);
+	D_ASSERT(si->si_open_batch == NULL && si->si_grp_inflights == 0);
 	if (si->si_rsrv_waiters > 0)
 		wakeup_reserve_waiters(si, true);
 
@@ -1925,6 +2405,9 @@ wal_open(struct bio_meta_context *mc)
 	D_INIT_LIST_HEAD(&si->si_pending_list);
 	si->si_rsrv_waiters = 0;
 	si->si_tx_failed = 0;
+	si->si_open_batch = NULL;
+	si->si_grp_lat = 0;
+	si->si_grp_inflights = 0;
 
 	si->si_ckp_id = hdr->wh_ckp_id;
 	si->si_ckp_blks = hdr->wh_ckp_blks;
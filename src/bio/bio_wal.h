@@ -85,6 +85,8 @@ struct wal_trans_tail {
 	uint32_t	tt_csum;	/* Checksum of WAL transaction */
 } __attribute__((packed));
 
+struct wal_tx_batch;
+
 /* In-memory WAL super information */
 struct wal_super_info {
 	struct wal_header	si_header;	/* WAL blob header */
@@ -98,6 +100,10 @@ struct wal_super_info {
 	ABT_mutex		si_mutex;	/* For si_rsrv_wq */
 	unsigned int		si_rsrv_waiters;/* Number of waiters in reserve waitqueue */
 	unsigned int		si_tx_failed:1;	/* Indicating some transaction failed */
+	/* WAL group commit */
+	struct wal_tx_batch	*si_open_batch;	/* Batch accepting new transactions */
+	uint64_t		si_grp_lat;	/* Moving average of WAL I/O latency, in usecs */
+	unsigned int		si_grp_inflights;/* Number of in-flight batched WAL I/Os */
 };
 
 /* In-memory Meta context, exported as opaque data structure */
@@ -49,7 +49,7 @@ unsigned int bio_chk_cnt_max;
 /* NUMA node affinity */
 unsigned int bio_numa_node;
 /* Per-xstream initial DMA buffer size (in chunk count) */
-static unsigned int bio_chk_cnt_init;
+unsigned int bio_chk_cnt_init;
 /* Diret RDMA over SCM */
 bool bio_scm_rdma;
 /* Whether SPDK inited */
@@ -59,6 +59,12 @@ unsigned int bio_spdk_subsys_timeout = 25000;	/* ms */
 /* How many blob unmap calls can be called in a row */
 unsigned int bio_spdk_max_unmap_cnt = 32;
 unsigned int bio_max_async_sz = (1UL << 20) /* 1MB */;
+/* Max transactions coalesced in one WAL I/O by group commit, 0 or 1 disables group commit */
+unsigned int bio_wal_grp_max = 32;
+/* Max time a WAL group commit batch can be held open for followers */
+unsigned int bio_wal_grp_window = 500;	/* us */
+/* Share idle DMA chunks among xstreams on the socket */
+bool bio_dma_pool_enabled = true;
 
 struct bio_nvme_data {
 	ABT_mutex		 bd_mutex;
@@ -256,6 +262,12 @@ bio_nvme_init(const char *nvme_conf, int numa_node, unsigned int mem_size,
 	d_getenv_int("DAOS_MAX_ASYNC_SZ", &bio_max_async_sz);
 	D_INFO("Max async data size is set to %u bytes\n", bio_max_async_sz);
 
+	d_getenv_int("DAOS_WAL_GRP_MAX", &bio_wal_grp_max);
+	d_getenv_int("DAOS_WAL_GRP_WINDOW", &bio_wal_grp_window);
+	D_INFO("WAL group commit is %s, max %u transactions, max window %u us\n",
+	       bio_wal_grp_max > 1 ? "enabled" : "disabled", bio_wal_grp_max,
+	       bio_wal_grp_window);
+
 	/* Hugepages disabled */
 	if (mem_size == 0) {
 		D_INFO("Set per-xstream DMA buffer upper bound to %u %uMB chunks\n",
@@ -283,6 +295,14 @@ bio_nvme_init(const char *nvme_conf, int numa_node, unsigned int mem_size,
 	D_INFO("Set per-xstream DMA buffer upper bound to %u %uMB chunks\n",
 	       bio_chk_cnt_max, size_mb);
 
+	d_getenv_bool("DAOS_DMA_SHARED_POOL", &bio_dma_pool_enabled);
+	rc = dma_pool_init(tgt_nr);
+	if (rc) {
+		D_ERROR("Failed to init shared DMA pool. "DF_RC"\n", DP_RC(rc));
+		goto free_cond;
+	}
+	D_INFO("Shared DMA pool is %s\n", bio_dma_pool_enabled ? "enabled" : "disabled");
+
 	spdk_bs_opts_init(&nvme_glb.bd_bs_opts, sizeof(nvme_glb.bd_bs_opts));
 	nvme_glb.bd_bs_opts.cluster_sz = DAOS_BS_CLUSTER_SZ;
 	nvme_glb.bd_bs_opts.max_channel_ops = BIO_BS_MAX_CHANNEL_OPS;
@@ -333,6 +353,7 @@ bio_nvme_init(const char *nvme_conf, int numa_node, unsigned int mem_size,
 	return 0;
 
 free_cond:
+	dma_pool_fini();
 	ABT_cond_free(&nvme_glb.bd_barrier);
 free_mutex:
 	ABT_mutex_free(&nvme_glb.bd_mutex);
@@ -353,6 +374,7 @@ bio_spdk_env_fini(void)
 void
 bio_nvme_fini(void)
 {
+	dma_pool_fini();
 	bio_spdk_env_fini();
 	ABT_cond_free(&nvme_glb.bd_barrier);
 	ABT_mutex_free(&nvme_glb.bd_mutex);
@@ -1904,6 +1926,9 @@ bio_nvme_poll(struct bio_xs_context *ctxt)
 	D_ASSERT(ctxt != NULL && ctxt->bxc_thread != NULL);
 	rc = spdk_thread_poll(ctxt->bxc_thread, 0, 0);
 
+	if (ctxt->bxc_dma_buf != NULL)
+		dma_buffer_lend(ctxt->bxc_dma_buf, daos_gettime_coarse());
+
 	/*
 	 * To avoid complicated race handling (init xstream and starting
 	 * VOS xstream concurrently access global device list & xstream
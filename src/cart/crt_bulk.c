@@ -127,6 +127,48 @@ out:
 	return rc;
 }
 
+int
+crt_bulk_cache_register(crt_context_t crt_ctx, void *buf, size_t len)
+{
+	struct crt_context	*ctx = crt_ctx;
+	int			rc = 0;
+
+	if (ctx == CRT_CONTEXT_NULL || buf == NULL || len == 0) {
+		D_ERROR("invalid parameter, crt_ctx: %p, buf: %p, len: %zu.\n",
+			crt_ctx, buf, len);
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+
+	rc = crt_hg_bulk_cache_register(&ctx->cc_hg_ctx, buf, len);
+	if (rc != 0)
+		D_ERROR("crt_hg_bulk_cache_register() failed, rc: "DF_RC"\n",
+			DP_RC(rc));
+
+out:
+	return rc;
+}
+
+int
+crt_bulk_cache_unregister(crt_context_t crt_ctx, void *buf, size_t len)
+{
+	struct crt_context	*ctx = crt_ctx;
+	int			rc = 0;
+
+	if (ctx == CRT_CONTEXT_NULL || buf == NULL || len == 0) {
+		D_ERROR("invalid parameter, crt_ctx: %p, buf: %p, len: %zu.\n",
+			crt_ctx, buf, len);
+		D_GOTO(out, rc = -DER_INVAL);
+	}
+
+	rc = crt_hg_bulk_cache_unregister(&ctx->cc_hg_ctx, buf, len);
+	if (rc != 0)
+		D_ERROR("crt_hg_bulk_cache_unregister() failed, rc: "DF_RC"\n",
+			DP_RC(rc));
+
+out:
+	return rc;
+}
+
 int
 crt_bulk_addref(crt_bulk_t bulk_hdl)
 {
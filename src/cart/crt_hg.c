@@ -272,6 +272,7 @@ crt_hg_pool_init(struct crt_hg_context *hg_ctx)
 
 	hg_pool->chp_num = 0;
 	hg_pool->chp_max_num = 0;
+	hg_pool->chp_miss = 0;
 	hg_pool->chp_enabled = false;
 	D_INIT_LIST_HEAD(&hg_pool->chp_list);
 
@@ -312,6 +313,7 @@ crt_hg_pool_get(struct crt_hg_context *hg_ctx)
 			       struct crt_hg_hdl,
 			       chh_link);
 	if (hdl == NULL) {
+		hg_pool->chp_miss++;
 		D_DEBUG(DB_NET,
 			"hg_pool %p is empty, cannot get.\n", hg_pool);
 		D_GOTO(unlock, hdl);
@@ -352,6 +354,17 @@ crt_hg_pool_put(struct crt_rpc_priv *rpc_priv)
 	}
 
 	D_SPIN_LOCK(&hg_pool->chp_lock);
+	/*
+	 * The pool is full but there were gets on the empty pool, then more in-flight RPCs than
+	 * the pool can hold, grow the pool to keep the handle.
+	 */
+	if (hg_pool->chp_enabled && hg_pool->chp_num >= hg_pool->chp_max_num &&
+	    hg_pool->chp_miss > 0 && hg_pool->chp_max_num < CRT_HG_POOL_MAX_LIMIT) {
+		hg_pool->chp_max_num = min(hg_pool->chp_max_num * 2, CRT_HG_POOL_MAX_LIMIT);
+		hg_pool->chp_miss = 0;
+		D_DEBUG(DB_NET, "hg_pool %p, grow max_num to %d.\n",
+			hg_pool, hg_pool->chp_max_num);
+	}
 	if (hg_pool->chp_enabled && hg_pool->chp_num < hg_pool->chp_max_num) {
 		d_list_add_tail(&hdl->chh_link, &hg_pool->chp_list);
 		hg_pool->chp_num++;
@@ -370,6 +383,404 @@ out:
 	return rc;
 }
 
+/*
+ * Cache of registered bulk handles for single buffer, keyed by the buffer address, length and
+ * permission. Repeated bulk creation for the same buffer takes a reference on the cached handle
+ * instead of registering the memory again. The least recently used handle is released when the
+ * cache is full, the in-flight users still hold their own references.
+ *
+ * Only buffers the user registered by crt_bulk_cache_register() are cached, unregistering the
+ * buffer releases its cached handles so that it can be freed then.
+ */
+static inline struct crt_bulk_cache_rec *
+crt_bulk_cache_link2rec(d_list_t *link)
+{
+	return container_of(link, struct crt_bulk_cache_rec, cbr_hlink);
+}
+
+static uint32_t
+crt_bulk_cache_op_key_hash(struct d_hash_table *htable, const void *key, unsigned int ksize)
+{
+	D_ASSERT(ksize == sizeof(struct crt_bulk_cache_key));
+
+	return (uint32_t)d_hash_murmur64(key, ksize, 0) & ((1U << CRT_BULK_CACHE_BITS) - 1);
+}
+
+static bool
+crt_bulk_cache_op_key_cmp(struct d_hash_table *htable, d_list_t *link, const void *key,
+			  unsigned int ksize)
+{
+	struct crt_bulk_cache_rec *rec = crt_bulk_cache_link2rec(link);
+
+	D_ASSERT(ksize == sizeof(struct crt_bulk_cache_key));
+
+	return memcmp(&rec->cbr_key, key, ksize) == 0;
+}
+
+static uint32_t
+crt_bulk_cache_op_rec_hash(struct d_hash_table *htable, d_list_t *link)
+{
+	struct crt_bulk_cache_rec *rec = crt_bulk_cache_link2rec(link);
+
+	return crt_bulk_cache_op_key_hash(htable, &rec->cbr_key, sizeof(rec->cbr_key));
+}
+
+static d_hash_table_ops_t crt_bulk_cache_ops = {
+	.hop_key_hash		= crt_bulk_cache_op_key_hash,
+	.hop_key_cmp		= crt_bulk_cache_op_key_cmp,
+	.hop_rec_hash		= crt_bulk_cache_op_rec_hash,
+};
+
+static inline struct crt_bulk_cache_rec *
+crt_bulk_cache_dlink2rec(d_list_t *link)
+{
+	return container_of(link, struct crt_bulk_cache_rec, cbr_dlink);
+}
+
+static uint32_t
+crt_bulk_cache_op_hdl_hash(struct d_hash_table *htable, const void *key, unsigned int ksize)
+{
+	D_ASSERT(ksize == sizeof(hg_bulk_t));
+
+	return (uint32_t)d_hash_murmur64(key, ksize, 0) & ((1U << CRT_BULK_CACHE_BITS) - 1);
+}
+
+static bool
+crt_bulk_cache_op_hdl_cmp(struct d_hash_table *htable, d_list_t *link, const void *key,
+			  unsigned int ksize)
+{
+	struct crt_bulk_cache_rec *rec = crt_bulk_cache_dlink2rec(link);
+
+	D_ASSERT(ksize == sizeof(hg_bulk_t));
+
+	return rec->cbr_hdl == *(hg_bulk_t *)key;
+}
+
+static uint32_t
+crt_bulk_cache_op_hdl_rec_hash(struct d_hash_table *htable, d_list_t *link)
+{
+	struct crt_bulk_cache_rec *rec = crt_bulk_cache_dlink2rec(link);
+
+	return crt_bulk_cache_op_hdl_hash(htable, &rec->cbr_hdl, sizeof(rec->cbr_hdl));
+}
+
+static d_hash_table_ops_t crt_bulk_cache_hdl_ops = {
+	.hop_key_hash		= crt_bulk_cache_op_hdl_hash,
+	.hop_key_cmp		= crt_bulk_cache_op_hdl_cmp,
+	.hop_rec_hash		= crt_bulk_cache_op_hdl_rec_hash,
+};
+
+static void
+crt_bulk_cache_init(struct crt_hg_context *hg_ctx)
+{
+	struct crt_bulk_cache	*cache = &hg_ctx->chc_bulk_cache;
+	int			 rc;
+
+	cache->cbc_enabled = false;
+
+	rc = D_MUTEX_INIT(&cache->cbc_mutex, NULL);
+	if (rc != 0)
+		goto out;
+
+	rc = d_hash_table_create_inplace(D_HASH_FT_NOLOCK, CRT_BULK_CACHE_BITS, NULL,
+					 &crt_bulk_cache_ops, &cache->cbc_htable);
+	if (rc != 0) {
+		D_MUTEX_DESTROY(&cache->cbc_mutex);
+		goto out;
+	}
+
+	rc = d_hash_table_create_inplace(D_HASH_FT_NOLOCK, CRT_BULK_CACHE_BITS, NULL,
+					 &crt_bulk_cache_hdl_ops, &cache->cbc_hdl_htable);
+	if (rc != 0) {
+		d_hash_table_destroy_inplace(&cache->cbc_htable, true);
+		D_MUTEX_DESTROY(&cache->cbc_mutex);
+		goto out;
+	}
+
+	D_INIT_LIST_HEAD(&cache->cbc_lru);
+	D_INIT_LIST_HEAD(&cache->cbc_regions);
+	cache->cbc_region_num = 0;
+	cache->cbc_num = 0;
+	cache->cbc_hit = 0;
+	cache->cbc_miss = 0;
+	cache->cbc_enabled = true;
+
+out:
+	if (rc != 0)
+		D_WARN("Failed to init bulk cache for hg_ctx %p, disabled: " DF_RC "\n",
+		       hg_ctx, DP_RC(rc));
+}
+
+/* Remove the record from the cache, the caller releases the handle and frees the record. */
+static void
+crt_bulk_cache_rec_del(struct crt_bulk_cache *cache, struct crt_bulk_cache_rec *rec)
+{
+	d_list_del_init(&rec->cbr_lru);
+	d_hash_rec_delete_at(&cache->cbc_htable, &rec->cbr_hlink);
+	d_hash_rec_delete_at(&cache->cbc_hdl_htable, &rec->cbr_dlink);
+	cache->cbc_num--;
+}
+
+static void
+crt_bulk_cache_rec_free(struct crt_bulk_cache_rec *rec)
+{
+	hg_return_t	hg_ret;
+
+	hg_ret = HG_Bulk_free(rec->cbr_hdl);
+	if (hg_ret != HG_SUCCESS)
+		D_ERROR("HG_Bulk_free failed, hg_ret: " DF_HG_RC "\n", DP_HG_RC(hg_ret));
+	D_FREE(rec);
+}
+
+static void
+crt_bulk_cache_fini(struct crt_hg_context *hg_ctx)
+{
+	struct crt_bulk_cache		*cache = &hg_ctx->chc_bulk_cache;
+	struct crt_bulk_cache_rec	*rec;
+	struct crt_bulk_cache_region	*region;
+
+	if (!cache->cbc_enabled)
+		return;
+
+	D_DEBUG(DB_NET, "hg_ctx %p bulk cache: %u cached, hit " DF_U64 ", miss " DF_U64 "\n",
+		hg_ctx, cache->cbc_num, cache->cbc_hit, cache->cbc_miss);
+
+	D_MUTEX_LOCK(&cache->cbc_mutex);
+	cache->cbc_enabled = false;
+	while ((rec = d_list_pop_entry(&cache->cbc_lru, struct crt_bulk_cache_rec, cbr_lru))) {
+		d_hash_rec_delete_at(&cache->cbc_htable, &rec->cbr_hlink);
+		d_hash_rec_delete_at(&cache->cbc_hdl_htable, &rec->cbr_dlink);
+		crt_bulk_cache_rec_free(rec);
+	}
+	cache->cbc_num = 0;
+	while ((region = d_list_pop_entry(&cache->cbc_regions, struct crt_bulk_cache_region,
+					  cbg_link)))
+		D_FREE(region);
+	cache->cbc_region_num = 0;
+	D_MUTEX_UNLOCK(&cache->cbc_mutex);
+
+	d_hash_table_destroy_inplace(&cache->cbc_hdl_htable, true);
+	d_hash_table_destroy_inplace(&cache->cbc_htable, true);
+	D_MUTEX_DESTROY(&cache->cbc_mutex);
+}
+
+/* Whether the buffer is within a registered region, cbc_mutex is held by the caller. */
+static bool
+crt_bulk_cache_registered(struct crt_bulk_cache *cache, struct crt_bulk_cache_key *key)
+{
+	struct crt_bulk_cache_region	*region;
+	char				*buf = key->cbk_buf;
+
+	d_list_for_each_entry(region, &cache->cbc_regions, cbg_link) {
+		if (buf >= region->cbg_buf &&
+		    buf + key->cbk_len <= region->cbg_buf + region->cbg_len)
+			return true;
+	}
+
+	return false;
+}
+
+int
+crt_hg_bulk_cache_register(struct crt_hg_context *hg_ctx, void *buf, size_t len)
+{
+	struct crt_bulk_cache		*cache = &hg_ctx->chc_bulk_cache;
+	struct crt_bulk_cache_region	*region;
+
+	if (!cache->cbc_enabled)
+		return -DER_NOSYS;
+
+	D_ALLOC_PTR(region);
+	if (region == NULL)
+		return -DER_NOMEM;
+
+	region->cbg_buf = buf;
+	region->cbg_len = len;
+
+	D_MUTEX_LOCK(&cache->cbc_mutex);
+	d_list_add(&region->cbg_link, &cache->cbc_regions);
+	cache->cbc_region_num++;
+	D_MUTEX_UNLOCK(&cache->cbc_mutex);
+
+	return 0;
+}
+
+int
+crt_hg_bulk_cache_unregister(struct crt_hg_context *hg_ctx, void *buf, size_t len)
+{
+	struct crt_bulk_cache		*cache = &hg_ctx->chc_bulk_cache;
+	struct crt_bulk_cache_region	*region;
+	struct crt_bulk_cache_rec	*rec;
+	struct crt_bulk_cache_rec	*tmp;
+	char				*start = buf;
+	char				*rec_buf;
+	d_list_t			 evicted;
+	bool				 found = false;
+
+	if (!cache->cbc_enabled)
+		return -DER_NOSYS;
+
+	D_INIT_LIST_HEAD(&evicted);
+
+	D_MUTEX_LOCK(&cache->cbc_mutex);
+	d_list_for_each_entry(region, &cache->cbc_regions, cbg_link) {
+		if (region->cbg_buf == start && region->cbg_len == len) {
+			found = true;
+			break;
+		}
+	}
+	if (!found) {
+		D_MUTEX_UNLOCK(&cache->cbc_mutex);
+		return -DER_NONEXIST;
+	}
+
+	d_list_del(&region->cbg_link);
+	cache->cbc_region_num--;
+
+	/* The buffer can be freed once this returns, drop every handle overlapping it */
+	d_list_for_each_entry_safe(rec, tmp, &cache->cbc_lru, cbr_lru) {
+		rec_buf = rec->cbr_key.cbk_buf;
+		if (rec_buf >= start + len || rec_buf + rec->cbr_key.cbk_len <= start)
+			continue;
+
+		crt_bulk_cache_rec_del(cache, rec);
+		d_list_add(&rec->cbr_lru, &evicted);
+	}
+	D_MUTEX_UNLOCK(&cache->cbc_mutex);
+
+	while ((rec = d_list_pop_entry(&evicted, struct crt_bulk_cache_rec, cbr_lru)))
+		crt_bulk_cache_rec_free(rec);
+	D_FREE(region);
+
+	return 0;
+}
+
+/*
+ * Take a reference on the cached bulk handle, return false if not found. \a cacheable tells if
+ * the new registered handle of the buffer should be added into the cache.
+ */
+static bool
+crt_bulk_cache_get(struct crt_hg_context *hg_ctx, struct crt_bulk_cache_key *key,
+		   hg_bulk_t *hg_bulk_hdl, bool *cacheable)
+{
+	struct crt_bulk_cache		*cache = &hg_ctx->chc_bulk_cache;
+	struct crt_bulk_cache_rec	*rec;
+	d_list_t			*link;
+	bool				 found = false;
+
+	*cacheable = false;
+
+	D_MUTEX_LOCK(&cache->cbc_mutex);
+	link = d_hash_rec_find(&cache->cbc_htable, key, sizeof(*key));
+	if (link == NULL) {
+		*cacheable = crt_bulk_cache_registered(cache, key);
+		if (*cacheable)
+			cache->cbc_miss++;
+		goto out;
+	}
+
+	rec = crt_bulk_cache_link2rec(link);
+	if (HG_Bulk_ref_incr(rec->cbr_hdl) != HG_SUCCESS)
+		goto out;
+
+	d_list_move(&rec->cbr_lru, &cache->cbc_lru);
+	cache->cbc_hit++;
+	*hg_bulk_hdl = rec->cbr_hdl;
+	found = true;
+
+out:
+	D_MUTEX_UNLOCK(&cache->cbc_mutex);
+	return found;
+}
+
+/* Add the new registered bulk handle into the cache, evict the LRU one if the cache is full. */
+static void
+crt_bulk_cache_put(struct crt_hg_context *hg_ctx, struct crt_bulk_cache_key *key,
+		   hg_bulk_t hg_bulk_hdl)
+{
+	struct crt_bulk_cache		*cache = &hg_ctx->chc_bulk_cache;
+	struct crt_bulk_cache_rec	*rec;
+	struct crt_bulk_cache_rec	*evict = NULL;
+	int				 rc;
+
+	D_ALLOC_PTR(rec);
+	if (rec == NULL)
+		return;
+
+	rec->cbr_key = *key;
+	rec->cbr_hdl = hg_bulk_hdl;
+	if (HG_Bulk_ref_incr(hg_bulk_hdl) != HG_SUCCESS) {
+		D_FREE(rec);
+		return;
+	}
+
+	D_MUTEX_LOCK(&cache->cbc_mutex);
+	/* The buffer may have been unregistered since the lookup. */
+	if (!crt_bulk_cache_registered(cache, key)) {
+		D_MUTEX_UNLOCK(&cache->cbc_mutex);
+		crt_bulk_cache_rec_free(rec);
+		return;
+	}
+
+	/* Others may have cached the same buffer concurrently. */
+	rc = d_hash_rec_insert(&cache->cbc_htable, key, sizeof(*key), &rec->cbr_hlink, true);
+	if (rc != 0) {
+		D_MUTEX_UNLOCK(&cache->cbc_mutex);
+		crt_bulk_cache_rec_free(rec);
+		return;
+	}
+
+	rc = d_hash_rec_insert(&cache->cbc_hdl_htable, &hg_bulk_hdl, sizeof(hg_bulk_hdl),
+			       &rec->cbr_dlink, false);
+	D_ASSERT(rc == 0);
+
+	d_list_add(&rec->cbr_lru, &cache->cbc_lru);
+	cache->cbc_num++;
+	if (cache->cbc_num > CRT_BULK_CACHE_MAX_NUM) {
+		evict = d_list_entry(cache->cbc_lru.prev, struct crt_bulk_cache_rec, cbr_lru);
+		crt_bulk_cache_rec_del(cache, evict);
+	}
+	D_MUTEX_UNLOCK(&cache->cbc_mutex);
+
+	if (evict != NULL)
+		crt_bulk_cache_rec_free(evict);
+}
+
+/*
+ * Bind the cached bulk handle, return false if it is not cached. Mercury can't bind a handle
+ * twice, so it is bound once and the binding is shared by the users of the cached handle, who
+ * bind it to the context it was created with.
+ */
+static bool
+crt_bulk_cache_bind(struct crt_hg_context *hg_ctx, hg_bulk_t hg_bulk_hdl, hg_return_t *hg_ret)
+{
+	struct crt_bulk_cache		*cache = &hg_ctx->chc_bulk_cache;
+	struct crt_bulk_cache_rec	*rec;
+	d_list_t			*link;
+
+	/* Nothing is cached without registered buffer */
+	if (!cache->cbc_enabled || cache->cbc_region_num == 0)
+		return false;
+
+	D_MUTEX_LOCK(&cache->cbc_mutex);
+	link = d_hash_rec_find(&cache->cbc_hdl_htable, &hg_bulk_hdl, sizeof(hg_bulk_hdl));
+	if (link == NULL) {
+		D_MUTEX_UNLOCK(&cache->cbc_mutex);
+		return false;
+	}
+
+	rec = crt_bulk_cache_dlink2rec(link);
+	if (!rec->cbr_bound) {
+		*hg_ret = HG_Bulk_bind(hg_bulk_hdl, hg_ctx->chc_hgctx);
+		if (*hg_ret == HG_SUCCESS)
+			rec->cbr_bound = true;
+	} else {
+		*hg_ret = HG_SUCCESS;
+	}
+	D_MUTEX_UNLOCK(&cache->cbc_mutex);
+
+	return true;
+}
+
 int
 crt_hg_addr_free(struct crt_hg_context *hg_ctx, hg_addr_t addr)
 {
@@ -983,6 +1394,8 @@ crt_hg_ctx_init(struct crt_hg_context *hg_ctx, int provider, int idx, bool prima
 	if (rc != 0)
 		D_ERROR("crt_hg_pool_init() failed, context idx %d hg_ctx %p, "
 			"rc: " DF_RC "\n", idx, hg_ctx, DP_RC(rc));
+	else
+		crt_bulk_cache_init(hg_ctx);
 out:
 	return rc;
 }
@@ -993,6 +1406,7 @@ crt_hg_ctx_fini(struct crt_hg_context *hg_ctx)
 	hg_return_t hg_ret;
 	int         rc = DER_SUCCESS;
 
+	crt_bulk_cache_fini(hg_ctx);
 	crt_hg_pool_fini(hg_ctx);
 
 	if (hg_ctx->chc_hgctx) {
@@ -1590,6 +2004,8 @@ crt_hg_bulk_create(struct crt_hg_context *hg_ctx, d_sg_list_t *sgl,
 	hg_return_t hg_ret;
 	int         rc       = 0, i;
 	bool        allocate = false;
+	bool        cache    = false;
+	struct crt_bulk_cache_key key;
 
 	D_ASSERT(hg_ctx != NULL && hg_ctx->chc_bulkcla != NULL);
 	D_ASSERT(sgl != NULL && bulk_hdl != NULL);
@@ -1597,6 +2013,19 @@ crt_hg_bulk_create(struct crt_hg_context *hg_ctx, d_sg_list_t *sgl,
 
 	flags = (bulk_perm == CRT_BULK_RW) ? HG_BULK_READWRITE : HG_BULK_READ_ONLY;
 
+	/* Nothing is cached without registered buffer */
+	if (hg_ctx->chc_bulk_cache.cbc_enabled && hg_ctx->chc_bulk_cache.cbc_region_num > 0 &&
+	    sgl->sg_nr == 1 && sgl->sg_iovs != NULL) {
+		memset(&key, 0, sizeof(key));
+		key.cbk_buf = sgl->sg_iovs[0].iov_buf;
+		key.cbk_len = sgl->sg_iovs[0].iov_buf_len;
+		key.cbk_flags = flags;
+		if (crt_bulk_cache_get(hg_ctx, &key, &hg_bulk_hdl, &cache)) {
+			*bulk_hdl = hg_bulk_hdl;
+			return 0;
+		}
+	}
+
 	if (sgl->sg_nr <= CRT_HG_IOVN_STACK) {
 		buf_sizes = buf_sizes_stack;
 	} else {
@@ -1627,6 +2056,8 @@ crt_hg_bulk_create(struct crt_hg_context *hg_ctx, d_sg_list_t *sgl,
 				buf_sizes, flags, &hg_bulk_hdl);
 	if (hg_ret == HG_SUCCESS) {
 		*bulk_hdl = hg_bulk_hdl;
+		if (cache)
+			crt_bulk_cache_put(hg_ctx, &key, hg_bulk_hdl);
 	} else {
 		D_ERROR("HG_Bulk_create failed, hg_ret: " DF_HG_RC "\n",
 			DP_HG_RC(hg_ret));
@@ -1648,7 +2079,8 @@ crt_hg_bulk_bind(crt_bulk_t bulk_hdl, struct crt_hg_context *hg_ctx)
 {
 	hg_return_t	  hg_ret = HG_SUCCESS;
 
-	hg_ret = HG_Bulk_bind(bulk_hdl, hg_ctx->chc_hgctx);
+	if (!crt_bulk_cache_bind(hg_ctx, bulk_hdl, &hg_ret))
+		hg_ret = HG_Bulk_bind(bulk_hdl, hg_ctx->chc_hgctx);
 	if (hg_ret != HG_SUCCESS)
 		D_ERROR("HG_Bulk_bind failed, hg_ret " DF_HG_RC "\n",
 			DP_HG_RC(hg_ret));
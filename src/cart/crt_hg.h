@@ -10,6 +10,7 @@
 #define __CRT_MERCURY_H__
 
 #include <gurt/list.h>
+#include <gurt/hash.h>
 
 #include <mercury.h>
 #include <mercury_types.h>
@@ -24,6 +25,8 @@
 
 /** MAX number of HG handles in pool */
 #define CRT_HG_POOL_MAX_NUM	(512)
+/** The HG handle pool can grow up to this number on demand */
+#define CRT_HG_POOL_MAX_LIMIT	(8192)
 /** number of prepost HG handles when enable pool */
 #define CRT_HG_POOL_PREPOST_NUM	(16)
 
@@ -108,11 +111,62 @@ struct crt_hg_pool {
 	int32_t			chp_num;
 	/* maximum number of HG handles in pool */
 	int32_t			chp_max_num;
+	/* number of get on empty pool since last growing */
+	int32_t			chp_miss;
 	/* HG handle list */
 	d_list_t		chp_list;
 	bool			chp_enabled;
 };
 
+/** MAX number of cached bulk handles per context */
+#define CRT_BULK_CACHE_MAX_NUM	(512)
+#define CRT_BULK_CACHE_BITS	(10)
+
+struct crt_bulk_cache_key {
+	void			*cbk_buf;
+	size_t			 cbk_len;
+	uint32_t		 cbk_flags;
+};
+
+/* Buffer the user registered by crt_bulk_cache_register() */
+struct crt_bulk_cache_region {
+	/* link to crt_bulk_cache::cbc_regions */
+	d_list_t		 cbg_link;
+	char			*cbg_buf;
+	size_t			 cbg_len;
+};
+
+/* Registered bulk handle of single buffer, referenced by the cache */
+struct crt_bulk_cache_rec {
+	/* link to crt_bulk_cache::cbc_htable */
+	d_list_t		 cbr_hlink;
+	/* link to crt_bulk_cache::cbc_hdl_htable */
+	d_list_t		 cbr_dlink;
+	/* link to crt_bulk_cache::cbc_lru, the most recent used one is at head */
+	d_list_t		 cbr_lru;
+	struct crt_bulk_cache_key cbr_key;
+	hg_bulk_t		 cbr_hdl;
+	/* the handle is bound to the context of the cache */
+	bool			 cbr_bound;
+};
+
+struct crt_bulk_cache {
+	pthread_mutex_t		 cbc_mutex;
+	/* cached handles by buffer */
+	struct d_hash_table	 cbc_htable;
+	/* cached handles by handle, to track the binding */
+	struct d_hash_table	 cbc_hdl_htable;
+	d_list_t		 cbc_lru;
+	/* registered buffers, only handles of these buffers are cached */
+	d_list_t		 cbc_regions;
+	uint32_t		 cbc_region_num;
+	/* number of cached bulk handles */
+	uint32_t		 cbc_num;
+	uint64_t		 cbc_hit;
+	uint64_t		 cbc_miss;
+	bool			 cbc_enabled;
+};
+
 /** HG context */
 struct crt_hg_context {
 	/* Flag indicating whether hg class is shared; true for SEP mode */
@@ -122,6 +176,7 @@ struct crt_hg_context {
 	hg_class_t		*chc_bulkcla; /* bulk class */
 	hg_context_t		*chc_bulkctx; /* bulk context */
 	struct crt_hg_pool	 chc_hg_pool; /* HG handle pool */
+	struct crt_bulk_cache	 chc_bulk_cache; /* registered bulk cache */
 	int			 chc_provider; /* provider */
 };
 
@@ -225,6 +280,8 @@ crt_der_2_hgret(int der)
 int crt_hg_bulk_create(struct crt_hg_context *hg_ctx, d_sg_list_t *sgl,
 		       crt_bulk_perm_t bulk_perm, crt_bulk_t *bulk_hdl);
 int crt_hg_bulk_bind(crt_bulk_t bulk_hdl, struct crt_hg_context *hg_ctx);
+int crt_hg_bulk_cache_register(struct crt_hg_context *hg_ctx, void *buf, size_t len);
+int crt_hg_bulk_cache_unregister(struct crt_hg_context *hg_ctx, void *buf, size_t len);
 int crt_hg_bulk_access(crt_bulk_t bulk_hdl, d_sg_list_t *sgl);
 int
 crt_hg_bulk_transfer(struct crt_bulk_desc *bulk_desc, crt_bulk_cb_t complete_cb, void *arg,
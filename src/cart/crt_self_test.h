@@ -199,6 +199,13 @@ struct crt_st_start_params {
 		struct {
 			enum crt_st_msg_type send_type: 2;
 			enum crt_st_msg_type reply_type: 2;
+			/*
+			 * Re-register the bulk buffer before every RPC. Must fit in
+			 * the bits left before buf_alignment, only flags is sent
+			 */
+			uint32_t bulk_recreate: 1;
+			/* Register the test buffers with the bulk cache */
+			uint32_t bulk_cache: 1;
 			int16_t buf_alignment: 16;
 		};
 		uint32_t flags;
@@ -61,6 +61,8 @@ struct st_g_data {
 	int16_t				  buf_alignment;
 	enum crt_st_msg_type		  send_type;
 	enum crt_st_msg_type		  reply_type;
+	bool				  bulk_recreate;
+	bool				  bulk_cache;
 
 	/* Private arguments data for all RPC callback functions */
 	struct st_cb_args		**cb_args_ptrs;
@@ -129,6 +131,8 @@ struct st_cb_args {
 
 	/* Length of the buf array */
 	size_t			 buf_len;
+	/* buf is registered with the bulk cache */
+	bool			 buf_cached;
 
 	/*
 	 * Extra space used for the payload of this repetition
@@ -363,6 +367,28 @@ static void send_next_rpc(struct st_cb_args *cb_args, int skip_inc_complete)
 		/* Re-use payload data memory, set arguments */
 		cb_args->rep_idx = local_rep;
 
+		/*
+		 * Optionally mimic an I/O path that registers its buffer for
+		 * every request, so the cost of bulk registration (or the
+		 * benefit of the registration cache) shows up in the results
+		 */
+		if (g_data->bulk_recreate && cb_args->bulk_hdl != CRT_BULK_NULL) {
+			crt_bulk_perm_t perms =
+				ISBULK(g_data->reply_type) ?
+					CRT_BULK_RW : CRT_BULK_RO;
+
+			crt_bulk_free(cb_args->bulk_hdl);
+			cb_args->bulk_hdl = CRT_BULK_NULL;
+			ret = crt_bulk_create(g_data->crt_ctx,
+					      &cb_args->sg_list,
+					      perms, &cb_args->bulk_hdl);
+			if (ret != 0) {
+				D_ERROR("crt_bulk_create failed; ret = %d\n",
+					ret);
+				D_GOTO(abort, ret);
+			}
+		}
+
 		/*
 		 * For the repetition we are just now generating, set which
 		 * rank/tag this upcoming latency measurement will be for
@@ -753,6 +779,10 @@ static void free_g_data(void)
 					crt_bulk_free(cb_args->bulk_hdl);
 					cb_args->bulk_hdl = NULL;
 				}
+				if (cb_args->buf_cached)
+					crt_bulk_cache_unregister(g_data->crt_ctx,
+								  cb_args->buf,
+								  cb_args->buf_len);
 				D_FREE(cb_args->buf);
 
 				/*
@@ -852,6 +882,8 @@ crt_self_test_start_handler(crt_rpc_t *rpc_req)
 	g_data->send_type = args->send_type;
 	g_data->buf_alignment = args->buf_alignment;
 	g_data->reply_type = args->reply_type;
+	g_data->bulk_recreate = args->bulk_recreate;
+	g_data->bulk_cache = args->bulk_cache;
 	g_data->num_endpts = args->endpts.iov_buf_len / 8;
 	ret = D_SPIN_INIT(&g_data->ctr_lock, PTHREAD_PROCESS_PRIVATE);
 	if (ret != 0)
@@ -957,6 +989,19 @@ crt_self_test_start_handler(crt_rpc_t *rpc_req)
 		/* Track how big the buffer is for bookkeeping */
 		cb_args->buf_len = alloc_buf_len;
 
+		/* Let the bulk handles of the buffer be cached */
+		if (g_data->bulk_cache) {
+			ret = crt_bulk_cache_register(g_data->crt_ctx,
+						      cb_args->buf,
+						      cb_args->buf_len);
+			if (ret != 0) {
+				D_ERROR("crt_bulk_cache_register failed; "
+					"ret = %d\n", ret);
+				D_GOTO(fail_cleanup, ret);
+			}
+			cb_args->buf_cached = true;
+		}
+
 		/*
 		 * Link the sg_list, iov's, and cb_args entries
 		 *
@@ -1396,6 +1396,64 @@ btr_cmp(struct btr_context *tcx, umem_off_t nd_off,
 	return cmp;
 }
 
+/** Nodes up to this many keys are searched by linear counting */
+#define BTR_SEARCH_LINEAR_MAX	16
+
+/**
+ * In-node search of integer key tree, keys are compared inline instead of
+ * calling btr_cmp for each probed record. Small nodes are searched by counting
+ * the keys smaller than \a hkey, the loop has no data dependent branch and
+ * can be vectorized by compiler; larger nodes use branch free bisection.
+ *
+ * \param cmp	[OUT]	comparison result of the returned record, it is
+ *			the same as btr_cmp() with the record.
+ *
+ * \return	the record where btr_probe() settles down in this node.
+ */
+static int
+btr_node_search_int(struct btr_context *tcx, umem_off_t nd_off, char *hkey,
+		    int *cmp)
+{
+	struct btr_node	*nd    = btr_off2ptr(tcx, nd_off);
+	char		*addr  = (char *)&nd[1];
+	uint32_t	 rsize = btr_rec_size(tcx);
+	uint64_t	 key   = *(uint64_t *)hkey;
+	uint64_t	 rkey;
+	int		 keyn  = nd->tn_keyn;
+	int		 base;
+	int		 half;
+	int		 n;
+	int		 i;
+
+	D_ASSERT(keyn > 0);
+	if (keyn <= BTR_SEARCH_LINEAR_MAX) {
+		for (base = i = 0; i < keyn; i++) {
+			rkey  = ((struct btr_record *)&addr[i * rsize])->rec_ukey[0];
+			base += (rkey < key);
+		}
+	} else {
+		for (base = 0, n = keyn; n > 1; n -= half) {
+			half = n / 2;
+			rkey = ((struct btr_record *)
+				&addr[(base + half) * rsize])->rec_ukey[0];
+			base = (rkey < key) ? base + half : base;
+		}
+		rkey  = ((struct btr_record *)&addr[base * rsize])->rec_ukey[0];
+		base += (rkey < key);
+	}
+
+	/* @base is the first key which is not smaller than @hkey */
+	if (base == keyn) {
+		*cmp = BTR_CMP_LT;
+		return keyn - 1;
+	}
+
+	rkey = ((struct btr_record *)&addr[base * rsize])->rec_ukey[0];
+	*cmp = (rkey == key) ? BTR_CMP_EQ : BTR_CMP_GT;
+	D_DEBUG(DB_TRACE, "searched record at %d, cmp %d\n", base, *cmp);
+	return base;
+}
+
 bool
 btr_probe_valid(dbtree_probe_opc_t opc)
 {
@@ -1470,6 +1528,17 @@ btr_probe(struct btr_context *tcx, dbtree_probe_opc_t probe_opc,
 		} else if (probe_opc == BTR_PROBE_LAST) {
 			at = start = end;
 			cmp = BTR_CMP_LT;
+		} else if (hkey != NULL && btr_is_int_key(tcx) &&
+			   !btr_is_direct_key(tcx)) {
+			/* Only pure integer key trees, e.g. VOS trees of
+			 * DAOS_OF_[DA]KEY_UINT64 objects, search the node in place.
+			 * btr_class_init() sets both features on trees whose class
+			 * has no hkey callbacks (e.g. DBTREE_CLASS_IV), those keep
+			 * going through btr_cmp() and the class key compare.
+			 */
+			D_ASSERT(probe_opc & BTR_PROBE_SPEC);
+			at = start = end = btr_node_search_int(tcx, nd_off,
+							       hkey, &cmp);
 		} else {
 			D_ASSERT(probe_opc & BTR_PROBE_SPEC);
 			/* binary search */
@@ -1733,6 +1802,16 @@ btr_probe_next(struct btr_context *tcx)
 		trace->tr_at = 0;
 		D_ASSERT(tmp != UMOFF_NULL);
 		trace->tr_node = tmp;
+
+		/* Entered a new leaf, read ahead its right sibling */
+		if (trace == &tcx->tc_trace[tcx->tc_depth - 1]) {
+			struct btr_trace *parent = trace - 1;
+
+			nd = btr_off2ptr(tcx, parent->tr_node);
+			if (parent->tr_at < nd->tn_keyn)
+				prefetch(btr_off2ptr(tcx, btr_node_child_at(tcx, parent->tr_node,
+									     parent->tr_at + 1)));
+		}
 	}
 
 	btr_trace_debug(tcx, trace, "is the next\n");
@@ -2276,6 +2355,431 @@ dbtree_upsert(daos_handle_t toh, dbtree_probe_opc_t opc, uint32_t intent,
 	return btr_tx_end(tcx, rc);
 }
 
+/**
+ * Try to locate \a key from the leaf trace of the previous operation instead
+ * of descending from the root, this is the fast path for inserting sorted
+ * keys. The key can be resolved within the current leaf if it is greater
+ * than the record pointed by the leaf trace, and either the leaf is the
+ * rightmost one of the tree or the key is not greater than its last record.
+ *
+ * \return	true	The leaf trace has been positioned for \a key, and
+ *			tcx::tc_probe_rc has been set as BTR_PROBE_EQ does.
+ *		false	The key is out of range of the leaf, full probe is
+ *			required.
+ */
+static bool
+btr_probe_leaf(struct btr_context *tcx, uint32_t intent, d_iov_t *key,
+	       char hkey[DAOS_HKEY_MAX])
+{
+	struct btr_trace	*trace;
+	struct btr_node		*nd;
+	struct btr_check_alb	 alb;
+	umem_off_t		 nd_off;
+	bool			 rightmost = true;
+	int			 level;
+	int			 start;
+	int			 end;
+	int			 at;
+	int			 cmp;
+	int			 rc;
+
+	if (tcx->tc_depth == 0)
+		return false;
+
+	for (level = 0; level < tcx->tc_depth - 1; level++) {
+		trace = &tcx->tc_trace[level];
+		nd = btr_off2ptr(tcx, trace->tr_node);
+		if (trace->tr_at != nd->tn_keyn) {
+			rightmost = false;
+			break;
+		}
+	}
+
+	level  = tcx->tc_depth - 1;
+	trace  = &tcx->tc_trace[level];
+	nd_off = trace->tr_node;
+	nd     = btr_off2ptr(tcx, nd_off);
+	if (trace->tr_at >= nd->tn_keyn)
+		return false;
+
+	/* the key must be on the right side of the current record */
+	cmp = btr_cmp(tcx, nd_off, trace->tr_at, hkey, key);
+	if (cmp == BTR_CMP_ERR || !(cmp & BTR_CMP_LT))
+		return false;
+
+	start = trace->tr_at + 1;
+	end   = nd->tn_keyn - 1;
+	if (start > end) {
+		if (!rightmost)
+			return false;
+		/* append to the rightmost leaf */
+		at = trace->tr_at;
+		goto found;
+	}
+
+	if (!rightmost) {
+		cmp = btr_cmp(tcx, nd_off, end, hkey, key);
+		if (cmp == BTR_CMP_ERR || (cmp & BTR_CMP_LT))
+			return false;
+	}
+
+	for (;;) {
+		at = (start + end) / 2;
+		cmp = btr_cmp(tcx, nd_off, at, hkey, key);
+		if (cmp == BTR_CMP_ERR)
+			return false;
+
+		if (cmp != BTR_CMP_EQ && start < end) {
+			if (cmp & BTR_CMP_LT)
+				start = at + 1;
+			else
+				end = at - 1;
+			continue;
+		}
+		break;
+	}
+
+	if (cmp == BTR_CMP_EQ && btr_has_collision(tcx)) {
+		cmp = btr_cmp(tcx, nd_off, at, NULL, key);
+		if (cmp != BTR_CMP_EQ)
+			return false; /* let btr_probe report it */
+	}
+
+	if (cmp == BTR_CMP_EQ) {
+		alb.nd_off = nd_off;
+		alb.at	   = at;
+		alb.intent = intent;
+		btr_trace_set(tcx, level, nd_off, at);
+
+		rc = btr_check_availability(tcx, &alb);
+		if (rc == PROBE_RC_UNAVAILABLE)
+			rc = PROBE_RC_NONE; /* reused by the follow-on insert */
+		tcx->tc_probe_rc = rc;
+		return true;
+	}
+ found:
+	btr_trace_set(tcx, level, nd_off, at + !(cmp & BTR_CMP_GT));
+	tcx->tc_probe_rc = PROBE_RC_NONE;
+	return true;
+}
+
+/**
+ * Update or insert a batch of keys within one transaction.
+ *
+ * Keys can be in any order, but if they are sorted in the order of the tree
+ * class, each key is located from the leaf of the previous one without
+ * descending from the root, unless the previous insert split that leaf.
+ *
+ * \param toh		[IN]	Tree open handle.
+ * \param intent	[IN]	The operation intent.
+ * \param nr		[IN]	Number of keys.
+ * \param keys		[IN]	Array of \a nr keys.
+ * \param vals		[IN]	Array of \a nr values.
+ *
+ * \return		0	success
+ *			-ve	error code, the whole batch is rolled back if
+ *				the tree is in transactional memory.
+ */
+int
+dbtree_upsert_batch(daos_handle_t toh, uint32_t intent, unsigned int nr,
+		    d_iov_t *keys, d_iov_t *vals)
+{
+	struct btr_context *tcx;
+	char		    hkey[DAOS_HKEY_MAX];
+	bool		    warm = false;
+	unsigned int	    i;
+	int		    rc = 0;
+
+	tcx = btr_hdl2tcx(toh);
+	if (tcx == NULL)
+		return -DER_NO_HDL;
+
+	for (i = 0; i < nr; i++) {
+		rc = btr_verify_key(tcx, &keys[i]);
+		if (rc)
+			return rc;
+	}
+
+	rc = btr_tx_begin(tcx);
+	if (rc != 0)
+		return rc;
+
+	for (i = 0; i < nr; i++) {
+		struct btr_node	*nd;
+		unsigned int	 depth;
+		int		 keyn = -1;
+		int		 probe_rc;
+
+		btr_hkey_gen(tcx, &keys[i], hkey);
+		if (!warm || !btr_probe_leaf(tcx, intent, &keys[i], hkey))
+			btr_probe(tcx, BTR_PROBE_EQ, intent, &keys[i], hkey);
+
+		depth	 = tcx->tc_depth;
+		probe_rc = tcx->tc_probe_rc;
+		if (depth != 0) {
+			nd = btr_off2ptr(tcx, tcx->tc_trace[depth - 1].tr_node);
+			keyn = nd->tn_keyn;
+		}
+
+		rc = btr_upsert(tcx, BTR_PROBE_BYPASS, intent, &keys[i],
+				&vals[i], NULL);
+		if (rc != 0)
+			break;
+
+		/* The leaf trace is still valid unless the path was changed
+		 * by splitting the leaf or growing the tree.
+		 */
+		if (depth == 0 || depth != tcx->tc_depth) {
+			warm = false;
+		} else if (probe_rc == PROBE_RC_OK) {
+			warm = true;
+		} else {
+			nd = btr_off2ptr(tcx, tcx->tc_trace[depth - 1].tr_node);
+			warm = (nd->tn_keyn == keyn + 1);
+		}
+	}
+
+	return btr_tx_end(tcx, rc);
+}
+
+/** Default fill factor (percentage) of nodes created by dbtree_bulk_load */
+#define BTR_BULK_FILL_DEF	80
+
+/** Number of items placed in the \a at node when spreading \a nr items
+ * evenly over \a nd_nr nodes.
+ */
+static inline unsigned int
+btr_bulk_items(unsigned int nr, unsigned int nd_nr, unsigned int at)
+{
+	return nr / nd_nr + (at < nr % nd_nr);
+}
+
+static int
+btr_bulk_load(struct btr_context *tcx, unsigned int nr, d_iov_t *keys,
+	      d_iov_t *vals, unsigned int fill)
+{
+	struct btr_root		*root = tcx->tc_tins.ti_root;
+	union btr_rec_buf	 rec_buf = {0};
+	struct btr_record	*rec = &rec_buf.rb_rec;
+	struct btr_record	*rec_dst;
+	struct btr_node		*nd;
+	umem_off_t		*nodes;
+	umem_off_t		*firsts;
+	umem_off_t		 prev_off = BTR_NODE_NULL;
+	unsigned int		 prev_at = 0;
+	unsigned int		 leaf_cap;
+	unsigned int		 node_cap;
+	unsigned int		 nd_nr;
+	unsigned int		 built = 0;
+	unsigned int		 used = 0;
+	unsigned int		 child_nr = 0;
+	unsigned int		 depth;
+	unsigned int		 cnt;
+	unsigned int		 i;
+	unsigned int		 j;
+	unsigned int		 k;
+	int			 rc;
+
+	/* NB: non-leaf node needs at least two children */
+	leaf_cap = MAX(1, (tcx->tc_order - 1) * fill / 100);
+	node_cap = MIN(tcx->tc_order, MAX(3, tcx->tc_order * fill / 100));
+	nd_nr	 = (nr + leaf_cap - 1) / leaf_cap;
+
+	if (btr_has_tx(tcx)) {
+		rc = btr_root_tx_add(tcx);
+		if (rc != 0) {
+			D_ERROR("Failed to add root into TX: "DF_RC"\n",
+				DP_RC(rc));
+			return rc;
+		}
+	}
+
+	/* Dynamic root: a tree in one leaf only needs the smallest root which
+	 * can hold all keys, btr_root_resize grows it for further inserts.
+	 */
+	root->tr_node_size = tcx->tc_order;
+	if (nd_nr == 1 && (tcx->tc_feats & BTR_FEAT_DYNAMIC_ROOT)) {
+		root->tr_node_size = 1;
+		while (root->tr_node_size < nr)
+			root->tr_node_size = MIN(root->tr_node_size * 2 + 1,
+						 tcx->tc_order);
+	}
+
+	D_ALLOC_ARRAY(nodes, nd_nr);
+	if (nodes == NULL)
+		return -DER_NOMEM;
+
+	D_ALLOC_ARRAY(firsts, nd_nr);
+	if (firsts == NULL) {
+		D_FREE(nodes);
+		return -DER_NOMEM;
+	}
+
+	/* build the leaf level from the sorted keys */
+	for (i = k = 0; i < nd_nr; i++) {
+		rc = btr_node_alloc(tcx, &nodes[i]);
+		if (rc != 0)
+			goto failed;
+		built++;
+
+		btr_node_set(tcx, nodes[i], BTR_NODE_LEAF);
+		firsts[i] = nodes[i];
+		nd = btr_off2ptr(tcx, nodes[i]);
+
+		cnt = btr_bulk_items(nr, nd_nr, i);
+		for (j = 0; j < cnt; j++, k++) {
+			btr_hkey_gen(tcx, &keys[k], &rec->rec_hkey[0]);
+			if (!UMOFF_IS_NULL(prev_off)) {
+				int	cmp;
+
+				cmp = btr_cmp(tcx, prev_off, prev_at,
+					      &rec->rec_hkey[0], &keys[k]);
+				if (cmp == BTR_CMP_ERR || !(cmp & BTR_CMP_LT)) {
+					D_ERROR("Key %u is not in ascending order\n", k);
+					rc = -DER_INVAL;
+					goto failed;
+				}
+			}
+
+			rc = btr_rec_alloc(tcx, &keys[k], &vals[k], rec, NULL);
+			if (rc != 0) {
+				D_DEBUG(DB_TRACE, "Failed to create new record: "
+					DF_RC"\n", DP_RC(rc));
+				goto failed;
+			}
+
+			rec_dst = btr_node_rec_at(tcx, nodes[i], j);
+			btr_rec_copy(tcx, rec_dst, rec, 1);
+			nd->tn_keyn++;
+			prev_off = nodes[i];
+			prev_at	 = j;
+		}
+	}
+
+	/* build the upper levels, the first key of each child (or the leaf of
+	 * the first key for direct key) is copied into its parent.
+	 */
+	for (depth = 1; nd_nr > 1; depth++) {
+		child_nr = nd_nr;
+		nd_nr	 = (child_nr + node_cap - 1) / node_cap;
+		built	 = used = 0;
+
+		for (i = k = 0; i < nd_nr; i++) {
+			umem_off_t	nd_off;
+			umem_off_t	first = firsts[k];
+
+			rc = btr_node_alloc(tcx, &nd_off);
+			if (rc != 0)
+				goto failed;
+
+			nd = btr_off2ptr(tcx, nd_off);
+			nd->tn_child = nodes[k++];
+
+			cnt = btr_bulk_items(child_nr, nd_nr, i);
+			for (j = 1; j < cnt; j++, k++) {
+				rec_dst = btr_node_rec_at(tcx, nd_off, j - 1);
+				rec_dst->rec_off = nodes[k];
+				if (btr_is_direct_key(tcx))
+					rec_dst->rec_node[0] = firsts[k];
+				else
+					btr_rec_copy_hkey(tcx, rec_dst,
+							  btr_node_rec_at(tcx, firsts[k], 0));
+			}
+			nd->tn_keyn = cnt - 1;
+			used = k;
+
+			/* NB: i < used, unconsumed children are not overwritten */
+			nodes[i]  = nd_off;
+			firsts[i] = first;
+			built++;
+		}
+	}
+	D_ASSERT(built == 1);
+
+	btr_node_set(tcx, nodes[0], BTR_NODE_ROOT);
+	root->tr_node  = nodes[0];
+	root->tr_depth = depth;
+	btr_context_set_depth(tcx, depth);
+	tcx->tc_probe_rc = PROBE_RC_UNKNOWN;
+
+	D_DEBUG(DB_TRACE, "Bulk loaded %u records, depth %u\n", nr, depth);
+	D_FREE(firsts);
+	D_FREE(nodes);
+	return 0;
+failed:
+	/* Transaction abort releases everything, otherwise destroy the nodes
+	 * (subtrees) built so far, and the children not yet linked to them.
+	 */
+	if (!btr_has_tx(tcx)) {
+		for (i = 0; i < built; i++)
+			btr_node_destroy(tcx, nodes[i], NULL, NULL);
+		for (i = used; i < child_nr; i++)
+			btr_node_destroy(tcx, nodes[i], NULL, NULL);
+	}
+	D_FREE(firsts);
+	D_FREE(nodes);
+	return rc;
+}
+
+/**
+ * Build an empty tree bottom-up from keys sorted in ascending order of the
+ * tree class, all nodes are filled up to \a fill_pct percent so the follow-on
+ * inserts do not split them immediately. This is much cheaper than inserting
+ * the keys one by one, which descends from the root and splits nodes for
+ * each of them.
+ *
+ * \param toh		[IN]	Tree open handle, the tree must be empty.
+ * \param nr		[IN]	Number of keys.
+ * \param keys		[IN]	Array of \a nr keys in strictly ascending order.
+ * \param vals		[IN]	Array of \a nr values.
+ * \param fill_pct	[IN]	Node fill factor in percent, zero for default.
+ *
+ * \return		0	success
+ *			-DER_INVAL	the tree is not empty or keys are
+ *					not sorted
+ *			-ve	other error code
+ */
+int
+dbtree_bulk_load(daos_handle_t toh, unsigned int nr, d_iov_t *keys,
+		 d_iov_t *vals, unsigned int fill_pct)
+{
+	struct btr_context *tcx;
+	unsigned int	    i;
+	int		    rc;
+
+	tcx = btr_hdl2tcx(toh);
+	if (tcx == NULL)
+		return -DER_NO_HDL;
+
+	if (fill_pct > 100) {
+		D_ERROR("Invalid fill factor %u\n", fill_pct);
+		return -DER_INVAL;
+	}
+
+	if (!btr_root_empty(tcx)) {
+		D_ERROR("Cannot bulk load a non-empty tree\n");
+		return -DER_INVAL;
+	}
+
+	if (nr == 0)
+		return 0;
+
+	for (i = 0; i < nr; i++) {
+		rc = btr_verify_key(tcx, &keys[i]);
+		if (rc)
+			return rc;
+	}
+
+	rc = btr_tx_begin(tcx);
+	if (rc != 0)
+		return rc;
+
+	rc = btr_bulk_load(tcx, nr, keys, vals,
+			   fill_pct == 0 ? BTR_BULK_FILL_DEF : fill_pct);
+
+	return btr_tx_end(tcx, rc);
+}
+
 /**
  * Delete the leaf record pointed by @cur_tr from the current node, then fill
  * the deletion gap by shifting remainded records on the specified direction.
@@ -3503,6 +4007,10 @@ btr_node_destroy(struct btr_context *tcx, umem_off_t nd_off,
 		for (i = nd->tn_keyn; i >= 0; i--) {
 			umem_off_t	child_off;
 
+			/* warm up the next child while destroying this one */
+			if (i > 0)
+				prefetch(btr_off2ptr(tcx, btr_node_child_at(tcx, nd_off, i - 1)));
+
 			child_off = btr_node_child_at(tcx, nd_off, i);
 			rc = btr_node_destroy(tcx, child_off, args, &empty);
 			if (rc != 0)
@@ -109,6 +109,8 @@ daos_lru_cache_create(int bits, uint32_t feats,
 		lcache->dlc_csize = (1U << bits);
 	else /* disable LRU */
 		lcache->dlc_csize = 0;
+	lcache->dlc_csize_min = lcache->dlc_csize;
+	lcache->dlc_csize_max = lcache->dlc_csize;
 
 	lcache->dlc_count = 0;
 	lcache->dlc_ops = ops;
@@ -130,9 +132,76 @@ daos_lru_cache_destroy(struct daos_lru_cache *lcache)
 	D_DEBUG(DB_TRACE, "Destroying LRU cache\n");
 	d_hash_table_debug(&lcache->dlc_htable);
 	d_hash_table_destroy_inplace(&lcache->dlc_htable, true);
+	D_FREE(lcache->dlc_ghost);
 	D_FREE(lcache);
 }
 
+/** Bits of the ghost filter per ref of the maximum cache size */
+#define LRU_GHOST_BITS	8
+
+int
+daos_lru_cache_adapt(struct daos_lru_cache *lcache, int min_bits)
+{
+	uint32_t	nbits;
+
+	D_ASSERT(min_bits >= 0 && min_bits < 32);
+	D_ASSERT(lcache->dlc_ghost == NULL);
+
+	if (lcache->dlc_csize_max <= (1U << min_bits))
+		return 0; /* Nothing to adapt */
+
+	nbits = lcache->dlc_csize_max * LRU_GHOST_BITS;
+	D_ALLOC_ARRAY(lcache->dlc_ghost, nbits / 64);
+	if (lcache->dlc_ghost == NULL)
+		return -DER_NOMEM;
+
+	lcache->dlc_ghost_mask = nbits - 1;
+	lcache->dlc_ghost_nr = 0;
+	lcache->dlc_csize_min = 1U << min_bits;
+	lcache->dlc_csize = lcache->dlc_csize_min;
+	D_DEBUG(DB_TRACE, "LRU cache size adapts between %u and %u\n",
+		lcache->dlc_csize_min, lcache->dlc_csize_max);
+	return 0;
+}
+
+/** Remember an evicted ref, forgetting all of them once there are too many */
+static void
+lru_ghost_add(struct daos_lru_cache *lcache, struct daos_llink *llink)
+{
+	uint32_t	bit;
+
+	if (lcache->dlc_ghost == NULL)
+		return;
+
+	if (lcache->dlc_ghost_nr++ == lcache->dlc_csize_max) {
+		memset(lcache->dlc_ghost, 0, (lcache->dlc_ghost_mask + 1) / 8);
+		lcache->dlc_ghost_nr = 1;
+	}
+
+	bit = lcache->dlc_ops->lop_rec_hash(llink) & lcache->dlc_ghost_mask;
+	lcache->dlc_ghost[bit / 64] |= 1ULL << (bit % 64);
+}
+
+/** Grow the cache if a new ref was recently evicted, it'd have hit if larger */
+static void
+lru_ghost_check(struct daos_lru_cache *lcache, struct daos_llink *llink)
+{
+	uint32_t	bit;
+	uint64_t	mask;
+
+	if (lcache->dlc_ghost == NULL)
+		return;
+
+	bit = lcache->dlc_ops->lop_rec_hash(llink) & lcache->dlc_ghost_mask;
+	mask = 1ULL << (bit % 64);
+	if (!(lcache->dlc_ghost[bit / 64] & mask))
+		return;
+
+	lcache->dlc_ghost[bit / 64] &= ~mask;
+	if (lcache->dlc_csize < lcache->dlc_csize_max)
+		lcache->dlc_csize++;
+}
+
 struct lru_evict_arg {
 	daos_lru_cond_cb_t	 cb;
 	void			*arg;
@@ -162,6 +231,7 @@ lru_del_evicted(struct daos_lru_cache *lcache,
 	D_ASSERT(llink->ll_ref == 1);
 	D_ASSERT(lcache->dlc_count > 0);
 
+	d_list_del_init(&llink->ll_qlink);
 	d_hash_rec_delete_at(&lcache->dlc_htable, &llink->ll_link);
 	lcache->dlc_count--;
 }
@@ -190,6 +260,48 @@ daos_lru_cache_evict(struct daos_lru_cache *lcache,
 		count, lcache->dlc_count, lcache->dlc_csize);
 }
 
+void
+daos_lru_cache_evict_one(struct daos_lru_cache *lcache, struct daos_llink *llink)
+{
+	llink->ll_evicted = 1;
+	if (llink->ll_ref == 1) /* the last refcount */
+		lru_del_evicted(lcache, llink);
+	else
+		d_hash_rec_evict_at(&lcache->dlc_htable, &llink->ll_link);
+}
+
+/**
+ * Advance the clock hand until the cache is within its size.  Busy refs and
+ * refs referenced since the prior sweep get a second chance.
+ */
+static void
+lru_clock_sweep(struct daos_lru_cache *lcache)
+{
+	struct daos_llink	*llink;
+	uint32_t		 scanned = 0;
+	uint32_t		 limit = lcache->dlc_count;
+
+	while (lcache->dlc_count > lcache->dlc_csize && scanned < limit) {
+		D_ASSERT(!d_list_empty(&lcache->dlc_lru));
+		llink = d_list_entry(lcache->dlc_lru.next, struct daos_llink,
+				     ll_qlink);
+		scanned++;
+
+		if (llink->ll_ref > 1 || llink->ll_referenced) {
+			llink->ll_referenced = 0;
+			d_list_move_tail(&llink->ll_qlink, &lcache->dlc_lru);
+			continue;
+		}
+
+		/* The hand found a cold ref right away, shrink toward the working set */
+		if (scanned == 1 && lcache->dlc_csize > lcache->dlc_csize_min)
+			lcache->dlc_csize--;
+
+		lru_ghost_add(lcache, llink);
+		lru_del_evicted(lcache, llink);
+	}
+}
+
 int
 daos_lru_ref_hold(struct daos_lru_cache *lcache, void *key,
 		  unsigned int key_size, void *create_args,
@@ -207,9 +319,8 @@ daos_lru_ref_hold(struct daos_lru_cache *lcache, void *key,
 	if (link != NULL) {
 		llink = link2llink(link);
 		D_ASSERT(llink->ll_evicted == 0);
-		/* remove busy item from LRU */
-		if (!d_list_empty(&llink->ll_qlink))
-			d_list_del_init(&llink->ll_qlink);
+		/* Only mark it, the clock sweep skips busy items */
+		llink->ll_referenced = 1;
 		D_GOTO(found, rc = 0);
 	}
 
@@ -223,6 +334,7 @@ daos_lru_ref_hold(struct daos_lru_cache *lcache, void *key,
 
 	D_DEBUG(DB_TRACE, "Inserting %p item into LRU Hash table\n", llink);
 	llink->ll_evicted = 0;
+	llink->ll_referenced = 0;
 	llink->ll_ref	  = 1; /* 1 for caller */
 	llink->ll_ops	  = lcache->dlc_ops;
 	D_INIT_LIST_HEAD(&llink->ll_qlink);
@@ -233,7 +345,9 @@ daos_lru_ref_hold(struct daos_lru_cache *lcache, void *key,
 		lcache->dlc_ops->lop_free_ref(llink);
 		return rc;
 	}
+	d_list_add_tail(&llink->ll_qlink, &lcache->dlc_lru);
 	lcache->dlc_count++;
+	lru_ghost_check(lcache, llink);
 found:
 	*llink_pp = llink;
 out:
@@ -244,28 +358,17 @@ void
 daos_lru_ref_release(struct daos_lru_cache *lcache, struct daos_llink *llink)
 {
 	D_ASSERT(lcache != NULL && llink != NULL && llink->ll_ref > 1);
-	D_ASSERT(d_list_empty(&llink->ll_qlink));
 
 	llink->ll_ref--;
 	if (llink->ll_ref == 1) { /* the last refcount */
 		if (lcache->dlc_csize == 0)
 			llink->ll_evicted = 1;
 
-		if (llink->ll_evicted) {
+		if (llink->ll_evicted)
 			lru_del_evicted(lcache, llink);
-		} else {
-			D_ASSERT(d_list_empty(&llink->ll_qlink));
-			d_list_add(&llink->ll_qlink, &lcache->dlc_lru);
-		}
 	}
 
-	while (!d_list_empty(&lcache->dlc_lru)) {
-		llink = d_list_entry(lcache->dlc_lru.prev, struct daos_llink,
-				     ll_qlink);
-		if (lcache->dlc_count < lcache->dlc_csize)
-			break; /* within threshold and no old item */
-
-		d_list_del_init(&llink->ll_qlink);
-		lru_del_evicted(lcache, llink);
-	}
+	/* Nothing to sweep if every item is freed on its last release */
+	if (lcache->dlc_csize != 0 && lcache->dlc_count > lcache->dlc_csize)
+		lru_clock_sweep(lcache);
 }
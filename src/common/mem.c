@@ -1938,6 +1938,7 @@ umem_cache_touch(struct umem_store *store, uint64_t wr_tx, umem_off_t addr, daos
 	}
 
 	touch_page(store, pinfo, wr_tx, addr, end_addr);
+	cache->ca_dirtied_bytes += size;
 
 	return 0;
 }
@@ -1968,6 +1969,8 @@ struct umem_checkpoint_data {
 	daos_handle_t            cd_fh;
 	/** Pointer to pages in set */
 	struct umem_page_info   *cd_pages[MAX_PAGES_PER_SET];
+	/** Snapshot of the dirty bitmap for each page in set */
+	uint64_t                 cd_bmaps[MAX_PAGES_PER_SET][UMEM_CACHE_BMAP_SZ];
 	/** Highest transaction ID for pages in set */
 	uint64_t                 cd_max_tx;
 	/** Number of pages included in the set */
@@ -1994,8 +1997,10 @@ page2chkpt(struct umem_store *store, struct umem_page_info *pinfo,
 	uint64_t               mask;
 	uint64_t               bit;
 
-	pinfo->pi_chkpt_data                            = chkpt_data;
-	chkpt_data->cd_pages[chkpt_data->cd_nr_pages++] = pinfo;
+	pinfo->pi_chkpt_data                          = chkpt_data;
+	chkpt_data->cd_pages[chkpt_data->cd_nr_pages] = pinfo;
+	memcpy(&chkpt_data->cd_bmaps[chkpt_data->cd_nr_pages][0], bits, sizeof(pinfo->pi_bmap));
+	chkpt_data->cd_nr_pages++;
 	if (store->stor_ops->so_wal_id_cmp(store, chkpt_data->cd_max_tx, pinfo->pi_last_inflight) <
 	    0)
 		chkpt_data->cd_max_tx = pinfo->pi_last_inflight;
@@ -2038,12 +2043,39 @@ next_bmap:
 	}
 	sgl->sg_nr_out = sgl->sg_nr = nr;
 	store_iod->io_nr            = nr;
-	/** Presently, the flush API can yield. Yielding is fine but ideally,
-	 *  we would like it to fail in such cases so we can re-run the checkpoint
-	 *  creation for the pages in the set. As it stands, we must set the copying
-	 *  bit here to avoid changes to the page.
-	 */
-	pinfo->pi_copying = 1;
+}
+
+/** The flush prep API can yield, so the pages in the set are not blocked for writes while
+ *  waiting on it.  Chunks dirtied in the meantime are not in the snapshot and stay dirty for
+ *  the next checkpoint, but the highest transaction ID must cover any write to the page since
+ *  the copy reflects the latest page content.
+ */
+static void
+chkpt_refresh_max_tx(struct umem_store *store, struct umem_checkpoint_data *chkpt_data)
+{
+	struct umem_page_info *pinfo;
+	int                    i;
+
+	for (i = 0; i < chkpt_data->cd_nr_pages; i++) {
+		pinfo                     = chkpt_data->cd_pages[i];
+		pinfo->pi_last_checkpoint = pinfo->pi_last_inflight;
+		if (store->stor_ops->so_wal_id_cmp(store, chkpt_data->cd_max_tx,
+						   pinfo->pi_last_inflight) < 0)
+			chkpt_data->cd_max_tx = pinfo->pi_last_inflight;
+	}
+}
+
+static inline bool
+page_is_dirty(struct umem_page_info *pinfo)
+{
+	int i;
+
+	for (i = 0; i < UMEM_CACHE_BMAP_SZ; i++) {
+		if (pinfo->pi_bmap[i] != 0)
+			return true;
+	}
+
+	return false;
 }
 
 /** This is O(n) but the list is tiny so let's keep it simple */
@@ -2076,7 +2108,8 @@ umem_cache_checkpoint(struct umem_store *store, umem_cache_wait_cb_t wait_cb, vo
 	uint64_t                     chkpt_id     = *out_id;
 	d_list_t                     free_list;
 	d_list_t                     waiting_list;
-	int                          i;
+	uint64_t                     dirtied_bytes;
+	int                          i, j;
 	int                          rc;
 	int                          inflight = 0;
 	int                          pages_scanned = 0;
@@ -2106,6 +2139,9 @@ umem_cache_checkpoint(struct umem_store *store, umem_cache_wait_cb_t wait_cb, vo
 	}
 
 	d_list_splice_init(&cache->ca_pgs_dirty, &cache->ca_pgs_copying);
+	/** Bytes dirtied from now on will be accounted to next checkpoint */
+	dirtied_bytes           = cache->ca_dirtied_bytes;
+	cache->ca_dirtied_bytes = 0;
 
 	/** First mark all pages in the new list so they won't be moved by an I/O thread.  This
 	 *  will enable us to continue the algorithm in relative isolation from I/O threads.
@@ -2146,28 +2182,30 @@ umem_cache_checkpoint(struct umem_store *store, umem_cache_wait_cb_t wait_cb, vo
 			if (rc != 0) {
 				/** Just put the pages back and break the loop */
 				for (i = 0; i < chkpt_data->cd_nr_pages; i++) {
-					pinfo             = chkpt_data->cd_pages[i];
-					pinfo->pi_copying = 0;
+					pinfo = chkpt_data->cd_pages[i];
 					d_list_add(&pinfo->pi_link, &cache->ca_pgs_copying);
 				}
 				d_list_add(&chkpt_data->cd_link, &free_list);
 				break;
 			}
 
-			for (i = 0; i < chkpt_data->cd_nr_pages; i++) {
-				pinfo                     = chkpt_data->cd_pages[i];
-				pinfo->pi_last_checkpoint = pinfo->pi_last_inflight;
-			}
+			chkpt_refresh_max_tx(store, chkpt_data);
+
+			/** Block writes only in case the copy yields */
+			for (i = 0; i < chkpt_data->cd_nr_pages; i++)
+				chkpt_data->cd_pages[i]->pi_copying = 1;
 
 			rc = store->stor_ops->so_flush_copy(chkpt_data->cd_fh,
 							    &chkpt_data->cd_sg_list);
 			/** If this fails, it means invalid argument, so assertion here is fine */
 			D_ASSERT(rc == 0);
 
+			/** Only clear the chunks being copied */
 			for (i = 0; i < chkpt_data->cd_nr_pages; i++) {
 				pinfo             = chkpt_data->cd_pages[i];
 				pinfo->pi_copying = 0;
-				memset(&pinfo->pi_bmap[0], 0, sizeof(pinfo->pi_bmap));
+				for (j = 0; j < UMEM_CACHE_BMAP_SZ; j++)
+					pinfo->pi_bmap[j] &= ~chkpt_data->cd_bmaps[i][j];
 			}
 
 			chkpt_insert_sorted(store, chkpt_data, &waiting_list);
@@ -2195,7 +2233,8 @@ umem_cache_checkpoint(struct umem_store *store, umem_cache_wait_cb_t wait_cb, vo
 		D_ASSERT(rc == 0);
 		for (i = 0; i < chkpt_data->cd_nr_pages; i++) {
 			pinfo = chkpt_data->cd_pages[i];
-			if (pinfo->pi_last_inflight != pinfo->pi_last_checkpoint)
+			if (pinfo->pi_last_inflight != pinfo->pi_last_checkpoint ||
+			    page_is_dirty(pinfo))
 				d_list_add_tail(&pinfo->pi_link, &cache->ca_pgs_dirty);
 			else
 				d_list_add_tail(&pinfo->pi_link, &cache->ca_pgs_lru);
@@ -2213,9 +2252,11 @@ umem_cache_checkpoint(struct umem_store *store, umem_cache_wait_cb_t wait_cb, vo
 
 	*out_id = chkpt_id;
 	if (stats) {
-		stats->uccs_nr_pages   = pages_scanned;
-		stats->uccs_nr_dchunks = dchunks_copied;
-		stats->uccs_nr_iovs    = iovs_used;
+		stats->uccs_nr_pages      = pages_scanned;
+		stats->uccs_nr_dchunks    = dchunks_copied;
+		stats->uccs_nr_iovs       = iovs_used;
+		stats->uccs_dirtied_bytes = dirtied_bytes;
+		stats->uccs_chkpt_bytes   = (uint64_t)dchunks_copied << UMEM_CACHE_CHUNK_SZ_SHIFT;
 	}
 
 	return 0;
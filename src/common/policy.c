@@ -16,12 +16,14 @@
 
 static const char *POLICY_NAMES[DAOS_MEDIA_POLICY_MAX] = {
 	"io_size",
-	"write_intensivity" };
+	"write_intensivity",
+	"hot_cold" };
 
 static const char *POLICY_PARAMS[DAOS_MEDIA_POLICY_MAX]
 				[DAOS_MEDIA_POLICY_PARAMS_MAX] = {
 {"th1", "th2", "", ""},				/* io_size */
-{"wr_size", "hot1", "hot2", ""}			/* write_intensivity */
+{"wr_size", "hot1", "hot2", ""},		/* write_intensivity */
+{"th1", "hot", "half_life", ""}			/* hot_cold */
 };
 
 static const char *PARAM_DELIM = "/";
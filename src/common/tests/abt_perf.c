@@ -29,6 +29,9 @@ static int		opt_concur = 1;
 static int		opt_secs;
 static int		opt_stack;
 static int		opt_cr_type;
+static int		opt_xs = 4;
+static int		opt_usec = 20;
+static bool		opt_steal;
 #ifdef ULT_MMAP_STACK
 static int		opt_mmap;
 static struct stack_pool *sp;
@@ -287,6 +290,173 @@ abt_lock_create_rate(void *arg)
 	ABT_mutex_unlock(abt_lock);
 }
 
+static ABT_pool		*skew_pools;
+static uint64_t		*skew_lats;
+static unsigned long	 skew_lat_max;
+
+static inline uint64_t
+abt_current_us(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return now.tv_sec * 1000000 + now.tv_nsec / 1000;
+}
+
+/* Busy task with fixed CPU cost, record the latency since it's submitted */
+static void
+abt_skew_task(void *arg)
+{
+	uint64_t	submit = (uint64_t)(uintptr_t)arg;
+	uint64_t	start = abt_current_us();
+
+	while (abt_current_us() - start < opt_usec)
+		;
+
+	ABT_mutex_lock(abt_lock);
+	if (abt_cntr < skew_lat_max)
+		skew_lats[abt_cntr] = abt_current_us() - submit;
+	abt_cntr++;
+	abt_ults--;
+	if (abt_waiting) {
+		ABT_cond_broadcast(abt_cond);
+		abt_waiting = false;
+	}
+	ABT_mutex_unlock(abt_lock);
+}
+
+static int
+abt_lat_cmp(const void *a, const void *b)
+{
+	uint64_t	la = *(uint64_t *)a;
+	uint64_t	lb = *(uint64_t *)b;
+
+	return (la > lb) - (la < lb);
+}
+
+/**
+ * Submit tasks to @opt_xs helper xstreams with skewed distribution (3/4 of tasks go to
+ * the first helper), keep @opt_concur tasks in flight for @opt_secs seconds, then report
+ * the latency percentiles. Helpers randomly steal from each other when @opt_steal is set.
+ *
+ * NB: this is only a proxy of dss_offload_submit(), which needs a running engine. Stealing
+ * is done by ABT_SCHED_RANDWS on raw ULTs here, while the engine steals queued tasks from
+ * the offload queue of same-NUMA helpers only when its generic pool is empty. Use it to
+ * compare the tail latency of skewed load with and without stealing, not to measure the
+ * engine offload path; the sched/offload/ engine telemetry covers the latter.
+ */
+static void
+abt_skew_offload(void)
+{
+	ABT_xstream	*xstreams;
+	ABT_pool	*sched_pools;
+	ABT_sched	 sched;
+	unsigned long	 nr;
+	uint64_t	 then;
+	int		 i, j, rc;
+
+	D_ALLOC_ARRAY(xstreams, opt_xs);
+	D_ALLOC_ARRAY(skew_pools, opt_xs);
+	D_ALLOC_ARRAY(sched_pools, opt_xs);
+	skew_lat_max = 1UL << 22;
+	D_ALLOC_ARRAY(skew_lats, skew_lat_max);
+	if (xstreams == NULL || skew_pools == NULL || sched_pools == NULL ||
+	    skew_lats == NULL) {
+		printf("Failed to allocate memory\n");
+		goto out;
+	}
+
+	for (i = 0; i < opt_xs; i++) {
+		rc = ABT_pool_create_basic(ABT_POOL_FIFO, ABT_POOL_ACCESS_MPMC, ABT_FALSE,
+					   &skew_pools[i]);
+		if (rc != ABT_SUCCESS) {
+			printf("ABT pool create failed: %d\n", rc);
+			goto out;
+		}
+	}
+
+	for (i = 0; i < opt_xs; i++) {
+		/* The first pool is the private one, others are stolen by random */
+		for (j = 0; j < opt_xs; j++)
+			sched_pools[j] = skew_pools[(i + j) % opt_xs];
+
+		if (opt_steal)
+			rc = ABT_sched_create_basic(ABT_SCHED_RANDWS, opt_xs, sched_pools,
+						    ABT_SCHED_CONFIG_NULL, &sched);
+		else
+			rc = ABT_sched_create_basic(ABT_SCHED_BASIC, 1, sched_pools,
+						    ABT_SCHED_CONFIG_NULL, &sched);
+		if (rc != ABT_SUCCESS) {
+			printf("ABT sched create failed: %d\n", rc);
+			goto out_xs;
+		}
+
+		rc = ABT_xstream_create(sched, &xstreams[i]);
+		if (rc != ABT_SUCCESS) {
+			printf("ABT xstream create failed: %d\n", rc);
+			goto out_xs;
+		}
+	}
+
+	then = abt_current_ms();
+	while (1) {
+		if (!abt_exiting && abt_current_ms() - then >= (uint64_t)opt_secs * 1000)
+			abt_exiting = true;
+
+		ABT_mutex_lock(abt_lock);
+		if (abt_exiting && abt_ults == 0) {
+			ABT_mutex_unlock(abt_lock);
+			break;
+		}
+
+		if (abt_exiting || abt_ults >= opt_concur) {
+			abt_waiting = true;
+			ABT_cond_wait(abt_cond, abt_lock);
+			ABT_mutex_unlock(abt_lock);
+			continue;
+		}
+		abt_ults++;
+		ABT_mutex_unlock(abt_lock);
+
+		i = (rand() % 4 != 0) ? 0 : rand() % opt_xs;
+		rc = ABT_thread_create(skew_pools[i], abt_skew_task,
+				       (void *)(uintptr_t)abt_current_us(), abt_attr, NULL);
+		if (rc != ABT_SUCCESS) {
+			printf("ABT thread create failed: %d\n", rc);
+			ABT_mutex_lock(abt_lock);
+			abt_ults--;
+			abt_exiting = true;
+			ABT_mutex_unlock(abt_lock);
+		}
+	}
+
+	nr = min(abt_cntr, skew_lat_max);
+	if (nr > 0) {
+		qsort(skew_lats, nr, sizeof(*skew_lats), abt_lat_cmp);
+		printf("ABT offload rate = %lu/sec, latency(us) p50=%lu p99=%lu "
+		       "p99.9=%lu max=%lu\n", abt_cntr / opt_secs, skew_lats[nr / 2],
+		       skew_lats[nr * 99 / 100], skew_lats[nr * 999 / 1000], skew_lats[nr - 1]);
+	}
+out_xs:
+	for (i = 0; i < opt_xs; i++) {
+		if (xstreams[i] == ABT_XSTREAM_NULL)
+			continue;
+		ABT_xstream_join(xstreams[i]);
+		ABT_xstream_free(&xstreams[i]);
+	}
+out:
+	if (skew_pools != NULL) {
+		for (i = 0; i < opt_xs; i++) {
+			if (skew_pools[i] != ABT_POOL_NULL)
+				ABT_pool_free(&skew_pools[i]);
+		}
+	}
+	D_FREE(skew_lats);
+	D_FREE(sched_pools);
+	D_FREE(skew_pools);
+	D_FREE(xstreams);
+}
+
 static void
 abt_reset(void)
 {
@@ -302,6 +472,7 @@ static struct option abt_ops[] = {
 	 * m = mutext creation
 	 * e = eventual creation
 	 * d = condition creation
+	 * k = skewed offload latency (ABT_SCHED_RANDWS proxy of engine offload)
 	 */
 	{ "test",	required_argument,	NULL,	't'	},
 	/**
@@ -313,6 +484,12 @@ static struct option abt_ops[] = {
 	{ "sec",	required_argument,	NULL,	's'	},
 	/** stack size (kilo-bytes) */
 	{ "stack",	required_argument,	NULL,	'S'	},
+	/** if test-id is 'k', number of helper xstreams */
+	{ "xs",		required_argument,	NULL,	'x'	},
+	/** if test-id is 'k', CPU cost of each task in micro-seconds */
+	{ "usec",	required_argument,	NULL,	'u'	},
+	/** if test-id is 'k', enable random work stealing between xstreams */
+	{ "steal",	no_argument,		NULL,	'W'	},
 #ifdef ULT_MMAP_STACK
 	{ "mmap",	no_argument,	NULL,	'm'	},
 #endif
@@ -324,7 +501,7 @@ main(int argc, char **argv)
 	char	test_id = 0;
 	int	rc;
 
-	while ((rc = getopt_long(argc, argv, "t:n:s:S:",
+	while ((rc = getopt_long(argc, argv, "t:n:s:S:x:u:W",
 				 abt_ops, NULL)) != -1) {
 		switch (rc) {
 		default:
@@ -343,6 +520,15 @@ main(int argc, char **argv)
 			opt_stack = atoi(optarg);
 			opt_stack <<= 10; /* kilo-byte */
 			break;
+		case 'x':
+			opt_xs = atoi(optarg);
+			break;
+		case 'u':
+			opt_usec = atoi(optarg);
+			break;
+		case 'W':
+			opt_steal = true;
+			break;
 #ifdef ULT_MMAP_STACK
 		case 'm':
 			opt_mmap = true;
@@ -444,6 +630,15 @@ main(int argc, char **argv)
 		       opt_concur, opt_secs);
 		abt_sched_rate();
 		goto out;
+	case 'k':
+		if (opt_xs <= 0 || opt_usec < 0) {
+			printf("invalid xs=%d or usec=%d\n", opt_xs, opt_usec);
+			goto out;
+		}
+		printf("Skewed offload test (tasks=%d, xs=%d, usec=%d, steal=%s, secs=%d)\n",
+		       opt_concur, opt_xs, opt_usec, opt_steal ? "yes" : "no", opt_secs);
+		abt_skew_offload();
+		goto out;
 	case 'm':
 		printf("mutex creation rate test (secs=%d)\n", opt_secs);
 		opt_cr_type = CR_MUTEX;
@@ -820,6 +820,95 @@ ik_btr_perf(void **state)
 }
 
 
+#define IK_VAL_LEN	16
+/**
+ * bulk btree operations:
+ * 1) bulk load even keys in [2, 2 * key_nr] to the empty tree
+ * 2) upsert all keys in [1, 2 * key_nr + 1] as one batch
+ * 3) lookup all keys
+ */
+static void
+ik_btr_bulk(void **state)
+{
+	d_iov_t		*key_iovs;
+	d_iov_t		*val_iovs;
+	uint64_t	*keys;
+	char		*vals;
+	char		 buf[64];
+	unsigned int	 key_nr;
+	unsigned int	 i;
+	double		 then;
+	double		 now;
+	int		 rc;
+
+	key_nr = atoi(tst_fn_val.optval);
+	if (key_nr == 0 || key_nr > (1U << 27)) {
+		D_PRINT("Invalid key number: %d\n", key_nr);
+		fail();
+	}
+
+	D_ALLOC_ARRAY(key_iovs, 2 * key_nr + 1);
+	D_ALLOC_ARRAY(val_iovs, 2 * key_nr + 1);
+	D_ALLOC_ARRAY(keys, 2 * key_nr + 1);
+	D_ALLOC_ARRAY(vals, (2 * key_nr + 1) * IK_VAL_LEN);
+	if (key_iovs == NULL || val_iovs == NULL || keys == NULL ||
+	    vals == NULL)
+		fail_msg("Array allocation failed\n");
+
+	for (i = 0; i < key_nr; i++) {
+		keys[i] = 2 * (i + 1);
+		snprintf(&vals[i * IK_VAL_LEN], IK_VAL_LEN, DF_U64, keys[i]);
+		d_iov_set(&key_iovs[i], &keys[i], sizeof(keys[i]));
+		d_iov_set(&val_iovs[i], &vals[i * IK_VAL_LEN],
+			  strlen(&vals[i * IK_VAL_LEN]) + 1);
+	}
+
+	D_PRINT("Bulk load %d records.\n", key_nr);
+	then = dts_time_now();
+	rc = dbtree_bulk_load(ik_toh, key_nr, key_iovs, val_iovs, 0);
+	if (rc != 0)
+		fail_msg("Failed to bulk load: "DF_RC"\n", DP_RC(rc));
+	now = dts_time_now();
+	D_PRINT("bulk load = %10.2f/sec\n", key_nr / (now - then));
+
+	rc = dbtree_bulk_load(ik_toh, key_nr, key_iovs, val_iovs, 0);
+	if (rc != -DER_INVAL)
+		fail_msg("Bulk load to non-empty tree: "DF_RC"\n", DP_RC(rc));
+	ik_btr_query(NULL);
+
+	for (i = 0; i < 2 * key_nr + 1; i++) {
+		keys[i] = i + 1;
+		snprintf(&vals[i * IK_VAL_LEN], IK_VAL_LEN, DF_U64, keys[i]);
+		d_iov_set(&key_iovs[i], &keys[i], sizeof(keys[i]));
+		d_iov_set(&val_iovs[i], &vals[i * IK_VAL_LEN],
+			  strlen(&vals[i * IK_VAL_LEN]) + 1);
+	}
+
+	D_PRINT("Batch upsert %d records.\n", 2 * key_nr + 1);
+	then = dts_time_now();
+	rc = dbtree_upsert_batch(ik_toh, DAOS_INTENT_UPDATE, 2 * key_nr + 1,
+				 key_iovs, val_iovs);
+	if (rc != 0)
+		fail_msg("Failed to upsert batch: "DF_RC"\n", DP_RC(rc));
+	now = dts_time_now();
+	D_PRINT("batch upsert = %10.2f/sec\n", (2 * key_nr + 1) / (now - then));
+	ik_btr_query(NULL);
+
+	for (i = 0; i < 2 * key_nr + 1; i++) {
+		sprintf(buf, "%u", i + 1);
+		tst_fn_val.opc = BTR_OPC_LOOKUP;
+		tst_fn_val.optval = buf;
+		tst_fn_val.input = false;
+		ik_btr_kv_operate(NULL);
+	}
+
+	D_FREE(vals);
+	D_FREE(keys);
+	D_FREE(val_iovs);
+	D_FREE(key_iovs);
+}
+
+
 static void
 ik_btr_drain(void **state)
 {
@@ -884,6 +973,7 @@ static struct option btr_ops[] = {
 	{ "iterate",	required_argument,	NULL,	'i'	},
 	{ "batch",	required_argument,	NULL,	'b'	},
 	{ "perf",	required_argument,	NULL,	'p'	},
+	{ "bulk",	required_argument,	NULL,	'l'	},
 	{ NULL,		0,			NULL,	0	},
 };
 
@@ -908,7 +998,7 @@ ts_group(void **state) {
 
 	while ((opt = getopt_long(test_group_stop-test_group_start+1,
 				  test_group_args+test_group_start,
-				  "tmC:Deocqu:d:r:f:i:b:p:",
+				  "tmC:Deocqu:d:r:f:i:b:p:l:",
 				  btr_ops,
 				  NULL)) != -1) {
 		tst_fn_val.optval = optarg;
@@ -962,6 +1052,9 @@ ts_group(void **state) {
 		case 'p':
 			ik_btr_perf(st);
 			break;
+		case 'l':
+			ik_btr_bulk(st);
+			break;
 		default:
 			D_PRINT("Unsupported command %c\n", opt);
 		case 'm':
@@ -1039,7 +1132,7 @@ main(int argc, char **argv)
 		test_name = "Btree testing tool";
 		optind = 0;
 		/* Check for -m option first */
-		while ((opt = getopt_long(argc, argv, "tmC:Deocqu:d:r:f:i:b:p:",
+		while ((opt = getopt_long(argc, argv, "tmC:Deocqu:d:r:f:i:b:p:l:",
 					  btr_ops, NULL)) != -1) {
 			if (opt == 'm') {
 				rc = use_pmem();
@@ -32,6 +32,7 @@ Usage: btree.sh [OPTIONS]
         ukey      Use integer keys
         perf      Run performance tests
         direct    Use direct string key
+        wide      Use tree order 63, so in-node search goes beyond linear scan
 EOF
     exit 1
 }
@@ -66,6 +67,11 @@ while [ $# -gt 0 ]; do
         UINT="+"
         test_conf_pre="${test_conf_pre} ukey"
         ;;
+    wide)
+        shift
+        ORDER=63
+        test_conf_pre="${test_conf_pre} wide"
+        ;;
     direct)
         BTR=${SL_BUILD_DIR}/src/common/tests/btree_direct
         KEYS=${KEYS:-"delta,lambda,kappa,omega,beta,alpha,epsilon"}
@@ -128,6 +134,15 @@ run_test()
         -b "$BAT_NUM"                               \
         -D
 
+        echo "B+tree bulk load test..."
+        eval "${VCMD[@]}" "$BTR" \
+        --start-test "btree bulk load ${test_conf_pre} ${test_conf}" \
+        "${DYN}" "${PMEM}" -C "${UINT}${IPL}o:$ORDER" \
+        -c                                          \
+        -o                                          \
+        -l "$BAT_NUM"                               \
+        -D
+
         echo "B+tree drain test..."
         eval "${VCMD[@]}" "$BTR" \
         --start-test "btree drain ${test_conf_pre} ${test_conf}" \
@@ -140,6 +155,7 @@ run_test()
         --start-test "btree performance ${test_conf_pre} ${test_conf}" \
         "${DYN}" "${PMEM}" -C "${UINT}${IPL}o:$ORDER" \
         -p "$BAT_NUM"                               \
+        -l "$BAT_NUM"                               \
         -D
     fi
 }
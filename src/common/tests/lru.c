@@ -22,6 +22,9 @@ struct uint_ref {
 	uint64_t		ur_key;
 };
 
+/** count of refs freed by the cache */
+static int uint_ref_freed;
+
 void
 uint_ref_lru_free(struct daos_llink *llink)
 {
@@ -31,6 +34,7 @@ uint_ref_lru_free(struct daos_llink *llink)
 	D_PRINT("Freeing LRU ref from uint_ref cb\n");
 	ref = container_of(llink, struct uint_ref, ur_llink);
 	D_FREE(ref);
+	uint_ref_freed++;
 }
 
 int
@@ -99,6 +103,209 @@ test_ref_hold(struct daos_lru_cache *cache,
 }
 
 
+#define LRU_CHECK(cond)							\
+	do {								\
+		if (!(cond)) {						\
+			D_ERROR("Check failed: %s\n", #cond);		\
+			D_GOTO(out, rc = -DER_MISMATCH);		\
+		}							\
+	} while (0)
+
+/** Hold and release a key, it's created if not cached */
+static int
+lru_touch(struct daos_lru_cache *cache, uint64_t key)
+{
+	struct daos_llink	*link;
+	int			 rc;
+
+	rc = daos_lru_ref_hold(cache, &key, sizeof(key), (void *)1, &link);
+	if (rc == 0)
+		daos_lru_ref_release(cache, link);
+	return rc;
+}
+
+/** Check if a key is cached without creating it, it marks the key referenced */
+static bool
+lru_cached(struct daos_lru_cache *cache, uint64_t key)
+{
+	struct daos_llink	*link;
+	int			 rc;
+
+	rc = daos_lru_ref_hold(cache, &key, sizeof(key), NULL, &link);
+	if (rc == 0)
+		daos_lru_ref_release(cache, link);
+	return rc == 0;
+}
+
+/** Referenced and busy refs get a second chance from the clock hand */
+static int
+test_second_chance(void)
+{
+	struct daos_lru_cache	*cache;
+	struct daos_llink	*link;
+	uint64_t		 key;
+	int			 rc;
+	int			 i;
+
+	D_PRINT("Test CLOCK second chance\n");
+	rc = daos_lru_cache_create(2, D_HASH_FT_NOLOCK, &uint_ref_llink_ops, &cache);
+	if (rc)
+		return rc;
+
+	for (i = 0; i < 4; i++) {
+		rc = lru_touch(cache, i);
+		if (rc)
+			goto out;
+	}
+	LRU_CHECK(cache->dlc_count == 4);
+
+	/* Key 0 is the oldest, but it's hit again, so key 1 is evicted instead */
+	rc = lru_touch(cache, 0);
+	if (rc)
+		goto out;
+	rc = lru_touch(cache, 4);
+	if (rc)
+		goto out;
+	LRU_CHECK(cache->dlc_count == 4);
+	LRU_CHECK(!lru_cached(cache, 1));
+	LRU_CHECK(lru_cached(cache, 0));
+
+	/* Key 2 is the oldest now, it's busy, so key 3 is evicted instead */
+	key = 2;
+	rc = daos_lru_ref_hold(cache, &key, sizeof(key), NULL, &link);
+	if (rc)
+		goto out;
+	rc = lru_touch(cache, 5);
+	if (rc) {
+		daos_lru_ref_release(cache, link);
+		goto out;
+	}
+	LRU_CHECK(!lru_cached(cache, 3));
+	LRU_CHECK(!daos_lru_ref_evicted(link));
+	daos_lru_ref_release(cache, link);
+
+	LRU_CHECK(cache->dlc_count == 4);
+	LRU_CHECK(lru_cached(cache, 2));
+out:
+	daos_lru_cache_destroy(cache);
+	return rc;
+}
+
+/** The cache grows on hits of the ghost filter and shrinks on cold refs */
+static int
+test_ghost_adapt(void)
+{
+	struct daos_lru_cache	*cache;
+	int			 rc;
+	int			 i, j;
+
+	D_PRINT("Test ghost filter adaptation\n");
+	rc = daos_lru_cache_create(4, D_HASH_FT_NOLOCK, &uint_ref_llink_ops, &cache);
+	if (rc)
+		return rc;
+
+	rc = daos_lru_cache_adapt(cache, 2);
+	if (rc)
+		goto out;
+	LRU_CHECK(cache->dlc_csize == 4);
+	LRU_CHECK(cache->dlc_csize_max == 16);
+
+	/* The working set of 8 keys doesn't fit, keys 0 - 3 are evicted into the ghost filter */
+	for (i = 0; i < 8; i++) {
+		rc = lru_touch(cache, i);
+		if (rc)
+			goto out;
+	}
+	LRU_CHECK(cache->dlc_csize == 4);
+	LRU_CHECK(cache->dlc_count == 4);
+	LRU_CHECK(!lru_cached(cache, 0));
+
+	/* Miss of a recently evicted key grows the cache until it holds the working set */
+	for (j = 0; j < 8; j++) {
+		for (i = 0; i < 8; i++) {
+			rc = lru_touch(cache, i);
+			if (rc)
+				goto out;
+		}
+	}
+	D_PRINT("Cache size %u for working set of 8\n", cache->dlc_csize);
+	LRU_CHECK(cache->dlc_csize >= 8 && cache->dlc_csize <= cache->dlc_csize_max);
+	for (i = 0; i < 8; i++)
+		LRU_CHECK(lru_cached(cache, i));
+
+	/* A scan of keys never reused shrinks it back to the lower bound */
+	for (i = 0; i < 256; i++) {
+		rc = lru_touch(cache, 1000 + i);
+		if (rc)
+			goto out;
+	}
+	D_PRINT("Cache size %u after scan\n", cache->dlc_csize);
+	LRU_CHECK(cache->dlc_csize == cache->dlc_csize_min);
+	LRU_CHECK(cache->dlc_count == cache->dlc_csize);
+out:
+	daos_lru_cache_destroy(cache);
+	return rc;
+}
+
+/** An idle ref is freed right away, a busy one after its last release */
+static int
+test_evict_one(void)
+{
+	struct daos_lru_cache	*cache;
+	struct daos_llink	*link;
+	uint64_t		 key;
+	int			 freed;
+	int			 rc;
+
+	D_PRINT("Test evict one\n");
+	rc = daos_lru_cache_create(4, D_HASH_FT_NOLOCK, &uint_ref_llink_ops, &cache);
+	if (rc)
+		return rc;
+
+	rc = lru_touch(cache, 0);
+	if (rc)
+		goto out;
+	rc = lru_touch(cache, 1);
+	if (rc)
+		goto out;
+	LRU_CHECK(cache->dlc_count == 2);
+
+	freed = uint_ref_freed;
+	key = 0;
+	rc = daos_lru_ref_hold(cache, &key, sizeof(key), NULL, &link);
+	if (rc)
+		goto out;
+	daos_lru_ref_release(cache, link);
+	daos_lru_cache_evict_one(cache, link);
+	LRU_CHECK(uint_ref_freed == freed + 1);
+	LRU_CHECK(cache->dlc_count == 1);
+	LRU_CHECK(!lru_cached(cache, 0));
+
+	key = 1;
+	rc = daos_lru_ref_hold(cache, &key, sizeof(key), NULL, &link);
+	if (rc)
+		goto out;
+	daos_lru_cache_evict_one(cache, link);
+	LRU_CHECK(daos_lru_ref_evicted(link));
+	LRU_CHECK(uint_ref_freed == freed + 1);
+	LRU_CHECK(cache->dlc_count == 1);
+	/* Can't be found by others after eviction */
+	LRU_CHECK(!lru_cached(cache, 1));
+
+	daos_lru_ref_release(cache, link);
+	LRU_CHECK(uint_ref_freed == freed + 2);
+	LRU_CHECK(cache->dlc_count == 0);
+
+	/* It can be created again */
+	rc = lru_touch(cache, 1);
+	if (rc)
+		goto out;
+	LRU_CHECK(cache->dlc_count == 1);
+out:
+	daos_lru_cache_destroy(cache);
+	return rc;
+}
+
 int
 main(int argc, char **argv)
 {
@@ -181,6 +388,18 @@ main(int argc, char **argv)
 	daos_lru_ref_release(tcache, link_ret[1]);
 	D_PRINT("Completed ref release for key: %"PRIu64"\n",
 		keys[1]);
+
+	rc = test_second_chance();
+	if (rc)
+		D_GOTO(exit, rc);
+
+	rc = test_ghost_adapt();
+	if (rc)
+		D_GOTO(exit, rc);
+
+	rc = test_evict_one();
+	if (rc)
+		D_GOTO(exit, rc);
 exit:
 	daos_lru_cache_destroy(tcache);
 	D_FREE(keys);
@@ -59,6 +59,26 @@ test_policy_positive(void **state)
 
 }
 
+static void
+test_policy_hot_cold(void **state)
+{
+	const char *str = "type=hot_cold/th1=1024/hot=16/half_life=300";
+	struct policy_desc_t out, exp_out;
+	bool result = false;
+
+	reset_policy_desc(&out);
+	reset_policy_desc(&exp_out);
+	result = daos_policy_try_parse(str, &out);
+
+	exp_out.policy = DAOS_MEDIA_POLICY_HOT_COLD;
+	exp_out.params[0] = 1024;
+	exp_out.params[1] = 16;
+	exp_out.params[2] = 300;
+
+	assert_true(result);
+	assert_true(are_policy_descs_equal(&out, &exp_out));
+}
+
 static void
 test_policy_negative(void **state)
 {
@@ -209,6 +229,7 @@ main(void)
 {
 	const struct CMUnitTest tests[] = {
 		cmocka_unit_test(test_policy_positive),
+		cmocka_unit_test(test_policy_hot_cold),
 		cmocka_unit_test(test_policy_negative),
 		cmocka_unit_test(test_policy_type_only),
 		cmocka_unit_test(test_policy_no_type),
@@ -45,12 +45,16 @@ struct test_arg {
 	int                      ta_chunk_nr;
 	d_list_t                 ta_prep_list;
 	d_list_t                 ta_flush_list;
+	/** Offset & tx ID of a write issued while the checkpoint is preparing */
+	uint64_t                 ta_prep_off;
+	uint64_t                 ta_prep_tx;
 };
 
 static void
 reset_arg(struct test_arg *arg)
 {
 	arg->ta_chunk_nr = 0;
+	arg->ta_prep_tx  = 0;
 	D_INIT_LIST_HEAD(&arg->ta_prep_list);
 	D_INIT_LIST_HEAD(&arg->ta_flush_list);
 }
@@ -361,6 +365,12 @@ flush_prep(struct umem_store *store, struct umem_store_iod *iod, daos_handle_t *
 	for (i = 0; i < iod->io_nr; i++)
 		check_io_region(arg, &iod->io_regions[i]);
 
+	/** Flush prep could yield, writes to the pages being checkpointed should not be blocked */
+	if (arg->ta_prep_tx != 0) {
+		touch_mem(arg, arg->ta_prep_tx, arg->ta_prep_off, 10);
+		arg->ta_prep_tx = 0;
+	}
+
 	fh->cookie = (uint64_t)arg;
 
 	return 0;
@@ -559,6 +569,51 @@ test_many_writes(void **state)
 	umem_cache_free(&arg->ta_store);
 }
 
+static void
+test_concurrent_touch(void **state)
+{
+	struct test_arg               *arg = *state;
+	struct umem_cache_chkpt_stats  stats = { 0 };
+	uint64_t                       id    = 0;
+	int                            rc;
+
+	arg->ta_store.stor_size = 3 * UMEM_CACHE_PAGE_SZ;
+	arg->ta_store.stor_ops  = &stor_ops;
+
+	/** In case prior test failed */
+	umem_cache_free(&arg->ta_store);
+
+	rc = umem_cache_alloc(&arg->ta_store, 0);
+	assert_rc_equal(rc, 0);
+
+	rc = umem_cache_map_range(&arg->ta_store, 0, (void *)(UMEM_CACHE_PAGE_SZ), 3);
+	assert_rc_equal(rc, 0);
+
+	reset_arg(arg);
+	touch_mem(arg, 1, 0, 10);
+
+	/** Dirty another chunk of the same page while the checkpoint is in flush prep */
+	arg->ta_prep_tx  = 2;
+	arg->ta_prep_off = UMEM_CACHE_CHUNK_SZ * 8;
+
+	rc = umem_cache_checkpoint(&arg->ta_store, wait_cb, NULL, &id, &stats);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(id, 1);
+	assert_int_equal(stats.uccs_nr_dchunks, 1);
+	assert_int_equal(stats.uccs_dirtied_bytes, 10);
+	assert_int_equal(stats.uccs_chkpt_bytes, UMEM_CACHE_CHUNK_SZ);
+
+	/** The chunk dirtied in flush prep is left for the next checkpoint */
+	rc = umem_cache_checkpoint(&arg->ta_store, wait_cb, NULL, &id, &stats);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(id, 2);
+	assert_int_equal(stats.uccs_nr_dchunks, 1);
+	assert_int_equal(stats.uccs_dirtied_bytes, 10);
+	check_lists_empty(arg);
+
+	umem_cache_free(&arg->ta_store);
+}
+
 int
 main(int argc, char **argv)
 {
@@ -570,6 +625,7 @@ main(int argc, char **argv)
 	    {"UMEM005: Test page cache", test_page_cache, NULL, NULL},
 	    {"UMEM006: Test page cache many pages", test_many_pages, NULL, NULL},
 	    {"UMEM007: Test page cache many writes", test_many_writes, NULL, NULL},
+	    {"UMEM008: Test page cache write during checkpoint", test_concurrent_touch, NULL, NULL},
 	    {NULL, NULL, NULL, NULL}};
 
 	d_register_alt_assert(mock_assert);
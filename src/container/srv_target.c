@@ -289,6 +289,8 @@ adjust_upper_bound(struct ds_cont_child *cont, bool vos_agg, uint64_t *upper_bou
 }
 
 #define MAX_SNAPSHOT_LOCAL	16
+/* Stop NVMe defrag when free space is less than 10%, relocation needs free space */
+#define AGG_DEFRAG_PRESS_MAX	4
 static int
 cont_child_aggregate(struct ds_cont_child *cont, cont_aggregate_cb_t agg_cb,
 		     struct agg_param *param)
@@ -304,6 +306,7 @@ cont_child_aggregate(struct ds_cont_child *cont, cont_aggregate_cb_t agg_cb,
 	int			snapshots_nr;
 	int			tgt_id = dss_get_module_info()->dmi_tgt_id;
 	uint32_t		flags = 0;
+	int			press;
 	int			i, rc = 0;
 
 	change_hlc = max(cont->sc_snapshot_delete_hlc,
@@ -431,6 +434,17 @@ cont_child_aggregate(struct ds_cont_child *cont, cont_aggregate_cb_t agg_cb,
 
 	if (dss_xstream_is_busy())
 		flags &= ~VOS_AGG_FL_FORCE_MERGE;
+
+	/*
+	 * Compact fragmented NVMe free space when the xstream is idle, or when there
+	 * is moderate space pressure. VOS will skip it if the fragmentation is low.
+	 */
+	if (param->ap_vos_agg) {
+		press = sched_req_space_check(req);
+		if (press < AGG_DEFRAG_PRESS_MAX &&
+		    (press != SCHED_SPACE_PRESS_NONE || !dss_xstream_is_busy()))
+			flags |= VOS_AGG_FL_DEFRAG;
+	}
 	rc = agg_cb(cont, &epoch_range, flags, param);
 out:
 	if (rc == 0 && epoch_min == 0)
@@ -239,6 +239,8 @@ const (
 	PoolPolicyIoSize PoolPolicy = C.DAOS_MEDIA_POLICY_IO_SIZE
 	// PoolPolicyWriteIntensivity sets the pool's policy to write_intensivity
 	PoolPolicyWriteIntensivity PoolPolicy = C.DAOS_MEDIA_POLICY_WRITE_INTENSIVITY
+	// PoolPolicyHotCold sets the pool's policy to hot_cold
+	PoolPolicyHotCold PoolPolicy = C.DAOS_MEDIA_POLICY_HOT_COLD
 )
 
 // PoolPolicyIsValid returns a boolean indicating whether or not the
@@ -138,6 +138,14 @@ struct sched_pool_info {
 	int			spi_ref;
 	uint32_t		spi_req_cnt;
 	struct stats_window	spi_stats_window;
+	/* Per QoS class IO requests, in enqueue (and deadline) order */
+	d_list_t		spi_qos_req[SCHED_QOS_MAX];
+	/* Weighted fair queuing across pools, linked to 'sched_info->si_qos_list' */
+	struct sched_qos_flow	spi_qos_flow;
+	/* Token buckets of the per-pool IOPS and bandwidth limits */
+	struct sched_qos_bucket	spi_qos_bucket;
+	/* Total request count in 'spi_qos_req' */
+	uint32_t		spi_qos_cnt;
 };
 
 struct sched_request {
@@ -156,6 +164,8 @@ struct sched_request {
 	uint64_t		 sr_wakeup_time;
 	/* When the request is enqueued, in msecs */
 	uint64_t		 sr_enqueue_ts;
+	/* QoS class, used by SCHED_POLICY_QOS */
+	uint32_t		 sr_qos_class;
 	unsigned int		 sr_abort:1,
 				 /* sr_ult is sched_request-owned */
 				 sr_owned:1;
@@ -164,26 +174,29 @@ struct sched_request {
 bool		sched_prio_disabled;
 unsigned int	sched_relax_intvl = SCHED_RELAX_INTVL_DEFAULT;
 unsigned int	sched_relax_mode;
+/* Relax after short idle period when the ULT rate is low, back off the relax interval */
+bool		sched_relax_adaptive;
+/* ULTs per second, below which the xstream is considered lightly loaded */
+unsigned int	sched_relax_rate = SCHED_RELAX_RATE_DEFAULT;
 unsigned int	sched_unit_runtime_max = 32; /* ms */
 bool		sched_watchdog_all;
 
-enum {
-	/* All requests for various pools are processed in FIFO */
-	SCHED_POLICY_FIFO	= 0,
-	/*
-	 * All requests are processed in RR based on certain ID (Client ID,
-	 * Pool ID, Container ID, JobID, UID, etc.)
-	 */
-	SCHED_POLICY_ID_RR,
-	/*
-	 * Request priority is based on certain ID (Client ID, Pool ID,
-	 * Container ID, JobID, UID, etc.)
-	 */
-	SCHED_POLICY_ID_PRIO,
-	SCHED_POLICY_MAX
+unsigned int	sched_policy = SCHED_POLICY_FIFO;
+/* Default per-pool IOPS limit on each target, 0 means unlimited */
+unsigned int	sched_qos_pool_iops;
+/* Default per-pool bandwidth limit on each target in MB/s, 0 means unlimited */
+unsigned int	sched_qos_pool_bw;
+
+/* Per-pool override of the default QoS limits */
+struct sched_qos_limit {
+	uuid_t		sql_pool;
+	unsigned int	sql_iops;
+	unsigned int	sql_bw;
 };
 
-static int	sched_policy;
+#define SCHED_QOS_LIMITS_MAX	64
+static struct sched_qos_limit	sched_qos_limits[SCHED_QOS_LIMITS_MAX];
+static unsigned int		sched_qos_limits_nr;
 
 /*
  * Time threshold for giving IO up throttling. If space pressure stays in the
@@ -205,6 +218,19 @@ static unsigned int max_delay_msecs[SCHED_REQ_MAX] = {
 	12000,	/* SCHED_REQ_MIGRATE */
 };
 
+/* Target queueing delay for different QoS classes, in msecs */
+static unsigned int qos_deadline_msecs[SCHED_QOS_MAX] = {
+	0,	/* SCHED_QOS_URGENT */
+	20,	/* SCHED_QOS_LATENCY */
+	200,	/* SCHED_QOS_BATCH */
+};
+
+static char *qos_class_names[SCHED_QOS_MAX] = {
+	"urgent",
+	"latency",
+	"batch",
+};
+
 /* Maximum QD for different type of ULTs */
 static unsigned int max_qds[SCHED_REQ_MAX] = {
 	64000,	/* SCHED_REQ_UPDATE */
@@ -345,6 +371,8 @@ spi_rec_free(struct d_hash_table *htable, d_list_t *rlink)
 			  type, pool2req_cnt(spi, type));
 		D_ASSERT(d_list_empty(pool2req_list(spi, type)));
 	}
+	D_ASSERTF(spi->spi_qos_cnt == 0, "qos_cnt:%u\n", spi->spi_qos_cnt);
+	D_ASSERT(d_list_empty(&spi->spi_qos_flow.qf_link));
 
 	D_FREE(spi);
 }
@@ -492,11 +520,14 @@ sched_metrics_init(struct dss_xstream *dx)
 {
 	struct sched_info	*info = &dx->dx_sched_info;
 	struct sched_stats	*stats = &info->si_stats;
-	int			 rc;
+	char			 path[D_TM_MAX_NAME_LEN];
+	int			 i, rc;
 
 	stats->ss_busy_ts = info->si_cur_ts;
 	stats->ss_watchdog_ts = 0;
 	stats->ss_last_unit = NULL;
+	stats->ss_relax_rem = 0;
+	stats->ss_wakeup_ts = 0;
 
 	rc = d_tm_add_metric(&stats->ss_total_time, D_TM_COUNTER, "Total running time", "ms",
 			     "sched/total_time/xs_%u", dx->dx_xs_id);
@@ -527,6 +558,36 @@ sched_metrics_init(struct dss_xstream *dx)
 			     "ULT", "sched/cycle_size/xs_%u", dx->dx_xs_id);
 	if (rc)
 		D_WARN("Failed to create cycle_size telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->ss_relax_cnt, D_TM_COUNTER, "Total relax periods", "times",
+			     "sched/relax_cnt/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create relax_cnt telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&stats->ss_relax_wakeup, D_TM_STATS_GAUGE,
+			     "Latency from relax wakeup to ULT execution", "us",
+			     "sched/relax_wakeup/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create relax_wakeup telemetry: "DF_RC"\n", DP_RC(rc));
+
+	if (sched_policy != SCHED_POLICY_QOS)
+		return;
+
+	for (i = 0; i < SCHED_QOS_MAX; i++) {
+		snprintf(path, sizeof(path), "sched/qos_delay/%s/xs_%u", qos_class_names[i],
+			 dx->dx_xs_id);
+		rc = d_tm_add_metric(&stats->ss_qos_delay[i], D_TM_STATS_GAUGE,
+				     "QoS class queueing delay", "ms", "%s", path);
+		if (rc) {
+			D_WARN("Failed to create qos_delay telemetry: "DF_RC"\n", DP_RC(rc));
+			continue;
+		}
+
+		/* Buckets of 1, 2, 4 ... 512 msecs */
+		rc = d_tm_init_histogram(stats->ss_qos_delay[i], path, 10, 1, 2);
+		if (rc)
+			D_WARN("Failed to init qos_delay histogram: "DF_RC"\n", DP_RC(rc));
+	}
 }
 
 static int
@@ -542,6 +603,12 @@ sched_info_init(struct dss_xstream *dx)
 	D_INIT_LIST_HEAD(&info->si_sleep_list);
 	D_INIT_LIST_HEAD(&info->si_fifo_list);
 	D_INIT_LIST_HEAD(&info->si_purge_list);
+	D_INIT_LIST_HEAD(&info->si_qos_list);
+	info->si_qos_vtime = 0;
+	info->si_rate_ts = info->si_cur_ts;
+	info->si_rate_ults = 0;
+	info->si_rate = 0;
+	info->si_relax_intvl = sched_relax_intvl;
 	info->si_req_cnt = 0;
 	info->si_sleep_cnt = 0;
 	info->si_wait_cnt = 0;
@@ -566,12 +633,69 @@ sched_info_init(struct dss_xstream *dx)
 	return rc;
 }
 
+/*
+ * Parse the per-pool QoS limits overriding DAOS_SCHED_QOS_POOL_IOPS/BW, in the format of
+ * "<pool_uuid>:<iops>:<bw_MBs>[,<pool_uuid>:<iops>:<bw_MBs>...]", 0 means unlimited.
+ */
+int
+sched_qos_limits_parse(char *str)
+{
+	struct sched_qos_limit	*sql;
+	char			*buf, *entry, *saved = NULL;
+	char			 uuid_str[DAOS_UUID_STR_SIZE];
+	int			 rc = 0;
+
+	D_STRNDUP(buf, str, strlen(str));
+	if (buf == NULL)
+		return -DER_NOMEM;
+
+	sched_qos_limits_nr = 0;
+	for (entry = strtok_r(buf, ",", &saved); entry != NULL;
+	     entry = strtok_r(NULL, ",", &saved)) {
+		if (sched_qos_limits_nr == SCHED_QOS_LIMITS_MAX) {
+			D_ERROR("Too many per-pool QoS limits, max %d\n", SCHED_QOS_LIMITS_MAX);
+			D_GOTO(out, rc = -DER_INVAL);
+		}
+
+		sql = &sched_qos_limits[sched_qos_limits_nr];
+		if (sscanf(entry, "%36[0-9a-fA-F-]:%u:%u", uuid_str, &sql->sql_iops,
+			   &sql->sql_bw) != 3 || uuid_parse(uuid_str, sql->sql_pool) != 0) {
+			D_ERROR("Invalid per-pool QoS limit [%s]\n", entry);
+			D_GOTO(out, rc = -DER_INVAL);
+		}
+		sched_qos_limits_nr++;
+	}
+out:
+	if (rc)
+		sched_qos_limits_nr = 0;
+	D_FREE(buf);
+	return rc;
+}
+
+/* Limits of the pool, the table is only changed before xstreams are started */
+static void
+sched_qos_pool_limit(uuid_t pool_uuid, unsigned int *iops, unsigned int *bw)
+{
+	unsigned int	i;
+
+	for (i = 0; i < sched_qos_limits_nr; i++) {
+		if (uuid_compare(sched_qos_limits[i].sql_pool, pool_uuid) == 0) {
+			*iops = sched_qos_limits[i].sql_iops;
+			*bw = sched_qos_limits[i].sql_bw;
+			return;
+		}
+	}
+
+	*iops = sched_qos_pool_iops;
+	*bw = sched_qos_pool_bw;
+}
+
 static struct sched_pool_info *
 cur_pool_info(struct sched_info *info, uuid_t pool_uuid)
 {
 	struct sched_pool_info	*spi;
 	d_list_t		*rlink, *list;
-	unsigned int		 type;
+	unsigned int		 type, iops, bw;
 	int			 rc;
 
 	D_ASSERT(info->si_pool_hash != NULL);
@@ -596,6 +720,12 @@ cur_pool_info(struct sched_info *info, uuid_t pool_uuid)
 		D_INIT_LIST_HEAD(list);
 	}
 
+	D_INIT_LIST_HEAD(&spi->spi_qos_flow.qf_link);
+	for (type = SCHED_QOS_URGENT; type < SCHED_QOS_MAX; type++)
+		D_INIT_LIST_HEAD(&spi->spi_qos_req[type]);
+	sched_qos_pool_limit(pool_uuid, &iops, &bw);
+	sched_qos_bucket_init(&spi->spi_qos_bucket, iops, bw, info->si_cur_ts);
+
 	rc = d_hash_rec_insert(info->si_pool_hash, pool_uuid, sizeof(uuid_t),
 			       &spi->spi_hash_link, false);
 	if (rc)
@@ -778,6 +908,26 @@ out:
 	return spi->spi_space_pressure;
 }
 
+static inline bool
+is_req_expired(struct sched_info *info, struct sched_request *req)
+{
+	struct sched_pool_info	*spi = req->sr_pool_info;
+	unsigned int		 req_type = req->sr_attr.sra_type;
+	unsigned int		 delay_msecs;
+
+	if (req_type == SCHED_REQ_UPDATE) {
+		struct pressure_ratio *pr;
+
+		pr = &pressure_gauge[spi->spi_space_pressure];
+		delay_msecs = pr->pr_delay;
+	} else {
+		delay_msecs = max_delay_msecs[req_type];
+	}
+
+	D_ASSERT(info->si_cur_ts >= req->sr_enqueue_ts);
+	return (info->si_cur_ts - req->sr_enqueue_ts) > delay_msecs;
+}
+
 static int
 process_req(struct dss_xstream *dx, struct sched_request *req)
 {
@@ -785,7 +935,6 @@ process_req(struct dss_xstream *dx, struct sched_request *req)
 	struct sched_pool_info	*spi = req->sr_pool_info;
 	struct sched_req_info	*sri;
 	unsigned int		 req_type = req->sr_attr.sra_type;
-	unsigned int		 delay_msecs;
 
 	D_ASSERT(spi != NULL);
 	D_ASSERT(req_type < SCHED_REQ_MAX);
@@ -802,18 +951,8 @@ process_req(struct dss_xstream *dx, struct sched_request *req)
 	if (req->sr_attr.sra_flags & SCHED_REQ_FL_NO_DELAY)
 		goto kickoff;
 
-	if (req_type == SCHED_REQ_UPDATE) {
-		struct pressure_ratio *pr;
-
-		pr = &pressure_gauge[spi->spi_space_pressure];
-		delay_msecs = pr->pr_delay;
-	} else {
-		delay_msecs = max_delay_msecs[req_type];
-	}
-
 	/* Request expired */
-	D_ASSERT(info->si_cur_ts >= req->sr_enqueue_ts);
-	if ((info->si_cur_ts - req->sr_enqueue_ts) > delay_msecs)
+	if (is_req_expired(info, req))
 		goto kickoff;
 
 	/* Remaining requests are not expired */
@@ -1098,6 +1237,134 @@ policy_fifo_process(struct dss_xstream *dx)
 	process_req_list(dx, &info->si_fifo_list, false);
 }
 
+static void
+policy_qos_enqueue(struct dss_xstream *dx, struct sched_request *req,
+		   void *prio_data)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	struct sched_pool_info	*spi = req->sr_pool_info;
+
+	req->sr_qos_class = sched_qos_class(req->sr_attr.sra_type, req->sr_attr.sra_flags);
+	d_list_add_tail(&req->sr_link, &spi->spi_qos_req[req->sr_qos_class]);
+
+	if (spi->spi_qos_cnt++ == 0)
+		sched_qos_flow_start(&spi->spi_qos_flow, &info->si_qos_list, info->si_qos_vtime);
+}
+
+/* Returns 1 when the request has to stay in queue */
+static int
+qos_process_req(struct dss_xstream *dx, struct sched_request *req)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	struct sched_pool_info	*spi = req->sr_pool_info;
+	unsigned int		 qos_class = req->sr_qos_class;
+	uint64_t		 size = req->sr_attr.sra_size;
+	uint64_t		 wait, cost;
+	int			 rc;
+
+	/*
+	 * Urgent requests aren't charged against the pool limits, others are held when
+	 * the pool runs out of tokens, unless they are about to time out.
+	 */
+	if (qos_class != SCHED_QOS_URGENT && !info->si_stop &&
+	    !sched_qos_bucket_ready(&spi->spi_qos_bucket) && !is_req_expired(info, req))
+		return 1;
+
+	wait = info->si_cur_ts - req->sr_enqueue_ts;
+	cost = sched_qos_cost(req_weights[req->sr_attr.sra_type], size);
+
+	rc = process_req(dx, req);
+	if (rc)
+		return rc;
+
+	/* 'req' is back to idle list, it can't be accessed anymore */
+	D_ASSERT(spi->spi_qos_cnt > 0);
+	spi->spi_qos_cnt--;
+	if (spi->spi_qos_cnt == 0)
+		d_list_del_init(&spi->spi_qos_flow.qf_link);
+
+	if (qos_class != SCHED_QOS_URGENT) {
+		sched_qos_bucket_charge(&spi->spi_qos_bucket, size);
+		info->si_qos_vtime = sched_qos_flow_charge(&spi->spi_qos_flow, cost);
+	}
+	d_tm_set_gauge(info->si_stats.ss_qos_delay[qos_class], wait);
+
+	return 0;
+}
+
+/*
+ * Kick off one request from the pool, the class heads are picked in EDF (Earliest Deadline
+ * First) order. Fetch and update share the token buckets of the pool, so EDF decides which
+ * class gets the tokens when the pool is limited. Without limits, all requests are kicked
+ * off in this cycle unless they are throttled by space pressure, EDF only decides the order
+ * they are kicked off (and executed). Returns 1 when nothing can be kicked off.
+ */
+static int
+qos_process_pool(struct dss_xstream *dx, struct sched_pool_info *spi)
+{
+	struct sched_request	*heads[SCHED_QOS_MAX] = { NULL };
+	struct sched_request	*req;
+	uint64_t		 deadline, min_deadline;
+	unsigned int		 i, min_class;
+
+	for (i = SCHED_QOS_LATENCY; i < SCHED_QOS_MAX; i++) {
+		if (!d_list_empty(&spi->spi_qos_req[i]))
+			heads[i] = d_list_entry(spi->spi_qos_req[i].next, struct sched_request,
+						sr_link);
+	}
+
+	while (1) {
+		min_class = SCHED_QOS_MAX;
+		min_deadline = UINT64_MAX;
+
+		for (i = SCHED_QOS_LATENCY; i < SCHED_QOS_MAX; i++) {
+			req = heads[i];
+			if (req == NULL)
+				continue;
+
+			deadline = req->sr_enqueue_ts + qos_deadline_msecs[i];
+			if (deadline < min_deadline) {
+				min_deadline = deadline;
+				min_class = i;
+			}
+		}
+
+		if (min_class == SCHED_QOS_MAX)
+			return 1;
+
+		if (qos_process_req(dx, heads[min_class]) == 0)
+			return 0;
+		/* Requests behind the head are enqueued later, they can't be kicked either */
+		heads[min_class] = NULL;
+	}
+}
+
+static void
+policy_qos_process(struct dss_xstream *dx)
+{
+	struct sched_info	*info = &dx->dx_sched_info;
+	struct sched_pool_info	*spi, *tmp;
+	struct sched_qos_flow	*pick;
+	struct sched_request	*req, *req_tmp;
+
+	/* Urgent requests are served prior to the fair queuing */
+	d_list_for_each_entry_safe(spi, tmp, &info->si_qos_list, spi_qos_flow.qf_link) {
+		sched_qos_bucket_refill(&spi->spi_qos_bucket, info->si_cur_ts);
+		spi->spi_qos_flow.qf_blocked = 0;
+
+		d_list_for_each_entry_safe(req, req_tmp, &spi->spi_qos_req[SCHED_QOS_URGENT],
+					   sr_link)
+			qos_process_req(dx, req);
+	}
+
+	/* Weighted fair queuing: always serve the backlogged pool with smallest vtime */
+	while ((pick = sched_qos_flow_pick(&info->si_qos_list)) != NULL) {
+		spi = container_of(pick, struct sched_pool_info, spi_qos_flow);
+		if (qos_process_pool(dx, spi))
+			pick->qf_blocked = 1;
+	}
+}
+
 struct sched_policy_ops {
 	void (*enqueue_io)(struct dss_xstream *dx, struct sched_request *req,
 			   void *prio_data);
@@ -1116,6 +1383,10 @@ static struct sched_policy_ops	policy_ops[SCHED_POLICY_MAX] = {
 	{	/* SCHED_POLICY_ID_PRIO */
 		.enqueue_io = NULL,
 		.process_io = NULL,
+	},
+	{	/* SCHED_POLICY_QOS */
+		.enqueue_io = policy_qos_enqueue,
+		.process_io = policy_qos_process,
 	}
 };
 
@@ -1719,6 +1990,64 @@ sched_pop_one(struct sched_data *data, ABT_pool pool, int pool_idx)
 }
 
 #define SCHED_IDLE_THRESH	8000UL	/* msecs */
+/* Idle threshold for adaptive relaxing when the ULT rate is low */
+#define SCHED_IDLE_THRESH_LOW	10UL	/* msecs */
+/* Adaptive relax interval is backed off up to 16 times of sched_relax_intvl */
+#define SCHED_RELAX_BACKOFF_MAX	4
+/* No back off within this period since the last ULT created by other xstream */
+#define SCHED_REMOTE_WINDOW	1000	/* msecs */
+/* Window of ULT rate sampling */
+#define SCHED_RATE_WINDOW	100	/* msecs */
+
+/* Update the moving average of ULTs executed per second */
+static void
+sched_rate_update(struct sched_info *info, uint32_t ults)
+{
+	uint64_t	elapsed, rate;
+
+	info->si_rate_ults += ults;
+
+	D_ASSERT(info->si_cur_ts >= info->si_rate_ts);
+	elapsed = info->si_cur_ts - info->si_rate_ts;
+	if (elapsed < SCHED_RATE_WINDOW)
+		return;
+
+	rate = (uint64_t)info->si_rate_ults * 1000 / elapsed;
+	info->si_rate = (info->si_rate * 3 + rate) / 4;
+	info->si_rate_ults = 0;
+	info->si_rate_ts = info->si_cur_ts;
+}
+
+static inline uint64_t
+sched_idle_thresh(struct sched_info *info)
+{
+	if (sched_relax_adaptive && info->si_rate < sched_relax_rate)
+		return SCHED_IDLE_THRESH_LOW;
+	return SCHED_IDLE_THRESH;
+}
+
+/*
+ * Called after relaxing in blocking network progress, \a start is in micro-seconds and
+ * \a timeout is the progress timeout in micro-seconds the relaxing was started with.
+ */
+void
+sched_relax_done(struct dss_xstream *dx, uint64_t start, unsigned int timeout)
+{
+	struct sched_stats	*stats = &dx->dx_sched_info.si_stats;
+	uint64_t		 now = daos_getutime();
+
+	D_ASSERT(timeout > 0);
+	if (now < start)
+		return;
+
+	stats->ss_relax_rem += now - start;
+	d_tm_inc_counter(stats->ss_relax_time, stats->ss_relax_rem / 1000);
+	stats->ss_relax_rem %= 1000;
+
+	/* Woken up by network event, measure how long it takes to run the first ULT */
+	if (now - start < timeout)
+		stats->ss_wakeup_ts = now;
+}
 
 /*
  * Try to relax CPU for a short period when the xstream is idle. The relaxing
@@ -1736,6 +2065,7 @@ sched_try_relax(struct dss_xstream *dx, ABT_pool *pools, uint32_t running)
 	struct sched_info	*info = &dx->dx_sched_info;
 	unsigned int		 sleep_time = sched_relax_intvl;
 	size_t			 blocked;
+	bool			 net_relax;
 	int			 ret;
 
 	dx->dx_timeout = 0;
@@ -1783,11 +2113,43 @@ sched_try_relax(struct dss_xstream *dx, ABT_pool *pools, uint32_t running)
 
 	/*
 	 * System is currently idle, but we only start relaxing when there is
-	 * no external events for a short period of SCHED_IDLE_THRESH.
+	 * no external events for a short period of SCHED_IDLE_THRESH, or
+	 * SCHED_IDLE_THRESH_LOW when adaptive relaxing is enabled and the
+	 * recent ULT rate is low.
 	 */
 	D_ASSERT(info->si_cur_ts >= info->si_stats.ss_busy_ts);
-	if (info->si_cur_ts - info->si_stats.ss_busy_ts < SCHED_IDLE_THRESH)
+	if (info->si_cur_ts - info->si_stats.ss_busy_ts < sched_idle_thresh(info)) {
+		info->si_relax_intvl = sched_relax_intvl;
 		return;
+	}
+
+	/* Relax on the blocking network progress if the xstream has Cart context */
+	net_relax = sched_relax_mode != SCHED_RELAX_MODE_SLEEP && dx->dx_progress_started;
+
+	/*
+	 * Back off the relax interval on consecutive idle cycles when relaxing on network
+	 * progress, network events wake up the blocking progress immediately anyway. A plain
+	 * sleep can't be cut short, so it always uses the base interval. ULTs created by other
+	 * xstreams (offload, collective, IV, etc.) can't wake up the relaxing xstream either,
+	 * so don't back off when such ULTs arrived recently, they would be delayed by the
+	 * whole interval otherwise.
+	 */
+	if (sched_relax_adaptive && net_relax) {
+		uint32_t	remote = atomic_load_relaxed(&info->si_remote_cnt);
+
+		if (remote != info->si_remote_seen) {
+			info->si_remote_seen = remote;
+			info->si_remote_ts = info->si_cur_ts;
+		}
+
+		if (info->si_remote_ts != 0 &&
+		    info->si_cur_ts - info->si_remote_ts < SCHED_REMOTE_WINDOW)
+			info->si_relax_intvl = sched_relax_intvl;
+
+		sleep_time = info->si_relax_intvl;
+		if (info->si_relax_intvl < (sched_relax_intvl << SCHED_RELAX_BACKOFF_MAX))
+			info->si_relax_intvl = min(info->si_relax_intvl * 2, SCHED_RELAX_INTVL_MAX);
+	}
 
 	/* Adjust sleep time according to the first sleeping ULT */
 	if (info->si_sleep_cnt > 0) {
@@ -1808,17 +2170,18 @@ sched_try_relax(struct dss_xstream *dx, ABT_pool *pools, uint32_t running)
 	 * Wait on external network request if the xstream has Cart context,
 	 * otherwise, sleep for a while.
 	 */
-	if (sched_relax_mode != SCHED_RELAX_MODE_SLEEP && dx->dx_progress_started) {
-		/* convert to micro-seconds */
+	d_tm_inc_counter(info->si_stats.ss_relax_cnt, 1);
+	if (net_relax) {
+		/* convert to micro-seconds, relaxing time is accounted by sched_relax_done() */
 		dx->dx_timeout = sleep_time * 1000;
 	} else {
 		ret = usleep(sleep_time * 1000);
 		if (ret)
 			D_ERROR("Sleep error: %s\n", strerror(errno));
-	}
 
-	/* Rough stats, interruption isn't taken into account */
-	d_tm_inc_counter(info->si_stats.ss_relax_time, sleep_time);
+		/* Rough stats, interruption isn't taken into account */
+		d_tm_inc_counter(info->si_stats.ss_relax_time, sleep_time);
+	}
 }
 
 static void
@@ -1859,9 +2222,14 @@ sched_start_cycle(struct sched_data *data, ABT_pool *pools)
 			DSS_POOL_GENERIC, ret);
 		cnt = 0;
 	}
+
+	/* Idle helper XS steals offloaded task from other busy helper XS */
+	if (cnt == 0 && dss_offload_steal_one(dx))
+		cnt = 1;
 	cycle->sc_ults_cnt[DSS_POOL_GENERIC] = cnt;
 	cycle->sc_ults_tot += cycle->sc_ults_cnt[DSS_POOL_GENERIC];
 
+	sched_rate_update(info, cycle->sc_ults_tot);
 	if (sched_relax_mode != SCHED_RELAX_MODE_DISABLED)
 		sched_try_relax(dx, pools, cycle->sc_ults_tot);
 
@@ -1984,6 +2352,21 @@ sched_watchdog_post(struct dss_xstream *dx)
 	free(strings);
 }
 
+static inline void
+sched_wakeup_account(struct dss_xstream *dx)
+{
+	struct sched_stats	*stats = &dx->dx_sched_info.si_stats;
+	uint64_t		 now;
+
+	if (stats->ss_wakeup_ts == 0)
+		return;
+
+	now = daos_getutime();
+	if (now >= stats->ss_wakeup_ts)
+		d_tm_set_gauge(stats->ss_relax_wakeup, now - stats->ss_wakeup_ts);
+	stats->ss_wakeup_ts = 0;
+}
+
 static void
 sched_run(ABT_sched sched)
 {
@@ -2025,8 +2408,10 @@ sched_run(ABT_sched sched)
 		/* Try to pick a ULT from generic ABT pool */
 		pool = pools[DSS_POOL_GENERIC];
 		unit = sched_pop_one(data, pool, DSS_POOL_GENERIC);
-		if (unit != ABT_UNIT_NULL)
+		if (unit != ABT_UNIT_NULL) {
+			sched_wakeup_account(dx);
 			goto execute;
+		}
 
 		/*
 		 * Nothing to be executed? Could be idle helper XS or poll ULT
@@ -0,0 +1,184 @@
+/*
+ * (C) Copyright 2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+
+/**
+ * sched_qos: building blocks of the QoS aware scheduler policy (SCHED_POLICY_QOS)
+ *
+ * Request classification, per-pool token buckets for IOPS/bandwidth limiting and
+ * the weighted fair queuing across pools. They don't depend on the scheduler state,
+ * so they can be unit tested without a running engine.
+ */
+
+#ifndef __DAOS_SCHED_QOS_H__
+#define __DAOS_SCHED_QOS_H__
+
+#include <daos_srv/daos_engine.h>
+#include <gurt/list.h>
+
+/* QoS classes of IO requests, used by SCHED_POLICY_QOS */
+enum sched_qos_class {
+	/* IO issued on behalf of rebuild or DTX resync, or marked as no delay */
+	SCHED_QOS_URGENT	= 0,
+	/* Latency sensitive IO (fetch) */
+	SCHED_QOS_LATENCY,
+	/* Throughput oriented IO (update) */
+	SCHED_QOS_BATCH,
+	SCHED_QOS_MAX,
+};
+
+/* Bandwidth limit is specified in MB/s */
+#define SCHED_QOS_BW_SHIFT	20
+/* Each 64KB of data costs one extra weight in fair queuing */
+#define SCHED_QOS_COST_SHIFT	16
+
+/* Per-pool token buckets of the IOPS and bandwidth limits on each target */
+struct sched_qos_bucket {
+	/* IOPS limit, 0 means unlimited */
+	uint32_t	qb_iops;
+	/* Bandwidth limit in MB/s, 0 means unlimited */
+	uint32_t	qb_bw;
+	int64_t		qb_iops_tokens;
+	int64_t		qb_bw_tokens;
+	/* Fraction of a token accrued by past refills, in 1/1000 token */
+	uint32_t	qb_iops_frac;
+	uint32_t	qb_bw_frac;
+	/* When the buckets were refilled, in msecs */
+	uint64_t	qb_refill_ts;
+};
+
+/* A backlogged pool in weighted fair queuing */
+struct sched_qos_flow {
+	/* Link to the list of backlogged flows */
+	d_list_t	qf_link;
+	/* Virtual finish time */
+	uint64_t	qf_vtime;
+	/* Nothing can be kicked off from this flow in current cycle */
+	unsigned int	qf_blocked:1;
+};
+
+static inline unsigned int
+sched_qos_class(unsigned int req_type, unsigned int req_flags)
+{
+	/* Priority inheritance for IO issued by rebuild or DTX resync */
+	if (req_flags & (SCHED_REQ_FL_NO_DELAY | SCHED_REQ_FL_INHERIT))
+		return SCHED_QOS_URGENT;
+
+	return req_type == SCHED_REQ_FETCH ? SCHED_QOS_LATENCY : SCHED_QOS_BATCH;
+}
+
+/* Weighted fair queuing cost of a request, \a weight is the weight of request type */
+static inline uint64_t
+sched_qos_cost(unsigned int weight, uint64_t size)
+{
+	return weight + (size >> SCHED_QOS_COST_SHIFT);
+}
+
+static inline void
+sched_qos_bucket_init(struct sched_qos_bucket *qb, uint32_t iops, uint32_t bw, uint64_t now)
+{
+	qb->qb_iops = iops;
+	qb->qb_bw = bw;
+	qb->qb_iops_tokens = iops;
+	qb->qb_bw_tokens = (int64_t)bw << SCHED_QOS_BW_SHIFT;
+	qb->qb_iops_frac = 0;
+	qb->qb_bw_frac = 0;
+	qb->qb_refill_ts = now;
+}
+
+static inline void
+sched_qos_bucket_refill(struct sched_qos_bucket *qb, uint64_t now)
+{
+	uint64_t	elapsed, acc, bw;
+
+	D_ASSERT(now >= qb->qb_refill_ts);
+	elapsed = now - qb->qb_refill_ts;
+	if (elapsed == 0)
+		return;
+
+	/*
+	 * Refill runs every scheduling cycle, keep the fraction of a token for next refill,
+	 * otherwise the limit can't be reached with short cycles. At most one second worth
+	 * of tokens can be accumulated.
+	 */
+	if (qb->qb_iops != 0) {
+		acc = elapsed * qb->qb_iops + qb->qb_iops_frac;
+		qb->qb_iops_tokens += acc / 1000;
+		qb->qb_iops_frac = acc % 1000;
+		if (qb->qb_iops_tokens >= qb->qb_iops) {
+			qb->qb_iops_tokens = qb->qb_iops;
+			qb->qb_iops_frac = 0;
+		}
+	}
+
+	if (qb->qb_bw != 0) {
+		bw = (uint64_t)qb->qb_bw << SCHED_QOS_BW_SHIFT;
+		acc = elapsed * bw + qb->qb_bw_frac;
+		qb->qb_bw_tokens += acc / 1000;
+		qb->qb_bw_frac = acc % 1000;
+		if (qb->qb_bw_tokens >= (int64_t)bw) {
+			qb->qb_bw_tokens = bw;
+			qb->qb_bw_frac = 0;
+		}
+	}
+	qb->qb_refill_ts = now;
+}
+
+static inline bool
+sched_qos_bucket_ready(struct sched_qos_bucket *qb)
+{
+	if (qb->qb_iops != 0 && qb->qb_iops_tokens <= 0)
+		return false;
+	if (qb->qb_bw != 0 && qb->qb_bw_tokens <= 0)
+		return false;
+	return true;
+}
+
+/* Bandwidth tokens could go negative, the debt is paid by following refills */
+static inline void
+sched_qos_bucket_charge(struct sched_qos_bucket *qb, uint64_t size)
+{
+	if (qb->qb_iops != 0)
+		qb->qb_iops_tokens--;
+	if (qb->qb_bw != 0)
+		qb->qb_bw_tokens -= size;
+}
+
+/* The flow just becomes backlogged, don't give it credit for the idle time */
+static inline void
+sched_qos_flow_start(struct sched_qos_flow *qf, d_list_t *flows, uint64_t sys_vtime)
+{
+	if (qf->qf_vtime < sys_vtime)
+		qf->qf_vtime = sys_vtime;
+	d_list_add_tail(&qf->qf_link, flows);
+}
+
+/* A request of \a cost is served from the flow, returns the new system virtual time */
+static inline uint64_t
+sched_qos_flow_charge(struct sched_qos_flow *qf, uint64_t cost)
+{
+	uint64_t	sys_vtime = qf->qf_vtime;
+
+	qf->qf_vtime += cost;
+	return sys_vtime;
+}
+
+/* Pick the backlogged and not blocked flow with the smallest virtual time */
+static inline struct sched_qos_flow *
+sched_qos_flow_pick(d_list_t *flows)
+{
+	struct sched_qos_flow	*qf, *pick = NULL;
+
+	d_list_for_each_entry(qf, flows, qf_link) {
+		if (qf->qf_blocked)
+			continue;
+		if (pick == NULL || qf->qf_vtime < pick->qf_vtime)
+			pick = qf;
+	}
+
+	return pick;
+}
+
+#endif /* __DAOS_SCHED_QOS_H__ */
@@ -527,7 +527,13 @@ dss_srv_handler(void *arg)
 	/* main service progress loop */
 	for (;;) {
 		if (dx->dx_comm) {
-			rc = crt_progress(dmi->dmi_ctx, dx->dx_timeout);
+			unsigned int	timeout = dx->dx_timeout;
+			uint64_t	relax_start = 0;
+
+			if (timeout > 0)
+				relax_start = daos_getutime();
+
+			rc = crt_progress(dmi->dmi_ctx, timeout);
 			if (rc != 0 && rc != -DER_TIMEDOUT) {
 				D_ERROR("failed to progress CART context: %d\n",
 					rc);
@@ -535,6 +541,9 @@ dss_srv_handler(void *arg)
 				 * temporary, Let's keep progressing for now.
 				 */
 			}
+
+			if (relax_start != 0)
+				sched_relax_done(dx, relax_start, timeout);
 		}
 
 		if (dss_xstream_exiting(dx))
@@ -574,6 +583,24 @@ signal:
 	}
 }
 
+/* The first NUMA node covered by the cpuset */
+static int
+dss_cpuset2numa(hwloc_cpuset_t cpus)
+{
+	hwloc_nodeset_t	nodeset;
+	int		node;
+
+	nodeset = hwloc_bitmap_alloc();
+	if (nodeset == NULL)
+		return -1;
+
+	hwloc_cpuset_to_nodeset(dss_topo, cpus, nodeset);
+	node = hwloc_bitmap_first(nodeset);
+	hwloc_bitmap_free(nodeset);
+
+	return node;
+}
+
 static inline struct dss_xstream *
 dss_xstream_alloc(hwloc_cpuset_t cpus)
 {
@@ -616,6 +643,15 @@ dss_xstream_alloc(hwloc_cpuset_t cpus)
 		D_ERROR("failed to allocate cpuset\n");
 		D_GOTO(err_future, rc = -DER_NOMEM);
 	}
+	dx->dx_numa_id = dss_cpuset2numa(cpus);
+
+	rc = D_SPIN_INIT(&dx->dx_offload.doq_lock, PTHREAD_PROCESS_PRIVATE);
+	if (rc != 0) {
+		D_ERROR("failed to init offload queue lock\n");
+		hwloc_bitmap_free(dx->dx_cpuset);
+		D_GOTO(err_future, rc);
+	}
+	D_INIT_LIST_HEAD(&dx->dx_offload.doq_list);
 
 	for (i = 0; i < DSS_POOL_CNT; i++)
 		dx->dx_pools[i] = ABT_POOL_NULL;
@@ -647,6 +683,7 @@ dss_xstream_free(struct dss_xstream *dx)
 		dx->dx_sp = NULL;
 	}
 #endif
+	D_SPIN_DESTROY(&dx->dx_offload.doq_lock);
 	hwloc_bitmap_free(dx->dx_cpuset);
 	D_FREE(dx);
 }
@@ -784,6 +821,7 @@ dss_start_one_xstream(hwloc_cpuset_t cpus, int tag, int xs_id)
 	}
 
 	dss_mem_stats_init(&dx->dx_mem_stats, xs_id);
+	dss_offload_metrics_init(dx);
 
 	/** start XS, ABT rank 0 is reserved for the primary xstream */
 	rc = ABT_xstream_create_with_rank(dx->dx_sched, xs_id + 1,
@@ -825,6 +863,7 @@ dss_start_one_xstream(hwloc_cpuset_t cpus, int tag, int xs_id)
 		goto out_xstream;
 	}
 	xstream_data.xd_xs_ptrs[xs_id] = dx;
+	dss_offload_peers_add(dx);
 	ABT_mutex_unlock(xstream_data.xd_mutex);
 	ABT_thread_attr_free(&attr);
 
@@ -1041,9 +1080,45 @@ dss_xstreams_init(void)
 	D_INFO("CPU relax mode is set to [%s]\n",
 	       sched_relax_mode2str(sched_relax_mode));
 
+	d_getenv_bool("DAOS_SCHED_RELAX_ADAPTIVE", &sched_relax_adaptive);
+	if (sched_relax_adaptive) {
+		d_getenv_int("DAOS_SCHED_RELAX_RATE", &sched_relax_rate);
+		D_INFO("Adaptive CPU relax is enabled, ULT rate threshold %u/s\n",
+		       sched_relax_rate);
+	}
+
 	d_getenv_int("DAOS_SCHED_UNIT_RUNTIME_MAX", &sched_unit_runtime_max);
+
+	env = getenv("DAOS_SCHED_POLICY");
+	if (env) {
+		sched_policy = sched_str2policy(env);
+		if (sched_policy == SCHED_POLICY_MAX) {
+			D_WARN("Invalid sched policy [%s]\n", env);
+			sched_policy = SCHED_POLICY_FIFO;
+		}
+	}
+	D_INFO("Sched policy is set to [%s]\n", sched_policy2str(sched_policy));
+
+	if (sched_policy == SCHED_POLICY_QOS) {
+		d_getenv_int("DAOS_SCHED_QOS_POOL_IOPS", &sched_qos_pool_iops);
+		d_getenv_int("DAOS_SCHED_QOS_POOL_BW", &sched_qos_pool_bw);
+		D_INFO("Default per-pool QoS limits: %u IOPS, %u MB/s on each target\n",
+		       sched_qos_pool_iops, sched_qos_pool_bw);
+
+		env = getenv("DAOS_SCHED_QOS_POOL_LIMITS");
+		if (env && sched_qos_limits_parse(env) != 0)
+			D_WARN("Ignore invalid per-pool QoS limits [%s]\n", env);
+	}
 	d_getenv_bool("DAOS_SCHED_WATCHDOG_ALL", &sched_watchdog_all);
 
+	d_getenv_bool("DAOS_OFFLOAD_STEAL", &dss_offload_steal);
+	if (dss_offload_steal && dss_tgt_offload_xs_nr < 2) {
+		D_INFO("Offload stealing needs at least 2 helper XS, disabled.\n");
+		dss_offload_steal = false;
+	} else if (dss_offload_steal) {
+		D_INFO("Offload stealing between helper XS is enabled.\n");
+	}
+
 	/* start the execution streams */
 	D_DEBUG(DB_TRACE,
 		"%d cores total detected starting %d main xstreams\n",
@@ -1160,13 +1235,7 @@ dss_acc_offload(struct dss_acc_task *at_args)
 {
 
 	int		rc = 0;
-	int		tid;
 
-	/**
-	 * Currently just launching it in this stream,
-	 * ideally will move to a separate exclusive xstream
-	 */
-	tid = dss_get_module_info()->dmi_tgt_id;
 	if (at_args == NULL) {
 		D_ERROR("missing arguments for acc_offload\n");
 		return -DER_INVAL;
@@ -1180,12 +1249,10 @@ dss_acc_offload(struct dss_acc_task *at_args)
 
 	switch (at_args->at_offload_type) {
 	case DSS_OFFLOAD_ULT:
-		rc = dss_ult_execute(compute_checksum_ult,
-				at_args->at_params,
-				NULL /* user-cb */,
-				NULL /* user-cb args */,
-				DSS_XS_OFFLOAD, tid,
-				0);
+		rc = dss_offload_submit(compute_checksum_ult,
+					at_args->at_params,
+					NULL /* user-cb */,
+					NULL /* user-cb args */);
 		break;
 	case DSS_OFFLOAD_ACC:
 		/** calls to offload to FPGA*/
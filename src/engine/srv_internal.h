@@ -9,6 +9,7 @@
 #include <daos_srv/daos_engine.h>
 #include <daos/stack_mmap.h>
 #include <gurt/telemetry_common.h>
+#include "sched_qos.h"
 
 /**
  * Argobots ULT pools for different tasks, NET_POLL & NVME_POLL
@@ -32,6 +33,11 @@ struct sched_stats {
 	struct d_tm_node_t	*ss_sq_len;		/* Sleep queue length */
 	struct d_tm_node_t	*ss_cycle_duration;	/* Cycle duration (ms) */
 	struct d_tm_node_t	*ss_cycle_size;		/* Total ULTs in a cycle */
+	struct d_tm_node_t	*ss_qos_delay[SCHED_QOS_MAX]; /* Per class queueing delay (ms) */
+	struct d_tm_node_t	*ss_relax_cnt;		/* Relax periods */
+	struct d_tm_node_t	*ss_relax_wakeup;	/* Woken up to first ULT run (us) */
+	uint64_t		 ss_relax_rem;		/* Relaxing time not accounted (us) */
+	uint64_t		 ss_wakeup_ts;		/* Woken up from relaxing (us) */
 	uint64_t		 ss_busy_ts;		/* Last busy timestamp (ms) */
 	uint64_t		 ss_watchdog_ts;	/* Last watchdog print ts (ms) */
 	void			*ss_last_unit;		/* Last executed unit */
@@ -47,6 +53,15 @@ struct sched_info {
 	d_list_t		 si_sleep_list;	/* All sleeping requests */
 	d_list_t		 si_fifo_list;	/* All IO requests in FIFO */
 	d_list_t		 si_purge_list;	/* Stale sched_pool_info */
+	d_list_t		 si_qos_list;	/* sched_pool_info with queued QoS IO */
+	uint64_t		 si_qos_vtime;	/* Virtual time of QoS fair queuing */
+	uint64_t		 si_rate_ts;	/* Start of current ULT rate window (ms) */
+	uint32_t		 si_rate_ults;	/* ULTs executed in current rate window */
+	uint32_t		 si_rate;	/* Moving average of ULTs per second */
+	unsigned int		 si_relax_intvl; /* Current relax interval (ms) */
+	uint64_t		 si_remote_ts;	/* Last ULT creation seen from other xstream (ms) */
+	uint32_t		 si_remote_seen; /* si_remote_cnt when si_remote_ts is updated */
+	ATOMIC uint32_t		 si_remote_cnt;	/* ULTs created by other xstreams */
 	struct d_hash_table	*si_pool_hash;	/* All sched_pool_info */
 	uint32_t		 si_req_cnt;	/* Total inuse request count */
 	int			 si_sleep_cnt;	/* Sleeping request count */
@@ -60,6 +75,23 @@ struct mem_stats {
 	uint64_t		ms_current;
 };
 
+/* Max number of helper XS on the same NUMA node that could be stolen from */
+#define DSS_OFFLOAD_PEERS_MAX	64
+
+/* Offloaded tasks not started yet, they can be stolen by idle helper XS */
+struct dss_offload_queue {
+	pthread_spinlock_t	 doq_lock;
+	d_list_t		 doq_list;
+	uint32_t		 doq_cnt;
+	/* Helper XS on the same NUMA node, published by dss_offload_peers_add() */
+	ATOMIC uint32_t		 doq_peer_nr;
+	struct dss_xstream	*doq_peers[DSS_OFFLOAD_PEERS_MAX];
+	struct d_tm_node_t	*doq_depth;	/* Queued offload tasks */
+	struct d_tm_node_t	*doq_exec;	/* Executed offload tasks */
+	struct d_tm_node_t	*doq_steal;	/* Tasks stolen from other helper XS */
+	struct d_tm_node_t	*doq_busy_time;	/* Time spent on offload tasks (us) */
+};
+
 /** Per-xstream configuration data */
 struct dss_xstream {
 	char			dx_name[DSS_XS_NAME_LEN];
@@ -93,6 +125,9 @@ struct dss_xstream {
 #endif
 	bool			dx_progress_started;	/* Network poll started */
 	int                     dx_tag;                 /** tag for xstream */
+	/* NUMA node of the bound cpuset, -1 if unknown */
+	int			dx_numa_id;
+	struct dss_offload_queue dx_offload;
 };
 
 /** Engine module's metrics */
@@ -165,9 +200,16 @@ void dss_mem_total_free_track(void *arg, daos_size_t bytes);
 int dss_engine_metrics_init(void);
 int dss_engine_metrics_fini(void);
 
+/* ult.c */
+extern bool dss_offload_steal;
+void dss_offload_metrics_init(struct dss_xstream *dx);
+void dss_offload_peers_add(struct dss_xstream *dx);
+bool dss_offload_steal_one(struct dss_xstream *dx);
+
 /* sched.c */
 #define SCHED_RELAX_INTVL_MAX		100 /* msec */
 #define SCHED_RELAX_INTVL_DEFAULT	1 /* msec */
+#define SCHED_RELAX_RATE_DEFAULT	100 /* ULTs per second */
 
 enum sched_cpu_relax_mode {
 	SCHED_RELAX_MODE_NET		= 0,
@@ -204,13 +246,66 @@ sched_relax_str2mode(char *str)
 		return SCHED_RELAX_MODE_INVALID;
 }
 
+enum sched_policy_id {
+	/* All requests for various pools are processed in FIFO */
+	SCHED_POLICY_FIFO	= 0,
+	/*
+	 * All requests are processed in RR based on certain ID (Client ID,
+	 * Pool ID, Container ID, JobID, UID, etc.)
+	 */
+	SCHED_POLICY_ID_RR,
+	/*
+	 * Request priority is based on certain ID (Client ID, Pool ID,
+	 * Container ID, JobID, UID, etc.)
+	 */
+	SCHED_POLICY_ID_PRIO,
+	/*
+	 * Weighted fair queuing across pools, earliest deadline first across
+	 * QoS classes within a pool, with optional per-pool IOPS/BW limits.
+	 */
+	SCHED_POLICY_QOS,
+	SCHED_POLICY_MAX
+};
+
+static inline char *
+sched_policy2str(enum sched_policy_id policy)
+{
+	switch (policy) {
+	case SCHED_POLICY_FIFO:
+		return "fifo";
+	case SCHED_POLICY_QOS:
+		return "qos";
+	default:
+		return "invalid";
+	}
+}
+
+/* Only the implemented policies can be selected */
+static inline enum sched_policy_id
+sched_str2policy(char *str)
+{
+	if (strcasecmp(str, "fifo") == 0)
+		return SCHED_POLICY_FIFO;
+	else if (strcasecmp(str, "qos") == 0)
+		return SCHED_POLICY_QOS;
+	else
+		return SCHED_POLICY_MAX;
+}
+
 extern bool sched_prio_disabled;
 extern unsigned int sched_stats_intvl;
 extern unsigned int sched_relax_intvl;
 extern unsigned int sched_relax_mode;
+extern bool sched_relax_adaptive;
+extern unsigned int sched_relax_rate;
 extern unsigned int sched_unit_runtime_max;
+extern unsigned int sched_policy;
+extern unsigned int sched_qos_pool_iops;
+extern unsigned int sched_qos_pool_bw;
+int sched_qos_limits_parse(char *str);
 extern bool sched_watchdog_all;
 
+void sched_relax_done(struct dss_xstream *dx, uint64_t start, unsigned int timeout);
 void dss_sched_fini(struct dss_xstream *dx);
 int dss_sched_init(struct dss_xstream *dx);
 int sched_req_enqueue(struct dss_xstream *dx, struct sched_req_attr *attr,
@@ -235,6 +330,20 @@ sched_xstream_stopping(void)
 	return state == ABT_TRUE;
 }
 
+/*
+ * ULT created by other xstream (or main thread) can't wake up a relaxing xstream, count it
+ * so that the adaptive relax won't back off on the xstream receiving cross-xstream work.
+ */
+static inline void
+sched_remote_create(struct dss_xstream *dx)
+{
+	if (!sched_relax_adaptive)
+		return;
+
+	if (dss_tls_get() == NULL || dss_current_xstream() != dx)
+		atomic_fetch_add_relaxed(&dx->dx_sched_info.si_remote_cnt, 1);
+}
+
 static inline int
 sched_create_task(struct dss_xstream *dx, void (*func)(void *), void *arg,
 		  ABT_task *task, unsigned int flags)
@@ -251,6 +360,7 @@ sched_create_task(struct dss_xstream *dx, void (*func)(void *), void *arg,
 		/* Atomic integer assignment from different xstream */
 		info->si_stats.ss_busy_ts = info->si_cur_ts;
 
+	sched_remote_create(dx);
 	rc = ABT_task_create(abt_pool, func, arg, task);
 	return dss_abterr2der(rc);
 }
@@ -301,6 +411,7 @@ sched_create_thread(struct dss_xstream *dx, void (*func)(void *), void *arg,
 		/* Atomic integer assignment from different xstream */
 		info->si_stats.ss_busy_ts = info->si_cur_ts;
 
+	sched_remote_create(dx);
 	rc = daos_abt_thread_create(cur_dx->dx_sp, dss_free_stack_cb, abt_pool, func, arg, t_attr, thread);
 	return dss_abterr2der(rc);
 }
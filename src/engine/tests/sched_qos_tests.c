@@ -0,0 +1,270 @@
+/*
+ * (C) Copyright 2023 Intel Corporation.
+ *
+ * SPDX-License-Identifier: BSD-2-Clause-Patent
+ */
+
+/*
+ * Unit tests for the QoS scheduler policy building blocks
+ */
+
+#include <stdarg.h>
+#include <stddef.h>
+#include <setjmp.h>
+#include <cmocka.h>
+#include "../sched_qos.h"
+
+static void
+test_sched_qos_class(void **state)
+{
+	assert_int_equal(sched_qos_class(SCHED_REQ_FETCH, 0), SCHED_QOS_LATENCY);
+	assert_int_equal(sched_qos_class(SCHED_REQ_UPDATE, 0), SCHED_QOS_BATCH);
+
+	/* No delay and inherited requests bypass the fair queuing */
+	assert_int_equal(sched_qos_class(SCHED_REQ_FETCH, SCHED_REQ_FL_NO_DELAY),
+			 SCHED_QOS_URGENT);
+	assert_int_equal(sched_qos_class(SCHED_REQ_UPDATE, SCHED_REQ_FL_INHERIT),
+			 SCHED_QOS_URGENT);
+	assert_int_equal(sched_qos_class(SCHED_REQ_UPDATE, SCHED_REQ_FL_PERIODIC),
+			 SCHED_QOS_BATCH);
+
+	/* Every 64KB of data costs one more weight */
+	assert_int_equal(sched_qos_cost(10, 0), 10);
+	assert_int_equal(sched_qos_cost(10, (64 << 10) - 1), 10);
+	assert_int_equal(sched_qos_cost(10, 1 << 20), 26);
+}
+
+static void
+test_sched_qos_bucket_unlimited(void **state)
+{
+	struct sched_qos_bucket	qb;
+	int			i;
+
+	sched_qos_bucket_init(&qb, 0, 0, 1000);
+	for (i = 0; i < 1000; i++) {
+		assert_true(sched_qos_bucket_ready(&qb));
+		sched_qos_bucket_charge(&qb, 1 << 20);
+	}
+	sched_qos_bucket_refill(&qb, 2000);
+	assert_true(sched_qos_bucket_ready(&qb));
+}
+
+static void
+test_sched_qos_bucket_iops(void **state)
+{
+	struct sched_qos_bucket	qb;
+	int			i;
+
+	sched_qos_bucket_init(&qb, 100, 0, 1000);
+
+	/* One second worth of requests is allowed in burst */
+	for (i = 0; i < 100; i++) {
+		assert_true(sched_qos_bucket_ready(&qb));
+		sched_qos_bucket_charge(&qb, 4096);
+	}
+	assert_false(sched_qos_bucket_ready(&qb));
+
+	/* 5ms is less than one token, the fraction is kept for next refill */
+	sched_qos_bucket_refill(&qb, 1005);
+	assert_false(sched_qos_bucket_ready(&qb));
+	assert_int_equal(qb.qb_iops_frac, 500);
+
+	sched_qos_bucket_refill(&qb, 1010);
+	assert_true(sched_qos_bucket_ready(&qb));
+	sched_qos_bucket_charge(&qb, 4096);
+	assert_false(sched_qos_bucket_ready(&qb));
+
+	/* Long idle period can't accumulate more than one second worth of tokens */
+	sched_qos_bucket_refill(&qb, 10000);
+	assert_int_equal(qb.qb_iops_tokens, 100);
+}
+
+static void
+test_sched_qos_bucket_bw(void **state)
+{
+	struct sched_qos_bucket	qb;
+
+	/* 2MB/s */
+	sched_qos_bucket_init(&qb, 0, 2, 1000);
+	assert_true(sched_qos_bucket_ready(&qb));
+
+	/* Large request is admitted with tokens left, the debt is paid by refills */
+	sched_qos_bucket_charge(&qb, 3 << 20);
+	assert_false(sched_qos_bucket_ready(&qb));
+
+	sched_qos_bucket_refill(&qb, 1500);
+	assert_false(sched_qos_bucket_ready(&qb));
+	assert_int_equal(qb.qb_bw_tokens, 0);
+
+	sched_qos_bucket_refill(&qb, 1501);
+	assert_true(sched_qos_bucket_ready(&qb));
+
+	sched_qos_bucket_refill(&qb, 60000);
+	assert_int_equal(qb.qb_bw_tokens, 2 << 20);
+}
+
+/* Refill every \a step msecs for one second, returns the number of requests admitted */
+static int
+bucket_serve_steps(struct sched_qos_bucket *qb, uint64_t step)
+{
+	uint64_t	end = qb->qb_refill_ts + 1000;
+	uint64_t	now;
+	int		served = 0;
+
+	for (now = qb->qb_refill_ts + step; now <= end; now += step) {
+		sched_qos_bucket_refill(qb, now);
+		while (sched_qos_bucket_ready(qb)) {
+			sched_qos_bucket_charge(qb, 4096);
+			served++;
+		}
+	}
+
+	return served;
+}
+
+static void
+test_sched_qos_bucket_steps(void **state)
+{
+	struct sched_qos_bucket	qb;
+	int			i;
+
+	/* Refills on every tick of the coarse clock still accrue the whole limit */
+	sched_qos_bucket_init(&qb, 1999, 0, 1000);
+	qb.qb_iops_tokens = 0;
+	assert_int_equal(bucket_serve_steps(&qb, 1), 1999);
+
+	sched_qos_bucket_init(&qb, 300, 0, 1000);
+	qb.qb_iops_tokens = 0;
+	assert_int_equal(bucket_serve_steps(&qb, 4), 300);
+
+	/* 3MB/s isn't a whole number of bytes per msec */
+	sched_qos_bucket_init(&qb, 0, 3, 1000);
+	qb.qb_bw_tokens = 0;
+	for (i = 1; i <= 1000; i++)
+		sched_qos_bucket_refill(&qb, 1000 + i);
+	assert_int_equal(qb.qb_bw_tokens, 3 << 20);
+}
+
+static void
+test_sched_qos_bucket_both(void **state)
+{
+	struct sched_qos_bucket	qb;
+
+	/* Either limit holds the pool */
+	sched_qos_bucket_init(&qb, 1000, 1, 0);
+	sched_qos_bucket_charge(&qb, 1 << 20);
+	assert_false(sched_qos_bucket_ready(&qb));
+	assert_int_equal(qb.qb_iops_tokens, 999);
+
+	sched_qos_bucket_init(&qb, 1, 1000, 0);
+	sched_qos_bucket_charge(&qb, 0);
+	assert_false(sched_qos_bucket_ready(&qb));
+}
+
+#define WFQ_FLOWS	3
+
+/* Serve \a nr requests from always backlogged flows, each flow has a fixed cost */
+static void
+wfq_serve(struct sched_qos_flow *flows, d_list_t *list, uint64_t *sys_vtime,
+	  uint64_t *costs, int *served, int nr)
+{
+	struct sched_qos_flow	*pick;
+	int			 i, idx;
+
+	for (i = 0; i < nr; i++) {
+		pick = sched_qos_flow_pick(list);
+		assert_non_null(pick);
+
+		idx = pick - flows;
+		served[idx]++;
+		*sys_vtime = sched_qos_flow_charge(pick, costs[idx]);
+	}
+}
+
+static void
+test_sched_qos_wfq(void **state)
+{
+	struct sched_qos_flow	flows[WFQ_FLOWS] = { 0 };
+	uint64_t		costs[WFQ_FLOWS] = { 1, 2, 4 };
+	int			served[WFQ_FLOWS] = { 0 };
+	uint64_t		sys_vtime = 0;
+	d_list_t		list;
+	int			i;
+
+	D_INIT_LIST_HEAD(&list);
+	assert_null(sched_qos_flow_pick(&list));
+
+	for (i = 0; i < WFQ_FLOWS; i++)
+		sched_qos_flow_start(&flows[i], &list, sys_vtime);
+
+	/* Service is shared in inverse proportion to the request cost */
+	wfq_serve(flows, &list, &sys_vtime, costs, served, 700);
+	assert_int_equal(served[0], 400);
+	assert_int_equal(served[1], 200);
+	assert_int_equal(served[2], 100);
+
+	/* Blocked flow is skipped in current cycle */
+	flows[0].qf_blocked = 1;
+	memset(served, 0, sizeof(served));
+	wfq_serve(flows, &list, &sys_vtime, costs, served, 30);
+	assert_int_equal(served[0], 0);
+	assert_int_equal(served[1], 20);
+	assert_int_equal(served[2], 10);
+	flows[0].qf_blocked = 0;
+
+	/* The flow skipped before catches up then */
+	memset(served, 0, sizeof(served));
+	wfq_serve(flows, &list, &sys_vtime, costs, served, 40);
+	assert_int_equal(served[0], 40);
+}
+
+static void
+test_sched_qos_wfq_idle(void **state)
+{
+	struct sched_qos_flow	flows[WFQ_FLOWS] = { 0 };
+	uint64_t		costs[WFQ_FLOWS] = { 1, 1, 1 };
+	int			served[WFQ_FLOWS] = { 0 };
+	uint64_t		sys_vtime = 0;
+	d_list_t		list;
+
+	D_INIT_LIST_HEAD(&list);
+	sched_qos_flow_start(&flows[0], &list, sys_vtime);
+	sched_qos_flow_start(&flows[1], &list, sys_vtime);
+	wfq_serve(flows, &list, &sys_vtime, costs, served, 1000);
+	assert_int_equal(served[0], 500);
+	assert_int_equal(served[1], 500);
+
+	/* Flow becomes backlogged after idle, it gets no credit for the idle period */
+	sched_qos_flow_start(&flows[2], &list, sys_vtime);
+	assert_true(flows[2].qf_vtime >= flows[0].qf_vtime - costs[0]);
+
+	memset(served, 0, sizeof(served));
+	wfq_serve(flows, &list, &sys_vtime, costs, served, 300);
+	assert_int_equal(served[0], 100);
+	assert_int_equal(served[1], 100);
+	assert_int_equal(served[2], 100);
+
+	/* Flow without backlog leaves the list */
+	d_list_del_init(&flows[1].qf_link);
+	memset(served, 0, sizeof(served));
+	wfq_serve(flows, &list, &sys_vtime, costs, served, 100);
+	assert_int_equal(served[1], 0);
+	assert_int_equal(served[0] + served[2], 100);
+}
+
+int
+main(void)
+{
+	const struct CMUnitTest tests[] = {
+		cmocka_unit_test(test_sched_qos_class),
+		cmocka_unit_test(test_sched_qos_bucket_unlimited),
+		cmocka_unit_test(test_sched_qos_bucket_iops),
+		cmocka_unit_test(test_sched_qos_bucket_bw),
+		cmocka_unit_test(test_sched_qos_bucket_steps),
+		cmocka_unit_test(test_sched_qos_bucket_both),
+		cmocka_unit_test(test_sched_qos_wfq),
+		cmocka_unit_test(test_sched_qos_wfq_idle),
+	};
+
+	return cmocka_run_group_tests_name("engine_sched_qos", tests, NULL, NULL);
+}
@@ -9,6 +9,7 @@
 #include <abt.h>
 #include <daos/common.h>
 #include <daos_errno.h>
+#include <gurt/telemetry_producer.h>
 #include "srv_internal.h"
 
 /* ============== Thread collective functions ============================ */
@@ -34,6 +35,8 @@ struct dss_future_arg {
 	void		*dfa_comp_arg;
 	int		dfa_status;
 	bool		dfa_async;
+	/** Link to 'dss_offload_queue::doq_list' */
+	d_list_t	dfa_link;
 };
 
 struct collective_arg {
@@ -507,9 +510,9 @@ ult_execute_cb(void *data)
  * \param[in]	stack_size	stacksize of the ULT, if it is 0, then create
  *				default size of ULT.
  */
-int
-dss_ult_execute(int (*func)(void *), void *arg, void (*user_cb)(void *),
-		void *cb_args, int xs_type, int tgt_id, size_t stack_size)
+static int
+future_arg_create(int (*func)(void *), void *arg, void (*user_cb)(void *),
+		  void *cb_args, struct dss_future_arg **future_arg_p)
 {
 	struct dss_future_arg	*future_arg;
 	ABT_future		future;
@@ -522,6 +525,7 @@ dss_ult_execute(int (*func)(void *), void *arg, void (*user_cb)(void *),
 	future_arg->dfa_func = func;
 	future_arg->dfa_arg = arg;
 	future_arg->dfa_status = 0;
+	D_INIT_LIST_HEAD(&future_arg->dfa_link);
 
 	if (user_cb == NULL) {
 		rc = ABT_future_create(1, NULL, &future);
@@ -538,18 +542,21 @@ dss_ult_execute(int (*func)(void *), void *arg, void (*user_cb)(void *),
 		future_arg->dfa_async	= true;
 	}
 
-	rc = dss_ult_create(ult_execute_cb, future_arg, xs_type, tgt_id,
-			    stack_size, NULL);
-	if (rc)
-		D_GOTO(free, rc);
+	*future_arg_p = future_arg;
+	return 0;
+}
 
-	if (!future_arg->dfa_async) {
-		ABT_future_wait(future);
+/* Wait for the execution in sync mode, \a rc is the execution submitting result */
+static int
+future_arg_wait(struct dss_future_arg *future_arg, int rc)
+{
+	if (rc == 0 && !future_arg->dfa_async) {
+		ABT_future_wait(future_arg->dfa_future);
 		rc = future_arg->dfa_status;
 	}
-free:
+
 	if (!future_arg->dfa_async) {
-		ABT_future_free(&future);
+		ABT_future_free(&future_arg->dfa_future);
 		D_FREE(future_arg);
 	} else if (rc) {
 		D_FREE(future_arg);
@@ -557,6 +564,23 @@ free:
 	return rc;
 }
 
+int
+dss_ult_execute(int (*func)(void *), void *arg, void (*user_cb)(void *),
+		void *cb_args, int xs_type, int tgt_id, size_t stack_size)
+{
+	struct dss_future_arg	*future_arg;
+	int			rc;
+
+	rc = future_arg_create(func, arg, user_cb, cb_args, &future_arg);
+	if (rc)
+		return rc;
+
+	rc = dss_ult_create(ult_execute_cb, future_arg, xs_type, tgt_id,
+			    stack_size, NULL);
+
+	return future_arg_wait(future_arg, rc);
+}
+
 /**
  * Create an ULT on each server xstream to execute a \a func(\a arg)
  *
@@ -589,6 +613,262 @@ dss_ult_create_all(void (*func)(void *), void *arg, bool main)
 	return rc;
 }
 
+/* ============== Offload with work stealing ============================= */
+
+/* Offloaded tasks could be stolen by idle helper XS on the same NUMA node */
+bool	dss_offload_steal;
+
+/* How many random victims are probed by an idle helper XS in each attempt */
+#define OFFLOAD_STEAL_PROBES	4
+
+static inline bool
+offload_xs_stealable(struct dss_xstream *dx)
+{
+	return dx != NULL && !dx->dx_main_xs && dx->dx_xs_id >= dss_sys_xs_nr;
+}
+
+void
+dss_offload_metrics_init(struct dss_xstream *dx)
+{
+	struct dss_offload_queue	*doq = &dx->dx_offload;
+	int				 rc;
+
+	if (!dss_offload_steal || !offload_xs_stealable(dx))
+		return;
+
+	rc = d_tm_add_metric(&doq->doq_depth, D_TM_GAUGE, "Queued offload tasks", "task",
+			     "sched/offload/queue/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create offload queue telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&doq->doq_exec, D_TM_COUNTER, "Executed offload tasks", "task",
+			     "sched/offload/exec/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create offload exec telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&doq->doq_steal, D_TM_COUNTER, "Offload tasks stolen from others",
+			     "task", "sched/offload/steal/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create offload steal telemetry: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&doq->doq_busy_time, D_TM_COUNTER, "Time spent on offload tasks",
+			     "us", "sched/offload/busy_time/xs_%u", dx->dx_xs_id);
+	if (rc)
+		D_WARN("Failed to create offload busy_time telemetry: "DF_RC"\n", DP_RC(rc));
+}
+
+static void
+offload_enqueue(struct dss_xstream *dx, struct dss_future_arg *future_arg, bool head)
+{
+	struct dss_offload_queue	*doq = &dx->dx_offload;
+
+	D_SPIN_LOCK(&doq->doq_lock);
+	if (head)
+		d_list_add(&future_arg->dfa_link, &doq->doq_list);
+	else
+		d_list_add_tail(&future_arg->dfa_link, &doq->doq_list);
+	doq->doq_cnt++;
+	D_SPIN_UNLOCK(&doq->doq_lock);
+
+	d_tm_inc_gauge(doq->doq_depth, 1);
+}
+
+/* Dequeue the oldest task, or the specified one when \a future_arg isn't NULL */
+static struct dss_future_arg *
+offload_dequeue(struct dss_xstream *dx, struct dss_future_arg *future_arg)
+{
+	struct dss_offload_queue	*doq = &dx->dx_offload;
+
+	D_SPIN_LOCK(&doq->doq_lock);
+	if (future_arg == NULL && !d_list_empty(&doq->doq_list))
+		future_arg = d_list_entry(doq->doq_list.next, struct dss_future_arg, dfa_link);
+
+	/* Already dequeued by the home helper XS or stolen by others */
+	if (future_arg != NULL && d_list_empty(&future_arg->dfa_link))
+		future_arg = NULL;
+
+	if (future_arg != NULL) {
+		d_list_del_init(&future_arg->dfa_link);
+		D_ASSERT(doq->doq_cnt > 0);
+		doq->doq_cnt--;
+	}
+	D_SPIN_UNLOCK(&doq->doq_lock);
+
+	if (future_arg != NULL)
+		d_tm_dec_gauge(doq->doq_depth, 1);
+
+	return future_arg;
+}
+
+static void
+offload_execute(struct dss_future_arg *future_arg)
+{
+	struct dss_offload_queue	*doq = &dss_current_xstream()->dx_offload;
+	uint64_t			 start = daos_getutime();
+
+	/* 'future_arg' is freed by ult_execute_cb() in async mode */
+	ult_execute_cb(future_arg);
+
+	d_tm_inc_counter(doq->doq_exec, 1);
+	d_tm_inc_counter(doq->doq_busy_time, daos_getutime() - start);
+}
+
+/* Runs on the home helper XS, the task could have been stolen by others */
+static void
+offload_run_ult(void *data)
+{
+	struct dss_future_arg	*future_arg;
+
+	future_arg = offload_dequeue(dss_current_xstream(), NULL);
+	if (future_arg != NULL)
+		offload_execute(future_arg);
+}
+
+static void
+offload_steal_ult(void *data)
+{
+	offload_execute(data);
+}
+
+static void
+offload_peer_add(struct dss_xstream *dx, struct dss_xstream *peer)
+{
+	struct dss_offload_queue	*doq = &dx->dx_offload;
+	uint32_t			 nr = atomic_load_relaxed(&doq->doq_peer_nr);
+
+	if (nr >= DSS_OFFLOAD_PEERS_MAX)
+		return;
+
+	/* The slot must be visible before the count, \a dx could be stealing already */
+	doq->doq_peers[nr] = peer;
+	atomic_store_release(&doq->doq_peer_nr, nr + 1);
+}
+
+/**
+ * Called once the helper XS \a dx is started, make it and the started helper XS on the
+ * same NUMA node stealable from each other. Main XS and system XS are never victims.
+ * Caller holds xstream_data.xd_mutex, so only one XS is added at a time.
+ *
+ * \param[in] dx	The newly started xstream
+ */
+void
+dss_offload_peers_add(struct dss_xstream *dx)
+{
+	struct dss_xstream	*peer;
+	int			 i;
+
+	if (!dss_offload_steal || !offload_xs_stealable(dx))
+		return;
+
+	for (i = dss_sys_xs_nr; i < dss_xstream_cnt(); i++) {
+		peer = dss_get_xstream(i);
+		if (peer == dx || !offload_xs_stealable(peer) ||
+		    peer->dx_numa_id != dx->dx_numa_id)
+			continue;
+
+		offload_peer_add(dx, peer);
+		offload_peer_add(peer, dx);
+	}
+}
+
+/**
+ * Called by the scheduler of an idle helper XS, steal the oldest queued task from a random
+ * helper XS on the same NUMA node, and run it in a new ULT.
+ *
+ * \param[in] dx	Current xstream
+ *
+ * \return		true if a task is stolen
+ */
+bool
+dss_offload_steal_one(struct dss_xstream *dx)
+{
+	struct dss_offload_queue	*doq = &dx->dx_offload;
+	struct dss_future_arg		*future_arg = NULL;
+	struct dss_xstream		*victim = NULL;
+	uint32_t			 i, start, peer_nr;
+	int				 rc;
+
+	if (!dss_offload_steal || !offload_xs_stealable(dx))
+		return false;
+
+	peer_nr = atomic_load_explicit(&doq->doq_peer_nr, memory_order_acquire);
+	if (peer_nr == 0)
+		return false;
+
+	/* Probe distinct peers starting from a random one */
+	start = rand() % peer_nr;
+	for (i = 0; i < min(OFFLOAD_STEAL_PROBES, peer_nr) && future_arg == NULL; i++) {
+		victim = doq->doq_peers[(start + i) % peer_nr];
+
+		/* Racy check, avoid taking the lock of idle helper XS */
+		if (victim->dx_offload.doq_cnt == 0)
+			continue;
+
+		future_arg = offload_dequeue(victim, NULL);
+	}
+
+	if (future_arg == NULL)
+		return false;
+
+	rc = sched_create_thread(dx, offload_steal_ult, future_arg, ABT_THREAD_ATTR_NULL, NULL,
+				 0);
+	if (rc) {
+		/* Give it back, the victim has to run it by itself */
+		D_ERROR("Failed to create ULT for stolen task: "DF_RC"\n", DP_RC(rc));
+		offload_enqueue(victim, future_arg, true);
+		rc = sched_create_thread(victim, offload_run_ult, NULL, ABT_THREAD_ATTR_NULL,
+					 NULL, 0);
+		if (rc)
+			D_ERROR("Failed to create ULT for offload task: "DF_RC"\n", DP_RC(rc));
+		return false;
+	}
+
+	d_tm_inc_counter(dx->dx_offload.doq_steal, 1);
+	return true;
+}
+
+/**
+ * Offload a function to helper XS, the task is queued on the helper XS selected for
+ * current target, and it could be stolen by other idle helper XS on the same NUMA node
+ * when DAOS_OFFLOAD_STEAL is enabled. Sync or async mode is the same as dss_ult_execute().
+ *
+ * \param[in]	func		function to execute
+ * \param[in]	arg		argument for \a func
+ * \param[in]	user_cb		user call back (async mode if not NULL)
+ * \param[in]	cb_args		argument for \a user_cb
+ */
+int
+dss_offload_submit(int (*func)(void *), void *arg, void (*user_cb)(void *), void *cb_args)
+{
+	struct dss_module_info	*info = dss_get_module_info();
+	struct dss_future_arg	*future_arg;
+	struct dss_xstream	*dx;
+	int			 rc;
+
+	D_ASSERT(info != NULL);
+	if (!dss_offload_steal)
+		goto no_steal;
+
+	dx = dss_get_xstream(sched_ult2xs(DSS_XS_OFFLOAD, info->dmi_tgt_id));
+	/* No helper XS, the task is offloaded to neighbor main XS */
+	if (!offload_xs_stealable(dx))
+		goto no_steal;
+
+	rc = future_arg_create(func, arg, user_cb, cb_args, &future_arg);
+	if (rc)
+		return rc;
+
+	offload_enqueue(dx, future_arg, false);
+	rc = sched_create_thread(dx, offload_run_ult, NULL, ABT_THREAD_ATTR_NULL, NULL, 0);
+	/* It's fine if the task has been stolen */
+	if (rc != 0 && offload_dequeue(dx, future_arg) == NULL)
+		rc = 0;
+
+	return future_arg_wait(future_arg, rc);
+no_steal:
+	return dss_ult_execute(func, arg, user_cb, cb_args, DSS_XS_OFFLOAD, info->dmi_tgt_id, 0);
+}
+
 int
 dss_offload_exec(int (*func)(void *), void *arg)
 {
@@ -597,7 +877,7 @@ dss_offload_exec(int (*func)(void *), void *arg)
 	D_ASSERT(info != NULL);
 	D_ASSERT(info->dmi_xstream->dx_main_xs);
 
-	return dss_ult_execute(func, arg, NULL, NULL, DSS_XS_OFFLOAD, info->dmi_tgt_id, 0);
+	return dss_offload_submit(func, arg, NULL, NULL);
 }
 
 int
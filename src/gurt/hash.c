@@ -9,6 +9,7 @@
 #define D_LOGFAC	DD_FAC(mem)
 
 #include <pthread.h>
+#include <sched.h>
 #include <gurt/common.h>
 #include <gurt/list.h>
 #include <gurt/hash.h>
@@ -429,6 +430,623 @@ ch_rec_find(struct d_hash_table *htable, struct d_hash_bucket *bucket,
 	return NULL;
 }
 
+/******************************************************************************
+ * Lock-free hash table (D_HASH_FT_LOCKFREE)
+ *
+ * Open addressing with linear probing over cache line sized groups, each slot
+ * has an 8-bit fingerprint of the key hash to avoid calling hop_key_cmp() on
+ * unrelated records. A slot is never reset to empty once used, deleted slots
+ * become tombstones which can be reused by insertion, so lookup can stop at
+ * the first empty slot.
+ *
+ * Lookup & traverse are lock-free, insert & delete are serialized by the
+ * spinlock of the home group of the key. A slot is claimed by a placeholder
+ * first, the record is published after its fingerprint, so a reader seeing
+ * the record always sees the right fingerprint.
+ *
+ * Memory reclamation is epoch based: readers are counted in per-phase striped
+ * counters, a grace period flips the phase and waits for the readers of the
+ * old phase. Deleted records are queued on the retire list of the deleting
+ * thread's stripe, and the table's refcount of a whole batch is dropped after
+ * one grace period, so a reader never touches a freed record. Tables without
+ * refcount callbacks wait for the grace period on each deletion instead, as
+ * the caller may free the record as soon as it's deleted.
+ *
+ * Tombstones make probing longer, once there are too many of them, all the
+ * writers are blocked to turn the tombstones at the end of probing sequences
+ * back into empty slots.
+ ******************************************************************************/
+
+#define LF_GROUP_SLOTS		7
+#define LF_READER_STRIPES	16
+#define LF_RETIRE_BATCH		32
+#define LF_TOMBSTONE		((d_list_t *)1UL)
+/* Slot claimed by an insertion which hasn't published the record yet */
+#define LF_CLAIMED		((d_list_t *)2UL)
+
+static inline bool
+lf_link_valid(d_list_t *link)
+{
+	return link != LF_TOMBSTONE && link != LF_CLAIMED;
+}
+
+struct lf_group {
+	ATOMIC uint8_t		 lg_tags[LF_GROUP_SLOTS];
+	uint8_t			 lg_pad;
+	d_list_t *ATOMIC	 lg_links[LF_GROUP_SLOTS];
+} __attribute__((aligned(64)));
+
+struct lf_reader {
+	ATOMIC uint32_t		 lr_cnt[2];
+} __attribute__((aligned(64)));
+
+/* Deleted records waiting for a grace period to drop the table's refcount */
+struct lf_retire {
+	pthread_spinlock_t	 lt_lock;
+	uint32_t		 lt_nr;
+	d_list_t		*lt_links[LF_RETIRE_BATCH];
+} __attribute__((aligned(64)));
+
+struct d_hash_lf {
+	struct lf_reader	 lf_readers[LF_READER_STRIPES];
+	struct lf_retire	 lf_retires[LF_READER_STRIPES];
+	struct lf_group		*lf_groups;
+	/* Writer lock of each home group */
+	union d_hash_lock	*lf_locks;
+	/* Serialize grace period waiting and anonymous key generating */
+	pthread_mutex_t		 lf_mutex;
+	uint32_t		 lf_mask;
+	ATOMIC uint32_t		 lf_phase;
+	/* Number of tombstones, and if there is a compaction in progress */
+	ATOMIC uint32_t		 lf_tombs;
+	ATOMIC bool		 lf_compacting;
+};
+
+/* Slot position found by probing */
+struct lf_pos {
+	struct lf_group		*lp_grp;
+	unsigned int		 lp_slot;
+};
+
+static ATOMIC uint32_t	lf_stripe_seq;
+static __thread int	lf_stripe = -1;
+
+static inline int
+lf_stripe_get(void)
+{
+	if (unlikely(lf_stripe < 0))
+		lf_stripe = atomic_fetch_add(&lf_stripe_seq, 1) % LF_READER_STRIPES;
+	return lf_stripe;
+}
+
+static inline ATOMIC uint32_t *
+lf_read_lock(struct d_hash_lf *lf)
+{
+	struct lf_reader	*lr;
+	ATOMIC uint32_t		*cnt;
+	uint32_t		 phase;
+
+	lr = &lf->lf_readers[lf_stripe_get()];
+
+	for (;;) {
+		phase = atomic_load(&lf->lf_phase);
+		cnt = &lr->lr_cnt[phase];
+		atomic_fetch_add(cnt, 1);
+		/* Recheck, the phase could be flipped before the counter is visible */
+		if (atomic_load(&lf->lf_phase) == phase)
+			return cnt;
+		atomic_fetch_sub(cnt, 1);
+	}
+}
+
+static inline void
+lf_read_unlock(ATOMIC uint32_t *cnt)
+{
+	atomic_fetch_sub(cnt, 1);
+}
+
+/** Wait for all the readers which could have seen the deleted records */
+static void
+lf_synchronize(struct d_hash_lf *lf)
+{
+	uint32_t	phase;
+	int		i;
+
+	D_MUTEX_LOCK(&lf->lf_mutex);
+	phase = atomic_load(&lf->lf_phase);
+	atomic_store(&lf->lf_phase, phase ^ 1);
+
+	for (i = 0; i < LF_READER_STRIPES; i++) {
+		while (atomic_load(&lf->lf_readers[i].lr_cnt[phase]) != 0)
+			sched_yield();
+	}
+	D_MUTEX_UNLOCK(&lf->lf_mutex);
+}
+
+static inline uint32_t
+lf_key_hash(struct d_hash_table *htable, const void *key, unsigned int ksize)
+{
+	if (htable->ht_ops->hop_key_hash)
+		return htable->ht_ops->hop_key_hash(htable, key, ksize);
+
+	return d_hash_string_u32((const char *)key, ksize);
+}
+
+/* Fingerprint uses the high bits of golden ratio scrambled hash */
+static inline uint8_t
+lf_hash2tag(uint32_t hash)
+{
+	return (hash * 0x9E3779B1U) >> 24;
+}
+
+static inline void
+lf_group_lock(struct d_hash_lf *lf, uint32_t hash)
+{
+	D_SPIN_LOCK(&lf->lf_locks[hash & lf->lf_mask].spin);
+}
+
+static inline void
+lf_group_unlock(struct d_hash_lf *lf, uint32_t hash)
+{
+	D_SPIN_UNLOCK(&lf->lf_locks[hash & lf->lf_mask].spin);
+}
+
+/**
+ * Probe the slots for \p key, or for the record \p link if \p key is NULL.
+ * Caller should either hold the home group lock or be in the read section.
+ */
+static d_list_t *
+lf_probe(struct d_hash_table *htable, uint32_t hash, const void *key,
+	 unsigned int ksize, d_list_t *target, struct lf_pos *pos)
+{
+	struct d_hash_lf	*lf = htable->ht_lf;
+	struct lf_group		*grp;
+	d_list_t		*link;
+	uint8_t			 tag = lf_hash2tag(hash);
+	uint32_t		 i;
+	unsigned int		 j;
+
+	for (i = 0; i <= lf->lf_mask; i++) {
+		grp = &lf->lf_groups[(hash + i) & lf->lf_mask];
+		for (j = 0; j < LF_GROUP_SLOTS; j++) {
+			link = atomic_load_explicit(&grp->lg_links[j], memory_order_acquire);
+			if (link == NULL)
+				return NULL;
+			if (!lf_link_valid(link))
+				continue;
+
+			if (target != NULL) {
+				if (link != target)
+					continue;
+			} else if (atomic_load_relaxed(&grp->lg_tags[j]) != tag ||
+				   !ch_key_cmp(htable, link, key, ksize)) {
+				continue;
+			}
+
+			if (pos != NULL) {
+				pos->lp_grp = grp;
+				pos->lp_slot = j;
+			}
+			return link;
+		}
+	}
+
+	return NULL;
+}
+
+/* Claim a free slot for \p link, caller should hold the home group lock */
+static int
+lf_claim(struct d_hash_table *htable, uint32_t hash, d_list_t *link)
+{
+	struct d_hash_lf	*lf = htable->ht_lf;
+	struct lf_group		*grp;
+	d_list_t		*cur;
+	uint32_t		 i;
+	unsigned int		 j;
+
+	/*
+	 * Mark the record as linked (see d_hash_rec_unlinked()), and take the table's
+	 * refcount before it's visible to the lock-free readers.
+	 */
+	link->next = link->prev = NULL;
+	ch_rec_addref(htable, link);
+
+	for (i = 0; i <= lf->lf_mask; i++) {
+		grp = &lf->lf_groups[(hash + i) & lf->lf_mask];
+		for (j = 0; j < LF_GROUP_SLOTS; j++) {
+			cur = atomic_load(&grp->lg_links[j]);
+			if (cur != NULL && cur != LF_TOMBSTONE)
+				continue;
+
+			/* Other home groups could race for the same free slot */
+			if (!atomic_compare_exchange_strong(&grp->lg_links[j], &cur, LF_CLAIMED))
+				continue;
+			if (cur == LF_TOMBSTONE)
+				atomic_fetch_sub(&lf->lf_tombs, 1);
+
+			/* Readers load the tag after the link with acquire ordering */
+			atomic_store_relaxed(&grp->lg_tags[j], lf_hash2tag(hash));
+			atomic_store_explicit(&grp->lg_links[j], link, memory_order_release);
+			return 0;
+		}
+	}
+
+	D_INIT_LIST_HEAD(link);
+	/* The caller still owns the record, don't free it */
+	ch_rec_decref(htable, link);
+	D_ERROR("Lock-free hash table %p is full\n", htable);
+	return -DER_NOSPACE;
+}
+
+static d_list_t *
+lf_rec_find(struct d_hash_table *htable, const void *key, unsigned int ksize)
+{
+	ATOMIC uint32_t	*cnt;
+	d_list_t	*link;
+
+	cnt = lf_read_lock(htable->ht_lf);
+	link = lf_probe(htable, lf_key_hash(htable, key, ksize), key, ksize, NULL, NULL);
+	if (link != NULL)
+		ch_rec_addref(htable, link);
+	lf_read_unlock(cnt);
+
+	return link;
+}
+
+static int
+lf_rec_insert(struct d_hash_table *htable, const void *key, unsigned int ksize,
+	      d_list_t *link, bool exclusive)
+{
+	uint32_t	hash = lf_key_hash(htable, key, ksize);
+	int		rc;
+
+	lf_group_lock(htable->ht_lf, hash);
+	if (exclusive && lf_probe(htable, hash, key, ksize, NULL, NULL) != NULL) {
+		D_DEBUG(DB_TRACE, "Dup key detected\n");
+		D_GOTO(out_unlock, rc = -DER_EXIST);
+	}
+	rc = lf_claim(htable, hash, link);
+out_unlock:
+	lf_group_unlock(htable->ht_lf, hash);
+	return rc;
+}
+
+static d_list_t *
+lf_rec_find_insert(struct d_hash_table *htable, const void *key,
+		   unsigned int ksize, d_list_t *link)
+{
+	uint32_t	 hash = lf_key_hash(htable, key, ksize);
+	d_list_t	*tmp;
+
+	lf_group_lock(htable->ht_lf, hash);
+	tmp = lf_probe(htable, hash, key, ksize, NULL, NULL);
+	if (tmp != NULL) {
+		ch_rec_addref(htable, tmp);
+		link = tmp;
+	} else if (lf_claim(htable, hash, link) != 0) {
+		link = NULL;
+	}
+	lf_group_unlock(htable->ht_lf, hash);
+
+	return link;
+}
+
+static int
+lf_rec_insert_anonym(struct d_hash_table *htable, d_list_t *link, void *arg)
+{
+	struct d_hash_lf	*lf = htable->ht_lf;
+	bool			 need_keyinit_lock;
+	uint32_t		 hash;
+	int			 rc;
+
+	need_keyinit_lock = !(htable->ht_feats & D_HASH_FT_NO_KEYINIT_LOCK);
+	if (need_keyinit_lock)
+		D_MUTEX_LOCK(&lf->lf_mutex);
+	ch_key_init(htable, link, arg);
+	if (need_keyinit_lock)
+		D_MUTEX_UNLOCK(&lf->lf_mutex);
+
+	hash = htable->ht_ops->hop_rec_hash(htable, link);
+	lf_group_lock(lf, hash);
+	rc = lf_claim(htable, hash, link);
+	lf_group_unlock(lf, hash);
+
+	return rc;
+}
+
+static inline d_list_t *ATOMIC *
+lf_slot(struct d_hash_lf *lf, uint64_t idx)
+{
+	return &lf->lf_groups[idx / LF_GROUP_SLOTS].lg_links[idx % LF_GROUP_SLOTS];
+}
+
+/*
+ * Tombstone followed by an empty slot is the end of all the probing sequences
+ * passing it, so it can be emptied when no writer is active. Scan backward
+ * twice to handle the sequences wrapping around the table end.
+ */
+static void
+lf_compact(struct d_hash_lf *lf)
+{
+	uint64_t	nr = (uint64_t)(lf->lf_mask + 1) * LF_GROUP_SLOTS;
+	uint64_t	i, idx;
+	uint32_t	g, freed = 0;
+
+	if (atomic_exchange(&lf->lf_compacting, true))
+		return;
+
+	for (g = 0; g <= lf->lf_mask; g++)
+		D_SPIN_LOCK(&lf->lf_locks[g].spin);
+
+	for (i = 2 * nr; i > 0; i--) {
+		idx = (i - 1) % nr;
+		if (atomic_load(lf_slot(lf, idx)) == LF_TOMBSTONE &&
+		    atomic_load(lf_slot(lf, (idx + 1) % nr)) == NULL) {
+			atomic_store(lf_slot(lf, idx), NULL);
+			freed++;
+		}
+	}
+	atomic_fetch_sub(&lf->lf_tombs, freed);
+
+	for (g = 0; g <= lf->lf_mask; g++)
+		D_SPIN_UNLOCK(&lf->lf_locks[g].spin);
+
+	D_DEBUG(DB_TRACE, "Lock-free hash table compacted %u tombstones\n", freed);
+	atomic_store(&lf->lf_compacting, false);
+}
+
+/* Drop the table's refcount of the retired records after a grace period */
+static void
+lf_release(struct d_hash_table *htable, d_list_t **links, uint32_t nr)
+{
+	uint32_t	i;
+
+	lf_synchronize(htable->ht_lf);
+	for (i = 0; i < nr; i++) {
+		if (ch_rec_decref(htable, links[i]))
+			ch_rec_free(htable, links[i]);
+	}
+}
+
+/*
+ * Queue the unlinked record on the retire list of the calling thread's stripe,
+ * release the queued records once the list is full.
+ */
+static void
+lf_retire(struct d_hash_table *htable, d_list_t *link)
+{
+	struct lf_retire	*lt = &htable->ht_lf->lf_retires[lf_stripe_get()];
+	d_list_t		*batch[LF_RETIRE_BATCH];
+	uint32_t		 nr = 0;
+
+	D_SPIN_LOCK(&lt->lt_lock);
+	if (lt->lt_nr == LF_RETIRE_BATCH) {
+		nr = lt->lt_nr;
+		memcpy(batch, lt->lt_links, sizeof(batch));
+		lt->lt_nr = 0;
+	}
+	lt->lt_links[lt->lt_nr++] = link;
+	D_SPIN_UNLOCK(&lt->lt_lock);
+
+	if (nr != 0)
+		lf_release(htable, batch, nr);
+}
+
+/* Release all the retired records */
+static void
+lf_reclaim(struct d_hash_table *htable)
+{
+	struct lf_retire	*lt;
+	d_list_t		*batch[LF_RETIRE_BATCH];
+	uint32_t		 nr;
+	int			 i;
+
+	for (i = 0; i < LF_READER_STRIPES; i++) {
+		lt = &htable->ht_lf->lf_retires[i];
+
+		D_SPIN_LOCK(&lt->lt_lock);
+		nr = lt->lt_nr;
+		memcpy(batch, lt->lt_links, nr * sizeof(batch[0]));
+		lt->lt_nr = 0;
+		D_SPIN_UNLOCK(&lt->lt_lock);
+
+		if (nr != 0)
+			lf_release(htable, batch, nr);
+	}
+}
+
+/**
+ * Unlink the record by \p key, or the record \p link if \p key is NULL, the
+ * table's refcount is released after a grace period.
+ */
+static bool
+lf_rec_delete(struct d_hash_table *htable, uint32_t hash, const void *key,
+	      unsigned int ksize, d_list_t *link)
+{
+	struct d_hash_lf	*lf = htable->ht_lf;
+	struct lf_pos		 pos;
+	uint32_t		 tombs = 0;
+
+	lf_group_lock(lf, hash);
+	if (key == NULL && d_list_empty(link))
+		link = NULL;
+	else
+		link = lf_probe(htable, hash, key, ksize, link, &pos);
+
+	if (link != NULL) {
+		tombs = atomic_fetch_add(&lf->lf_tombs, 1) + 1;
+		atomic_store_explicit(&pos.lp_grp->lg_links[pos.lp_slot], LF_TOMBSTONE,
+				      memory_order_release);
+		D_INIT_LIST_HEAD(link);
+	}
+	lf_group_unlock(lf, hash);
+
+	if (link == NULL)
+		return false;
+
+	/* Compact when more than 1/4 slots are tombstones */
+	if (tombs > (lf->lf_mask + 1) * LF_GROUP_SLOTS / 4)
+		lf_compact(lf);
+
+	/* No refcount, the caller could free the record once it's deleted */
+	if (htable->ht_ops->hop_rec_decref == NULL)
+		lf_synchronize(lf);
+	else
+		lf_retire(htable, link);
+
+	return true;
+}
+
+static int
+lf_table_traverse(struct d_hash_table *htable, d_hash_traverse_cb_t cb, void *arg)
+{
+	struct d_hash_lf	*lf = htable->ht_lf;
+	struct lf_group		*grp;
+	ATOMIC uint32_t		*cnt;
+	d_list_t		*link;
+	uint32_t		 i;
+	unsigned int		 j;
+	int			 rc = 0;
+
+	cnt = lf_read_lock(lf);
+	for (i = 0; i <= lf->lf_mask && !rc; i++) {
+		grp = &lf->lf_groups[i];
+		for (j = 0; j < LF_GROUP_SLOTS; j++) {
+			link = atomic_load_explicit(&grp->lg_links[j], memory_order_acquire);
+			if (link == NULL)
+				break;
+			if (!lf_link_valid(link))
+				continue;
+
+			rc = cb(link, arg);
+			if (rc)
+				break;
+		}
+	}
+	lf_read_unlock(cnt);
+
+	return rc;
+}
+
+/* Return any record in the table, caller should hold the read section */
+static d_list_t *
+lf_table_any(struct d_hash_table *htable)
+{
+	struct d_hash_lf	*lf = htable->ht_lf;
+	struct lf_group		*grp;
+	d_list_t		*link;
+	uint32_t		 i;
+	unsigned int		 j;
+
+	for (i = 0; i <= lf->lf_mask; i++) {
+		grp = &lf->lf_groups[i];
+		for (j = 0; j < LF_GROUP_SLOTS; j++) {
+			link = atomic_load_explicit(&grp->lg_links[j], memory_order_acquire);
+			if (link == NULL)
+				break;
+			if (lf_link_valid(link))
+				return link;
+		}
+	}
+
+	return NULL;
+}
+
+static void
+lf_table_free(struct d_hash_lf *lf, uint32_t nr_retires, uint32_t nr_locks)
+{
+	uint32_t	i;
+
+	for (i = 0; i < nr_retires; i++)
+		D_SPIN_DESTROY(&lf->lf_retires[i].lt_lock);
+	for (i = 0; i < nr_locks; i++)
+		D_SPIN_DESTROY(&lf->lf_locks[i].spin);
+	D_FREE(lf->lf_locks);
+	D_FREE(lf->lf_groups);
+	D_FREE(lf);
+}
+
+static int
+lf_table_create(struct d_hash_table *htable)
+{
+	struct d_hash_lf	*lf;
+	uint32_t		 nr = 1U << htable->ht_bits;
+	uint32_t		 i = 0;
+	uint32_t		 j = 0;
+	int			 rc;
+
+	if (htable->ht_feats & (D_HASH_FT_EPHEMERAL | D_HASH_FT_LRU) ||
+	    htable->ht_ops->hop_rec_hash == NULL) {
+		D_ERROR("Lock-free hash table doesn't support feats %#x, or no rec_hash\n",
+			htable->ht_feats);
+		return -DER_INVAL;
+	}
+
+	D_ALIGNED_ALLOC(lf, 64, sizeof(*lf));
+	if (lf == NULL)
+		return -DER_NOMEM;
+
+	for (j = 0; j < LF_READER_STRIPES; j++) {
+		rc = D_SPIN_INIT(&lf->lf_retires[j].lt_lock, PTHREAD_PROCESS_PRIVATE);
+		if (rc)
+			D_GOTO(failed, rc);
+	}
+
+	D_ALIGNED_ALLOC(lf->lf_groups, 64, sizeof(*lf->lf_groups) * nr);
+	if (lf->lf_groups == NULL)
+		D_GOTO(failed, rc = -DER_NOMEM);
+
+	D_ALLOC_ARRAY(lf->lf_locks, nr);
+	if (lf->lf_locks == NULL)
+		D_GOTO(failed, rc = -DER_NOMEM);
+
+	for (i = 0; i < nr; i++) {
+		rc = D_SPIN_INIT(&lf->lf_locks[i].spin, PTHREAD_PROCESS_PRIVATE);
+		if (rc)
+			D_GOTO(failed, rc);
+	}
+
+	rc = D_MUTEX_INIT(&lf->lf_mutex, NULL);
+	if (rc)
+		D_GOTO(failed, rc);
+
+	lf->lf_mask = nr - 1;
+	htable->ht_lf = lf;
+	return 0;
+failed:
+	lf_table_free(lf, j, i);
+	return rc;
+}
+
+static int
+lf_table_destroy(struct d_hash_table *htable, bool force)
+{
+	struct d_hash_lf	*lf = htable->ht_lf;
+	ATOMIC uint32_t		*cnt;
+	d_list_t		*link;
+
+	for (;;) {
+		cnt = lf_read_lock(lf);
+		link = lf_table_any(htable);
+		lf_read_unlock(cnt);
+
+		if (link == NULL)
+			break;
+		if (!force) {
+			D_DEBUG(DB_TRACE, "Warning, non-empty hash\n");
+			return -DER_BUSY;
+		}
+		lf_rec_delete(htable, htable->ht_ops->hop_rec_hash(htable, link), NULL, 0,
+			      link);
+	}
+	lf_reclaim(htable);
+
+	D_MUTEX_DESTROY(&lf->lf_mutex);
+	lf_table_free(lf, LF_READER_STRIPES, lf->lf_mask + 1);
+	memset(htable, 0, sizeof(*htable));
+	return 0;
+}
+
 bool
 d_hash_rec_unlinked(d_list_t *link)
 {
@@ -445,6 +1063,9 @@ d_hash_rec_find(struct d_hash_table *htable, const void *key,
 	bool			 is_lru = (htable->ht_feats & D_HASH_FT_LRU);
 
 	D_ASSERT(key != NULL && ksize != 0);
+	if (htable->ht_feats & D_HASH_FT_LOCKFREE)
+		return lf_rec_find(htable, key, ksize);
+
 	idx = ch_key_hash(htable, key, ksize);
 	bucket = &htable->ht_buckets[idx];
 
@@ -468,6 +1089,9 @@ d_hash_rec_insert(struct d_hash_table *htable, const void *key,
 	int			 rc = 0;
 
 	D_ASSERT(key != NULL && ksize != 0);
+	if (htable->ht_feats & D_HASH_FT_LOCKFREE)
+		return lf_rec_insert(htable, key, ksize, link, exclusive);
+
 	idx = ch_key_hash(htable, key, ksize);
 	bucket = &htable->ht_buckets[idx];
 
@@ -496,6 +1120,9 @@ d_hash_rec_find_insert(struct d_hash_table *htable, const void *key,
 	uint32_t		 idx;
 
 	D_ASSERT(key != NULL && ksize != 0);
+	if (htable->ht_feats & D_HASH_FT_LOCKFREE)
+		return lf_rec_find_insert(htable, key, ksize, link);
+
 	idx = ch_key_hash(htable, key, ksize);
 	bucket = &htable->ht_buckets[idx];
 
@@ -527,6 +1154,9 @@ d_hash_rec_insert_anonym(struct d_hash_table *htable, d_list_t *link,
 	if (htable->ht_ops->hop_key_init == NULL)
 		return -DER_INVAL;
 
+	if (htable->ht_feats & D_HASH_FT_LOCKFREE)
+		return lf_rec_insert_anonym(htable, link, arg);
+
 	need_keyinit_lock = !(htable->ht_feats & D_HASH_FT_NO_KEYINIT_LOCK);
 	if (need_lock && need_keyinit_lock) {
 		/* Lock all buckets because of unknown key yet */
@@ -572,6 +1202,9 @@ d_hash_rec_delete(struct d_hash_table *htable, const void *key,
 	bool			 zombie  = false;
 
 	D_ASSERT(key != NULL && ksize != 0);
+	if (htable->ht_feats & D_HASH_FT_LOCKFREE)
+		return lf_rec_delete(htable, lf_key_hash(htable, key, ksize), key, ksize, NULL);
+
 	idx = ch_key_hash(htable, key, ksize);
 	bucket = &htable->ht_buckets[idx];
 
@@ -598,6 +1231,10 @@ d_hash_rec_delete_at(struct d_hash_table *htable, d_list_t *link)
 	bool	 zombie  = false;
 	bool	 need_lock = !(htable->ht_feats & D_HASH_FT_NOLOCK);
 
+	if (htable->ht_feats & D_HASH_FT_LOCKFREE)
+		return lf_rec_delete(htable, htable->ht_ops->hop_rec_hash(htable, link), NULL, 0,
+				     link);
+
 	if (need_lock) {
 		idx = ch_rec_hash(htable, link);
 		ch_bucket_lock(htable, idx, false);
@@ -667,7 +1304,7 @@ void
 d_hash_rec_addref(struct d_hash_table *htable, d_list_t *link)
 {
 	uint32_t idx = 0;
-	bool	 need_lock = !(htable->ht_feats & D_HASH_FT_NOLOCK);
+	bool	 need_lock = !(htable->ht_feats & (D_HASH_FT_NOLOCK | D_HASH_FT_LOCKFREE));
 
 	if (need_lock) {
 		idx = ch_rec_hash(htable, link);
@@ -684,7 +1321,7 @@ void
 d_hash_rec_decref(struct d_hash_table *htable, d_list_t *link)
 {
 	uint32_t idx = 0;
-	bool	 need_lock = !(htable->ht_feats & D_HASH_FT_NOLOCK);
+	bool	 need_lock = !(htable->ht_feats & (D_HASH_FT_NOLOCK | D_HASH_FT_LOCKFREE));
 	bool	 ephemeral = (htable->ht_feats & D_HASH_FT_EPHEMERAL);
 	bool	 zombie;
 
@@ -710,7 +1347,7 @@ int
 d_hash_rec_ndecref(struct d_hash_table *htable, int count, d_list_t *link)
 {
 	uint32_t idx = 0;
-	bool	 need_lock = !(htable->ht_feats & D_HASH_FT_NOLOCK);
+	bool	 need_lock = !(htable->ht_feats & (D_HASH_FT_NOLOCK | D_HASH_FT_LOCKFREE));
 	bool	 ephemeral = (htable->ht_feats & D_HASH_FT_EPHEMERAL);
 	bool	 zombie = false;
 	int	 rc = 0;
@@ -795,6 +1432,12 @@ d_hash_table_create_inplace(uint32_t feats, uint32_t bits, void *priv,
 	htable->ht_bits	 = bits;
 	htable->ht_ops	 = hops;
 	htable->ht_priv	 = priv;
+	htable->ht_buckets = NULL;
+	htable->ht_locks = NULL;
+	htable->ht_lf	 = NULL;
+
+	if (feats & D_HASH_FT_LOCKFREE)
+		return lf_table_create(htable);
 
 	if (hops->hop_rec_hash == NULL && !(feats & D_HASH_FT_NOLOCK)) {
 		htable->ht_feats |= D_HASH_FT_GLOCK;
@@ -882,6 +1525,13 @@ out:
 	return rc;
 }
 
+void
+d_hash_table_reclaim(struct d_hash_table *htable)
+{
+	if (htable->ht_feats & D_HASH_FT_LOCKFREE)
+		lf_reclaim(htable);
+}
+
 int
 d_hash_table_traverse(struct d_hash_table *htable, d_hash_traverse_cb_t cb,
 		      void *arg)
@@ -892,7 +1542,7 @@ d_hash_table_traverse(struct d_hash_table *htable, d_hash_traverse_cb_t cb,
 	uint32_t		 idx;
 	int			 rc = 0;
 
-	if (htable->ht_buckets == NULL) {
+	if (htable->ht_buckets == NULL && htable->ht_lf == NULL) {
 		D_ERROR("d_hash_table %p not initialized (NULL buckets).\n",
 			htable);
 		D_GOTO(out, rc = -DER_UNINIT);
@@ -902,6 +1552,9 @@ d_hash_table_traverse(struct d_hash_table *htable, d_hash_traverse_cb_t cb,
 		D_GOTO(out, rc = -DER_INVAL);
 	}
 
+	if (htable->ht_feats & D_HASH_FT_LOCKFREE)
+		return lf_table_traverse(htable, cb, arg);
+
 	for (idx = 0; idx < nr && !rc; idx++) {
 		bucket = &htable->ht_buckets[idx];
 		ch_bucket_lock(htable, idx, true);
@@ -923,6 +1576,9 @@ d_hash_table_is_empty(struct d_hash_table *htable)
 	uint32_t	 idx;
 	bool		 is_empty = true;
 
+	if (htable->ht_feats & D_HASH_FT_LOCKFREE)
+		return d_hash_rec_first(htable) == NULL;
+
 	if (htable->ht_buckets == NULL) {
 		D_ERROR("d_hash_table %p not initialized (NULL buckets).\n",
 			htable);
@@ -947,6 +1603,9 @@ d_hash_table_destroy_inplace(struct d_hash_table *htable, bool force)
 	uint32_t		 i;
 	int			 rc = 0;
 
+	if (htable->ht_feats & D_HASH_FT_LOCKFREE)
+		return lf_table_destroy(htable, force);
+
 	for (i = 0; i < nr; i++) {
 		bucket = &htable->ht_buckets[i];
 		while (!d_list_empty(&bucket->hb_head)) {
@@ -1697,6 +1697,8 @@ _test_gurt_hash_parallel_refcounting(uint32_t ht_feats)
 	if (!ephemeral) {
 		_test_gurt_hash_threaded_same_operations(hash_parallel_delete,
 							 thtab, entries);
+		/* Lock-free table drops its refcount after a grace period */
+		d_hash_table_reclaim(thtab);
 		expected_refcount -= 1;
 		test_gurt_hash_refcount(entries, expected_refcount);
 	}
@@ -1745,6 +1747,7 @@ test_gurt_hash_parallel_same_operations(void **state)
 	test_gurt_hash_threaded_same_operations(D_HASH_FT_RWLOCK
 						| D_HASH_FT_EPHEMERAL);
 	test_gurt_hash_threaded_same_operations(D_HASH_FT_LRU);
+	test_gurt_hash_threaded_same_operations(D_HASH_FT_LOCKFREE);
 }
 
 static void
@@ -1756,6 +1759,7 @@ test_gurt_hash_parallel_different_operations(void **state)
 	test_gurt_hash_threaded_concurrent_operations(D_HASH_FT_RWLOCK
 						      | D_HASH_FT_EPHEMERAL);
 	test_gurt_hash_threaded_concurrent_operations(D_HASH_FT_LRU);
+	test_gurt_hash_threaded_concurrent_operations(D_HASH_FT_LOCKFREE);
 }
 
 static void
@@ -1767,6 +1771,130 @@ test_gurt_hash_parallel_refcounting(void **state)
 	_test_gurt_hash_parallel_refcounting(D_HASH_FT_RWLOCK
 					     | D_HASH_FT_EPHEMERAL);
 	_test_gurt_hash_parallel_refcounting(D_HASH_FT_LRU);
+	_test_gurt_hash_parallel_refcounting(D_HASH_FT_LOCKFREE);
+}
+
+#define TEST_GURT_HASH_PERF_LOOP	(D_ON_VALGRIND ? 1000 : 200000)
+
+static void
+test_gurt_hash_op_rec_addref_atomic(struct d_hash_table *thtab, d_list_t *link)
+{
+	struct test_hash_entry *tlink = test_gurt_hash_link2ptr(link);
+
+	__atomic_add_fetch(&tlink->tl_ref, 1, __ATOMIC_RELAXED);
+}
+
+static bool
+test_gurt_hash_op_rec_decref_atomic(struct d_hash_table *thtab, d_list_t *link)
+{
+	struct test_hash_entry	*tlink = test_gurt_hash_link2ptr(link);
+	int			 ref;
+
+	ref = __atomic_sub_fetch(&tlink->tl_ref, 1, __ATOMIC_ACQ_REL);
+	TEST_THREAD_ASSERT(ref >= 0);
+
+	return ref == 0;
+}
+
+static d_hash_table_ops_t th_atomic_ref_ops = {
+	.hop_key_cmp    = test_gurt_hash_op_key_cmp,
+	.hop_rec_hash	= test_gurt_hash_op_rec_hash,
+	.hop_rec_addref	= test_gurt_hash_op_rec_addref_atomic,
+	.hop_rec_decref	= test_gurt_hash_op_rec_decref_atomic,
+};
+
+static void *
+hash_perf_mt_thread(struct hash_thread_arg *arg)
+{
+	struct test_hash_entry	*entry;
+	d_list_t		*test;
+	unsigned int		 seed = arg->thread_idx;
+	int			 i, idx;
+	int			 rc;
+
+	/*
+	 * Mostly lookups across the whole table, 1 of 16 operations deletes and
+	 * re-inserts an entry owned by this thread.
+	 */
+	for (i = 0; i < TEST_GURT_HASH_PERF_LOOP; i++) {
+		if (i % 16) {
+			idx = rand_r(&seed) % TEST_GURT_HASH_NUM_ENTRIES;
+			test = d_hash_rec_find(arg->thtab, arg->entries[idx]->tl_key,
+					       TEST_GURT_HASH_KEY_LEN);
+			/*
+			 * Entries of other threads could be absent while being
+			 * re-inserted, only the owned ones must be found.
+			 */
+			if (idx / TEST_GURT_HASH_ENTRIES_PER_THREAD == arg->thread_idx)
+				TEST_THREAD_ASSERT(test == &arg->entries[idx]->tl_link);
+			else
+				TEST_THREAD_ASSERT(test == NULL ||
+						   test == &arg->entries[idx]->tl_link);
+			if (test != NULL)
+				d_hash_rec_decref(arg->thtab, test);
+			continue;
+		}
+
+		idx = arg->thread_idx * TEST_GURT_HASH_ENTRIES_PER_THREAD +
+		      rand_r(&seed) % TEST_GURT_HASH_ENTRIES_PER_THREAD;
+		entry = arg->entries[idx];
+		TEST_THREAD_ASSERT(d_hash_rec_delete_at(arg->thtab, &entry->tl_link));
+		rc = d_hash_rec_insert(arg->thtab, entry->tl_key, TEST_GURT_HASH_KEY_LEN,
+				       &entry->tl_link, true);
+		TEST_THREAD_ASSERT(rc == 0);
+	}
+
+	return NULL;
+}
+
+static void
+hash_perf_mt(uint32_t ht_feats, const char *name)
+{
+	struct d_hash_table	 *thtab;
+	struct test_hash_entry	**entries;
+	struct timespec		  then;
+	struct timespec		  now;
+	double			  duration;
+	int			  i;
+	int			  rc;
+
+	entries = test_gurt_hash_alloc_items(TEST_GURT_HASH_NUM_ENTRIES);
+	assert_non_null(entries);
+
+	rc = d_hash_table_create(ht_feats, TEST_GURT_HASH_NUM_BITS, NULL, &th_atomic_ref_ops,
+				 &thtab);
+	assert_int_equal(rc, 0);
+
+	for (i = 0; i < TEST_GURT_HASH_NUM_ENTRIES; i++) {
+		rc = d_hash_rec_insert(thtab, entries[i]->tl_key, TEST_GURT_HASH_KEY_LEN,
+				       &entries[i]->tl_link, true);
+		assert_int_equal(rc, 0);
+	}
+
+	d_gettime(&then);
+	_test_gurt_hash_threaded_same_operations(hash_perf_mt_thread, thtab, entries);
+	d_gettime(&now);
+
+	duration = (double)d_timediff_ns(&then, &now) / NSEC_PER_SEC;
+	fprintf(stdout, "Hash table: %s, threads: %d, rate: %F\n", name,
+		TEST_GURT_HASH_NUM_THREADS,
+		(double)TEST_GURT_HASH_PERF_LOOP * TEST_GURT_HASH_NUM_THREADS / duration);
+
+	rc = d_hash_table_destroy(thtab, true);
+	assert_int_equal(rc, 0);
+	/* All the lookup and deferred table references are dropped */
+	test_gurt_hash_refcount(entries, 0);
+
+	test_gurt_hash_free_items(entries, TEST_GURT_HASH_NUM_ENTRIES);
+}
+
+/* Multi-threaded lookup/insert benchmark, lock-free vs. chained hash tables */
+static void
+test_gurt_hash_perf_mt(void **state)
+{
+	hash_perf_mt(0, "SPINLOCK");
+	hash_perf_mt(D_HASH_FT_RWLOCK, "RWLOCK");
+	hash_perf_mt(D_HASH_FT_LOCKFREE, "LOCKFREE");
 }
 
 
@@ -2096,6 +2224,7 @@ main(int argc, char **argv)
 	    cmocka_unit_test(test_gurt_string_buffer),
 	    cmocka_unit_test(test_d_rank_list_dup_sort_uniq),
 	    cmocka_unit_test(test_hash_perf),
+	    cmocka_unit_test(test_gurt_hash_perf_mt),
 	};
 
 	d_register_alt_assert(mock_assert);
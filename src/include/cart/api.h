@@ -936,6 +936,38 @@ crt_bulk_create(crt_context_t crt_ctx, d_sg_list_t *sgl,
 int
 crt_bulk_bind(crt_bulk_t bulk_hdl, crt_context_t crt_ctx);
 
+/**
+ * Register a buffer whose bulk handles can be cached in the context.
+ *
+ * crt_bulk_create() of a single iov within a registered buffer takes a
+ * reference on the cached handle of the same iov and permission instead of
+ * registering the memory again. The buffer must remain allocated until it is
+ * unregistered. A cached handle is shared by its users, it can only be bound
+ * to the context it was created with.
+ *
+ * \param[in] crt_ctx		CRT transport context
+ * \param[in] buf		start address of the buffer
+ * \param[in] len		length of the buffer
+ *
+ * \return			DER_SUCCESS on success, negative value if error
+ */
+int
+crt_bulk_cache_register(crt_context_t crt_ctx, void *buf, size_t len);
+
+/**
+ * Unregister a buffer registered by crt_bulk_cache_register(), the cached bulk
+ * handles of the buffer are released. The buffer can be freed after the bulk
+ * handles created before are freed.
+ *
+ * \param[in] crt_ctx		CRT transport context
+ * \param[in] buf		start address of the buffer
+ * \param[in] len		length of the buffer
+ *
+ * \return			DER_SUCCESS on success, negative value if error
+ */
+int
+crt_bulk_cache_unregister(crt_context_t crt_ctx, void *buf, size_t len);
+
 /**
  * Add reference of the bulk handle.
  *
@@ -548,6 +548,10 @@ int  dbtree_fetch_prev(daos_handle_t toh, d_iov_t *key_out, d_iov_t *val_out, bo
 int  dbtree_fetch_next(daos_handle_t toh, d_iov_t *key_out, d_iov_t *val_out, bool move);
 int  dbtree_upsert(daos_handle_t toh, dbtree_probe_opc_t opc, uint32_t intent,
 		   d_iov_t *key, d_iov_t *val, d_iov_t *val_out);
+int  dbtree_upsert_batch(daos_handle_t toh, uint32_t intent, unsigned int nr,
+			 d_iov_t *keys, d_iov_t *vals);
+int  dbtree_bulk_load(daos_handle_t toh, unsigned int nr, d_iov_t *keys,
+		      d_iov_t *vals, unsigned int fill_pct);
 int  dbtree_delete(daos_handle_t toh, dbtree_probe_opc_t opc,
 		   d_iov_t *key, void *args);
 int  dbtree_query(daos_handle_t toh, struct btr_attr *attr,
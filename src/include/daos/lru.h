@@ -31,19 +31,29 @@ struct daos_llink_ops {
 
 struct daos_llink {
 	d_list_t		 ll_link;	/**< LRU hash link */
-	d_list_t		 ll_qlink;	/**< Temp link for traverse */
+	d_list_t		 ll_qlink;	/**< Link on the clock ring */
 	uint32_t		 ll_ref;	/**< refcount for this ref */
-	uint32_t		 ll_evicted:1;	/**< has been evicted */
+	uint32_t		 ll_evicted:1,	/**< has been evicted */
+				 ll_referenced:1; /**< held since last sweep */
 	struct daos_llink_ops	*ll_ops;	/**< ops to maintain refs */
 };
 
 /**
- * LRU cache implementation using d_hash_table and d_list_t
+ * LRU cache implementation using d_hash_table and d_list_t.
+ *
+ * Replacement is approximated with a CLOCK (second chance) policy: all
+ * refs stay on the ring, a hit only sets ll_referenced and the sweep on
+ * release gives referenced or busy refs a second chance.
  */
 struct daos_lru_cache {
-	uint32_t		 dlc_csize;	/**< Provided cache size */
+	uint32_t		 dlc_csize;	/**< Current cache size */
+	uint32_t		 dlc_csize_min;	/**< Lower bound of adaptive size */
+	uint32_t		 dlc_csize_max;	/**< Provided cache size */
 	uint32_t		 dlc_count;	/**< count of refs in cache */
-	d_list_t		 dlc_lru;	/**< list head of LRU */
+	uint32_t		 dlc_ghost_mask; /**< bits in dlc_ghost minus one */
+	uint32_t		 dlc_ghost_nr;	/**< refs recorded in dlc_ghost */
+	uint64_t		*dlc_ghost;	/**< hashes of recently evicted refs */
+	d_list_t		 dlc_lru;	/**< clock ring, hand at head */
 	struct d_hash_table	 dlc_htable;	/**< Hash table for all refs */
 	struct daos_llink_ops	*dlc_ops;	/**< ops to maintain refs */
 };
@@ -73,6 +83,20 @@ daos_lru_cache_create(int bits, uint32_t feats,
 void
 daos_lru_cache_destroy(struct daos_lru_cache *lcache);
 
+/**
+ * Let the size of an LRU cache adapt to its working set, from power2(min_bits)
+ * up to the size provided at creation.  The cache starts at the lower bound,
+ * grows when a missing ref was recently evicted, and shrinks back while the
+ * clock hand finds cold refs.
+ *
+ * \param[in] lcache		LRU cache reference
+ * \param[in] min_bits		power2(min_bits) is the minimum size
+ *
+ * \return		0 on success and negative on failure.
+ */
+int
+daos_lru_cache_adapt(struct daos_lru_cache *lcache, int min_bits);
+
 typedef bool (*daos_lru_cond_cb_t)(struct daos_llink *llink, void *arg);
 
 /**
@@ -87,6 +111,16 @@ void
 daos_lru_cache_evict(struct daos_lru_cache *lcache,
 		     daos_lru_cond_cb_t cond, void *arg);
 
+/**
+ * Evict a single item, it's freed right away if it's idle, otherwise after
+ * its last refcount is released.
+ *
+ * \param[in] lcache		DAOS LRU cache
+ * \param[in] llink		DAOS LRU item to be evicted
+ */
+void
+daos_lru_cache_evict_one(struct daos_lru_cache *lcache, struct daos_llink *llink);
+
 /**
  * Find a ref in the cache \a lcache and take its reference.
  * if reference is not found add it.
@@ -892,6 +892,8 @@ struct umem_cache {
 	d_list_t                 ca_pgs_copying;
 	/** LRU list all pages not in one of the other states for future eviction support */
 	d_list_t                 ca_pgs_lru;
+	/** Bytes dirtied by transactions since the last checkpoint started */
+	uint64_t                 ca_dirtied_bytes;
 	/** TODO: some other global status */
 	/** All pages, sorted by umem_page::pg_id */
 	struct umem_page         ca_pages[0];
@@ -906,6 +908,10 @@ struct umem_cache_chkpt_stats {
 	int		 uccs_nr_dchunks;
 	/** Number of sgl iovs used to copy dirty chunks */
 	int		 uccs_nr_iovs;
+	/** Bytes dirtied by transactions since last checkpoint */
+	uint64_t	 uccs_dirtied_bytes;
+	/** Bytes copied by this checkpoint */
+	uint64_t	 uccs_chkpt_bytes;
 };
 
 static inline uint64_t
@@ -1014,6 +1014,8 @@ struct bio_wal_rp_stats {
 	uint64_t	wrs_sz;		/* bytes replayed */
 	uint64_t	wrs_entries;	/* replayed entries count */
 	uint64_t	wrs_tx_cnt;	/* total transactions */
+	uint64_t	wrs_io_wait;	/* time blocked on WAL reads (us) */
+	uint64_t	wrs_rd_sz;	/* bytes read from WAL blob */
 };
 
 /*
@@ -229,12 +229,16 @@ enum {
 enum {
 	SCHED_REQ_FL_NO_DELAY	= (1 << 0),
 	SCHED_REQ_FL_PERIODIC	= (1 << 1),
+	/* Issued on behalf of rebuild or DTX resync, inherits their priority */
+	SCHED_REQ_FL_INHERIT	= (1 << 2),
 };
 
 struct sched_req_attr {
 	uuid_t		sra_pool_id;
 	uint32_t	sra_type;
 	uint32_t	sra_flags;
+	/* Estimated data size in bytes, used by bandwidth limiting */
+	uint64_t	sra_size;
 };
 
 static inline void
@@ -243,6 +247,7 @@ sched_req_attr_init(struct sched_req_attr *attr, unsigned int type,
 {
 	attr->sra_type = type;
 	attr->sra_flags = 0;
+	attr->sra_size = 0;
 	uuid_copy(attr->sra_pool_id, *pool_id);
 }
 
@@ -513,6 +518,8 @@ int dss_ult_create(void (*func)(void *), void *arg, int xs_type, int tgt_id,
 int dss_ult_execute(int (*func)(void *), void *arg, void (*user_cb)(void *),
 		    void *cb_args, int xs_type, int tgt_id, size_t stack_size);
 int dss_ult_create_all(void (*func)(void *), void *arg, bool main);
+int dss_offload_submit(int (*func)(void *), void *arg, void (*user_cb)(void *),
+		       void *cb_args);
 int __attribute__((weak)) dss_offload_exec(int (*func)(void *), void *arg);
 int __attribute__((weak)) dss_main_exec(void (*func)(void *), void *arg);
 
@@ -12,6 +12,7 @@
 enum tier_policy_t {
 	DAOS_MEDIA_POLICY_IO_SIZE,
 	DAOS_MEDIA_POLICY_WRITE_INTENSIVITY,
+	DAOS_MEDIA_POLICY_HOT_COLD,
 	DAOS_MEDIA_POLICY_MAX
 };
 
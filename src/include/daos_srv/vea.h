@@ -68,6 +68,8 @@ struct vea_unmap_context {
 	int (*vnc_unmap)(d_sg_list_t *unmap_sgl, uint32_t blk_sz, void *data);
 	void *vnc_data;
 	bool vnc_ext_flush;
+	/* Serve small & medium reservations from pre-reserved per size class runs */
+	bool vnc_alloc_cache;
 };
 
 #define	VEA_COMPAT_FEATURE_BITMAP	(1 << 0)
@@ -110,6 +112,7 @@ struct vea_stat {
 	uint64_t	vs_frags_small;	/* Small free frags */
 	uint64_t	vs_frags_bitmap; /* Bitmap frags */
 	uint64_t	vs_frags_aging;	/* Aging frags */
+	uint64_t	vs_resrv_cache;	/* Number of allocation cache reserve */
 };
 
 struct vea_space_info;
@@ -313,6 +316,30 @@ int vea_query(struct vea_space_info *vsi, struct vea_attr *attr,
  */
 int vea_flush(struct vea_space_info *vsi, bool force, uint32_t nr_flush, uint32_t *nr_flushed);
 
+/**
+ * Calculate the free space fragmentation index, which is the percentage of free
+ * blocks not covered by the largest free extent. 0 means no fragmentation at all,
+ * the index gets close to 100 when free space is scattered in tiny fragments.
+ *
+ * \param vsi        [IN]	In-memory compound index
+ *
+ * \return			Fragmentation index in [0, 100]
+ */
+unsigned int vea_frag_index(struct vea_space_info *vsi);
+
+/**
+ * Check if relocating an allocated extent helps compacting free space, that's
+ * the extent is sandwiched by two small free extents, so the three fragments
+ * will be coalesced into one once the extent is freed.
+ *
+ * \param vsi        [IN]	In-memory compound index
+ * \param blk_off    [IN]	Block offset of the allocated extent
+ * \param blk_cnt    [IN]	Block count of the allocated extent
+ *
+ * \return			True if the extent is worth relocating
+ */
+bool vea_defrag_candidate(struct vea_space_info *vsi, uint64_t blk_off, uint32_t blk_cnt);
+
 /**
  * Free metrcis
  *
@@ -464,6 +464,7 @@ vos_cont_query(daos_handle_t coh, vos_cont_info_t *cinfo);
 enum {
 	VOS_AGG_FL_FORCE_SCAN	= (1UL << 0),	/* Scan all obj/dkey/akeys */
 	VOS_AGG_FL_FORCE_MERGE	= (1UL << 1),	/* Merge all coalesce-able EV records */
+	VOS_AGG_FL_DEFRAG	= (1UL << 2),	/* Relocate EV records to compact NVMe space */
 };
 
 /**
@@ -1036,6 +1037,31 @@ int
 vos_iter_fetch(daos_handle_t ih, vos_iter_entry_t *entry,
 	       daos_anchor_t *anchor);
 
+/**
+ * Return up to \a nr entries starting from the current cursor, and move the
+ * cursor to the entry after the last returned one. It is equivalent to calling
+ * vos_iter_fetch() and vos_iter_next() \a nr times, but the iterator state is
+ * only validated once.
+ *
+ * Returned entries may reference the tree records, they are only valid until
+ * the caller yields or modifies the tree.
+ *
+ * \param ih	[IN]	Iterator handle
+ * \param ents	[OUT]	Array of returned entries
+ * \param anchors [OUT]	Optional, array of position anchors for the entries
+ * \param nr	[IN/OUT] Size of \a ents (and \a anchors) as input, number of
+ *			returned entries as output
+ *
+ * \return		Zero if there are more entries
+ *			-DER_NONEXIST if no more entry, \a nr can be non-zero
+ *			negative value if error, \a nr can be non-zero
+ *			positive value if the iterator needs to be probed
+ *			again, see vos_iter_next()
+ */
+int
+vos_iter_fetch_batch(daos_handle_t ih, vos_iter_entry_t *ents,
+		     daos_anchor_t *anchors, uint32_t *nr);
+
 /**
  * Copy out the data fetched by vos_iter_fetch()
  *
@@ -363,8 +363,15 @@ enum {
 	VOS_IT_FOR_DISCARD	= (1 << 7),
 	/** Entry is not committed */
 	VOS_IT_UNCOMMITTED	= (1 << 8),
+	/**
+	 * vos_iterate() fetches entries in batches for non-recursive iteration
+	 * without post callback. The callback must not access the entry via the
+	 * iterator handle, and must return VOS_ITER_CB_DELETE if it modified
+	 * the iterated tree.
+	 */
+	VOS_IT_BATCH		= (1 << 9),
 	/** Mask for all flags */
-	VOS_IT_MASK		= (1 << 9) - 1,
+	VOS_IT_MASK		= (1 << 10) - 1,
 };
 
 typedef struct {
@@ -424,6 +431,13 @@ typedef struct {
 	void			*ip_filter_arg;
 	/** flags for for iterator */
 	uint32_t		ip_flags;
+	/**
+	 * Partition of the object index to iterate (VOS_ITER_OBJ only), the OID
+	 * space is split into @ip_part_nr disjoint ranges which can be iterated
+	 * concurrently by different ULTs. 0 or 1 @ip_part_nr for the whole index.
+	 */
+	uint32_t		ip_part_id;
+	uint32_t		ip_part_nr;
 } vos_iter_param_t;
 
 enum {
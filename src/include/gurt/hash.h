@@ -205,6 +205,24 @@ enum d_hash_feats {
 	 */
 	D_HASH_FT_NO_KEYINIT_LOCK	= (1 << 5),
 
+	/**
+	 * Lock-free lookup hash table with open addressing.
+	 *
+	 * Records are stored in cache line sized groups of slots with inline
+	 * fingerprints, lookup and traverse never take any lock, insertion and
+	 * deletion are serialized per home group by spinlock. Deleted records
+	 * are released only after all the concurrent lookups have finished:
+	 * with hop_rec_decref(), the table's refcount is dropped in batches
+	 * some time after the deletion (see d_hash_table_reclaim()), without
+	 * it, the deletion waits for the concurrent lookups.
+	 *
+	 * The table can hold at most 7 * power2(bits) records, it can't be used
+	 * with D_HASH_FT_EPHEMERAL or D_HASH_FT_LRU, hop_rec_hash() is mandatory,
+	 * and hop_rec_addref/decref have to be atomic as for D_HASH_FT_RWLOCK.
+	 * Records can't be deleted from d_hash_table_traverse() callback.
+	 */
+	D_HASH_FT_LOCKFREE		= (1 << 6),
+
 	/**
 	 * Use Global Table Lock instead of per bucket locking.
 	 * TODO: should be removed when all will use per bucket locking.
@@ -218,6 +236,9 @@ union d_hash_lock {
 	pthread_rwlock_t	rwlock;
 };
 
+/** Internal data of D_HASH_FT_LOCKFREE hash table */
+struct d_hash_lf;
+
 struct d_hash_bucket {
 	d_list_t		hb_head;
 #if D_HASH_DEBUG
@@ -248,6 +269,8 @@ struct d_hash_table {
 	struct d_hash_bucket	*ht_buckets;
 	/** different type of locks based on ht_feats */
 	union d_hash_lock	*ht_locks;
+	/** open addressing slots for D_HASH_FT_LOCKFREE */
+	struct d_hash_lf	*ht_lf;
 };
 
 /**
@@ -305,6 +328,15 @@ typedef int (*d_hash_traverse_cb_t)(d_list_t *link, void *arg);
 int  d_hash_table_traverse(struct d_hash_table *htable,
 			   d_hash_traverse_cb_t cb, void *arg);
 
+/**
+ * Drop the table's refcount of all the records deleted from a
+ * D_HASH_FT_LOCKFREE hash table whose release is still deferred.
+ * It's a noop for other types of hash table.
+ *
+ * \param[in] htable		The hash table.
+ */
+void d_hash_table_reclaim(struct d_hash_table *htable);
+
 /**
  * Destroy a hash table.
  *
@@ -18,6 +18,9 @@
 
 unsigned int	srv_io_mode = DIM_DTX_FULL_ENABLED;
 int		dc_obj_proto_version;
+unsigned int	obj_coalesce_max;
+unsigned int	obj_coalesce_size = OBJ_COALESCE_SIZE_DEF;
+unsigned int	obj_coalesce_window;
 
 /**
  * Initialize object interface
@@ -72,6 +75,20 @@ dc_obj_init(void)
 	d_getenv_bool("DAOS_TX_VERIFY_RDG", &tx_verify_rdg);
 	D_INFO("%s TX redundancy group verification\n", tx_verify_rdg ? "Enable" : "Disable");
 
+	d_getenv_int("DAOS_OBJ_COALESCE", &obj_coalesce_max);
+	if (obj_coalesce_max > OBJ_COALESCE_MAX) {
+		D_WARN("Invalid RPC coalescing count %u, set to max %u\n",
+		       obj_coalesce_max, OBJ_COALESCE_MAX);
+		obj_coalesce_max = OBJ_COALESCE_MAX;
+	}
+	if (obj_coalesce_max > 1) {
+		dc_tx_batch_init();
+		d_getenv_int("DAOS_OBJ_COALESCE_SIZE", &obj_coalesce_size);
+		d_getenv_int("DAOS_OBJ_COALESCE_WINDOW", &obj_coalesce_window);
+		D_INFO("Coalesce up to %u transactions per CPD RPC, update size %u, window %u us\n",
+		       obj_coalesce_max, obj_coalesce_size, obj_coalesce_window);
+	}
+
 out_class:
 	if (rc)
 		obj_class_fini();
@@ -5663,6 +5663,23 @@ out:
 	return rc;
 }
 
+/*
+ * Small stand-alone update is converted to internal transaction when RPC coalescing is enabled,
+ * then independent updates to the same leader target can be packed into single CPD RPC.
+ */
+static bool
+obj_update_coalesce(struct obj_auxi_args *obj_auxi, daos_obj_update_t *args)
+{
+	if (obj_coalesce_max <= 1 || srv_io_mode != DIM_DTX_FULL_ENABLED)
+		return false;
+
+	if (obj_auxi->io_retry || daos_handle_is_valid(obj_auxi->th) ||
+	    obj_req_with_cond_flags(args->flags))
+		return false;
+
+	return daos_iods_len(args->iods, args->nr) <= obj_coalesce_size;
+}
+
 static int
 dc_obj_update(tse_task_t *task, struct dtx_epoch *epoch, uint32_t map_ver,
 	      daos_obj_update_t *args, struct dc_object *obj)
@@ -5686,7 +5703,7 @@ dc_obj_update(tse_task_t *task, struct dtx_epoch *epoch, uint32_t map_ver,
 		D_GOTO(out_task, rc);
 	}
 
-	if (obj_auxi->tx_convert) {
+	if (obj_auxi->tx_convert || obj_update_coalesce(obj_auxi, args)) {
 		if (obj_auxi->is_ec_obj && obj_auxi->req_reasbed) {
 			args->iods = obj_auxi->reasb_req.orr_uiods;
 			args->sgls = obj_auxi->reasb_req.orr_usgls;
@@ -45,6 +45,18 @@ extern unsigned int	srv_io_mode;
 /* Whether check redundancy group validation when DTX resync. */
 extern bool	tx_verify_rdg;
 
+/* Max independent transactions that can be packed in one CPD RPC. */
+#define OBJ_COALESCE_MAX	64
+/* Default max size of stand-alone update to be coalesced. */
+#define OBJ_COALESCE_SIZE_DEF	4096
+
+/** Max transactions per coalesced CPD RPC, 0 or 1 means coalescing disabled. */
+extern unsigned int	obj_coalesce_max;
+/** Max payload size of stand-alone update to be converted for coalescing. */
+extern unsigned int	obj_coalesce_size;
+/** Delay (in micro-seconds) for collecting more transactions into the CPD RPC. */
+extern unsigned int	obj_coalesce_window;
+
 /** client object shard */
 struct dc_obj_shard {
 	/** refcount */
@@ -879,6 +891,9 @@ dc_tx_attach(daos_handle_t th, struct dc_object *obj, enum obj_rpc_opc opc, tse_
 int
 dc_tx_convert(struct dc_object *obj, enum obj_rpc_opc opc, tse_task_t *task);
 
+void
+dc_tx_batch_init(void);
+
 int
 iov_alloc_for_csum_info(d_iov_t *iov, struct dcs_csum_info *csum_info);
 
@@ -108,6 +108,8 @@ struct dc_tx {
 	uint16_t		 tx_inprogress_cnt;
 	/** Pool map version when trigger first IO. */
 	uint32_t		 tx_pm_ver;
+	/** Estimated inline CPD RPC body size. */
+	uint32_t		 tx_body_size;
 	/** Reference the pool. */
 	struct dc_pool          *tx_pool;
 
@@ -964,6 +966,8 @@ struct tx_commit_cb_args {
 	struct dc_tx		*tcca_tx;
 	crt_rpc_t		*tcca_req;
 	daos_tx_commit_t	*tcca_args;
+	/* The index of the TX in the (coalesced) CPD RPC. */
+	uint32_t		 tcca_idx;
 };
 
 static int
@@ -984,8 +988,8 @@ dc_tx_commit_cb(tse_task_t *task, void *data)
 		if (rc == 0) {
 			int	*sub_rets = oco->oco_sub_rets.ca_arrays;
 
-			/* FIXME: currently, we pack one DTX per CPD RPC. */
-			rc = sub_rets[0];
+			D_ASSERT(tcca->tcca_idx < oco->oco_sub_rets.ca_count);
+			rc = sub_rets[tcca->tcca_idx];
 		}
 	}
 
@@ -995,25 +999,26 @@ dc_tx_commit_cb(tse_task_t *task, void *data)
 	D_MUTEX_LOCK(&tx->tx_lock);
 
 	if (rc == 0) {
-		uint64_t	*sub_epochs = oco->oco_sub_epochs.ca_arrays;
+		uint64_t	 sub_epoch;
+
+		D_ASSERT(tcca->tcca_idx < oco->oco_sub_epochs.ca_count);
+		sub_epoch = ((uint64_t *)oco->oco_sub_epochs.ca_arrays)[tcca->tcca_idx];
 
 		tx->tx_status = TX_COMMITTED;
 		dc_tx_cleanup(tx);
 
-		/* FIXME: currently, we pack one DTX per CPD RPC. */
-
 		if (tx->tx_epoch.oe_value == 0) {
-			if (sub_epochs[0] == 0) {
+			if (sub_epoch == 0) {
 				D_WARN("Server forgot to reply epoch for TX "
 				       DF_DTI"\n", DP_DTI(&tx->tx_id));
 			} else {
-				tx->tx_epoch.oe_value = sub_epochs[0];
+				tx->tx_epoch.oe_value = sub_epoch;
 				tx->tx_epoch.oe_flags &= ~DTX_EPOCH_UNCERTAIN;
 			}
-		} else if (tx->tx_epoch.oe_value != sub_epochs[0]) {
+		} else if (tx->tx_epoch.oe_value != sub_epoch) {
 			D_WARN("Server replied different epoch for TX "DF_DTI
 			       ": c "DF_U64", s "DF_U64"\n", DP_DTI(&tx->tx_id),
-			       tx->tx_epoch.oe_value, sub_epochs[0]);
+			       tx->tx_epoch.oe_value, sub_epoch);
 		} else {
 			tx->tx_epoch.oe_flags &= ~DTX_EPOCH_UNCERTAIN;
 		}
@@ -2090,8 +2095,8 @@ dc_tx_commit_prepare(struct dc_tx *tx, tse_task_t *task)
 		}
 	}
 
-	/* NOTE: Currently, we only pack single DTX per CPD RPC, then elect
-	 *	 the first targets in the dispatch list as the leader.
+	/* NOTE: Elect the first targets in the dispatch list as the leader. Independent
+	 *	 DTXs with the same leader may be coalesced into one CPD RPC.
 	 */
 	tx->tx_leader_rank = shard_tgts[0].st_rank;
 	tx->tx_leader_tag = shard_tgts[0].st_tgt_idx;
@@ -2216,6 +2221,7 @@ dc_tx_commit_prepare(struct dc_tx *tx, tse_task_t *task)
 	 * tx->tx_tgts_bulk.dcb_iov.iov_buf in dc_tx_cleanup().
 	 */
 	shard_tgts = NULL;
+	tx->tx_body_size = body_size;
 
 	dc_tx_dump(tx);
 
@@ -2250,6 +2256,254 @@ out:
 	return rc < 0 ? rc : 0;
 }
 
+/*
+ * Independent DTXs sharing the same leader target are coalesced into one CPD RPC. The first
+ * TX creates the batch and schedules the send task, the others committed before the send task
+ * runs (in the same scheduler progress pass, or within obj_coalesce_window) join the batch.
+ * The server handles each DTX independently and replies per DTX result and epoch.
+ */
+#define TX_BATCH_BUCKETS	64
+
+struct dc_tx_batch_member {
+	struct dc_tx		*dtbm_tx;
+	tse_task_t		*dtbm_task;
+};
+
+struct dc_tx_batch {
+	/* Link into tx_batch_buckets when the batch is open for new member. */
+	d_list_t			 dtb_link;
+	struct dc_cont			*dtb_co;
+	tse_sched_t			*dtb_sched;
+	crt_rpc_t			*dtb_req;
+	uint32_t			 dtb_rank;
+	uint32_t			 dtb_tag;
+	uint32_t			 dtb_pm_ver;
+	uint32_t			 dtb_flags;
+	uint32_t			 dtb_nr;
+	uint32_t			 dtb_size;
+	struct daos_cpd_sg		*dtb_sgs;
+	struct dc_tx_batch_member	 dtb_members[0];
+};
+
+static pthread_mutex_t	tx_batch_lock = PTHREAD_MUTEX_INITIALIZER;
+static d_list_t		tx_batch_buckets[TX_BATCH_BUCKETS];
+
+void
+dc_tx_batch_init(void)
+{
+	int	i;
+
+	for (i = 0; i < TX_BATCH_BUCKETS; i++)
+		D_INIT_LIST_HEAD(&tx_batch_buckets[i]);
+}
+
+static inline bool
+dc_tx_batch_eligible(struct dc_tx *tx)
+{
+	/* Resent CPD RPC is marked as 'resend' as a whole, send it separately. */
+	if (obj_coalesce_max <= 1 || tx->tx_retry || tx->tx_set_resend)
+		return false;
+
+	/* Only the TX with whole body inline is coalesced, the batch is limited by bulk size. */
+	return tx->tx_head.dcs_type == DCST_HEAD && tx->tx_reqs.dcs_type == DCST_REQ_CLI &&
+	       tx->tx_disp.dcs_type == DCST_ENT && tx->tx_tgts.dcs_type == DCST_TGT &&
+	       tx->tx_body_size < DAOS_BULK_LIMIT / 2;
+}
+
+static inline d_list_t *
+dc_tx_batch_bucket(uint32_t rank, uint32_t tag)
+{
+	return &tx_batch_buckets[(rank * 31 + tag) % TX_BATCH_BUCKETS];
+}
+
+static inline uint32_t
+dc_tx_batch_flags(struct dc_tx *tx)
+{
+	return tx->tx_reintegrating ? ORF_REINTEGRATING_IO : 0;
+}
+
+static int
+dc_tx_batch_comp_cb(tse_task_t *task, void *data)
+{
+	struct dc_tx_batch	*batch = tse_task_get_priv(task);
+	int			 rc = task->dt_result;
+	int			 i;
+
+	D_DEBUG(DB_IO, "Coalesced CPD RPC with %u TXs to %u/%u done: "DF_RC"\n",
+		batch->dtb_nr, batch->dtb_rank, batch->dtb_tag, DP_RC(rc));
+
+	/* The reply is processed by dc_tx_commit_cb() on each member. */
+	for (i = 0; i < batch->dtb_nr; i++)
+		tse_task_complete(batch->dtb_members[i].dtbm_task, rc);
+
+	crt_req_decref(batch->dtb_req);
+	D_FREE(batch);
+
+	return 0;
+}
+
+static int
+dc_tx_batch_send(tse_task_t *task)
+{
+	struct dc_tx_batch	*batch = tse_task_get_priv(task);
+	struct obj_cpd_in	*oci = crt_req_get(batch->dtb_req);
+	struct daos_cpd_sg	*sgs = batch->dtb_sgs;
+	struct dc_tx		*tx;
+	uint32_t		 nr;
+	int			 rc;
+	int			 i;
+
+	/* Close the batch, no more member after that. */
+	D_MUTEX_LOCK(&tx_batch_lock);
+	if (!d_list_empty(&batch->dtb_link))
+		d_list_del_init(&batch->dtb_link);
+	D_MUTEX_UNLOCK(&tx_batch_lock);
+
+	nr = batch->dtb_nr;
+	D_ASSERT(nr > 0);
+
+	/* For test, fail the batch if it does not carry the expected count of TXs. */
+	if (DAOS_FAIL_CHECK(DAOS_OBJ_COALESCE_CHECK) && nr != daos_fail_value_get()) {
+		D_ERROR("Coalesced CPD RPC with %u TXs, expected "DF_U64"\n",
+			nr, daos_fail_value_get());
+		tse_task_complete(task, -DER_MISMATCH);
+		return -DER_MISMATCH;
+	}
+
+	for (i = 0; i < nr; i++) {
+		tx = batch->dtb_members[i].dtbm_tx;
+		sgs[i] = tx->tx_head;
+		sgs[nr + i] = tx->tx_reqs;
+		sgs[nr * 2 + i] = tx->tx_disp;
+		sgs[nr * 3 + i] = tx->tx_tgts;
+	}
+
+	tx = batch->dtb_members[0].dtbm_tx;
+	rc = dc_cont2uuid(tx->tx_co, &oci->oci_co_hdl, &oci->oci_co_uuid);
+	D_ASSERT(rc == 0);
+
+	uuid_copy(oci->oci_pool_uuid, tx->tx_pool->dp_pool);
+	oci->oci_map_ver = batch->dtb_pm_ver;
+	oci->oci_flags = ORF_CPD_LEADER | batch->dtb_flags;
+
+	oci->oci_sub_heads.ca_arrays = sgs;
+	oci->oci_sub_heads.ca_count = nr;
+	oci->oci_sub_reqs.ca_arrays = sgs + nr;
+	oci->oci_sub_reqs.ca_count = nr;
+	oci->oci_disp_ents.ca_arrays = sgs + nr * 2;
+	oci->oci_disp_ents.ca_count = nr;
+	oci->oci_disp_tgts.ca_arrays = sgs + nr * 3;
+	oci->oci_disp_tgts.ca_count = nr;
+
+	D_DEBUG(DB_IO, "Send coalesced CPD RPC with %u TXs, %u bytes to %u/%u\n",
+		nr, batch->dtb_size, batch->dtb_rank, batch->dtb_tag);
+
+	crt_req_addref(batch->dtb_req);
+	return daos_rpc_send(batch->dtb_req, task);
+}
+
+/*
+ * Add the TX to the batch for its leader target. Return false if the TX cannot be coalesced,
+ * then the caller sends it via standalone CPD RPC.
+ */
+static bool
+dc_tx_batch_add(tse_task_t *task, struct dc_tx *tx, daos_tx_commit_t *args)
+{
+	struct tx_commit_cb_args	 tcca;
+	struct dc_tx_batch		*batch;
+	tse_task_t			*send_task = NULL;
+	tse_sched_t			*sched = tse_task2sched(task);
+	d_list_t			*head;
+	crt_endpoint_t			 tgt_ep;
+	uint32_t			 flags = dc_tx_batch_flags(tx);
+	int				 rc;
+
+	head = dc_tx_batch_bucket(tx->tx_leader_rank, tx->tx_leader_tag);
+
+	D_MUTEX_LOCK(&tx_batch_lock);
+	d_list_for_each_entry(batch, head, dtb_link) {
+		if (batch->dtb_co == tx->tx_co && batch->dtb_sched == sched &&
+		    batch->dtb_rank == tx->tx_leader_rank && batch->dtb_tag == tx->tx_leader_tag &&
+		    batch->dtb_pm_ver == tx->tx_pm_ver && batch->dtb_flags == flags &&
+		    batch->dtb_size + tx->tx_body_size < DAOS_BULK_LIMIT)
+			goto join;
+	}
+
+	D_ALLOC(batch, sizeof(*batch) + sizeof(batch->dtb_members[0]) * obj_coalesce_max +
+		       sizeof(*batch->dtb_sgs) * obj_coalesce_max * 4);
+	if (batch == NULL)
+		goto out;
+
+	tgt_ep.ep_grp = tx->tx_pool->dp_sys->sy_group;
+	tgt_ep.ep_tag = tx->tx_leader_tag;
+	tgt_ep.ep_rank = tx->tx_leader_rank;
+
+	rc = obj_req_create(daos_task2ctx(task), &tgt_ep, DAOS_OBJ_RPC_CPD, &batch->dtb_req);
+	if (rc != 0)
+		goto out_batch;
+
+	rc = tse_task_create(dc_tx_batch_send, sched, batch, &send_task);
+	if (rc != 0)
+		goto out_req;
+
+	/* The batch will be released via dc_tx_batch_comp_cb() since now. */
+	rc = tse_task_register_comp_cb(send_task, dc_tx_batch_comp_cb, NULL, 0);
+	if (rc != 0) {
+		tse_task_complete(send_task, rc);
+		goto out_req;
+	}
+
+	batch->dtb_co = tx->tx_co;
+	batch->dtb_sched = sched;
+	batch->dtb_rank = tx->tx_leader_rank;
+	batch->dtb_tag = tx->tx_leader_tag;
+	batch->dtb_pm_ver = tx->tx_pm_ver;
+	batch->dtb_flags = flags;
+	batch->dtb_sgs = (struct daos_cpd_sg *)&batch->dtb_members[obj_coalesce_max];
+
+join:
+	crt_req_addref(batch->dtb_req);
+	tcca.tcca_req = batch->dtb_req;
+	tcca.tcca_tx = tx;
+	tcca.tcca_args = args;
+	tcca.tcca_idx = batch->dtb_nr;
+
+	rc = tse_task_register_comp_cb(task, dc_tx_commit_cb, &tcca, sizeof(tcca));
+	if (rc != 0) {
+		crt_req_decref(batch->dtb_req);
+		/* Complete the new created send task with empty batch that will release it. */
+		if (send_task != NULL)
+			tse_task_complete(send_task, rc);
+		goto out;
+	}
+
+	batch->dtb_members[batch->dtb_nr].dtbm_tx = tx;
+	batch->dtb_members[batch->dtb_nr].dtbm_task = task;
+	batch->dtb_nr++;
+	batch->dtb_size += tx->tx_body_size;
+	if (send_task != NULL)
+		d_list_add_tail(&batch->dtb_link, head);
+	else if (batch->dtb_nr == obj_coalesce_max)
+		d_list_del_init(&batch->dtb_link);
+
+	tx->tx_renew = 0;
+	tx->tx_status = TX_COMMITTING;
+	D_MUTEX_UNLOCK(&tx_batch_lock);
+
+	if (send_task != NULL)
+		tse_task_schedule_with_delay(send_task, false, obj_coalesce_window);
+
+	return true;
+
+out_req:
+	crt_req_decref(batch->dtb_req);
+out_batch:
+	D_FREE(batch);
+out:
+	D_MUTEX_UNLOCK(&tx_batch_lock);
+	return false;
+}
+
 static int
 dc_tx_commit_trigger(tse_task_t *task, struct dc_tx *tx, daos_tx_commit_t *args)
 {
@@ -2275,6 +2529,12 @@ dc_tx_commit_trigger(tse_task_t *task, struct dc_tx *tx, daos_tx_commit_t *args)
 			goto out;
 	}
 
+	if (dc_tx_batch_eligible(tx) && dc_tx_batch_add(task, tx, args)) {
+		/* The task will be completed when the coalesced CPD RPC replied. */
+		D_MUTEX_UNLOCK(&tx->tx_lock);
+		return 0;
+	}
+
 	tgt_ep.ep_grp = tx->tx_pool->dp_sys->sy_group;
 	tgt_ep.ep_tag = tx->tx_leader_tag;
 	tgt_ep.ep_rank = tx->tx_leader_rank;
@@ -2288,6 +2548,7 @@ dc_tx_commit_trigger(tse_task_t *task, struct dc_tx *tx, daos_tx_commit_t *args)
 	tcca.tcca_req = req;
 	tcca.tcca_tx = tx;
 	tcca.tcca_args = args;
+	tcca.tcca_idx = 0;
 
 	rc = tse_task_register_comp_cb(task, dc_tx_commit_cb,
 				       &tcca, sizeof(tcca));
@@ -656,19 +656,17 @@ out:
 /* Xstream offload function for encoding new parity from full stripe of
  * replicas.
  */
-static void
+static int
 agg_encode_full_stripe_ult(void *arg)
 {
-	struct ec_agg_stripe_ud	*stripe_ud =
-					(struct ec_agg_stripe_ud *)arg;
-	struct ec_agg_entry	*entry = stripe_ud->asu_agg_entry;
+	struct ec_agg_entry	*entry = arg;
 	unsigned int		 k = ec_age2k(entry);
 	unsigned int		 p = ec_age2p(entry);
 	unsigned int		 cell_bytes = ec_age2cs_b(entry);
 	unsigned char		*data[OBJ_EC_MAX_K];
 	unsigned char		*parity_bufs[OBJ_EC_MAX_P];
 	unsigned char		*buf;
-	int			 i, rc = 0;
+	int			 i;
 
 	buf = entry->ae_sgl.sg_iovs[AGG_IOV_DATA].iov_buf;
 	for (i = 0; i < k; i++)
@@ -681,7 +679,7 @@ agg_encode_full_stripe_ult(void *arg)
 	ec_encode_data(cell_bytes, k, p, entry->ae_codec->ec_gftbls, data,
 		       parity_bufs);
 
-	ABT_eventual_set(stripe_ud->asu_eventual, (void *)&rc, sizeof(rc));
+	return 0;
 }
 
 /* Encodes a full stripe. Called when replicas form a full stripe.
@@ -689,36 +687,8 @@ agg_encode_full_stripe_ult(void *arg)
 static int
 agg_encode_full_stripe(struct ec_agg_entry *entry)
 {
-	struct ec_agg_stripe_ud		stripe_ud = { 0 };
-	int				*status;
-	int				tid, rc = 0;
-
-	stripe_ud.asu_agg_entry = entry;
-	tid = dss_get_module_info()->dmi_tgt_id;
-	rc = ABT_eventual_create(sizeof(*status), &stripe_ud.asu_eventual);
-	if (rc != ABT_SUCCESS) {
-		rc = dss_abterr2der(rc);
-		goto out;
-	}
-	rc = dss_ult_create(agg_encode_full_stripe_ult, &stripe_ud,
-			    DSS_XS_OFFLOAD, tid, 0, NULL);
-	if (rc)
-		goto ev_out;
-
-	rc = ABT_eventual_wait(stripe_ud.asu_eventual, (void **)&status);
-	if (rc != ABT_SUCCESS) {
-		rc = dss_abterr2der(rc);
-		goto ev_out;
-	}
-	if (*status != 0)
-		rc = *status;
-	else
-		rc = 0;
-
-ev_out:
-	ABT_eventual_free(&stripe_ud.asu_eventual);
-out:
-	return rc;
+	/* Pure computation, it could be stolen by any idle helper XS */
+	return dss_offload_exec(agg_encode_full_stripe_ult, entry);
 }
 
 /* Driver function for full_stripe encode. Fetches the data and then invokes
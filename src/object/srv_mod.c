@@ -206,6 +206,20 @@ struct dss_module_key obj_module_key = {
 	.dmk_fini = obj_tls_fini,
 };
 
+static void
+obj_rw_req_attr(struct obj_rw_in *orw, struct sched_req_attr *attr)
+{
+	attr->sra_size = daos_iods_len(orw->orw_iod_array.oia_iods,
+				       orw->orw_iod_array.oia_iod_nr);
+	/* Unknown size (e.g. size query) is only charged against the IOPS limit */
+	if (attr->sra_size == (daos_size_t)-1)
+		attr->sra_size = 0;
+
+	/* Data recovery IO inherits the priority of the rebuild ULT which issued it */
+	if (orw->orw_flags & (ORF_FOR_MIGRATION | ORF_EC_RECOV))
+		attr->sra_flags |= SCHED_REQ_FL_INHERIT;
+}
+
 static int
 obj_get_req_attr(crt_rpc_t *rpc, struct sched_req_attr *attr)
 {
@@ -214,11 +228,13 @@ obj_get_req_attr(crt_rpc_t *rpc, struct sched_req_attr *attr)
 
 		sched_req_attr_init(attr, SCHED_REQ_UPDATE,
 				    &orw->orw_pool_uuid);
+		obj_rw_req_attr(orw, attr);
 	} else if (obj_rpc_is_fetch(rpc)) {
 		struct obj_rw_in	*orw = crt_req_get(rpc);
 
 		sched_req_attr_init(attr, SCHED_REQ_FETCH,
 				    &orw->orw_pool_uuid);
+		obj_rw_req_attr(orw, attr);
 	} else if (obj_rpc_is_migrate(rpc)) {
 		struct obj_migrate_in	*omi = crt_req_get(rpc);
 
@@ -290,10 +290,15 @@ const char perf_daos_usage[] = "\n"
 "	and 64. The utility runs in synchronous mode if credits is set to 0.\n\n"
 "-c TINY|LARGE|R2S|R3S|R4S|EC2P1|EC2P2|EC4P2|EC8P2\n"
 "	Object class for DAOS full stack test.\n\n"
+"-B number\n"
+"	Coalesce up to 'number' small updates to the same target into one RPC.\n"
+"	It is same as setting DAOS_OBJ_COALESCE, should be used together with\n"
+"	asynchronous I/O (credits). The default value is 0 (disabled).\n\n"
 "-g dmg_conf\n"
 "	dmg configuration file.\n\n"
 "Examples:\n"
-"	$ daos_perf -C 16 -A -R 'U;p F;i=5;p V'\n";
+"	$ daos_perf -C 16 -A -R 'U;p F;i=5;p V'\n"
+"	$ daos_perf -C 64 -B 16 -s 64 -R 'U;p'\n";
 
 static void
 ts_print_usage(void)
@@ -310,11 +315,12 @@ const struct option perf_daos_opts[] = {
 	{ "type",	required_argument,	NULL,	'T' },
 	{ "credits",	required_argument,	NULL,	'C' },
 	{ "class",	required_argument,	NULL,	'c' },
+	{ "coalesce",	required_argument,	NULL,	'B' },
 	{ "dmg_conf",	required_argument,	NULL,	'g' },
 	{ NULL,		0,			NULL,	0   },
 };
 
-const char perf_daos_optstr[] = "T:C:c:g:";
+const char perf_daos_optstr[] = "T:C:c:B:g:";
 
 int
 main(int argc, char **argv)
@@ -323,6 +329,7 @@ main(int argc, char **argv)
 	char		*dmg_conf = NULL;
 	char		uuid_buf[256];
 	int		credits   = -1;	/* sync mode */
+	char		*coalesce = NULL;
 	d_rank_t	svc_rank  = 0;	/* pool service rank */
 	struct option	*ts_opts;
 	char		*ts_optstr;
@@ -380,12 +387,19 @@ main(int argc, char **argv)
 				return rc;
 			}
 			break;
+		case 'B':
+			coalesce = optarg;
+			break;
 		case 'g':
 			dmg_conf = optarg;
 			break;
 		}
 	}
 
+	/* Must be set before initializing DAOS client library. */
+	if (coalesce != NULL)
+		setenv("DAOS_OBJ_COALESCE", coalesce, 1);
+
 	if (!cmds) {
 		D_PRINT("Please provide command string\n");
 		ts_print_usage();
@@ -473,6 +487,7 @@ main(int argc, char **argv)
 			"Parameters :\n"
 			"\tpool size     : SCM: %u MB, NVMe: %u MB\n"
 			"\tcredits       : %d (sync I/O for -ve)\n"
+			"\tcoalesce      : %s\n"
 			"\tobj_per_cont  : %u x %d (procs)\n"
 			"\tdkey_per_obj  : %u (%s)\n"
 			"\takey_per_dkey : %u\n"
@@ -483,6 +498,7 @@ main(int argc, char **argv)
 			(unsigned int)(ts_scm_size >> 20),
 			(unsigned int)(ts_nvme_size >> 20),
 			credits,
+			coalesce == NULL ? "0" : coalesce,
 			ts_obj_p_cont,
 			ts_ctx.tsc_mpi_size,
 			ts_dkey_p_obj, ts_dkey_prefix == NULL ? "int" : "buf",
@@ -109,6 +109,22 @@ class DaosCoreTest(DaosCoreBase):
         """
         self.run_subtest()
 
+    def test_daos_single_rdg_tx_coalesce(self):
+        """Jira ID: DAOS-1568
+
+        Test Description:
+            Run daos_test -t with coalesced CPD RPCs (DAOS_OBJ_COALESCE=8)
+
+        Use cases:
+            Core tests for daos_test
+
+        :avocado: tags=all,pr,daily_regression
+        :avocado: tags=hw,medium,provider
+        :avocado: tags=daos_test,daos_core_test
+        :avocado: tags=DaosCoreTest,test_daos_single_rdg_tx_coalesce
+        """
+        self.run_subtest()
+
     def test_daos_distributed_tx(self):
         """Jira ID: DAOS-1568
 
@@ -881,6 +881,386 @@ dtx_21(void **state)
 	ioreq_fini(&req);
 }
 
+/*
+ * The following tests cover coalescing of small stand-alone updates into one CPD RPC. The
+ * coalescing is configured via client environment (DAOS_OBJ_COALESCE, DAOS_OBJ_COALESCE_SIZE)
+ * that is parsed in daos_init(), the tests are skipped if it is not enabled.
+ */
+#define DTX_COALESCE_KEY_LEN	32
+#define DTX_COALESCE_SIZE_DEF	4096
+
+struct dtx_coalesce_io {
+	daos_event_t	dci_ev;
+	daos_key_t	dci_dkey;
+	daos_iod_t	dci_iod;
+	d_sg_list_t	dci_sgl;
+	d_iov_t		dci_iov;
+	char		dci_dkey_buf[DTX_COALESCE_KEY_LEN];
+	char		dci_akey_buf[DTX_COALESCE_KEY_LEN];
+};
+
+static unsigned int
+dtx_coalesce_max(void)
+{
+	unsigned int	max = 0;
+
+	d_getenv_int("DAOS_OBJ_COALESCE", &max);
+	return max;
+}
+
+static unsigned int
+dtx_coalesce_size(void)
+{
+	unsigned int	size = DTX_COALESCE_SIZE_DEF;
+
+	d_getenv_int("DAOS_OBJ_COALESCE_SIZE", &size);
+	return size;
+}
+
+static void
+dtx_coalesce_key(char *dkey, char *akey, int idx, bool same_dkey)
+{
+	snprintf(dkey, DTX_COALESCE_KEY_LEN, "coalesce dkey %d", same_dkey ? 0 : idx);
+	snprintf(akey, DTX_COALESCE_KEY_LEN, "coalesce akey %d", idx);
+}
+
+static char **
+dtx_coalesce_bufs_alloc(int nr, daos_size_t size)
+{
+	char	**bufs;
+	int	  i;
+
+	D_ALLOC_ARRAY(bufs, nr);
+	assert_non_null(bufs);
+
+	for (i = 0; i < nr; i++) {
+		D_ALLOC(bufs[i], size);
+		assert_non_null(bufs[i]);
+		dts_buf_render(bufs[i], size);
+	}
+
+	return bufs;
+}
+
+static void
+dtx_coalesce_bufs_free(char **bufs, int nr)
+{
+	int	i;
+
+	for (i = 0; i < nr; i++)
+		D_FREE(bufs[i]);
+	D_FREE(bufs);
+}
+
+/*
+ * Issue @nr concurrent stand-alone single value updates of @size bytes, under the same dkey if
+ * @same_dkey or different dkeys otherwise. They are all committed before the scheduler makes
+ * progress, so can join the same batch. Return the result of each update via @rcs.
+ */
+static void
+dtx_coalesce_update(test_arg_t *arg, struct ioreq *req, int nr, daos_size_t size,
+		    bool same_dkey, char **bufs, int *rcs)
+{
+	struct dtx_coalesce_io	*ios;
+	struct dtx_coalesce_io	*io;
+	daos_event_t		*evp;
+	int			 rc;
+	int			 i;
+
+	D_ALLOC_ARRAY(ios, nr);
+	assert_non_null(ios);
+
+	for (i = 0; i < nr; i++) {
+		io = &ios[i];
+		dtx_coalesce_key(io->dci_dkey_buf, io->dci_akey_buf, i, same_dkey);
+		d_iov_set(&io->dci_dkey, io->dci_dkey_buf, strlen(io->dci_dkey_buf));
+		d_iov_set(&io->dci_iod.iod_name, io->dci_akey_buf, strlen(io->dci_akey_buf));
+		io->dci_iod.iod_type = DAOS_IOD_SINGLE;
+		io->dci_iod.iod_size = size;
+		io->dci_iod.iod_nr = 1;
+		d_iov_set(&io->dci_iov, bufs[i], size);
+		io->dci_sgl.sg_nr = 1;
+		io->dci_sgl.sg_iovs = &io->dci_iov;
+
+		rc = daos_event_init(&io->dci_ev, arg->eq, NULL);
+		assert_rc_equal(rc, 0);
+
+		rc = daos_obj_update(req->oh, DAOS_TX_NONE, 0, &io->dci_dkey, 1, &io->dci_iod,
+				     &io->dci_sgl, &io->dci_ev);
+		assert_rc_equal(rc, 0);
+	}
+
+	for (i = 0; i < nr; i++) {
+		rc = daos_eq_poll(arg->eq, 0, DAOS_EQ_WAIT, 1, &evp);
+		assert_int_equal(rc, 1);
+	}
+
+	for (i = 0; i < nr; i++) {
+		rcs[i] = ios[i].dci_ev.ev_error;
+		daos_event_fini(&ios[i].dci_ev);
+	}
+
+	D_FREE(ios);
+}
+
+/* Data of the successful updates are visible, the failed ones leave nothing. */
+static void
+dtx_coalesce_verify(struct ioreq *req, int nr, daos_size_t size, bool same_dkey,
+		    char **bufs, int *rcs)
+{
+	char	 dkey[DTX_COALESCE_KEY_LEN];
+	char	 akey[DTX_COALESCE_KEY_LEN];
+	char	*fetch_buf;
+	int	 i;
+
+	D_ALLOC(fetch_buf, size);
+	assert_non_null(fetch_buf);
+
+	for (i = 0; i < nr; i++) {
+		dtx_coalesce_key(dkey, akey, i, same_dkey);
+		memset(fetch_buf, 0, size);
+		lookup_single(dkey, akey, 0, fetch_buf, size, DAOS_TX_NONE, req);
+		if (rcs[i] == 0) {
+			assert_int_equal(req->iod[0].iod_size, size);
+			assert_memory_equal(bufs[i], fetch_buf, size);
+		} else {
+			assert_int_equal(req->iod[0].iod_size, 0);
+		}
+	}
+
+	D_FREE(fetch_buf);
+}
+
+/* The coalesced RPC on client is failed with -DER_MISMATCH if it does not carry @nr TXs. */
+static void
+dtx_coalesce_check(uint64_t fail_flag, int nr)
+{
+	daos_fail_value_set(nr);
+	daos_fail_loc_set(DAOS_OBJ_COALESCE_CHECK | fail_flag);
+}
+
+static void
+dtx_22(void **state)
+{
+	test_arg_t	*arg = *state;
+	unsigned int	 max = dtx_coalesce_max();
+	daos_obj_id_t	 oid;
+	struct ioreq	 req;
+	char		**bufs;
+	int		*rcs;
+	int		 nr;
+	int		 i;
+
+	FAULT_INJECTION_REQUIRED();
+
+	print_message("coalesced RPC with multiple TXs closed by count\n");
+
+	if (max <= 1) {
+		print_message("Skip: DAOS_OBJ_COALESCE is not set\n");
+		skip();
+	}
+
+	/* Twice of the max TXs per RPC, each batch will be closed when it is full. */
+	nr = max * 2;
+	bufs = dtx_coalesce_bufs_alloc(nr, dts_dtx_iosize);
+	D_ALLOC_ARRAY(rcs, nr);
+	assert_non_null(rcs);
+
+	oid = daos_test_oid_gen(arg->coh, OC_S1, 0, 0, arg->myrank);
+	ioreq_init(&req, arg->coh, oid, DAOS_IOD_SINGLE, arg);
+
+	dtx_coalesce_check(DAOS_FAIL_ALWAYS, max);
+	dtx_coalesce_update(arg, &req, nr, dts_dtx_iosize, false, bufs, rcs);
+	daos_fail_loc_set(0);
+	daos_fail_value_set(0);
+
+	for (i = 0; i < nr; i++)
+		assert_rc_equal(rcs[i], 0);
+
+	dtx_coalesce_verify(&req, nr, dts_dtx_iosize, false, bufs, rcs);
+
+	D_FREE(rcs);
+	dtx_coalesce_bufs_free(bufs, nr);
+	ioreq_fini(&req);
+}
+
+static void
+dtx_23(void **state)
+{
+	test_arg_t	*arg = *state;
+	unsigned int	 max = dtx_coalesce_max();
+	daos_size_t	 size = DTX_COALESCE_SIZE_DEF;
+	daos_obj_id_t	 oid;
+	struct ioreq	 req;
+	char		**bufs;
+	int		*rcs;
+	int		 i;
+
+	FAULT_INJECTION_REQUIRED();
+
+	print_message("coalesced RPC with multiple TXs closed by size\n");
+
+	/* The body of 5 TXs with 4KiB inline data each exceeds DAOS_BULK_LIMIT. */
+	if (max < 5 || dtx_coalesce_size() < size) {
+		print_message("Skip: DAOS_OBJ_COALESCE < 5 or DAOS_OBJ_COALESCE_SIZE < %u\n",
+			      (unsigned int)size);
+		skip();
+	}
+
+	bufs = dtx_coalesce_bufs_alloc(max, size);
+	D_ALLOC_ARRAY(rcs, max);
+	assert_non_null(rcs);
+
+	oid = daos_test_oid_gen(arg->coh, OC_S1, 0, 0, arg->myrank);
+	ioreq_init(&req, arg->coh, oid, DAOS_IOD_SINGLE, arg);
+
+	/* None of the batches can be full, all of them are closed by size. */
+	dtx_coalesce_check(DAOS_FAIL_ALWAYS, max);
+	dtx_coalesce_update(arg, &req, max, size, false, bufs, rcs);
+	daos_fail_loc_set(0);
+	daos_fail_value_set(0);
+
+	for (i = 0; i < max; i++)
+		assert_rc_equal(rcs[i], -DER_MISMATCH);
+
+	dtx_coalesce_verify(&req, max, size, false, bufs, rcs);
+
+	/* The same updates succeed without the check. */
+	dtx_coalesce_update(arg, &req, max, size, false, bufs, rcs);
+	for (i = 0; i < max; i++)
+		assert_rc_equal(rcs[i], 0);
+
+	dtx_coalesce_verify(&req, max, size, false, bufs, rcs);
+
+	D_FREE(rcs);
+	dtx_coalesce_bufs_free(bufs, max);
+	ioreq_fini(&req);
+}
+
+static void
+dtx_24(void **state)
+{
+	test_arg_t	*arg = *state;
+	unsigned int	 max = dtx_coalesce_max();
+	daos_obj_id_t	 oid;
+	struct ioreq	 req;
+	char		**bufs;
+	int		*rcs;
+	int		 failed = 0;
+	int		 i;
+
+	FAULT_INJECTION_REQUIRED();
+
+	print_message("per TX result in coalesced RPC\n");
+
+	if (max <= 1) {
+		print_message("Skip: DAOS_OBJ_COALESCE is not set\n");
+		skip();
+	}
+
+	bufs = dtx_coalesce_bufs_alloc(max, dts_dtx_iosize);
+	D_ALLOC_ARRAY(rcs, max);
+	assert_non_null(rcs);
+
+	print_message("one TX in the batch restarts on the leader\n");
+
+	oid = daos_test_oid_gen(arg->coh, OC_S1, 0, 0, arg->myrank);
+	ioreq_init(&req, arg->coh, oid, DAOS_IOD_SINGLE, arg);
+
+	/* The restarted TX is retried separately, the others are done by the first RPC. */
+	dtx_set_fail_loc(arg, DAOS_DTX_RESTART | DAOS_FAIL_ONCE);
+	dtx_coalesce_check(DAOS_FAIL_ONCE, max);
+	dtx_coalesce_update(arg, &req, max, dts_dtx_iosize, false, bufs, rcs);
+	daos_fail_loc_set(0);
+	daos_fail_value_set(0);
+	dtx_set_fail_loc(arg, 0);
+
+	for (i = 0; i < max; i++)
+		assert_rc_equal(rcs[i], 0);
+
+	dtx_coalesce_verify(&req, max, dts_dtx_iosize, false, bufs, rcs);
+	ioreq_fini(&req);
+
+	if (!test_runable(arg, dts_dtx_replica_cnt))
+		goto out;
+
+	print_message("one TX in the batch fails on the shard_1\n");
+
+	/* All TXs are against the same redundancy group, then share the leader. */
+	oid = daos_test_oid_gen(arg->coh, dts_dtx_class, 0, 0, arg->myrank);
+	ioreq_init(&req, arg->coh, oid, DAOS_IOD_SINGLE, arg);
+
+	dtx_set_fail_loc(arg, DAOS_DTX_FAIL_IO | DAOS_FAIL_ONCE);
+	dtx_coalesce_check(DAOS_FAIL_ONCE, max);
+	dtx_coalesce_update(arg, &req, max, dts_dtx_iosize, true, bufs, rcs);
+	daos_fail_loc_set(0);
+	daos_fail_value_set(0);
+	dtx_set_fail_loc(arg, 0);
+
+	for (i = 0; i < max; i++) {
+		if (rcs[i] != 0) {
+			assert_rc_equal(rcs[i], -DER_IO);
+			failed++;
+		}
+	}
+	assert_int_equal(failed, 1);
+
+	dtx_coalesce_verify(&req, max, dts_dtx_iosize, true, bufs, rcs);
+	ioreq_fini(&req);
+
+out:
+	D_FREE(rcs);
+	dtx_coalesce_bufs_free(bufs, max);
+}
+
+static void
+dtx_25(void **state)
+{
+	test_arg_t	*arg = *state;
+	unsigned int	 max = dtx_coalesce_max();
+	daos_obj_id_t	 oid;
+	struct ioreq	 req;
+	char		**bufs;
+	int		*rcs;
+	int		 i;
+
+	FAULT_INJECTION_REQUIRED();
+
+	print_message("resend coalesced RPC with lost reply\n");
+
+	if (max <= 1) {
+		print_message("Skip: DAOS_OBJ_COALESCE is not set\n");
+		skip();
+	}
+
+	bufs = dtx_coalesce_bufs_alloc(max, dts_dtx_iosize);
+	D_ALLOC_ARRAY(rcs, max);
+	assert_non_null(rcs);
+
+	oid = daos_test_oid_gen(arg->coh, OC_S1, 0, 0, arg->myrank);
+	ioreq_init(&req, arg->coh, oid, DAOS_IOD_SINGLE, arg);
+
+	/*
+	 * The reply of the coalesced RPC is lost, then each TX times out and is resent
+	 * separately with 'resend' flag, the server replies per the handled DTX.
+	 */
+	dtx_set_fail_loc(arg, DAOS_DTX_LOST_RPC_REPLY | DAOS_FAIL_ALWAYS);
+	dtx_coalesce_check(DAOS_FAIL_ONCE, max);
+	dtx_coalesce_update(arg, &req, max, dts_dtx_iosize, false, bufs, rcs);
+	daos_fail_loc_set(0);
+	daos_fail_value_set(0);
+	dtx_set_fail_loc(arg, 0);
+
+	for (i = 0; i < max; i++)
+		assert_rc_equal(rcs[i], 0);
+
+	dtx_coalesce_verify(&req, max, dts_dtx_iosize, false, bufs, rcs);
+
+	D_FREE(rcs);
+	dtx_coalesce_bufs_free(bufs, max);
+	ioreq_fini(&req);
+}
+
 static int
 dtx_base_rf0_setup(void **state)
 {
@@ -944,6 +1324,14 @@ static const struct CMUnitTest dtx_tests[] = {
 	 dtx_20, dtx_base_rf1_setup, test_case_teardown},
 	{"DTX21: do not abort partially committed DTX",
 	 dtx_21, dtx_base_rf0_setup, test_case_teardown},
+	{"DTX22: coalesced RPC with multiple TXs closed by count",
+	 dtx_22, NULL, test_case_teardown},
+	{"DTX23: coalesced RPC with multiple TXs closed by size",
+	 dtx_23, NULL, test_case_teardown},
+	{"DTX24: per TX result in coalesced RPC",
+	 dtx_24, NULL, test_case_teardown},
+	{"DTX25: resend coalesced RPC with lost reply",
+	 dtx_25, NULL, test_case_teardown},
 };
 
 static int
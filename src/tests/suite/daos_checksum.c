@@ -1748,6 +1748,59 @@ request_is_after_extent_start(void **state)
 	});
 }
 
+/**
+ * Fetch an unaligned sub-range of an extent larger than the server DMA chunk
+ * (8MB by default), so the server maps it to a dedicated huge chunk with a
+ * cached bulk handle. Because the fetch doesn't start on a csum chunk
+ * boundary, the server side IOV carries a csum prefix which must not be
+ * included in the RDMA transfer. Fetch twice so the second one reuses the
+ * cached huge chunk and its registration.
+ */
+static void
+huge_fetch_with_csum_prefix(void **state)
+{
+	struct csum_test_ctx	 ctx = {0};
+	daos_oclass_id_t	 oc = dts_csum_oc;
+	daos_recx_t		 fetch_recx;
+	daos_size_t		 data_len = 12 << 20;
+	char			*data;
+	int			 i;
+	int			 rc;
+
+	if (csum_ec_enabled() && !test_runable(*state, csum_ec_grp_size()))
+		skip();
+
+	setup_from_test_args(&ctx, (test_arg_t *)*state);
+	setup_single_recx_data(&ctx, "0", data_len);
+	/** Non-repeating pattern so that a shifted transfer can't match */
+	data = ctx.update_sgl.sg_iovs[0].iov_buf;
+	for (i = 0; i < data_len; i++)
+		data[i] = (char)((i >> 8) ^ (i * 7));
+
+	setup_cont_obj(&ctx, dts_csum_prop_type, false, 1024 * 32, oc);
+	rc = daos_obj_update(ctx.oh, DAOS_TX_NONE, 0, &ctx.dkey, 1,
+			     &ctx.update_iod, &ctx.update_sgl, NULL);
+	assert_success(rc);
+
+	fetch_recx.rx_idx = 1000;
+	fetch_recx.rx_nr = (9 << 20) + 123;
+	ctx.fetch_iod.iod_recxs = &fetch_recx;
+	ctx.fetch_sgl.sg_iovs[0].iov_len = fetch_recx.rx_nr;
+
+	for (i = 0; i < 2; i++) {
+		memset(ctx.fetch_sgl.sg_iovs[0].iov_buf, 0, fetch_recx.rx_nr);
+		rc = daos_obj_fetch(ctx.oh, DAOS_TX_NONE, 0, &ctx.dkey, 1,
+				    &ctx.fetch_iod, &ctx.fetch_sgl, NULL, NULL);
+		assert_success(rc);
+		assert_memory_equal(data + fetch_recx.rx_idx,
+				    ctx.fetch_sgl.sg_iovs[0].iov_buf,
+				    fetch_recx.rx_nr);
+	}
+
+	cleanup_data(&ctx);
+	cleanup_cont_obj(&ctx);
+}
+
 static bool
 rank_in_placement(uint32_t rank, struct daos_obj_layout *placement)
 {
@@ -2834,6 +2887,8 @@ static const struct CMUnitTest csum_tests[] = {
     CSUM_TEST("DAOS_CSUM18: request extent starts much later than the "
 	      "beginning of the stored extent",
 	      request_is_after_extent_start),
+    CSUM_TEST("DAOS_CSUM18.1: unaligned fetch larger than the server DMA chunk",
+	      huge_fetch_with_csum_prefix),
     CSUM_TEST("DAOS_CSUM19: DTX with checksum enabled against REP obj", dtx_with_csum),
     CSUM_TEST("DAOS_CSUM_REBUILD01: Array, Data is inlined", rebuild_1),
     CSUM_TEST("DAOS_CSUM_REBUILD02: Array, Data not inlined, not bulk", rebuild_2),
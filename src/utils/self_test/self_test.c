@@ -808,7 +808,7 @@ static int run_self_test(struct st_size_params all_params[],
 			 uint32_t num_ms_endpts_in,
 			 struct st_endpoint *endpts, uint32_t num_endpts,
 			 int output_megabits, int16_t buf_alignment,
-			 char *attach_info_path,
+			 bool bulk_recreate, bool bulk_cache, char *attach_info_path,
 			 bool use_daos_agent_vars)
 {
 	crt_context_t		  crt_ctx;
@@ -1000,6 +1000,8 @@ static int run_self_test(struct st_size_params all_params[],
 		test_params.send_type = all_params[size_idx].send_type;
 		test_params.reply_type = all_params[size_idx].reply_type;
 		test_params.buf_alignment = buf_alignment;
+		test_params.bulk_recreate = bulk_recreate;
+		test_params.bulk_cache = bulk_cache;
 		test_params.srv_grp = dest_name;
 
 		ret = test_msg_size(crt_ctx, ms_endpts, num_ms_endpts,
@@ -1235,6 +1237,19 @@ static void print_usage(const char *prog_name, const char *msg_sizes_str,
 	       "      Short version: -b\n"
 	       "      By default, self-test outputs performance results in MB (#Bytes/1024^2)\n"
 	       "      Specifying --Mbits switches the output to megabits (#bits/1000000)\n"
+	       "\n"
+	       "  --bulk-recreate\n"
+	       "      Short version: -k\n"
+	       "      Free and re-create the bulk handle before every bulk RPC instead of\n"
+	       "        registering each test buffer once. Measures the registration cost\n"
+	       "        seen by I/O paths.\n"
+	       "\n"
+	       "  --bulk-cache\n"
+	       "      Short version: -c\n"
+	       "      Register the test buffers with the bulk cache, so that re-created bulk\n"
+	       "        handles are taken from the cache. Use with --bulk-recreate to measure\n"
+	       "        the effect of the cache.\n"
+	       "\n"
 	       "  --path  /path/to/attach_info_file/directory/\n"
 	       "      Short version: -p  prefix\n"
 	       "      This option implies --singleton is set.\n"
@@ -1718,6 +1733,8 @@ int main(int argc, char *argv[])
 		CRT_ST_BUF_ALIGN_DEFAULT;
 	char				*attach_info_path = NULL;
 	bool				 use_daos_agent_vars = false;
+	bool				 bulk_recreate = false;
+	bool				 bulk_cache = false;
 
 	ret = d_log_init();
 	if (ret != 0) {
@@ -1735,6 +1752,8 @@ int main(int argc, char *argv[])
 			{"max-inflight-rpcs", required_argument, 0, 'i'},
 			{"align", required_argument, 0, 'a'},
 			{"Mbits", no_argument, 0, 'b'},
+			{"bulk-recreate", no_argument, 0, 'k'},
+			{"bulk-cache", no_argument, 0, 'c'},
 			{"singleton", no_argument, 0, 't'},
 			{"randomize-endpoints", no_argument, 0, 'q'},
 			{"path", required_argument, 0, 'p'},
@@ -1744,7 +1763,7 @@ int main(int argc, char *argv[])
 			{0, 0, 0, 0}
 		};
 
-		c = getopt_long(argc, argv, "g:m:e:s:r:i:a:bthnqp:u",
+		c = getopt_long(argc, argv, "g:m:e:s:r:i:a:bkcthnqp:u",
 				long_options, NULL);
 		if (c == -1)
 			break;
@@ -1794,6 +1813,12 @@ int main(int argc, char *argv[])
 		case 'b':
 			output_megabits = 1;
 			break;
+		case 'k':
+			bulk_recreate = true;
+			break;
+		case 'c':
+			bulk_cache = true;
+			break;
 		case 'p':
 			attach_info_path = optarg;
 			break;
@@ -1994,14 +2019,18 @@ int main(int argc, char *argv[])
 	else
 		printf("  Buffer addresses end with:  %d\n", buf_alignment);
 	printf("  Repetitions per size:       %d\n"
-	       "  Max in-flight RPCs:          %d\n\n",
-	       rep_count, max_inflight);
+	       "  Max in-flight RPCs:          %d\n"
+	       "  Bulk handle per RPC:        %s\n"
+	       "  Bulk cache:                 %s\n\n",
+	       rep_count, max_inflight, bulk_recreate ? "yes" : "no",
+	       bulk_cache ? "yes" : "no");
 
 	/********************* Run the self test *********************/
 	ret = run_self_test(all_params, num_msg_sizes, rep_count,
 			    max_inflight, dest_name, ms_endpts,
 			    num_ms_endpts, endpts, num_endpts,
-			    output_megabits, buf_alignment, attach_info_path,
+			    output_megabits, buf_alignment, bulk_recreate,
+			    bulk_cache, attach_info_path,
 			    use_daos_agent_vars);
 
 	/********************* Clean up *********************/
@@ -13,6 +13,7 @@
 #include <setjmp.h>
 #include <cmocka.h>
 #include <getopt.h>
+#include <pthread.h>
 
 #include <daos/tests_lib.h>
 #include <daos/common.h>
@@ -593,7 +594,7 @@ ut_free_bitmap(void **state)
 }
 
 static int
-ut_setup(struct vea_ut_args *test_args)
+ut_setup_path(struct vea_ut_args *test_args, const char *path)
 {
 	daos_size_t pool_size = (50 << 20); /* 50MB */
 	struct umem_attr uma = {0};
@@ -603,10 +604,10 @@ ut_setup(struct vea_ut_args *test_args)
 	memset(test_args, 0, sizeof(struct vea_ut_args));
 	D_INIT_LIST_HEAD(&test_args->vua_alloc_list);
 
-	unlink(pool_file);
+	unlink(path);
 
 	uma.uma_id = UMEM_CLASS_PMEM;
-	uma.uma_pool = umempobj_create(pool_file, "vea_ut", 0,
+	uma.uma_pool = umempobj_create(path, "vea_ut", 0,
 					     pool_size, 0666, NULL);
 	if (uma.uma_pool == NULL) {
 		fprintf(stderr, "create pmemobj pool error\n");
@@ -651,6 +652,12 @@ error:
 	return rc;
 }
 
+static int
+ut_setup(struct vea_ut_args *test_args)
+{
+	return ut_setup_path(test_args, pool_file);
+}
+
 static int
 vea_ut_setup(void **state)
 {
@@ -1587,6 +1594,286 @@ ut_reclaim_unused_bitmap(void **state)
 	ut_teardown(&args);
 }
 
+static void
+ut_alloc_cache(void **state)
+{
+	struct vea_ut_args		 args;
+	struct vea_unmap_context	 unmap_ctxt = { 0 };
+	struct vea_resrvd_ext		*ext;
+	struct vea_stat			 stat;
+	struct vea_attr			 attr;
+	d_list_t			*r_list;
+	uint64_t			 capacity = 1llu << 30; /* 1 GiB */
+	uint64_t			 off;
+	uint32_t			 nr_flushed;
+	int				 i, rc;
+
+	print_message("Test allocation cache\n");
+	ut_setup(&args);
+	rc = vea_format(&args.vua_umm, &args.vua_txd, args.vua_md, 0, 1, capacity,
+			NULL, NULL, false);
+	assert_rc_equal(rc, 0);
+
+	unmap_ctxt.vnc_alloc_cache = true;
+	rc = vea_load(&args.vua_umm, &args.vua_txd, args.vua_md, &unmap_ctxt,
+		      NULL, &args.vua_vsi);
+	assert_rc_equal(rc, 0);
+
+	/* Medium sized reservations are carved from the same cached run */
+	r_list = &args.vua_resrvd_list[0];
+	off = VEA_HINT_OFF_INVAL;
+	for (i = 0; i < 4; i++) {
+		rc = vea_reserve(args.vua_vsi, 100, NULL, r_list);
+		assert_rc_equal(rc, 0);
+
+		ext = d_list_entry(r_list->prev, struct vea_resrvd_ext, vre_link);
+		assert_int_equal(ext->vre_blk_cnt, 100);
+		assert_null(ext->vre_private);
+		if (off != VEA_HINT_OFF_INVAL)
+			assert_int_equal(ext->vre_blk_off, off);
+		off = ext->vre_blk_off + ext->vre_blk_cnt;
+
+		rc = vea_verify_alloc(args.vua_vsi, true, ext->vre_blk_off, 100, false);
+		assert_rc_equal(rc, 0);
+	}
+
+	/* Small reservations are still served by bitmap */
+	rc = vea_reserve(args.vua_vsi, 8, NULL, &args.vua_resrvd_list[1]);
+	assert_rc_equal(rc, 0);
+	ext = d_list_entry(args.vua_resrvd_list[1].prev, struct vea_resrvd_ext, vre_link);
+	assert_non_null(ext->vre_private);
+
+	rc = vea_query(args.vua_vsi, &attr, &stat);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(stat.vs_resrv_cache, 4);
+	/* Cached blocks are accounted as free */
+	assert_int_equal(stat.vs_free_transient + 400 + 8, attr.va_tot_blks);
+
+	/* Publish two of them, cancel the others */
+	rc = umem_tx_begin(&args.vua_umm, &args.vua_txd);
+	assert_rc_equal(rc, 0);
+	d_list_move_tail(r_list->next, &args.vua_alloc_list);
+	d_list_move_tail(r_list->next, &args.vua_alloc_list);
+	rc = vea_tx_publish(args.vua_vsi, NULL, &args.vua_alloc_list);
+	assert_rc_equal(rc, 0);
+	rc = umem_tx_commit(&args.vua_umm);
+	assert_rc_equal(rc, 0);
+
+	rc = vea_cancel(args.vua_vsi, NULL, r_list);
+	assert_rc_equal(rc, 0);
+	rc = vea_cancel(args.vua_vsi, NULL, &args.vua_resrvd_list[1]);
+	assert_rc_equal(rc, 0);
+
+	/* Forced flush returns all the cached runs */
+	rc = vea_flush(args.vua_vsi, true, UINT32_MAX, &nr_flushed);
+	assert_rc_equal(rc, 0);
+	assert_true(nr_flushed > 0);
+	assert_int_equal(args.vua_vsi->vsi_alloc_cache->vac_blks, 0);
+
+	rc = vea_query(args.vua_vsi, &attr, &stat);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(stat.vs_free_transient + 200, attr.va_tot_blks);
+	assert_int_equal(stat.vs_free_persistent + 200, attr.va_tot_blks);
+
+	vea_unload(args.vua_vsi);
+	ut_teardown(&args);
+}
+
+static void
+ut_defrag(void **state)
+{
+	struct vea_ut_args		 args;
+	struct vea_unmap_context	 unmap_ctxt = { 0 };
+	struct vea_hint_context		*h_ctxt = NULL;
+	struct vea_resrvd_ext		*ext;
+	uint64_t			 capacity = 1llu << 30; /* 1 GiB */
+	uint64_t			 offs[5];
+	uint32_t			 nr_flushed;
+	unsigned int			 frag_idx;
+	int				 i, rc;
+
+	print_message("Test fragmentation index and defrag candidate\n");
+	ut_setup(&args);
+	rc = vea_format(&args.vua_umm, &args.vua_txd, args.vua_md, 0, 1, capacity,
+			NULL, NULL, false);
+	assert_rc_equal(rc, 0);
+
+	rc = vea_load(&args.vua_umm, &args.vua_txd, args.vua_md, &unmap_ctxt,
+		      NULL, &args.vua_vsi);
+	assert_rc_equal(rc, 0);
+
+	/* Single free extent, no fragmentation at all */
+	assert_int_equal(vea_frag_index(args.vua_vsi), 0);
+
+	args.vua_hint[0]->vhd_off = 0;
+	args.vua_hint[0]->vhd_seq = 0;
+	rc = vea_hint_load(args.vua_hint[0], &h_ctxt);
+	assert_rc_equal(rc, 0);
+
+	/* Reserve five consecutive extents */
+	for (i = 0; i < 5; i++) {
+		rc = vea_reserve(args.vua_vsi, 100, h_ctxt, &args.vua_resrvd_list[0]);
+		assert_rc_equal(rc, 0);
+
+		ext = d_list_entry(args.vua_resrvd_list[0].prev, struct vea_resrvd_ext,
+				   vre_link);
+		offs[i] = ext->vre_blk_off;
+		if (i > 0)
+			assert_int_equal(offs[i], offs[i - 1] + 100);
+	}
+
+	rc = umem_tx_begin(&args.vua_umm, &args.vua_txd);
+	assert_rc_equal(rc, 0);
+	rc = vea_tx_publish(args.vua_vsi, h_ctxt, &args.vua_resrvd_list[0]);
+	assert_rc_equal(rc, 0);
+	rc = umem_tx_commit(&args.vua_umm);
+	assert_rc_equal(rc, 0);
+
+	frag_idx = vea_frag_index(args.vua_vsi);
+	assert_true(frag_idx <= 100);
+
+	/* Free the 2nd and 4th extents, make the 3rd one sandwiched by free fragments */
+	rc = vea_free(args.vua_vsi, offs[1], 100);
+	assert_rc_equal(rc, 0);
+	rc = vea_free(args.vua_vsi, offs[3], 100);
+	assert_rc_equal(rc, 0);
+
+	/* Not visible to the compound index before aging flush */
+	assert_false(vea_defrag_candidate(args.vua_vsi, offs[2], 100));
+
+	rc = vea_flush(args.vua_vsi, true, UINT32_MAX, &nr_flushed);
+	assert_rc_equal(rc, 0);
+
+	assert_true(vea_defrag_candidate(args.vua_vsi, offs[2], 100));
+	assert_false(vea_defrag_candidate(args.vua_vsi, offs[2], 50));
+	assert_false(vea_defrag_candidate(args.vua_vsi, offs[0], 100));
+	assert_false(vea_defrag_candidate(args.vua_vsi, offs[4], 100));
+	assert_true(vea_frag_index(args.vua_vsi) >= frag_idx);
+
+	vea_hint_unload(h_ctxt);
+	vea_unload(args.vua_vsi);
+	ut_teardown(&args);
+}
+
+#define BENCH_THREADS	4
+#define BENCH_OPS	20000
+
+struct bench_arg {
+	pthread_t	ba_thread;
+	char		ba_path[PATH_MAX];
+	bool		ba_cache;
+	int		ba_rc;
+	uint64_t	ba_ops;
+};
+
+/* Reserve & publish 4k ~ 1M extents, free every other extent to age the space */
+static void *
+bench_alloc_thread(void *data)
+{
+	struct bench_arg		*ba = data;
+	struct vea_ut_args		 args;
+	struct vea_unmap_context	 unmap_ctxt = { 0 };
+	struct vea_hint_context		*h_ctxt = NULL;
+	struct vea_resrvd_ext		*ext;
+	d_list_t			 r_list;
+	unsigned int			 seed = 0;
+	int				 i, rc;
+
+	rc = ut_setup_path(&args, ba->ba_path);
+	if (rc)
+		goto out;
+
+	rc = vea_format(&args.vua_umm, &args.vua_txd, args.vua_md, 0, 1, 32llu << 30,
+			NULL, NULL, false);
+	if (rc)
+		goto teardown;
+
+	unmap_ctxt.vnc_alloc_cache = ba->ba_cache;
+	rc = vea_load(&args.vua_umm, &args.vua_txd, args.vua_md, &unmap_ctxt,
+		      NULL, &args.vua_vsi);
+	if (rc)
+		goto teardown;
+
+	rc = vea_hint_load(args.vua_hint[0], &h_ctxt);
+	if (rc)
+		goto unload;
+
+	D_INIT_LIST_HEAD(&r_list);
+	for (i = 0; i < BENCH_OPS; i++) {
+		uint32_t	blk_cnt = 1 + rand_r(&seed) % VEA_CACHE_MAX_BLKS;
+		uint64_t	blk_off;
+
+		rc = vea_reserve(args.vua_vsi, blk_cnt, h_ctxt, &r_list);
+		if (rc)
+			break;
+
+		ext = d_list_entry(r_list.prev, struct vea_resrvd_ext, vre_link);
+		blk_off = ext->vre_blk_off;
+
+		rc = umem_tx_begin(&args.vua_umm, &args.vua_txd);
+		if (rc)
+			break;
+		rc = vea_tx_publish(args.vua_vsi, h_ctxt, &r_list);
+		rc = rc ? umem_tx_abort(&args.vua_umm, rc) : umem_tx_commit(&args.vua_umm);
+		if (rc)
+			break;
+
+		if (i % 2) {
+			rc = vea_free(args.vua_vsi, blk_off, blk_cnt);
+			if (rc)
+				break;
+		}
+		ba->ba_ops++;
+	}
+
+	vea_hint_unload(h_ctxt);
+unload:
+	vea_unload(args.vua_vsi);
+teardown:
+	ut_teardown(&args);
+	unlink(ba->ba_path);
+out:
+	ba->ba_rc = rc;
+	return NULL;
+}
+
+static void
+bench_alloc(bool cache)
+{
+	struct bench_arg	ba[BENCH_THREADS] = { 0 };
+	uint64_t		start, end, tot_ops = 0;
+	int			i, rc;
+
+	start = daos_get_ntime();
+	for (i = 0; i < BENCH_THREADS; i++) {
+		snprintf(ba[i].ba_path, sizeof(ba[i].ba_path), "%s.%d", pool_file, i);
+		ba[i].ba_cache = cache;
+		rc = pthread_create(&ba[i].ba_thread, NULL, bench_alloc_thread, &ba[i]);
+		assert_int_equal(rc, 0);
+	}
+
+	for (i = 0; i < BENCH_THREADS; i++) {
+		rc = pthread_join(ba[i].ba_thread, NULL);
+		assert_int_equal(rc, 0);
+		assert_rc_equal(ba[i].ba_rc, 0);
+		tot_ops += ba[i].ba_ops;
+	}
+	end = daos_get_ntime();
+
+	print_message("alloc cache %s: %d threads, "DF_U64" ops, %.2f ops/sec\n",
+		      cache ? "on" : "off", BENCH_THREADS, tot_ops,
+		      (double)tot_ops * NSEC_PER_SEC / (end - start));
+}
+
+/* Each thread works on its own pool, just like each target xstream does */
+static void
+ut_alloc_bench_mt(void **state)
+{
+	print_message("Multithreaded allocation throughput\n");
+	bench_alloc(false);
+	bench_alloc(true);
+}
+
 static const struct CMUnitTest vea_uts[] = {
 	{ "vea_format", ut_format, NULL, NULL},
 	{ "vea_load", ut_load, NULL, NULL},
@@ -1615,7 +1902,10 @@ static const struct CMUnitTest vea_uts[] = {
 	{ "vea_free_invalid_space", ut_free_invalid_space, NULL, NULL},
 	{ "vea_interleaved_ops", ut_interleaved_ops, NULL, NULL},
 	{ "vea_fragmentation", ut_fragmentation, NULL, NULL},
-	{ "vea_reclaim_unused_bitmap", ut_reclaim_unused_bitmap, NULL, NULL}
+	{ "vea_reclaim_unused_bitmap", ut_reclaim_unused_bitmap, NULL, NULL},
+	{ "vea_alloc_cache", ut_alloc_cache, NULL, NULL},
+	{ "vea_defrag", ut_defrag, NULL, NULL},
+	{ "vea_alloc_bench_mt", ut_alloc_bench_mt, NULL, NULL}
 };
 
 int main(int argc, char **argv)
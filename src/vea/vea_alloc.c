@@ -426,6 +426,152 @@ reserve_single(struct vea_space_info *vsi, uint32_t blk_cnt,
 	return reserve_extent(vsi, blk_cnt, resrvd);
 }
 
+static inline unsigned int
+alloc_cache_class(uint32_t blk_cnt)
+{
+	D_ASSERT(blk_cnt > 0 && blk_cnt <= VEA_CACHE_MAX_BLKS);
+	if (blk_cnt == 1)
+		return 0;
+
+	return 64 - __builtin_clzll(blk_cnt - 1);
+}
+
+/* Return the unused part of a cached run to the compound index */
+static int
+alloc_cache_return(struct vea_space_info *vsi, struct vea_free_extent *run)
+{
+	struct vea_alloc_cache	*vac = vsi->vsi_alloc_cache;
+	struct vea_free_extent	 vfe = *run;
+	int			 rc;
+
+	D_ASSERT(run->vfe_blk_cnt > 0);
+	D_ASSERT(vac->vac_blks >= run->vfe_blk_cnt);
+	vac->vac_blks -= run->vfe_blk_cnt;
+	run->vfe_blk_off = 0;
+	run->vfe_blk_cnt = 0;
+
+	/* Cached blocks are still accounted as free blocks */
+	vfe.vfe_age = 0;	/* Not used */
+	rc = compound_free_extent(vsi, &vfe, VEA_FL_NO_ACCOUNTING);
+	if (rc)
+		D_ERROR("Return cached run ["DF_U64", %u] failed. "DF_RC"\n",
+			vfe.vfe_blk_off, vfe.vfe_blk_cnt, DP_RC(rc));
+	return rc;
+}
+
+static int
+alloc_cache_refill(struct vea_space_info *vsi, struct vea_free_extent *run,
+		   uint32_t run_blks)
+{
+	struct vea_alloc_cache	*vac = vsi->vsi_alloc_cache;
+	struct vea_resrvd_ext	 resrvd = { 0 };
+	int			 rc;
+
+	D_ASSERT(run->vfe_blk_cnt == 0);
+	if (run_blks < vsi->vsi_class.vfc_large_thresh) {
+		rc = reserve_size_tree(vsi, run_blks, &resrvd);
+		if (rc || resrvd.vre_blk_cnt > 0)
+			goto done;
+	}
+
+	rc = reserve_extent(vsi, run_blks, &resrvd);
+done:
+	if (rc || resrvd.vre_blk_cnt == 0)
+		return rc;
+
+	D_ASSERT(resrvd.vre_blk_cnt == run_blks);
+	run->vfe_blk_off = resrvd.vre_blk_off;
+	run->vfe_blk_cnt = run_blks;
+	run->vfe_age = get_current_age();
+	vac->vac_blks += run_blks;
+
+	D_DEBUG(DB_IO, "Cached run ["DF_U64", %u]\n", run->vfe_blk_off, run->vfe_blk_cnt);
+	return 0;
+}
+
+/*
+ * Reserve from the per size class run of allocation cache, the run is refilled
+ * (from size tree or the largest free extent) when it's exhausted.
+ */
+int
+reserve_cache(struct vea_space_info *vsi, uint32_t blk_cnt,
+	      struct vea_resrvd_ext *resrvd)
+{
+	struct vea_alloc_cache	*vac = vsi->vsi_alloc_cache;
+	struct vea_free_extent	*run;
+	unsigned int		 cls;
+	int			 rc;
+
+	if (vac == NULL || blk_cnt > VEA_CACHE_MAX_BLKS)
+		return 0;
+
+	/* Small allocations are served by bitmaps */
+	if (is_bitmap_feature_enabled(vsi) && blk_cnt <= VEA_MAX_BITMAP_CLASS)
+		return 0;
+
+	cls = alloc_cache_class(blk_cnt);
+	run = &vac->vac_runs[cls];
+
+	if (run->vfe_blk_cnt < blk_cnt) {
+		if (run->vfe_blk_cnt > 0) {
+			rc = alloc_cache_return(vsi, run);
+			if (rc)
+				return rc;
+		}
+
+		rc = alloc_cache_refill(vsi, run, (1U << cls) * VEA_CACHE_RUN_NR);
+		if (rc || run->vfe_blk_cnt == 0)
+			return rc;
+	}
+
+	resrvd->vre_blk_off = run->vfe_blk_off;
+	resrvd->vre_blk_cnt = blk_cnt;
+	resrvd->vre_private = NULL;
+
+	run->vfe_blk_off += blk_cnt;
+	run->vfe_blk_cnt -= blk_cnt;
+	run->vfe_age = get_current_age();
+	D_ASSERT(vac->vac_blks >= blk_cnt);
+	vac->vac_blks -= blk_cnt;
+	vac->vac_hits++;
+
+	D_DEBUG(DB_IO, "["DF_U64", %u]\n", resrvd->vre_blk_off, resrvd->vre_blk_cnt);
+
+	return 0;
+}
+
+/* Return idle (or all when @force is true) cached runs to the compound index */
+int
+alloc_cache_flush(struct vea_space_info *vsi, bool force, uint32_t cur_time,
+		  uint32_t *nr_returned)
+{
+	struct vea_alloc_cache	*vac = vsi->vsi_alloc_cache;
+	struct vea_free_extent	*run;
+	uint32_t		 nr = 0;
+	int			 i, rc = 0;
+
+	if (vac == NULL || vac->vac_blks == 0)
+		goto out;
+
+	for (i = 0; i < VEA_CACHE_CLASS_MAX; i++) {
+		run = &vac->vac_runs[i];
+
+		if (run->vfe_blk_cnt == 0)
+			continue;
+		if (!force && cur_time < (run->vfe_age + VEA_CACHE_RUN_AGE))
+			continue;
+
+		rc = alloc_cache_return(vsi, run);
+		if (rc)
+			break;
+		nr++;
+	}
+out:
+	if (nr_returned != NULL)
+		*nr_returned = nr;
+	return rc;
+}
+
 static int
 persistent_alloc_extent(struct vea_space_info *vsi, struct vea_free_extent *vfe)
 {
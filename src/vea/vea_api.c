@@ -8,6 +8,7 @@
 #include <daos/common.h>
 #include <daos/btree_class.h>
 #include <daos/dtx.h>
+#include <gurt/telemetry_producer.h>
 #include "vea_internal.h"
 
 static void
@@ -262,6 +263,8 @@ vea_unload(struct vea_space_info *vsi)
 	}
 
 	destroy_free_class(&vsi->vsi_class);
+	/* Cached runs are in-memory reservations only, no need to return them */
+	D_FREE(vsi->vsi_alloc_cache);
 	D_FREE(vsi);
 }
 
@@ -307,6 +310,14 @@ vea_load(struct umem_instance *umem, struct umem_tx_stage_data *txd,
 	vsi->vsi_unmap_ctxt = *unmap_ctxt;
 	vsi->vsi_metrics = metrics;
 
+	if (unmap_ctxt->vnc_alloc_cache) {
+		D_ALLOC_PTR(vsi->vsi_alloc_cache);
+		if (vsi->vsi_alloc_cache == NULL) {
+			rc = -DER_NOMEM;
+			goto error;
+		}
+	}
+
 	rc = create_free_class(&vsi->vsi_class, md);
 	if (rc)
 		goto error;
@@ -358,11 +369,13 @@ aging_flush(struct vea_space_info *vsi, bool force, uint32_t nr_flush, uint32_t
  * Reserve an extent on block device, reserve attempting order:
  *
  * 1. Reserve from the free extent with 'hinted' start offset. (lookup vsi_free_btr)
- * 2. If the largest free extent is large enough for splitting, divide it in
+ * 2. Try to reserve from the run of allocation cache for the size class, if it's
+ *    enabled. (refill the run by step 3 & 4 when it's exhausted)
+ * 3. If the largest free extent is large enough for splitting, divide it in
  *    half-and-half then reserve from the latter half. (lookup vfc_heap). Otherwise;
- * 3. Try to reserve from some small free extent (<= VEA_LARGE_EXT_MB) in best-fit,
+ * 4. Try to reserve from some small free extent (<= VEA_LARGE_EXT_MB) in best-fit,
  *    if it fails, reserve from the largest free extent. (lookup vfc_size_btr)
- * 4. Fail reserve with ENOMEM if all above attempts fail.
+ * 5. Fail reserve with ENOMEM if all above attempts fail.
  */
 int
 vea_reserve(struct vea_space_info *vsi, uint32_t blk_cnt,
@@ -403,6 +416,13 @@ retry:
 			goto done;
 	}
 
+	/* Reserve from the allocation cache */
+	rc = reserve_cache(vsi, blk_cnt, resrvd);
+	if (rc != 0)
+		goto error;
+	else if (resrvd->vre_blk_cnt != 0)
+		goto done;
+
 	/* Reserve from the largest extent or a small extent */
 	rc = reserve_single(vsi, blk_cnt, resrvd);
 	if (rc != 0)
@@ -843,6 +863,12 @@ vea_query(struct vea_space_info *vsi, struct vea_attr *attr,
 		stat->vs_frags_small = vsi->vsi_stat[STAT_FRAGS_SMALL];
 		stat->vs_frags_bitmap = vsi->vsi_stat[STAT_FRAGS_BITMAP];
 		stat->vs_frags_aging = vsi->vsi_stat[STAT_FRAGS_AGING];
+		stat->vs_resrv_cache = 0;
+		if (vsi->vsi_alloc_cache != NULL) {
+			/* Cached runs are reserved in-memory, but still free */
+			stat->vs_free_transient += vsi->vsi_alloc_cache->vac_blks;
+			stat->vs_resrv_cache = vsi->vsi_alloc_cache->vac_hits;
+		}
 	}
 
 	return 0;
@@ -858,3 +884,118 @@ vea_flush(struct vea_space_info *vsi, bool force, uint32_t nr_flush, uint32_t *n
 
 	return trigger_aging_flush(vsi, force, nr_flush, nr_flushed);
 }
+
+/* Size of the largest free extent in compound index */
+static uint64_t
+largest_free_extent(struct vea_space_info *vsi)
+{
+	struct vea_free_class	*vfc = &vsi->vsi_class;
+	struct vea_extent_entry	*entry;
+	d_iov_t			 key_in, key_out, val;
+	uint64_t		 int_key = 0, found = 0;
+	int			 rc;
+
+	if (!d_binheap_is_empty(&vfc->vfc_heap)) {
+		entry = container_of(d_binheap_root(&vfc->vfc_heap), struct vea_extent_entry,
+				     vee_node);
+		return entry->vee_ext.vfe_blk_cnt;
+	}
+
+	D_ASSERT(daos_handle_is_valid(vfc->vfc_size_btr));
+	d_iov_set(&key_in, &int_key, sizeof(int_key));
+	d_iov_set(&key_out, &found, sizeof(found));
+	d_iov_set(&val, NULL, 0);
+
+	rc = dbtree_fetch(vfc->vfc_size_btr, BTR_PROBE_LAST, DAOS_INTENT_DEFAULT, &key_in,
+			  &key_out, &val);
+	if (rc) {
+		if (rc != -DER_NONEXIST)
+			D_ERROR("Failed to fetch largest sized class. "DF_RC"\n", DP_RC(rc));
+		return 0;
+	}
+
+	return found;
+}
+
+unsigned int
+vea_frag_index(struct vea_space_info *vsi)
+{
+	struct vea_metrics	*metrics = vsi->vsi_metrics;
+	uint64_t		 free_blks, largest;
+	unsigned int		 frag_idx = 0;
+
+	free_blks = vsi->vsi_stat[STAT_FREE_EXTENT_BLKS];
+	if (free_blks != 0) {
+		largest = min(largest_free_extent(vsi), free_blks);
+		frag_idx = 100 - (unsigned int)(largest * 100 / free_blks);
+	}
+
+	if (metrics && metrics->vm_frag_idx)
+		d_tm_set_gauge(metrics->vm_frag_idx, frag_idx);
+
+	return frag_idx;
+}
+
+bool
+vea_defrag_candidate(struct vea_space_info *vsi, uint64_t blk_off, uint32_t blk_cnt)
+{
+	struct vea_free_extent	*prev, *next;
+	struct vea_bitmap_entry	*bitmap_entry;
+	d_iov_t			 key_in, key_out, val;
+	uint64_t		 off;
+	int			 rc;
+
+	D_ASSERT(vsi != NULL);
+	if (blk_cnt == 0 || blk_cnt >= vsi->vsi_class.vfc_large_thresh)
+		return false;
+
+	/* Extent allocated from bitmap chunk, the chunk is what fragments the space */
+	if (daos_handle_is_valid(vsi->vsi_bitmap_btr)) {
+		d_iov_set(&key_in, &blk_off, sizeof(blk_off));
+		d_iov_set(&key_out, NULL, sizeof(off));
+		d_iov_set(&val, NULL, 0);
+
+		rc = dbtree_fetch(vsi->vsi_bitmap_btr, BTR_PROBE_LE, DAOS_INTENT_DEFAULT, &key_in,
+				  &key_out, &val);
+		if (rc == 0) {
+			bitmap_entry = (struct vea_bitmap_entry *)val.iov_buf;
+			if (blk_off < bitmap_entry->vbe_bitmap.vfb_blk_off +
+				      bitmap_entry->vbe_bitmap.vfb_blk_cnt)
+				return false;
+		} else if (rc != -DER_NONEXIST) {
+			return false;
+		}
+	}
+
+	/* Free extent right after the allocated one? */
+	off = blk_off + blk_cnt;
+	d_iov_set(&key_in, &off, sizeof(off));
+	d_iov_set(&key_out, NULL, sizeof(off));
+	d_iov_set(&val, NULL, 0);
+
+	rc = dbtree_fetch(vsi->vsi_free_btr, BTR_PROBE_EQ, DAOS_INTENT_DEFAULT, &key_in,
+			  &key_out, &val);
+	if (rc)
+		return false;
+	next = (struct vea_free_extent *)val.iov_buf;
+	if (next->vfe_blk_cnt >= vsi->vsi_class.vfc_large_thresh)
+		return false;
+
+	/* Free extent right before the allocated one? */
+	d_iov_set(&key_in, &blk_off, sizeof(blk_off));
+	d_iov_set(&key_out, NULL, sizeof(off));
+	d_iov_set(&val, NULL, 0);
+
+	rc = dbtree_fetch(vsi->vsi_free_btr, BTR_PROBE_LT, DAOS_INTENT_DEFAULT, &key_in,
+			  &key_out, &val);
+	if (rc)
+		return false;
+	prev = (struct vea_free_extent *)val.iov_buf;
+
+	/*
+	 * Relocating the allocated extent will coalesce three fragments into one, the
+	 * two small free neighbors are otherwise useless for larger allocations.
+	 */
+	return prev->vfe_blk_off + prev->vfe_blk_cnt == blk_off &&
+	       prev->vfe_blk_cnt < vsi->vsi_class.vfc_large_thresh;
+}
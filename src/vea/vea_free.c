@@ -1012,6 +1012,12 @@ trigger_aging_flush(struct vea_space_info *vsi, bool force, uint32_t nr_flush,
 	}
 
 	cur_time = get_current_age();
+
+	/* Return idle runs of allocation cache */
+	rc = alloc_cache_flush(vsi, force, cur_time, &tot_flushed);
+	if (rc)
+		goto out;
+
 	if (!need_aging_flush(vsi, cur_time, force)) {
 		rc = 0;
 		goto out;
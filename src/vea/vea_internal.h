@@ -164,10 +164,35 @@ struct vea_metrics {
 	struct d_tm_node_t	*vm_rsrv[STAT_RESRV_TYPE_MAX];
 	struct d_tm_node_t	*vm_frags[STAT_FRAGS_TYPE_MAX];
 	struct d_tm_node_t	*vm_free_blks;
+	struct d_tm_node_t	*vm_frag_idx;
 };
 
 #define MAX_FLUSH_FRAGS	256
 
+/* Allocation cache size classes: 2^0 ~ 2^8 blocks (4KiB ~ 1MiB for 4k block) */
+#define VEA_CACHE_CLASS_MAX	9
+#define VEA_CACHE_MAX_BLKS	(1U << (VEA_CACHE_CLASS_MAX - 1))
+/* Run size (in size class blocks) pre-reserved for each size class */
+#define VEA_CACHE_RUN_NR	32
+/* Idle run will be returned to the compound index on aging flush, in seconds */
+#define VEA_CACHE_RUN_AGE	10
+
+/*
+ * Allocation front-end cache. Each size class has a pre-reserved contiguous run
+ * carved sequentially by the reservations of that class, so that most small and
+ * medium reservations don't have to lookup the size tree or split the largest
+ * free extent. The run is reserved in-memory only, each carved extent is made
+ * persistent individually on publish, and the unused part of a run is returned
+ * lazily on aging flush, so nothing is leaked on crash.
+ */
+struct vea_alloc_cache {
+	struct vea_free_extent	vac_runs[VEA_CACHE_CLASS_MAX];
+	/* Blocks held by all the cached runs */
+	uint64_t		vac_blks;
+	/* Reservations served from cache */
+	uint64_t		vac_hits;
+};
+
 /* In-memory compound index */
 struct vea_space_info {
 	/* Instance for the pmemobj pool on SCM */
@@ -206,6 +231,8 @@ struct vea_space_info {
 	uint64_t			 vsi_stat[STAT_MAX];
 	/* Metrics */
 	struct vea_metrics		*vsi_metrics;
+	/* Allocation cache, NULL when disabled */
+	struct vea_alloc_cache		*vsi_alloc_cache;
 	/* Last aging buffer flush timestamp */
 	uint32_t			 vsi_flush_time;
 	bool				 vsi_flush_scheduled;
@@ -292,6 +319,10 @@ int reserve_hint(struct vea_space_info *vsi, uint32_t blk_cnt,
 		 struct vea_resrvd_ext *resrvd);
 int reserve_single(struct vea_space_info *vsi, uint32_t blk_cnt,
 		   struct vea_resrvd_ext *resrvd);
+int reserve_cache(struct vea_space_info *vsi, uint32_t blk_cnt,
+		  struct vea_resrvd_ext *resrvd);
+int alloc_cache_flush(struct vea_space_info *vsi, bool force, uint32_t cur_time,
+		      uint32_t *nr_returned);
 int persistent_alloc(struct vea_space_info *vsi, struct vea_free_entry *vfe);
 int
 bitmap_tx_add_ptr(struct umem_instance *vsi_umem, uint64_t *bitmap,
@@ -491,6 +491,11 @@ vea_metrics_alloc(const char *path, int tgt_id)
 	if (rc)
 		D_WARN("Failed to create free blks telemetry: "DF_RC"\n", DP_RC(rc));
 
+	rc = d_tm_add_metric(&metrics->vm_frag_idx, D_TM_GAUGE, "free space fragmentation index",
+			     "%", "%s/%s/frag_index/tgt_%u", path, VEA_TELEMETRY_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create frag index telemetry: "DF_RC"\n", DP_RC(rc));
+
 	return metrics;
 }
 
@@ -541,18 +541,150 @@ set_visibility(struct evt_entry *ent, uint32_t flags)
 	ent->en_visibility |= flags;
 }
 
+/**
+ * Compact sort key of an entry for the visibility sweep.  It carries the
+ * fields compared by evt_ent_cmp so the sort and the sweep don't have to
+ * chase entry pointers.  \a vk_seq keeps the order of equal keys stable.
+ */
+struct evt_vis_key {
+	uint64_t		 vk_lo;
+	uint64_t		 vk_hi;
+	daos_epoch_t		 vk_epoch;
+	struct evt_entry	*vk_ent;
+	uint32_t		 vk_seq;
+	uint16_t		 vk_minor_epc;
+};
+
+/**
+ * Entries that haven't been swept yet: the sorted run of the initial entries
+ * in [vq_run_at, vq_run_nr) and a min-heap of the truncated or split entries
+ * pushed back during the sweep in [0, vq_nr).  Each push follows a pop, so
+ * the heap always fits in the slots already consumed from the run.
+ */
+struct evt_vis_queue {
+	struct evt_vis_key	*vq_keys;
+	uint32_t		 vq_nr;
+	uint32_t		 vq_run_at;
+	uint32_t		 vq_run_nr;
+	/** sequence of the next pushed key */
+	uint32_t		 vq_seq;
+};
+
+static inline void
+evt_vis_key_set(struct evt_vis_key *key, struct evt_entry *ent, uint32_t seq)
+{
+	key->vk_lo = ent->en_sel_ext.ex_lo;
+	key->vk_hi = ent->en_sel_ext.ex_hi;
+	key->vk_epoch = ent->en_epoch;
+	key->vk_minor_epc = ent->en_minor_epc;
+	key->vk_ent = ent;
+	key->vk_seq = seq;
+}
+
+/** Same order as evt_rect_cmp, ties are resolved by sequence */
+static inline int
+evt_vis_key_cmp(const struct evt_vis_key *k1, const struct evt_vis_key *k2)
+{
+	if (k1->vk_lo != k2->vk_lo)
+		return k1->vk_lo < k2->vk_lo ? -1 : 1;
+	if (k1->vk_epoch != k2->vk_epoch)
+		return k1->vk_epoch > k2->vk_epoch ? -1 : 1;
+	if (k1->vk_minor_epc != k2->vk_minor_epc)
+		return k1->vk_minor_epc > k2->vk_minor_epc ? -1 : 1;
+	if (k1->vk_hi != k2->vk_hi)
+		return k1->vk_hi < k2->vk_hi ? -1 : 1;
+	if (k1->vk_seq != k2->vk_seq)
+		return k1->vk_seq < k2->vk_seq ? -1 : 1;
+	return 0;
+}
+
+static int
+evt_vis_key_qsort_cmp(const void *p1, const void *p2)
+{
+	return evt_vis_key_cmp(p1, p2);
+}
+
+/**
+ * Push an entry to the heap.  Sequence grows monotonically, so an entry
+ * lands behind the equal ones, as evt_insert_sorted would place it.
+ */
+static void
+evt_vis_queue_push(struct evt_vis_queue *queue, struct evt_entry *ent)
+{
+	struct evt_vis_key	*keys = queue->vq_keys;
+	struct evt_vis_key	 key;
+	uint32_t		 at;
+	uint32_t		 parent;
+
+	D_ASSERT(queue->vq_nr < queue->vq_run_at);
+	evt_vis_key_set(&key, ent, queue->vq_seq++);
+	for (at = queue->vq_nr++; at > 0; at = parent) {
+		parent = (at - 1) / 2;
+		if (evt_vis_key_cmp(&keys[parent], &key) <= 0)
+			break;
+		keys[at] = keys[parent];
+	}
+	keys[at] = key;
+}
+
+/** Return true if the smallest entry is at the head of the run */
+static inline bool
+evt_vis_queue_in_run(struct evt_vis_queue *queue)
+{
+	if (queue->vq_run_at == queue->vq_run_nr)
+		return false;
+	if (queue->vq_nr == 0)
+		return true;
+	return evt_vis_key_cmp(&queue->vq_keys[queue->vq_run_at],
+			       &queue->vq_keys[0]) < 0;
+}
+
+static inline struct evt_entry *
+evt_vis_queue_top(struct evt_vis_queue *queue)
+{
+	if (evt_vis_queue_in_run(queue))
+		return queue->vq_keys[queue->vq_run_at].vk_ent;
+	if (queue->vq_nr == 0)
+		return NULL;
+	return queue->vq_keys[0].vk_ent;
+}
+
 static struct evt_entry *
-evt_find_next_visible(struct evt_entry *this_ent, d_list_t *head,
-		      d_list_t **next)
+evt_vis_queue_pop(struct evt_vis_queue *queue)
+{
+	struct evt_vis_key	*keys = queue->vq_keys;
+	struct evt_entry	*ent;
+	struct evt_vis_key	 last;
+	uint32_t		 at;
+	uint32_t		 child;
+
+	if (evt_vis_queue_in_run(queue))
+		return keys[queue->vq_run_at++].vk_ent;
+
+	D_ASSERT(queue->vq_nr > 0);
+	ent = keys[0].vk_ent;
+	last = keys[--queue->vq_nr];
+	for (at = 0; (child = 2 * at + 1) < queue->vq_nr; at = child) {
+		if (child + 1 < queue->vq_nr &&
+		    evt_vis_key_cmp(&keys[child + 1], &keys[child]) < 0)
+			child++;
+		if (evt_vis_key_cmp(&last, &keys[child]) <= 0)
+			break;
+		keys[at] = keys[child];
+	}
+	keys[at] = last;
+
+	return ent;
+}
+
+static struct evt_entry *
+evt_find_next_visible(struct evt_entry *this_ent, struct evt_vis_queue *queue)
 {
-	d_list_t		*temp;
 	struct evt_extent	*this_ext;
 	struct evt_extent	*next_ext;
 	struct evt_entry	*next_ent;
 
-	while (*next != head) {
-		next_ent = evt_array_link2entry(*next);
-
+	while ((next_ent = evt_vis_queue_top(queue)) != NULL) {
 		if (evt_ent_is_later(next_ent, this_ent))
 			return next_ent; /* next_ent is a later update */
 		this_ext = &this_ent->en_sel_ext;
@@ -562,8 +694,7 @@ evt_find_next_visible(struct evt_entry *this_ent, d_list_t *head,
 
 		/* next_ent is covered */
 		set_visibility(next_ent, EVT_COVERED);
-		temp = *next;
-		*next = temp->next;
+		evt_vis_queue_pop(queue);
 	}
 
 	return NULL;
@@ -794,8 +925,8 @@ process_ext:
 
 static int
 evt_find_visible(struct evt_context *tcx, const struct evt_filter *filter,
-		 struct evt_entry_array *ent_array, int *num_visible,
-		 bool removals_only)
+		 struct evt_entry_array *ent_array, struct evt_vis_key *keys,
+		 int *num_visible, bool removals_only)
 {
 	struct evt_extent	*this_ext;
 	struct evt_extent	*next_ext;
@@ -806,11 +937,12 @@ evt_find_visible(struct evt_context *tcx, const struct evt_filter *filter,
 	struct evt_entry	*next_ent;
 	struct evt_entry	*temp_ent;
 	struct evt_entry	*split;
+	struct evt_vis_queue	 queue;
 	d_list_t		 covered;
 	d_list_t		 removals;
-	d_list_t		*current;
 	d_list_t		*next;
-	bool			 insert;
+	uint32_t		 nr = ent_array->ea_ent_nr;
+	uint32_t		 i;
 	int			 rc = 0;
 
 	D_INIT_LIST_HEAD(&covered);
@@ -822,7 +954,8 @@ evt_find_visible(struct evt_context *tcx, const struct evt_filter *filter,
 	 * covered to start.   All other entries are placed into the sorted list
 	 * to be considered in the visibility algorithm.
 	 */
-	evt_ent_array_for_each(this_ent, ent_array) {
+	for (i = 0; i < nr; i++) {
+		this_ent = keys[i].vk_ent;
 		next = evt_array_entry2link(this_ent);
 
 		if (evt_entry_punched(this_ent, filter)) {
@@ -885,31 +1018,31 @@ evt_find_visible(struct evt_context *tcx, const struct evt_filter *filter,
 		return 0;
 	}
 
-	/* Now uncover entries */
-	current = covered.next;
-	/* Some compilers can't tell that this_ent will be initialized */
-	this_ent = evt_array_link2entry(current);
-	insert = true;
-	next = current->next;
-
-	while (next != &covered) {
-		if (insert) {
-			this_ent = evt_array_link2entry(current);
-			evt_mark_visible(this_ent, false, num_visible);
-			evt_array_entry2le(this_ent)->le_prev = NULL;
-		}
+	/* Sweep the sorted list from the left.  Truncated and split entries
+	 * are pushed back to a heap so each step costs O(log n) rather than a
+	 * walk of the remaining list.
+	 */
+	queue.vq_keys = keys;
+	queue.vq_nr = 0;
+	queue.vq_run_at = 0;
+	queue.vq_run_nr = 0;
+	d_list_for_each_entry(le, &covered, le_link) {
+		evt_vis_key_set(&keys[queue.vq_run_nr], &le->le_ent,
+				queue.vq_run_nr);
+		queue.vq_run_nr++;
+	}
+	queue.vq_seq = queue.vq_run_nr;
 
-		insert = true;
+	this_ent = evt_vis_queue_pop(&queue);
+	evt_mark_visible(this_ent, false, num_visible);
+	evt_array_entry2le(this_ent)->le_prev = NULL;
 
-		/* Find next visible rectangle */
-		next_ent = evt_find_next_visible(this_ent, &covered, &next);
-		if (next_ent == NULL)
-			return 0;
+	/* Find next visible rectangle */
+	while ((next_ent = evt_find_next_visible(this_ent, &queue)) != NULL) {
+		evt_vis_queue_pop(&queue);
 
 		this_ext = &this_ent->en_sel_ext;
 		next_ext = &next_ent->en_sel_ext;
-		current = next;
-		next = current->next;
 		/* NB: Three possibilities
 		 * 1. No intersection.  Current entry is inserted in entirety
 		 * 2. Partial intersection, next is earlier. Next is truncated
@@ -919,7 +1052,7 @@ evt_find_visible(struct evt_context *tcx, const struct evt_filter *filter,
 		 */
 		if (next_ext->ex_lo >= this_ext->ex_hi + 1) {
 			/* Case #1, entry already inserted, nothing to do */
-			continue;
+			goto visible;
 		}
 
 		if (evt_ent_is_later(this_ent, next_ent)) {
@@ -935,17 +1068,10 @@ evt_find_visible(struct evt_context *tcx, const struct evt_filter *filter,
 			if (rc != 0)
 				return rc;
 
-			/* current now points at next_ent.  Remove it and
-			 * reinsert it in the list in case truncation moved
-			 * it to a new position
+			/* Push it back in case truncation moved it to a new
+			 * position, then rerun without changing this_ent.
 			 */
-			d_list_del(current);
-			next = evt_insert_sorted(next_ent, &covered, next);
-
-			/* Now we need to rerun this iteration without
-			 * inserting this_ent again
-			 */
-			insert = false;
+			evt_vis_queue_push(&queue, next_ent);
 			continue;
 		}
 
@@ -972,30 +1098,69 @@ evt_find_visible(struct evt_context *tcx, const struct evt_filter *filter,
 				ent_array->ea_ent_nr--;
 				return rc;
 			}
-			/* Case #4, split, insert tail into sorted list */
+			/* Case #4, split, push tail to be swept */
 			evt_split_entry(tcx, this_ent, next_ent, split,
 					temp_ent);
-			/* Current points at next_ent */
-			next = evt_insert_sorted(split, &covered, next);
+			evt_vis_queue_push(&queue, split);
 		}
+visible:
+		this_ent = next_ent;
+		evt_mark_visible(this_ent, false, num_visible);
+		evt_array_entry2le(this_ent)->le_prev = NULL;
 	}
 
-	this_ent = evt_array_link2entry(current);
-	D_ASSERT(!evt_flags_equal(this_ent->en_visibility, EVT_COVERED));
-	evt_mark_visible(this_ent, false, num_visible);
-
 	return 0;
 }
 
-/** Place all entries into covered list in sorted order based on selected
- * range.   Then walk through the range to find only extents that are visible
- * and place them in the main list.   Update the selection bounds for visible
+/**
+ * Sort compact keys of all entries in the array into \a keys, then move the
+ * entries to the same order so the sweep and the final sort walk the array
+ * sequentially.  Each entry is moved once by following the permutation
+ * cycles, a key points at its final slot once the slot is filled.
+ */
+static void
+evt_vis_keys_sort(struct evt_entry_array *ent_array, struct evt_vis_key *keys)
+{
+	struct evt_list_entry	*ents = ent_array->ea_ents;
+	struct evt_list_entry	 tmp;
+	uint32_t		 nr = ent_array->ea_ent_nr;
+	uint32_t		 i;
+	uint32_t		 j;
+	uint32_t		 k;
+
+	for (i = 0; i < nr; i++)
+		evt_vis_key_set(&keys[i], &ents[i].le_ent, i);
+
+	qsort(keys, nr, sizeof(keys[0]), evt_vis_key_qsort_cmp);
+
+	for (i = 0; i < nr; i++) {
+		if (keys[i].vk_ent == &ents[i].le_ent)
+			continue;
+
+		tmp = ents[i];
+		for (j = i;; j = k) {
+			k = evt_array_entry2le(keys[j].vk_ent) - ents;
+			keys[j].vk_ent = &ents[j].le_ent;
+			if (k == i) {
+				ents[j] = tmp;
+				break;
+			}
+			ents[j] = ents[k];
+		}
+	}
+}
+
+/** Sort compact keys of all entries in sorted order based on selected range.
+ * Then sweep through the range to find only extents that are visible and
+ * place them in the main list.   Update the selection bounds for visible
  * rectangles.
  */
 int
 evt_ent_array_sort(struct evt_context *tcx, struct evt_entry_array *ent_array,
 		   const struct evt_filter *filter, int flags)
 {
+	struct evt_vis_key	 embedded[EVT_EMBEDDED_NR];
+	struct evt_vis_key	*keys;
 	struct evt_list_entry	*ents;
 	struct evt_entry	*ent;
 	int			(*compar)(const void *, const void *);
@@ -1019,15 +1184,23 @@ evt_ent_array_sort(struct evt_context *tcx, struct evt_entry_array *ent_array,
 	}
 
 	for (;;) {
-		ents = ent_array->ea_ents;
+		if (ent_array->ea_size <= EVT_EMBEDDED_NR) {
+			keys = embedded;
+		} else {
+			D_ALLOC_ARRAY_NZ(keys, ent_array->ea_size);
+			if (keys == NULL)
+				return -DER_NOMEM;
+		}
 
-		/* Sort the array first */
-		qsort(ents, ent_array->ea_ent_nr, sizeof(ents[0]),
-		      evt_ent_list_cmp);
+		/* Sort the keys first */
+		evt_vis_keys_sort(ent_array, keys);
 
 		/* Now separate entries into covered and visible */
-		rc = evt_find_visible(tcx, filter, ent_array, &num_visible,
+		rc = evt_find_visible(tcx, filter, ent_array, keys,
+				      &num_visible,
 				      (flags & EVT_ITER_REMOVALS) != 0);
+		if (keys != embedded)
+			D_FREE(keys);
 		if (rc != 0) {
 			if (rc == -DER_AGAIN)
 				continue; /* List reallocated, start over */
@@ -1483,6 +1656,8 @@ evt_node_destroy(struct evt_context *tcx, umem_off_t nd_off, int level,
 	for (i = nd->tn_nr - 1; i >= 0; i--) {
 		if (leaf) {
 			ne = evt_node_entry_at(tcx, nd, i);
+			if (i > 0)
+				prefetch(evt_off2ptr(tcx, evt_node_entry_at(tcx, nd, i - 1)->ne_child));
 			/* NB: This will be replaced with a callback */
 			rc = evt_node_entry_free(tcx, ne);
 			if (rc)
@@ -1498,6 +1673,9 @@ evt_node_destroy(struct evt_context *tcx, umem_off_t nd_off, int level,
 				break;
 			}
 		} else {
+			/* warm up the next child while destroying this one */
+			if (i > 0)
+				prefetch(evt_off2ptr(tcx, nd->tn_child[i - 1]));
 			rc = evt_node_destroy(tcx, nd->tn_child[i], level + 1,
 					      &empty);
 			if (rc) {
@@ -2895,12 +3073,19 @@ evt_move_trace(struct evt_context *tcx)
 
 	/* move to the first/last entry in the subtree */
 	while (trace < &tcx->tc_trace[tcx->tc_depth - 1]) {
-		umem_off_t	tmp;
+		struct evt_node	*parent = nd;
+		umem_off_t	 tmp;
 
 		tmp = evt_node_child_at(tcx, nd, trace->tr_at);
 		nd = evt_off2node(tcx, tmp);
 		D_ASSERTF(nd->tn_nr != 0, "%d\n", nd->tn_nr);
 
+		/* Entering a leaf, read ahead its right sibling */
+		if (trace + 1 == &tcx->tc_trace[tcx->tc_depth - 1] &&
+		    trace->tr_at + 1 < parent->tn_nr)
+			prefetch(evt_off2ptr(tcx, evt_node_child_at(tcx, parent,
+								    trace->tr_at + 1)));
+
 		trace++;
 		trace->tr_at = 0;
 		trace->tr_node = tmp;
@@ -231,6 +231,70 @@ ilog_ver_inc(struct ilog_context *lctx)
 	return magic;
 }
 
+/** Slot of the visibility cache */
+struct ilog_vis_slot {
+	/** Log root, NULL if the slot is empty */
+	struct ilog_root	*vs_root;
+	/** Magic, i.e. version, of the log when the slot was filled */
+	uint32_t		 vs_magic;
+	/** Resolved visibility */
+	struct ilog_vis		 vs_vis;
+};
+
+struct ilog_vis_cache {
+	/** Number of slots minus one */
+	uint32_t		vc_mask;
+	/** Direct mapped slots */
+	struct ilog_vis_slot	vc_slots[0];
+};
+
+int
+ilog_vis_cache_create(uint32_t nr, struct ilog_vis_cache **cachep)
+{
+	struct ilog_vis_cache	*cache;
+	uint32_t		 size = 1;
+
+	D_ASSERT(nr != 0);
+	while (size < nr)
+		size <<= 1;
+
+	D_ALLOC(cache, sizeof(*cache) + sizeof(cache->vc_slots[0]) * size);
+	if (cache == NULL)
+		return -DER_NOMEM;
+
+	cache->vc_mask = size - 1;
+	*cachep = cache;
+
+	return 0;
+}
+
+void
+ilog_vis_cache_destroy(struct ilog_vis_cache *cache)
+{
+	D_FREE(cache);
+}
+
+static inline struct ilog_vis_slot *
+ilog_vis_slot_get(struct ilog_vis_cache *cache, struct ilog_root *root)
+{
+	return &cache->vc_slots[d_hash_mix64((uint64_t)root) & cache->vc_mask];
+}
+
+/** Drop the cached visibility of a log being modified */
+static inline void
+ilog_vis_cache_evict(struct ilog_context *lctx)
+{
+	struct ilog_vis_cache	*cache = lctx->ic_cbs.dc_vis_cache;
+	struct ilog_vis_slot	*slot;
+
+	if (cache == NULL)
+		return;
+
+	slot = ilog_vis_slot_get(cache, lctx->ic_root);
+	if (slot->vs_root == lctx->ic_root)
+		slot->vs_root = NULL;
+}
+
 /** Called when we know a txn is needed.  Subsequent calls are a noop. */
 static inline int
 ilog_tx_begin(struct ilog_context *lctx)
@@ -273,6 +337,7 @@ ilog_tx_end(struct ilog_context *lctx, int rc)
 
 done:
 	lctx->ic_in_txn = false;
+	ilog_vis_cache_evict(lctx);
 	return umem_tx_end(lctx->ic_umm, rc);
 }
 
@@ -453,6 +518,92 @@ ilog_log2cache(struct ilog_context *lctx, struct ilog_array_cache *cache)
 	}
 }
 
+bool
+ilog_vis_cache_lookup(struct ilog_vis_cache *cache, struct umem_instance *umm,
+		      struct ilog_df *root_df, struct ilog_vis *vis)
+{
+	struct ilog_root	*root = (struct ilog_root *)root_df;
+	struct ilog_vis_slot	*slot = ilog_vis_slot_get(cache, root);
+	struct ilog_context	 lctx = {
+		.ic_root = root,
+		.ic_umm  = umm,
+	};
+	struct ilog_array_cache	 ac;
+	const struct ilog_id	*latest;
+
+	if (slot->vs_root != root || slot->vs_magic != root->lr_magic)
+		return false;
+
+	/* The root may have been freed and reused by a new log that reached
+	 * the same version.  The latest entry tells them apart.
+	 */
+	ilog_log2cache(&lctx, &ac);
+	if (ac.ac_nr == 0)
+		return false;
+
+	latest = &ac.ac_entries[ac.ac_nr - 1];
+	if (latest->id_epoch != slot->vs_vis.iv_latest.id_epoch ||
+	    latest->id_value != slot->vs_vis.iv_latest.id_value)
+		return false;
+
+	*vis = slot->vs_vis;
+	return true;
+}
+
+void
+ilog_vis_cache_insert(struct ilog_vis_cache *cache, struct ilog_df *root_df,
+		      const struct ilog_vis *vis)
+{
+	struct ilog_root	*root = (struct ilog_root *)root_df;
+	struct ilog_vis_slot	*slot = ilog_vis_slot_get(cache, root);
+
+	slot->vs_root = root;
+	slot->vs_magic = root->lr_magic;
+	slot->vs_vis = *vis;
+}
+
+bool
+ilog_vis_resolve(const struct ilog_entries *entries, struct ilog_vis *vis)
+{
+	struct ilog_entry	entry;
+
+	if (entries->ie_num_entries == 0)
+		return false;
+
+	/* Only cache entries whose DTX has been committed and dropped, their
+	 * status doesn't depend on the intent or the caller's transaction.
+	 */
+	ilog_foreach_entry(entries, &entry) {
+		if (entry.ie_status != ILOG_COMMITTED ||
+		    entry.ie_id.id_tx_id != DTX_LID_COMMITTED)
+			return false;
+	}
+
+	memset(vis, 0, sizeof(*vis));
+	vis->iv_latest = entries->ie_ids[entries->ie_num_entries - 1];
+
+	/* Same walk as the visibility check of the caller, the newest entries
+	 * create the key until the first punch.
+	 */
+	ilog_foreach_entry_reverse(entries, &entry) {
+		vis->iv_floor = entry.ie_id.id_epoch;
+		if (ilog_is_punch(&entry))
+			vis->iv_floor_minor = entry.ie_id.id_punch_minor_eph;
+		else
+			vis->iv_floor_minor = entry.ie_id.id_update_minor_eph;
+
+		if (ilog_has_punch(&entry)) {
+			vis->iv_punch_minor = entry.ie_id.id_punch_minor_eph;
+			if (!ilog_is_punch(&entry))
+				vis->iv_create = entry.ie_id.id_epoch;
+			break;
+		}
+
+		vis->iv_create = entry.ie_id.id_epoch;
+	}
+
+	return true;
+}
 
 int
 ilog_destroy(struct umem_instance *umm,
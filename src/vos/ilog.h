@@ -34,6 +34,7 @@ struct  ilog_df {
 };
 
 struct umem_instance;
+struct ilog_vis_cache;
 
 enum ilog_status {
 	/** Log status is not set */
@@ -67,6 +68,8 @@ struct ilog_desc_cbs {
 			     uint32_t tx_id, daos_epoch_t epoch, bool abort,
 			     void *args);
 	void	*dc_log_del_args;
+	/** Visibility cache to evict the log from when it's modified */
+	struct ilog_vis_cache	*dc_vis_cache;
 };
 
 /** Globally initialize incarnation log */
@@ -166,7 +169,7 @@ struct ilog_entry {
 	int32_t		ie_idx;
 };
 
-#define ILOG_PRIV_SIZE 144
+#define ILOG_PRIV_SIZE 152
 /* Information about ilog entries */
 struct ilog_info {
 	/** Status of ilog entry */
@@ -304,6 +307,74 @@ ilog_ts_idx_get(struct ilog_df *ilog_df);
 uint32_t
 ilog_version_get(daos_handle_t loh);
 
+/** Visibility of an incarnation log with only committed entries, resolved
+ *  from the latest entry back to the first punch without any parent punch.
+ *  It stays valid for reads at or after the latest entry as long as the
+ *  parent punch doesn't reach the floor entry.
+ */
+struct ilog_vis {
+	/** Latest entry of the log */
+	struct ilog_id		iv_latest;
+	/** Earliest creation epoch in the current incarnation, 0 if none */
+	daos_epoch_t		iv_create;
+	/** Epoch of the oldest entry the resolution depends on */
+	daos_epoch_t		iv_floor;
+	/** Minor epoch of the floor entry */
+	uint16_t		iv_floor_minor;
+	/** Minor epoch of the punch at the floor entry, 0 if not punched */
+	uint16_t		iv_punch_minor;
+};
+
+/** Create a visibility cache
+ *
+ * \param	nr[IN]		Number of slots, rounded up to a power of two
+ * \param	cachep[OUT]	Returned cache
+ *
+ * \return 0 on success, error code on failure
+ */
+int
+ilog_vis_cache_create(uint32_t nr, struct ilog_vis_cache **cachep);
+
+/** Destroy a visibility cache */
+void
+ilog_vis_cache_destroy(struct ilog_vis_cache *cache);
+
+/** Look up the resolved visibility of a log.  A hit requires the log to be
+ *  at the same version and latest entry as when it was inserted.
+ *
+ * \param	cache[IN]	The visibility cache
+ * \param	umm[IN]		The umem instance
+ * \param	root[IN]	Pointer to log root
+ * \param	vis[OUT]	Resolved visibility
+ *
+ * \return true on hit
+ */
+bool
+ilog_vis_cache_lookup(struct ilog_vis_cache *cache, struct umem_instance *umm,
+		      struct ilog_df *root, struct ilog_vis *vis);
+
+/** Insert the resolved visibility of a log, replacing any colliding slot.
+ *  Any modification of the log with \a dc_vis_cache set in the callbacks
+ *  evicts it.
+ *
+ * \param	cache[IN]	The visibility cache
+ * \param	root[IN]	Pointer to log root
+ * \param	vis[IN]		Resolved visibility
+ */
+void
+ilog_vis_cache_insert(struct ilog_vis_cache *cache, struct ilog_df *root,
+		      const struct ilog_vis *vis);
+
+/** Resolve the visibility of fetched entries for the cache
+ *
+ * \param	entries[IN]	The fetched entries
+ * \param	vis[OUT]	Resolved visibility
+ *
+ * \return true if all entries are committed and \p vis is set
+ */
+bool
+ilog_vis_resolve(const struct ilog_entries *entries, struct ilog_vis *vis);
+
 /** Returns true if there is a punch minor epoch */
 static inline bool
 ilog_has_punch(const struct ilog_entry *entry)
@@ -98,6 +98,7 @@ lrua_array_alloc_one(struct lru_array *array, struct lru_sub *sub)
 		return -DER_NOMEM;
 
 	alloc_cb(array, rec_size * nr_ents);
+	array->la_sub_alloc++;
 
 	/** Add newly allocated ones to head of list */
 	d_list_del(&sub->ls_link);
@@ -140,6 +141,7 @@ sub_find_free(struct lru_array *array, struct lru_sub *sub,
 	lrua_insert(sub, &sub->ls_lru, entry, tree_idx, true);
 
 	entry->le_key = key;
+	entry->le_stamp = ++array->la_stamp;
 
 	*entryp = entry;
 
@@ -177,12 +179,73 @@ manual_find_free(struct lru_array *array, struct lru_entry **entryp,
 	return 0;
 }
 
+/** Evict the LRU of \p sub and reuse it for \p key */
+static inline void
+sub_evict_lru(struct lru_array *array, struct lru_sub *sub,
+	      struct lru_entry **entryp, uint32_t *idx, uint64_t key)
+{
+	struct lru_entry	*entry;
+
+	entry = &sub->ls_table[sub->ls_lru];
+	/** Key should not be 0, otherwise, it should be in free list */
+	D_ASSERT(entry->le_key != 0);
+
+	evict_cb(array, sub, entry, sub->ls_lru);
+	array->la_evicted++;
+
+	*idx = ent2idx(array, sub, sub->ls_lru);
+	entry->le_key = key;
+	entry->le_stamp = ++array->la_stamp;
+	sub->ls_lru = entry->le_next_idx;
+
+	*entryp = entry;
+}
+
+static inline int
+adaptive_find_free(struct lru_array *array, struct lru_entry **entryp,
+		   uint32_t *idx, uint64_t key)
+{
+	struct lru_sub	*sub;
+	struct lru_sub	*victim = NULL;
+	uint64_t	 stamp = 0;
+	uint32_t	 i;
+	int		 rc;
+
+	d_list_for_each_entry(sub, &array->la_free_sub, ls_link) {
+		if (sub_find_free(array, sub, entryp, idx, key))
+			return 0;
+	}
+
+	/** Grow before evicting anything */
+	if (!d_list_empty(&array->la_unused_sub)) {
+		sub = d_list_entry(array->la_unused_sub.next, struct lru_sub, ls_link);
+		rc = lrua_array_alloc_one(array, sub);
+		if (rc == 0 && sub_find_free(array, sub, entryp, idx, key))
+			return 0;
+	}
+
+	/** All allocated sub arrays are full, evict the oldest of their LRUs */
+	for (i = 0; i < array->la_array_nr; i++) {
+		sub = &array->la_sub[i];
+		if (sub->ls_table == NULL || sub->ls_lru == LRU_NO_IDX)
+			continue;
+		if (victim == NULL || sub->ls_table[sub->ls_lru].le_stamp < stamp) {
+			victim = sub;
+			stamp = sub->ls_table[sub->ls_lru].le_stamp;
+		}
+	}
+	D_ASSERT(victim != NULL);
+
+	sub_evict_lru(array, victim, entryp, idx, key);
+
+	return 0;
+}
+
 int
 lrua_find_free(struct lru_array *array, struct lru_entry **entryp,
 	       uint32_t *idx, uint64_t key)
 {
 	struct lru_sub		*sub;
-	struct lru_entry	*entry;
 
 	*entryp = NULL;
 
@@ -190,21 +253,14 @@ lrua_find_free(struct lru_array *array, struct lru_entry **entryp,
 		return manual_find_free(array, entryp, idx, key);
 	}
 
+	if (array->la_flags & LRU_FLAG_EVICT_ADAPTIVE)
+		return adaptive_find_free(array, entryp, idx, key);
+
 	sub = &array->la_sub[0];
 	if (sub_find_free(array, sub, entryp, idx, key))
 		return 0;
 
-	entry = &sub->ls_table[sub->ls_lru];
-	/** Key should not be 0, otherwise, it should be in free list */
-	D_ASSERT(entry->le_key != 0);
-
-	evict_cb(array, sub, entry, sub->ls_lru);
-
-	*idx = ent2idx(array, sub, sub->ls_lru);
-	entry->le_key = key;
-	sub->ls_lru = entry->le_next_idx;
-
-	*entryp = entry;
+	sub_evict_lru(array, sub, entryp, idx, key);
 
 	return 0;
 }
@@ -240,7 +296,7 @@ lrua_evictx(struct lru_array *array, uint32_t idx, uint64_t key)
 	lrua_remove_entry(array, sub, &sub->ls_lru, entry, ent_idx);
 
 	if (sub->ls_free == LRU_NO_IDX &&
-	    (array->la_flags & LRU_FLAG_EVICT_MANUAL)) {
+	    (array->la_flags & LRU_FLAG_MULTI_SUB)) {
 		D_ASSERT(d_list_empty(&sub->ls_link));
 		/** Add the entry back to the free list */
 		d_list_add_tail(&sub->ls_link, &array->la_free_sub);
@@ -276,9 +332,9 @@ lrua_array_alloc(struct lru_array **arrayp, uint32_t nr_ent, uint32_t nr_arrays,
 	D_ASSERT(nr_arrays != 0);
 	D_ASSERT(nr_ent > nr_arrays);
 
-	if (nr_arrays != 1) {
-		/** No good algorithm for auto eviction across multiple
-		 *  sub arrays since one lru is maintained per sub array
+	if (nr_arrays != 1 && (flags & LRU_FLAG_EVICT_ADAPTIVE) == 0) {
+		/** Auto eviction across multiple sub arrays must compare the
+		 *  per sub array LRUs, so it is only done when requested.
 		 */
 		flags |= LRU_FLAG_EVICT_MANUAL;
 	}
@@ -335,6 +391,7 @@ array_free_one(struct lru_array *array, struct lru_sub *sub)
 		fini_cb(array, sub, &sub->ls_table[idx], idx);
 
 	D_FREE(sub->ls_table);
+	array->la_sub_alloc--;
 
 	free_cb(array,
 		(sizeof(struct lru_entry) + array->la_payload_size) *
@@ -388,3 +445,46 @@ lrua_array_aggregate(struct lru_array *array)
 		array_free_one(array, sub);
 	}
 }
+
+bool
+lrua_array_trim(struct lru_array *array, uint64_t since)
+{
+	struct lru_entry	*entry;
+	struct lru_sub		*sub = NULL;
+	uint32_t		 ent_idx;
+	int			 i;
+
+	if ((array->la_flags & LRU_FLAG_EVICT_ADAPTIVE) == 0)
+		return false; /* Not applicable */
+
+	for (i = array->la_array_nr - 1; i > 0; i--) {
+		if (array->la_sub[i].ls_table != NULL) {
+			sub = &array->la_sub[i];
+			break;
+		}
+	}
+
+	if (sub == NULL)
+		return false; /* The first sub array is always kept */
+
+	if (sub->ls_lru != LRU_NO_IDX) {
+		/** The MRU is the entry preceding the LRU */
+		entry = &sub->ls_table[sub->ls_table[sub->ls_lru].le_prev_idx];
+		if (entry->le_stamp > since)
+			return false;
+
+		ent_idx = sub->ls_lru;
+		do {
+			entry = &sub->ls_table[ent_idx];
+			evict_cb(array, sub, entry, ent_idx);
+			entry->le_key = 0;
+			ent_idx = entry->le_next_idx;
+		} while (ent_idx != sub->ls_lru);
+	}
+
+	d_list_del(&sub->ls_link);
+	d_list_add(&sub->ls_link, &array->la_unused_sub);
+	array_free_one(array, sub);
+
+	return true;
+}
@@ -37,6 +37,8 @@ struct lru_entry {
 	uint32_t	 le_next_idx;
 	/** Previous index in LRU array */
 	uint32_t	 le_prev_idx;
+	/** Access stamp, used to pick the LRU across sub arrays */
+	uint64_t	 le_stamp;
 };
 
 struct lru_sub {
@@ -69,8 +71,17 @@ enum {
 	 *  reuse of entries
 	 */
 	LRU_FLAG_REUSE_UNIQUE		= 2,
+	/** Automatic eviction with multiple sub arrays.  Sub arrays are
+	 *  allocated on demand before anything is evicted, the victim is the
+	 *  oldest of the per sub array LRUs and cold sub arrays can be released
+	 *  with lrua_array_trim().
+	 */
+	LRU_FLAG_EVICT_ADAPTIVE		= 4,
 };
 
+/** Internal: flags for arrays tracking sub arrays with free entries */
+#define LRU_FLAG_MULTI_SUB	(LRU_FLAG_EVICT_MANUAL | LRU_FLAG_EVICT_ADAPTIVE)
+
 struct lru_array {
 	/** Number of indices */
 	uint32_t		 la_count;
@@ -94,6 +105,12 @@ struct lru_array {
 	struct lru_callbacks	 la_cbs;
 	/** User callback argument passed on init */
 	void			*la_arg;
+	/** Access clock, source of lru_entry::le_stamp */
+	uint64_t		 la_stamp;
+	/** Number of entries evicted to make room for new ones */
+	uint64_t		 la_evicted;
+	/** Number of allocated sub arrays */
+	uint32_t		 la_sub_alloc;
 	/** Allocated subarrays */
 	struct lru_sub		 la_sub[0];
 };
@@ -138,7 +155,7 @@ lrua_remove_entry(struct lru_array *array, struct lru_sub *sub, uint32_t *head,
 	 * If no free entries in the sub, then remove it from array free list (array->la_free_sub)
 	 * to avoid being searched when try to find free entry next time.
 	 */
-	if (head == &sub->ls_free && *head == LRU_NO_IDX && array->la_flags & LRU_FLAG_EVICT_MANUAL)
+	if (head == &sub->ls_free && *head == LRU_NO_IDX && array->la_flags & LRU_FLAG_MULTI_SUB)
 		d_list_del_init(&sub->ls_link);
 }
 
@@ -218,6 +235,7 @@ lrua_lookup_idx(struct lru_array *array, uint32_t idx, uint64_t key,
 	if (entry->le_key == key) {
 		if (touch_mru && !array->la_evicting) {
 			/** Only make mru if we are not evicting it */
+			entry->le_stamp = ++array->la_stamp;
 			lrua_move_to_mru(array, sub, entry, ent_idx);
 		}
 		return entry;
@@ -431,6 +449,7 @@ lrua_allocx_inplace_(struct lru_array *array, uint32_t idx, uint64_t key,
 	}
 
 	entry->le_key = key;
+	entry->le_stamp = ++array->la_stamp;
 
 	/** First remove */
 	lrua_remove_entry(array, sub, &sub->ls_free, entry, ent_idx);
@@ -469,7 +488,8 @@ lrua_evict(struct lru_array *array, uint32_t *idx)
  * \param	array[in,out]	Pointer to LRU array
  * \param	nr_ent[in]	Number of records in array
  * \param	nr_arrays[in]	Number of 2nd level arrays.   If it is not 1,
- *				manual eviction is implied.
+ *				manual eviction is implied unless
+ *				LRU_FLAG_EVICT_ADAPTIVE is set.
  * \param	rec_size[in]	Size of each record
  * \param	cbs[in]		Optional callbacks
  * \param	arg[in]		Optional argument passed to all callbacks
@@ -497,4 +517,17 @@ lrua_array_free(struct lru_array *array);
 void
 lrua_array_aggregate(struct lru_array *array);
 
+/** Release a cold sub array of an adaptive array
+ *
+ * Evicts the entries of the last allocated sub array, other than the first
+ * one, and frees it, provided none of its entries was accessed after \p since.
+ *
+ * \param	array[in]	The LRU array
+ * \param	since[in]	Access stamp (la_stamp) marking the cold period
+ *
+ * \return	true if a sub array was released
+ */
+bool
+lrua_array_trim(struct lru_array *array, uint64_t since);
+
 #endif /* __LRU_ARRAY__ */
@@ -759,6 +759,122 @@ ts_many_add(void)
 	D_FREE(seq);
 }
 
+/* Width of the range targeted by the overlap benchmark */
+#define TS_OVERLAP_RANGE	4096
+
+static void
+ts_overlap_perf(void)
+{
+	struct evt_entry_in	 entry = {0};
+	struct evt_filter	 filter = {0};
+	struct evt_rect		*rect;
+	bio_addr_t		 bio_addr = {0};
+	EVT_ENT_ARRAY_LG_PTR(ent_array);
+	uint64_t		 start;
+	uint64_t		 elapsed;
+	uint64_t		 len;
+	int			 visible = 0;
+	int			 nr;
+	int			 rounds;
+	int			 i;
+	int			 rc;
+	char			*arg;
+	char			*tmp;
+	/* argument format: "n:NUM,r:NUM"
+	 * n: number of overlapping writes to the range
+	 * r: number of rounds of lookup over the range
+	 */
+	arg = tst_fn_val.optval;
+	if (!arg) {
+		D_PRINT("need input parameters n:NUM,r:NUM\n");
+		fail();
+	}
+
+	if (arg[0] != 'n' || arg[1] != EVT_SEP_VAL) {
+		D_PRINT("Invalid parameter %s\n", arg);
+		fail();
+	}
+	nr = strtol(&arg[2], &tmp, 0);
+	if (nr <= 0) {
+		D_PRINT("Invalid number of writes %d\n", nr);
+		fail();
+	}
+	if (*tmp != EVT_SEP) {
+		D_PRINT("Invalid parameter %s\n", arg);
+		fail();
+	}
+	arg = tmp + 1;
+
+	if (arg[0] != 'r' || arg[1] != EVT_SEP_VAL) {
+		D_PRINT("Invalid parameter %s\n", arg);
+		fail();
+	}
+	rounds = strtol(&arg[2], &tmp, 0);
+	if (rounds <= 0) {
+		D_PRINT("Invalid number of rounds %d\n", rounds);
+		fail();
+	}
+
+	rect = &entry.ei_rect;
+	for (i = 0; i < nr; i++) {
+		/* Random extents with up to a quarter of the range, plus
+		 * periodic full range rewrites, all at distinct epochs.
+		 */
+		if (i % 16 == 0) {
+			rect->rc_ex.ex_lo = 0;
+			len = TS_OVERLAP_RANGE;
+		} else {
+			rect->rc_ex.ex_lo = rand() % TS_OVERLAP_RANGE;
+			len = 1 + rand() % (TS_OVERLAP_RANGE / 4);
+			if (rect->rc_ex.ex_lo + len > TS_OVERLAP_RANGE)
+				len = TS_OVERLAP_RANGE - rect->rc_ex.ex_lo;
+		}
+		rect->rc_ex.ex_hi = rect->rc_ex.ex_lo + len - 1;
+		rect->rc_epc = i + 1;
+
+		/* Punched extents, only the visibility is measured */
+		rc = bio_strdup(ts_utx, &bio_addr, NULL);
+		if (rc != 0) {
+			D_FATAL("Insufficient memory for test\n");
+			fail();
+		}
+		entry.ei_bound = rect->rc_epc;
+		entry.ei_addr = bio_addr;
+		entry.ei_ver = 0;
+		entry.ei_inob = 0;
+
+		rc = evt_insert(ts_toh, &entry, NULL);
+		if (rc == 1)
+			rc = 0;
+		if (rc != 0) {
+			D_FATAL("Add rect %d failed "DF_RC"\n", i, DP_RC(rc));
+			fail();
+		}
+	}
+
+	filter.fr_ex.ex_lo = 0;
+	filter.fr_ex.ex_hi = TS_OVERLAP_RANGE - 1;
+	filter.fr_epr.epr_lo = 0;
+	filter.fr_epr.epr_hi = nr;
+	filter.fr_epoch = nr;
+
+	start = daos_get_ntime();
+	for (i = 0; i < rounds; i++) {
+		evt_ent_array_init(ent_array, 0);
+		rc = evt_find(ts_toh, &filter, ent_array);
+		if (rc != 0) {
+			D_FATAL("Find failed "DF_RC"\n", DP_RC(rc));
+			fail();
+		}
+		visible = ent_array->ea_ent_nr;
+		evt_ent_array_fini(ent_array);
+	}
+	elapsed = daos_get_ntime() - start;
+
+	D_PRINT("Overlap: %d writes, %d visible, %d rounds, "DF_U64" us per find\n",
+		nr, visible, rounds, elapsed / 1000 / rounds);
+}
+
 static void
 ts_tree_debug(void)
 {
@@ -2448,6 +2564,7 @@ static struct option ts_ops[] = {
 	{ "debug",	required_argument,	NULL,	'b'	},
 	{ "test",	required_argument,	NULL,	't'	},
 	{ "sort",	required_argument,	NULL,	's'	},
+	{ "overlap",	required_argument,	NULL,	'p'	},
 	{ NULL,		0,			NULL,	0	},
 };
 
@@ -2499,6 +2616,9 @@ ts_cmd_run(char opc, char *args)
 	case 'b':
 		ts_tree_debug();
 		break;
+	case 'p':
+		ts_overlap_perf();
+		break;
 	case 't':
 		break;
 	case 's':
@@ -2523,7 +2643,7 @@ ts_group(void **state)
 	int	opc = 0;
 
 	while ((opc = getopt_long(test_group_argc, test_group_args,
-				  "C:a:m:e:f:g:d:b:Docl::ts:r:", ts_ops, NULL)) != -1) {
+				  "C:a:m:e:f:g:d:b:Docl::ts:r:p:", ts_ops, NULL)) != -1) {
 		ts_cmd_run(opc, optarg);
 	}
 }
@@ -185,6 +185,19 @@ if (( result != 0 )); then
         exit "$result"
 fi
 
+# Overlapping writes benchmark
+cmd="$VCMD $EVT_CTL --start-test \"evtree overlap tests $*\" $*"
+for nr in 10 100 1000 10000; do
+    cmd+=" -C o:16 -p n:$nr,r:10 -D"
+done
+echo "$cmd"
+eval "$cmd"
+result="${PIPESTATUS[0]}"
+echo "Overlap test returned $result"
+if (( result != 0 )); then
+        exit "$result"
+fi
+
 # Drain tests
 cmd="$VCMD $EVT_CTL --start-test \"evtree drain tests $*\" $* -C o:4"
 cmd+=" -e s:0,e:128,n:2379 -c"
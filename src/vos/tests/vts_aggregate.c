@@ -2860,6 +2860,201 @@ aggregate_35(void **state)
 	assert_int_equal(feats & INIT_FEATS, INIT_FEATS);
 }
 
+#define AGG_PERF_REC_NR	8
+#define AGG_PERF_IOD_SIZE	16
+
+/* Write overlapped extents to @obj_nr objects and aggregate them, returns usecs */
+static uint64_t
+aggregate_perf(struct io_test_args *arg, int obj_nr, daos_epoch_t epoch)
+{
+	daos_epoch_range_t	 epr;
+	daos_unit_oid_t		 oid;
+	daos_recx_t		 recx;
+	char			 dkey[UPDATE_DKEY_SIZE];
+	char			 akey[UPDATE_AKEY_SIZE];
+	char			*buf;
+	uint64_t		 start;
+	int			 i, j, rc;
+
+	D_ALLOC(buf, 64 * AGG_PERF_IOD_SIZE);
+	assert_non_null(buf);
+
+	dts_key_gen(dkey, UPDATE_DKEY_SIZE, UPDATE_DKEY);
+	dts_key_gen(akey, UPDATE_AKEY_SIZE, UPDATE_AKEY);
+	epr.epr_lo = epoch;
+	for (i = 0; i < obj_nr; i++) {
+		oid = dts_unit_oid_gen(0, 0);
+		for (j = 0; j < AGG_PERF_REC_NR; j++) {
+			recx.rx_idx = j * 8;
+			recx.rx_nr = 64;
+			update_value(arg, oid, epoch + j, 0, dkey, akey, DAOS_IOD_ARRAY,
+				     AGG_PERF_IOD_SIZE, &recx, buf);
+		}
+	}
+	epr.epr_hi = epoch + AGG_PERF_REC_NR;
+	D_FREE(buf);
+
+	start = daos_getutime();
+	rc = vos_aggregate(arg->ctx.tc_co_hdl, &epr, NULL, NULL, 0);
+	assert_rc_equal(rc, 0);
+
+	return daos_getutime() - start;
+}
+
+/*
+ * Aggregate multiple objects with partitions running in several ULTs.
+ */
+static void
+aggregate_36(void **state)
+{
+	struct io_test_args	*arg = *state;
+	struct agg_tst_dataset	 ds = { 0 };
+	daos_recx_t		 recx_tot;
+	unsigned int		 saved_parts = vos_agg_parts;
+	unsigned int		 parts[] = { 1, 4 };
+	int			 obj_nr = slow_test ? 2000 : 200;
+	uint64_t		 usecs;
+	int			 i;
+
+	recx_tot.rx_idx = 0;
+	recx_tot.rx_nr = 20;
+
+	ds.td_type = DAOS_IOD_ARRAY;
+	ds.td_iod_size = 1024;
+	ds.td_expected_recs = -1;
+	ds.td_recx_nr = 1;
+	ds.td_recx = &recx_tot;
+	ds.td_upd_epr.epr_lo = 1;
+	ds.td_upd_epr.epr_hi = 1000;
+	ds.td_agg_epr.epr_lo = 750;
+	ds.td_agg_epr.epr_hi = 1000;
+	ds.td_discard = false;
+
+	vos_agg_parts = 4;
+	aggregate_multi(arg, &ds);
+
+	for (i = 0; i < ARRAY_SIZE(parts); i++) {
+		vos_agg_parts = parts[i];
+		usecs = aggregate_perf(arg, obj_nr, 2000 + i * (AGG_PERF_REC_NR + 1));
+		print_message("%u partition(s): aggregated %d objects in "DF_U64" us, "
+			      "%.1f objects/s\n", parts[i], obj_nr, usecs,
+			      usecs ? obj_nr * 1000000.0 / usecs : 0.0);
+	}
+
+	vos_agg_parts = saved_parts;
+	cleanup();
+}
+
+struct agg_yield_arg {
+	/* Number of calls to the yield function */
+	int	ya_calls;
+	/* Abort on this call, 0 to never abort */
+	int	ya_abort_at;
+};
+
+/* Mimic agg_rate_ctl(): yield, then alternate between slack and tight mode */
+static int
+agg_yield_func(void *arg)
+{
+	struct agg_yield_arg	*ya = arg;
+
+	ya->ya_calls++;
+	ABT_thread_yield();
+
+	if (ya->ya_abort_at != 0 && ya->ya_calls >= ya->ya_abort_at)
+		return -1;
+
+	return ya->ya_calls % 2;
+}
+
+/*
+ * Overwrite the same extent of @obj_nr objects several times, aggregate them with the
+ * yield function, then verify the latest data of each object is intact.
+ */
+static int
+aggregate_paced(struct io_test_args *arg, int obj_nr, daos_epoch_t epoch,
+		struct agg_yield_arg *ya)
+{
+	daos_epoch_range_t	 epr;
+	daos_unit_oid_t		*oids;
+	daos_recx_t		 recx;
+	char			 dkey[UPDATE_DKEY_SIZE];
+	char			 akey[UPDATE_AKEY_SIZE];
+	daos_size_t		 len = 64 * AGG_PERF_IOD_SIZE;
+	char			*bufs, *buf_f;
+	int			 i, j, rc;
+
+	D_ALLOC_ARRAY(oids, obj_nr);
+	assert_non_null(oids);
+	D_ALLOC(bufs, obj_nr * len);
+	assert_non_null(bufs);
+	D_ALLOC(buf_f, len);
+	assert_non_null(buf_f);
+
+	dts_key_gen(dkey, UPDATE_DKEY_SIZE, UPDATE_DKEY);
+	dts_key_gen(akey, UPDATE_AKEY_SIZE, UPDATE_AKEY);
+	recx.rx_idx = 0;
+	recx.rx_nr = 64;
+	for (i = 0; i < obj_nr; i++) {
+		oids[i] = dts_unit_oid_gen(0, 0);
+		for (j = 0; j < AGG_PERF_REC_NR; j++)
+			update_value(arg, oids[i], epoch + j, 0, dkey, akey, DAOS_IOD_ARRAY,
+				     AGG_PERF_IOD_SIZE, &recx, bufs + i * len);
+	}
+
+	epr.epr_lo = epoch;
+	epr.epr_hi = epoch + AGG_PERF_REC_NR;
+	rc = vos_aggregate(arg->ctx.tc_co_hdl, &epr, agg_yield_func, ya, 0);
+
+	for (i = 0; i < obj_nr; i++) {
+		fetch_value(arg, oids[i], epr.epr_hi, 0, dkey, akey, DAOS_IOD_ARRAY,
+			    AGG_PERF_IOD_SIZE, &recx, buf_f);
+		assert_memory_equal(buf_f, bufs + i * len, len);
+	}
+
+	D_FREE(buf_f);
+	D_FREE(bufs);
+	D_FREE(oids);
+
+	return rc;
+}
+
+/*
+ * Parallel partitions paced by the yield function of the caller: slack/tight mode
+ * switches and abort must reach the helper partitions.
+ */
+static void
+aggregate_37(void **state)
+{
+	struct io_test_args	*arg = *state;
+	struct agg_yield_arg	 ya = { 0 };
+	unsigned int		 saved_parts = vos_agg_parts;
+	int			 obj_nr = 200;
+	int			 rc;
+
+	vos_agg_parts = 4;
+
+	/* Pacing, helpers follow the alternating slack/tight mode till done */
+	rc = aggregate_paced(arg, obj_nr, 1, &ya);
+	assert_rc_equal(rc, 0);
+	assert_true(ya.ya_calls > 0);
+	print_message("Aggregated %d objects with %d rate control calls\n", obj_nr,
+		      ya.ya_calls);
+
+	/*
+	 * Abort on the first call, the caller stops calling the rate control once
+	 * aborted and the helpers must quit on their own.
+	 */
+	ya.ya_calls = 0;
+	ya.ya_abort_at = 1;
+	rc = aggregate_paced(arg, obj_nr, 1000, &ya);
+	assert_true(rc >= 0);
+	assert_int_equal(ya.ya_calls, 1);
+
+	vos_agg_parts = saved_parts;
+	cleanup();
+}
+
 static int
 agg_tst_teardown(void **state)
 {
@@ -2976,6 +3171,10 @@ static const struct CMUnitTest aggregate_tests[] = {
 	  aggregate_34, NULL, agg_tst_teardown },
 	{ "VOS435: Test aggregation timestamp functions",
 	  aggregate_35, NULL, NULL },
+	{ "VOS436: Aggregate EV, multiple objects, keys, parallel partitions",
+	  aggregate_36, NULL, agg_tst_teardown },
+	{ "VOS437: Aggregate EV, parallel partitions paced by rate control",
+	  aggregate_37, NULL, agg_tst_teardown },
 };
 
 int
@@ -858,6 +858,70 @@ dtx_18(void **state)
 	assert_memory_equal(update_buf, fetch_buf, UPDATE_BUF_SIZE);
 }
 
+/* DTX batched commit with repeated entries */
+static void
+dtx_19(void **state)
+{
+	struct io_test_args		*args = *state;
+	struct dtx_id			 xid[10];
+	daos_iod_t			 iod = { 0 };
+	d_sg_list_t			 sgl = { 0 };
+	daos_recx_t			 rex = { 0 };
+	daos_key_t			 dkey;
+	daos_key_t			 akey;
+	d_iov_t				 val_iov;
+	uint64_t			 epoch;
+	char				 dkey_buf[UPDATE_DKEY_SIZE];
+	char				 akey_buf[UPDATE_AKEY_SIZE];
+	char				 update_buf[UPDATE_BUF_SIZE];
+	int				 rc;
+	int				 i;
+
+	for (i = 0; i < 10; i++) {
+		struct dtx_handle		*dth = NULL;
+		d_iov_t				 dkey_iov;
+		uint64_t			 dkey_hash;
+
+		vts_dtx_prep_update(args, &val_iov, &dkey_iov, &dkey,
+				    dkey_buf, &akey, akey_buf, &iod, &sgl,
+				    &rex, update_buf, UPDATE_BUF_SIZE,
+				    UPDATE_REC_SIZE, &dkey_hash, &epoch, false);
+
+		vts_dtx_begin(&args->oid, args->ctx.tc_co_hdl, epoch, dkey_hash,
+			      &dth);
+
+		rc = io_test_obj_update(args, epoch, 0, &dkey, &iod, &sgl,
+					dth, true);
+		assert_rc_equal(rc, 0);
+
+		xid[i] = dth->dth_xid;
+
+		vts_dtx_end(dth);
+	}
+
+	/* Commit the first half, then the whole batch. */
+	rc = vos_dtx_commit(args->ctx.tc_co_hdl, xid, 5, NULL);
+	assert_rc_equal(rc, 5);
+
+	rc = vos_dtx_commit(args->ctx.tc_co_hdl, xid, 10, NULL);
+	assert_rc_equal(rc, 5);
+
+	for (i = 0; i < 10; i++) {
+		rc = vos_dtx_check(args->ctx.tc_co_hdl, &xid[i], NULL, NULL, NULL, NULL, false);
+		assert_int_equal(rc, DTX_ST_COMMITTED);
+	}
+
+	sleep(3);
+
+	rc = vos_dtx_aggregate(args->ctx.tc_co_hdl);
+	assert_rc_equal(rc, 0);
+
+	for (i = 0; i < 10; i++) {
+		rc = vos_dtx_check(args->ctx.tc_co_hdl, &xid[i], NULL, NULL, NULL, NULL, false);
+		assert_rc_equal(rc, -DER_NONEXIST);
+	}
+}
+
 static int
 dtx_tst_teardown(void **state)
 {
@@ -892,6 +956,8 @@ static const struct CMUnitTest dtx_tests[] = {
 	  dtx_17, NULL, dtx_tst_teardown },
 	{ "VOS518: DTX aggregation",
 	  dtx_18, NULL, dtx_tst_teardown },
+	{ "VOS519: DTX batched commit with repeated entries",
+	  dtx_19, NULL, dtx_tst_teardown },
 };
 
 int
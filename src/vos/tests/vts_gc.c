@@ -43,6 +43,10 @@ static const int singv_size	= 16;
 static int obj_per_cont = OBJ_PER_CONT;
 static int dkey_per_obj = DKEY_PER_OBJ;
 
+/* set VTS_GC_BENCH_KEYS=10000000 for the large object deletion benchmark */
+#define BENCH_KEYS	(16 << 10)
+static unsigned int bench_keys = BENCH_KEYS;
+
 static struct vos_gc_stat	gc_stat;
 
 void
@@ -551,6 +555,82 @@ gc_cont_test(void **state)
 	assert_rc_equal(rc, 0);
 }
 
+static int
+gc_bench_run(struct gc_test_args *args, unsigned int bulk_creds)
+{
+	struct io_credit	*cred;
+	daos_unit_oid_t		 oid;
+	unsigned int		 saved_creds = vos_gc_bulk_creds;
+	uint64_t		 usecs;
+	int			 i;
+	int			 rc;
+
+	cred = dts_credit_take(&args->gc_ctx);
+	D_ASSERT(cred);
+
+	d_iov_set(&cred->tc_dkey, cred->tc_dbuf, DTS_KEY_LEN);
+	d_iov_set(&cred->tc_iod.iod_name, cred->tc_abuf, DTS_KEY_LEN);
+
+	args->gc_array = true;
+	oid = dts_unit_oid_gen(0, 0);
+	gc_add_stat(STAT_OBJ);
+	for (i = 0; i < bench_keys; i++) {
+		gc_add_stat(STAT_DKEY);
+		gc_add_stat(STAT_AKEY);
+		dts_key_gen(cred->tc_dbuf, DTS_KEY_LEN, NULL);
+
+		rc = gc_obj_update(args, args->gc_ctx.tsc_coh, oid, 1, cred);
+		if (rc)
+			goto out;
+	}
+	gc_print_stat();
+
+	rc = vos_obj_delete(args->gc_ctx.tsc_coh, oid);
+	if (rc) {
+		print_error("failed to delete object: %s\n", d_errstr(rc));
+		goto out;
+	}
+
+	vos_gc_bulk_creds = bulk_creds;
+	usecs = daos_getutime();
+	rc = vos_gc_pool(args->gc_ctx.tsc_poh, 0, NULL, NULL);
+	usecs = daos_getutime() - usecs;
+	vos_gc_bulk_creds = saved_creds;
+	if (rc < 0) {
+		print_error("gc pool failed: %s\n", d_errstr(rc));
+		goto out;
+	}
+	print_message("GC reclaimed %u keys in "DF_U64" us (%.1f keys/s), bulk credits %u\n",
+		      bench_keys, usecs, usecs ? bench_keys * 1000000.0 / usecs : 0.0,
+		      bulk_creds);
+
+	daos_fail_loc_set(DAOS_VOS_GC_CONT | DAOS_FAIL_ALWAYS);
+	rc = gc_wait_check(args, false);
+out:
+	dts_credit_return(&args->gc_ctx, cred);
+	return rc;
+}
+
+static void
+gc_bench_test(void **state)
+{
+	struct gc_test_args *args = *state;
+	int		     rc;
+
+	rc = gc_bench_run(args, 0);
+	assert_rc_equal(rc, 0);
+}
+
+static void
+gc_bench_test_bulk(void **state)
+{
+	struct gc_test_args *args = *state;
+	int		     rc;
+
+	rc = gc_bench_run(args, VOS_GC_BULK_CREDS);
+	assert_rc_equal(rc, 0);
+}
+
 static int
 gc_setup(void **state)
 {
@@ -618,6 +698,10 @@ static const struct CMUnitTest gc_tests[] = {
 	  gc_obj_test_destroy, gc_prepare, NULL},
 	{ "GC06: container garbage reopened container",
 	  gc_obj_test_reopened, gc_prepare, NULL},
+	{ "GC07: large object garbage collecting",
+	  gc_bench_test, gc_prepare, NULL},
+	{ "GC08: large object garbage collecting (bulk mode)",
+	  gc_bench_test_bulk, gc_prepare, NULL},
 };
 
 int
@@ -625,9 +709,11 @@ run_gc_tests(const char *cfg)
 {
 	char	test_name[DTS_CFG_MAX];
 
+	d_getenv_int("VTS_GC_BENCH_KEYS", &bench_keys);
 	if (DAOS_ON_VALGRIND) {
 		obj_per_cont = 2;
 		dkey_per_obj = 3;
+		bench_keys = 16;
 	}
 
 	dts_create_config(test_name, "GC tests %s", cfg);
@@ -1046,6 +1046,93 @@ ilog_test_discard(void **state)
 	ilog_fetch_finish(&ilents);
 }
 
+static void
+ilog_test_vis_cache(void **state)
+{
+	struct io_test_args	*args = *state;
+	struct vos_pool		*pool;
+	struct umem_instance	*umm;
+	struct ilog_df		*ilog;
+	struct ilog_vis_cache	*cache;
+	struct ilog_desc_cbs	 cbs = ilog_callbacks;
+	struct ilog_entries	 ilents;
+	struct ilog_vis		 vis;
+	struct ilog_id		 id;
+	daos_handle_t		 loh;
+	int			 rc;
+
+	pool = vos_hdl2pool(args->ctx.tc_po_hdl);
+	assert_non_null(pool);
+	umm = vos_pool2umm(pool);
+
+	rc = ilog_vis_cache_create(16, &cache);
+	assert_rc_equal(rc, 0);
+	cbs.dc_vis_cache = cache;
+
+	ilog_fetch_init(&ilents);
+
+	ilog = ilog_alloc_root(umm);
+
+	rc = ilog_create(umm, ilog);
+	LOG_FAIL(rc, 0, "Failed to create a new incarnation log\n");
+
+	rc = ilog_open(umm, ilog, &cbs, &loh);
+	LOG_FAIL(rc, 0, "Failed to open incarnation log\n");
+
+	current_status = PREPARED;
+	rc = ilog_update(loh, NULL, 1, 1, false);
+	LOG_FAIL(rc, 0, "Failed to insert log entry\n");
+	id = current_tx_id;
+
+	/* Uncommitted entries are never cached */
+	rc = ilog_fetch(umm, ilog, &cbs, DAOS_INTENT_DEFAULT, false, &ilents);
+	LOG_FAIL(rc, 0, "Failed to fetch ilog\n");
+	assert_false(ilog_vis_resolve(&ilents, &vis));
+
+	rc = ilog_persist(loh, &id);
+	LOG_FAIL(rc, 0, "Failed to persist log entry\n");
+
+	current_status = COMMITTED;
+	rc = ilog_update(loh, NULL, 2, 1, true);
+	LOG_FAIL(rc, 0, "Failed to insert log entry\n");
+	id = current_tx_id;
+	rc = ilog_persist(loh, &id);
+	LOG_FAIL(rc, 0, "Failed to persist log entry\n");
+
+	rc = ilog_update(loh, NULL, 3, 1, false);
+	LOG_FAIL(rc, 0, "Failed to insert log entry\n");
+	id = current_tx_id;
+	rc = ilog_persist(loh, &id);
+	LOG_FAIL(rc, 0, "Failed to persist log entry\n");
+
+	rc = ilog_fetch(umm, ilog, &cbs, DAOS_INTENT_DEFAULT, false, &ilents);
+	LOG_FAIL(rc, 0, "Failed to fetch ilog\n");
+	assert_true(ilog_vis_resolve(&ilents, &vis));
+	assert_int_equal(vis.iv_latest.id_epoch, 3);
+	assert_int_equal(vis.iv_create, 3);
+	assert_int_equal(vis.iv_floor, 2);
+	assert_int_equal(vis.iv_punch_minor, 1);
+
+	assert_false(ilog_vis_cache_lookup(cache, umm, ilog, &vis));
+	ilog_vis_cache_insert(cache, ilog, &vis);
+	memset(&vis, 0, sizeof(vis));
+	assert_true(ilog_vis_cache_lookup(cache, umm, ilog, &vis));
+	assert_int_equal(vis.iv_latest.id_epoch, 3);
+
+	/* Any modification evicts the log */
+	rc = ilog_update(loh, NULL, 4, 1, false);
+	LOG_FAIL(rc, 0, "Failed to insert log entry\n");
+	assert_false(ilog_vis_cache_lookup(cache, umm, ilog, &vis));
+
+	ilog_close(loh);
+	rc = ilog_destroy(umm, &cbs, ilog);
+	assert_rc_equal(rc, 0);
+
+	ilog_free_root(umm, ilog);
+	ilog_fetch_finish(&ilents);
+	ilog_vis_cache_destroy(cache);
+}
+
 static const struct CMUnitTest inc_tests[] = {
 	{ "VOS500.1: VOS incarnation log UPDATE", ilog_test_update, NULL,
 		NULL},
@@ -1057,6 +1144,8 @@ static const struct CMUnitTest inc_tests[] = {
 		NULL, NULL},
 	{ "VOS500.5: VOS incarnation log DISCARD test", ilog_test_discard,
 		NULL, NULL},
+	{ "VOS500.6: VOS incarnation log visibility cache test",
+		ilog_test_vis_cache, NULL, NULL},
 };
 
 int
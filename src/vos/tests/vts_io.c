@@ -1636,6 +1636,128 @@ vos_iterate_test(void **state)
 	arg->ta_flags = old_flags;
 }
 
+struct batch_info {
+	int	bi_calls;
+	int	bi_yield;
+};
+
+static int
+iter_batch_cb(daos_handle_t ih, vos_iter_entry_t *entry, vos_iter_type_t type,
+	      vos_iter_param_t *param, void *cb_arg, unsigned int *acts)
+{
+	struct batch_info	*info = cb_arg;
+
+	assert_int_equal(type, VOS_ITER_OBJ);
+	info->bi_calls++;
+	/* force reprobe in the middle of a batch */
+	if (info->bi_yield != 0 && info->bi_calls % info->bi_yield == 0)
+		*acts |= VOS_ITER_CB_YIELD;
+
+	return 0;
+}
+
+static void
+vos_iterate_batch_test(void **state)
+{
+	struct io_test_args	*arg = *state;
+	struct batch_info	 info = {0};
+	vos_iter_param_t	 param = {0};
+	struct vos_iter_anchors	 anchors = {0};
+	vos_iter_entry_t	 ents[4];
+	daos_handle_t		 ih;
+	daos_epoch_t		 epoch = 1;
+	uint32_t		 nr;
+	int			 total = 0;
+	int			 rc;
+	unsigned long		 old_flags = arg->ta_flags;
+
+	arg->ta_flags = 0;
+	test_args_reset(arg, VPOOL_SIZE);
+
+	gen_io(arg, ITER_OBJ_NR, 1, 1, 0, &epoch);
+
+	param.ip_hdl = arg->ctx.tc_co_hdl;
+	param.ip_epc_expr = VOS_IT_EPC_RR;
+	param.ip_ih = DAOS_HDL_INVAL;
+	param.ip_epr.epr_hi = epoch;
+	param.ip_epr.epr_lo = 0;
+
+	rc = vos_iter_prepare(VOS_ITER_OBJ, &param, &ih, NULL);
+	assert_rc_equal(rc, 0);
+
+	rc = vos_iter_probe(ih, NULL);
+	while (rc == 0) {
+		nr = ARRAY_SIZE(ents);
+		rc = vos_iter_fetch_batch(ih, ents, NULL, &nr);
+		total += nr;
+	}
+	assert_rc_equal(rc, -DER_NONEXIST);
+	assert_int_equal(total, ITER_OBJ_NR);
+	vos_iter_finish(ih);
+
+	param.ip_flags = VOS_IT_BATCH;
+	rc = vos_iterate(&param, VOS_ITER_OBJ, false, &anchors, iter_batch_cb, NULL, &info,
+			 NULL);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(info.bi_calls, ITER_OBJ_NR);
+
+	memset(&anchors, 0, sizeof(anchors));
+	info.bi_calls = 0;
+	info.bi_yield = 3;
+	rc = vos_iterate(&param, VOS_ITER_OBJ, false, &anchors, iter_batch_cb, NULL, &info,
+			 NULL);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(info.bi_calls, ITER_OBJ_NR);
+
+	arg->ta_flags = old_flags;
+}
+
+static void
+vos_iterate_part_test(void **state)
+{
+	struct io_test_args	*arg = *state;
+	struct batch_info	 info = {0};
+	vos_iter_param_t	 param = {0};
+	struct vos_iter_anchors	 anchors;
+	daos_handle_t		 ih;
+	daos_epoch_t		 epoch = 1;
+	uint32_t		 part_nrs[] = {2, 3, 7, 64};
+	int			 i, j;
+	int			 rc;
+	unsigned long		 old_flags = arg->ta_flags;
+
+	arg->ta_flags = 0;
+	test_args_reset(arg, VPOOL_SIZE);
+
+	gen_io(arg, ITER_OBJ_NR, 1, 1, 0, &epoch);
+
+	param.ip_hdl = arg->ctx.tc_co_hdl;
+	param.ip_epc_expr = VOS_IT_EPC_RR;
+	param.ip_ih = DAOS_HDL_INVAL;
+	param.ip_epr.epr_hi = epoch;
+	param.ip_epr.epr_lo = 0;
+
+	/* Partitions are disjoint and cover the whole object index */
+	for (i = 0; i < ARRAY_SIZE(part_nrs); i++) {
+		info.bi_calls = 0;
+		param.ip_part_nr = part_nrs[i];
+		for (j = 0; j < part_nrs[i]; j++) {
+			memset(&anchors, 0, sizeof(anchors));
+			param.ip_part_id = j;
+			rc = vos_iterate(&param, VOS_ITER_OBJ, false, &anchors, iter_batch_cb,
+					 NULL, &info, NULL);
+			assert_rc_equal(rc, 0);
+		}
+		assert_int_equal(info.bi_calls, ITER_OBJ_NR);
+	}
+
+	param.ip_part_id = param.ip_part_nr;
+	rc = vos_iter_prepare(VOS_ITER_OBJ, &param, &ih, NULL);
+	assert_rc_equal(rc, -DER_INVAL);
+
+	arg->ta_flags = old_flags;
+}
+
 static int
 io_update_and_fetch_incorrect_dkey(struct io_test_args *arg,
 				   daos_epoch_t update_epoch,
@@ -3008,6 +3130,9 @@ static const struct CMUnitTest io_tests[] = {
     {"VOS245.1: Object iter test with anchor (for oid)", oid_iter_test_with_anchor,
      oid_iter_test_setup, NULL},
     {"VOS250.0: vos_iterate tests - Check single callback", vos_iterate_test, NULL, NULL},
+    {"VOS250.1: vos_iterate tests - Batched iteration", vos_iterate_batch_test, NULL, NULL},
+    {"VOS250.2: vos_iterate tests - Partitioned object iteration", vos_iterate_part_test, NULL,
+     NULL},
     {"VOS280: Same Obj ID on two containers (obj_cache test)", io_simple_one_key_cross_container,
      NULL, NULL},
     {"VOS281.0: Fetch from non existent object", io_fetch_no_exist_object, NULL, NULL},
@@ -23,6 +23,7 @@
 #include <vos_layout.h>
 #include <daos_srv/vos.h>
 #include <vos_internal.h>
+#include <vos_policy.h>
 
 #define VPOOL_TEST_WAL_SZ	(1ULL << 25) /* default_cluster_sz(): DAOS_BS_CLUSTER_SZ: 32MB */
 
@@ -146,6 +147,83 @@ pool_policy_update(void **state)
 	assert_rc_equal(ret, 0);
 }
 
+static void
+pool_policy_heat(void **state)
+{
+	struct vp_test_args	*arg = *state;
+	struct policy_desc_t	 policy_desc = { 0 };
+	struct vos_pool		*vp;
+	daos_unit_oid_t		 oid;
+	daos_key_t		 akey;
+	char			 akey_buf[] = "hot_akey";
+	uint64_t		 hot_key, cold_key;
+	uuid_t			 uuid;
+	int			 i, ret;
+
+	uuid_generate(uuid);
+	ret = vos_pool_create(arg->fname[0], uuid, VPOOL_256M, 0, 0, NULL);
+	assert_rc_equal(ret, 0);
+
+	ret = vos_pool_open(arg->fname[0], uuid, 0, &arg->poh[0]);
+	assert_rc_equal(ret, 0);
+
+	vp = vos_hdl2pool(arg->poh[0]);
+	assert_null(vp->vp_heat);
+
+	policy_desc.policy = DAOS_MEDIA_POLICY_HOT_COLD;
+	policy_desc.params[1] = 3;
+	ret = vos_pool_ctl(arg->poh[0], VOS_PO_CTL_SET_POLICY, &policy_desc);
+	assert_rc_equal(ret, 0);
+	assert_non_null(vp->vp_heat);
+	assert_int_equal(vp->vp_heat->vht_hot, 3);
+	assert_int_equal(vp->vp_heat->vht_half_life, VOS_HEAT_HALF_LIFE_DEF);
+
+	oid = dts_unit_oid_gen(0, 0);
+	d_iov_set(&akey, akey_buf, strlen(akey_buf));
+	hot_key = vos_heat_key(&oid, &akey);
+	assert_int_not_equal(hot_key, VOS_HEAT_KEY_NONE);
+	/* Pick a cold key which doesn't share the slot with the hot one */
+	do {
+		oid = dts_unit_oid_gen(0, 0);
+		cold_key = vos_heat_key(&oid, &akey);
+	} while (((cold_key ^ hot_key) & vp->vp_heat->vht_mask) == 0);
+
+	for (i = 0; i < 3; i++)
+		vos_heat_record(vp, hot_key);
+	vos_heat_record(vp, cold_key);
+
+	assert_int_equal(vos_heat_get(vp, hot_key), 3);
+	assert_int_equal(vos_heat_get(vp, cold_key), 1);
+	assert_int_equal(vos_heat_get(vp, VOS_HEAT_KEY_NONE), 0);
+
+	/* Only the aggregation placement is driven by heat */
+	if (vp->vp_vea_info != NULL) {
+		assert_int_equal(vos_policy_media_select(vp, DAOS_IOD_ARRAY, 64, VOS_IOS_GENERIC,
+							 cold_key), DAOS_MEDIA_SCM);
+		assert_int_equal(vos_policy_media_select(vp, DAOS_IOD_ARRAY, 64,
+							 VOS_IOS_AGGREGATION, cold_key),
+				 DAOS_MEDIA_NVME);
+		assert_int_equal(vos_policy_media_select(vp, DAOS_IOD_ARRAY, 8192,
+							 VOS_IOS_AGGREGATION, hot_key),
+				 DAOS_MEDIA_SCM);
+	} else {
+		assert_int_equal(vos_policy_media_select(vp, DAOS_IOD_ARRAY, 8192,
+							 VOS_IOS_AGGREGATION, cold_key),
+				 DAOS_MEDIA_SCM);
+	}
+
+	/* Heat table is released on switching to other policy */
+	policy_desc.policy = DAOS_MEDIA_POLICY_IO_SIZE;
+	ret = vos_pool_ctl(arg->poh[0], VOS_PO_CTL_SET_POLICY, &policy_desc);
+	assert_rc_equal(ret, 0);
+	assert_null(vp->vp_heat);
+
+	ret = vos_pool_close(arg->poh[0]);
+	assert_rc_equal(ret, 0);
+	ret = vos_pool_destroy(arg->fname[0], uuid);
+	assert_rc_equal(ret, 0);
+}
+
 static void
 pool_interop(void **state)
 {
@@ -562,6 +640,8 @@ static const struct CMUnitTest pool_tests[] = {
 		pool_file_setup, pool_file_destroy},
 	{ "VOS12: Pool policy update", pool_policy_update,
 		 pool_file_setup, pool_file_destroy},
+	{ "VOS13: Pool hot/cold policy heat tracking", pool_policy_heat,
+		 pool_file_setup, pool_file_destroy},
 
 };
 
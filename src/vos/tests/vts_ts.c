@@ -223,6 +223,120 @@ ilog_test_ts_get(void **state)
 
 }
 
+static void
+ilog_test_ts_tier(void **state)
+{
+	struct ts_test_arg	*ts_arg = *state;
+	struct vos_ts_entry	*entry;
+	struct vos_ts_entry	*neg_entry;
+	uint32_t		*obj_idx = &ts_arg->ta_records[VOS_TS_TYPE_OBJ][0];
+	daos_epoch_t		 read_time;
+	uint64_t		 hash = 0x1234;
+	bool			 found;
+
+	vos_ts_set_reset(ts_arg->ta_ts_set, 0, 0);
+	entry = vos_ts_alloc(ts_arg->ta_ts_set, &ts_arg->ta_records[0][0], 0);
+	assert_non_null(entry);
+
+	entry = vos_ts_alloc(ts_arg->ta_ts_set, obj_idx, hash);
+	assert_non_null(entry);
+	neg_entry = entry->te_negative;
+	assert_non_null(neg_entry);
+	read_time = neg_entry->te_ts.tp_ts_rh + 100;
+	vos_ts_rh_update(entry, read_time, &ts_arg->ta_ts_set->ts_tx_id);
+
+	/** The evicted timestamp is kept apart from the negative entry */
+	vos_ts_evict(obj_idx, VOS_TS_TYPE_OBJ, true);
+	assert_true(neg_entry->te_ts.tp_ts_rh < read_time);
+
+	vos_ts_set_reset(ts_arg->ta_ts_set, VOS_TS_TYPE_OBJ, 0);
+	found = vos_ts_lookup(ts_arg->ta_ts_set, obj_idx, false, &entry);
+	assert_false(found);
+	entry = vos_ts_alloc(ts_arg->ta_ts_set, obj_idx, hash);
+	assert_non_null(entry);
+	assert_int_equal(entry->te_ts.tp_ts_rh, read_time);
+	/** The reader can still write at its read time */
+	assert_true(daos_dti_equal(&entry->te_ts.tp_tx_rh,
+				   &ts_arg->ta_ts_set->ts_tx_id));
+	vos_ts_evict(obj_idx, VOS_TS_TYPE_OBJ, true);
+
+	/** A negative lookup moves it to the negative entry */
+	vos_ts_set_reset(ts_arg->ta_ts_set, VOS_TS_TYPE_OBJ, 0);
+	entry = vos_ts_get_negative(ts_arg->ta_ts_set, hash, false);
+	assert_ptr_equal(entry, neg_entry);
+	assert_int_equal(neg_entry->te_ts.tp_ts_rh, read_time);
+	assert_true(daos_dti_equal(&neg_entry->te_ts.tp_tx_rh,
+				   &ts_arg->ta_ts_set->ts_tx_id));
+}
+
+static void
+ilog_test_ts_trim_held(void **state)
+{
+	struct ts_test_arg	*ts_arg = *state;
+	struct vos_ts_table	*ts_table = vos_ts_table_get(true);
+	struct vos_ts_info	*info = &ts_table->tt_type_info[VOS_TS_TYPE_CONT];
+	struct lru_array	*array = info->ti_array;
+	uint32_t		*records = &ts_arg->ta_records[VOS_TS_TYPE_CONT][0];
+	uint32_t		 sub_size = array->la_count / array->la_array_nr;
+	struct vos_ts_set	*held = NULL;
+	struct vos_ts_entry	*entry;
+	struct dtx_handle	 dth = {0};
+	uint32_t		 idx;
+	bool			 found;
+	int			 rc;
+
+	assert_int_equal(array->la_sub_alloc, 1);
+
+	/** Fill two sub arrays, the second one referenced by another set */
+	for (idx = 0; idx < 2 * sub_size; idx++) {
+		vos_ts_set_reset(ts_arg->ta_ts_set, 0, 0);
+		entry = vos_ts_alloc(ts_arg->ta_ts_set, &records[idx], 0);
+		assert_non_null(entry);
+		if (idx != sub_size)
+			continue;
+
+		daos_dti_gen_unique(&dth.dth_xid);
+		rc = vos_ts_set_allocate(&held, 0, 0, 1, &dth, true);
+		assert_rc_equal(rc, 0);
+		found = vos_ts_lookup(held, &records[idx], false, &entry);
+		assert_true(found);
+	}
+	assert_int_equal(array->la_sub_alloc, 2);
+
+	/** The working set now fits in the first sub array */
+	for (idx = 0; idx < sub_size; idx++)
+		vos_ts_evict(&records[idx], VOS_TS_TYPE_CONT, true);
+	for (idx = 0; idx < 2 * sub_size; idx++) {
+		vos_ts_set_reset(ts_arg->ta_ts_set, 0, 0);
+		entry = vos_ts_alloc(ts_arg->ta_ts_set,
+				     &ts_arg->ta_extra_records[idx % NUM_EXTRA], 0);
+		assert_non_null(entry);
+		vos_ts_evict(&ts_arg->ta_extra_records[idx % NUM_EXTRA],
+			     VOS_TS_TYPE_CONT, true);
+	}
+
+	/** The trim waits for the sets, so the held entry stays valid */
+	assert_true(info->ti_trim_pending);
+	assert_int_equal(array->la_sub_alloc, 2);
+	entry = held->ts_entries[0].se_entry;
+	assert_ptr_equal(entry->te_record_ptr, &records[sub_size]);
+
+	vos_ts_set_free(held);
+	assert_int_equal(array->la_sub_alloc, 2);
+
+	/** Releasing the last set runs the trim */
+	vos_ts_set_free(ts_arg->ta_ts_set);
+	assert_false(info->ti_trim_pending);
+	assert_int_equal(array->la_sub_alloc, 1);
+	found = vos_ts_peek_entry(&records[sub_size], VOS_TS_TYPE_CONT, &entry,
+				  true);
+	assert_false(found);
+
+	daos_dti_gen_unique(&dth.dth_xid);
+	rc = vos_ts_set_allocate(&ts_arg->ta_ts_set, 0, 0, 1, &dth, true);
+	assert_rc_equal(rc, 0);
+}
+
 static int
 alloc_ts_cache(void **state)
 {
@@ -663,6 +777,79 @@ lru_array_multi_test(void **state)
 	lru_array_multi_test_iter(state);
 }
 
+static void
+lru_array_adaptive_test(void **state)
+{
+	struct lru_arg		*ts_arg = *state;
+	struct lru_array	*array = ts_arg->array;
+	struct lru_record	*entry;
+	uint64_t		 since;
+	int			 live;
+	int			 i;
+	bool			 found;
+	int			 rc;
+
+	ts_arg->lookup = false;
+	assert_int_equal(array->la_sub_alloc, 1);
+
+	/** Sub arrays are allocated before anything is evicted */
+	for (i = 0; i < LRU_ARRAY_SIZE; i++) {
+		rc = lrua_alloc(array, &ts_arg->indexes[i].idx, &entry);
+		assert_rc_equal(rc, 0);
+		assert_non_null(entry);
+		entry->record = &ts_arg->indexes[i];
+		ts_arg->indexes[i].value = i;
+	}
+	assert_int_equal(array->la_sub_alloc, LRU_ARRAY_NR);
+	assert_int_equal(array->la_evicted, 0);
+
+	/** The victim is the oldest entry of all sub arrays */
+	found = lrua_lookup(array, &ts_arg->indexes[0].idx, &entry);
+	assert_true(found);
+	rc = lrua_alloc(array, &ts_arg->indexes[LRU_ARRAY_SIZE].idx, &entry);
+	assert_rc_equal(rc, 0);
+	entry->record = &ts_arg->indexes[LRU_ARRAY_SIZE];
+	ts_arg->indexes[LRU_ARRAY_SIZE].value = LRU_ARRAY_SIZE;
+	assert_int_equal(array->la_evicted, 1);
+	assert_true(ts_arg->indexes[1].value == MAGIC1);
+	found = lrua_lookup(array, &ts_arg->indexes[0].idx, &entry);
+	assert_true(found);
+
+	/** A cold sub array is released along with its entries */
+	since = array->la_stamp;
+	assert_true(lrua_array_trim(array, since));
+	assert_int_equal(array->la_sub_alloc, LRU_ARRAY_NR - 1);
+	live = 0;
+	for (i = 0; i <= LRU_ARRAY_SIZE; i++) {
+		found = lrua_lookup(array, &ts_arg->indexes[i].idx, &entry);
+		if (found) {
+			assert_true(ts_arg->indexes[i].value == i);
+			live++;
+		} else {
+			assert_true(ts_arg->indexes[i].value == MAGIC1);
+		}
+	}
+	assert_int_equal(live, LRU_ARRAY_SIZE - LRU_ARRAY_SIZE / LRU_ARRAY_NR);
+
+	/** Lookups above touched every sub array left */
+	assert_false(lrua_array_trim(array, since));
+
+	/** Released sub arrays are allocated again on demand */
+	for (i = 0; i <= LRU_ARRAY_SIZE; i++) {
+		found = lrua_lookup(array, &ts_arg->indexes[i].idx, &entry);
+		if (found)
+			continue;
+		rc = lrua_alloc(array, &ts_arg->indexes[i].idx, &entry);
+		assert_rc_equal(rc, 0);
+		entry->record = &ts_arg->indexes[i];
+		ts_arg->indexes[i].value = i;
+	}
+	assert_int_equal(array->la_sub_alloc, LRU_ARRAY_NR);
+
+	for (i = 0; i <= LRU_ARRAY_SIZE; i++)
+		lrua_evict(array, &ts_arg->indexes[i].idx);
+}
+
 static int
 init_lru_test(void **state)
 {
@@ -699,6 +886,24 @@ init_lru_multi_test(void **state)
 	return rc;
 }
 
+static int
+init_lru_adaptive_test(void **state)
+{
+	struct lru_arg		*ts_arg;
+	int			 rc;
+
+	D_ALLOC_PTR(ts_arg);
+	if (ts_arg == NULL)
+		return 1;
+
+	rc = lrua_array_alloc(&ts_arg->array, LRU_ARRAY_SIZE, LRU_ARRAY_NR,
+			      sizeof(struct lru_record), LRU_FLAG_EVICT_ADAPTIVE,
+			      &lru_cbs, ts_arg);
+
+	*state = ts_arg;
+	return rc;
+}
+
 static int
 finalize_lru_test(void **state)
 {
@@ -775,6 +980,12 @@ static const struct CMUnitTest ts_tests[] = {
 		init_lru_multi_test, finalize_lru_test},
 	{ "VOS600.4: VOS timestamp allocation test", ilog_test_ts_get,
 		ts_test_init, ts_test_fini},
+	{ "VOS600.5: LRU adaptive array", lru_array_adaptive_test,
+		init_lru_adaptive_test, finalize_lru_test},
+	{ "VOS600.6: VOS timestamp precise tier", ilog_test_ts_tier,
+		ts_test_init, ts_test_fini},
+	{ "VOS600.7: VOS timestamp trim with a held set", ilog_test_ts_trim_held,
+		ts_test_init, ts_test_fini},
 };
 
 int
@@ -784,6 +784,45 @@ wal_ut_wrap_many(void **state)
 	ut_mc_fini(args);
 }
 
+static void
+wal_ut_replay_stats(void **state)
+{
+	struct bio_ut_args	*args = *state;
+	uint64_t		 meta_sz = (128ULL << 20);	/* 128 MB */
+	struct bio_wal_rp_stats	 wrs = { 0 };
+	struct ut_tx_array	*txa;
+	int			 tx_nr = 40, rc;
+
+	rc = ut_mc_init(args, meta_sz, meta_sz, meta_sz);
+	assert_rc_equal(rc, 0);
+
+	/* Roughly 32MB WAL data, which spans multiple replay windows */
+	ut_fill_wal(args, tx_nr, &txa);
+
+	rc = bio_mc_close(args->bua_mc);
+	assert_rc_equal(rc, 0);
+
+	rc = bio_mc_open(args->bua_xs_ctxt, args->bua_pool_id, 0, &args->bua_mc);
+	assert_rc_equal(rc, 0);
+
+	txa->ta_replay_nr = tx_nr;
+	txa->ta_tx_idx = 0;
+
+	rc = bio_wal_replay(args->bua_mc, &wrs, ut_replay_multi, txa);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(txa->ta_replayed_nr, txa->ta_replay_nr);
+	assert_int_equal(wrs.wrs_tx_cnt, tx_nr);
+	assert_true(wrs.wrs_rd_sz >= wrs.wrs_sz);
+	assert_true(wrs.wrs_io_wait <= wrs.wrs_tm);
+
+	print_message("Replayed "DF_U64" bytes in "DF_U64" us, I/O wait "DF_U64" us\n",
+		      wrs.wrs_sz, wrs.wrs_tm, wrs.wrs_io_wait);
+
+	ut_txa_free(txa);
+
+	ut_mc_fini(args);
+}
+
 static void
 wal_ut_holes(void **state)
 {
@@ -871,6 +910,163 @@ wal_ut_holes(void **state)
 	ut_mc_fini(args);
 }
 
+struct ut_grp_arg {
+	struct bio_ut_args	*ga_args;
+	struct ut_tx_array	*ga_txa;
+	unsigned int		 ga_start;
+	unsigned int		 ga_nr;
+	int			 ga_rc;
+};
+
+static void
+ut_grp_commit_ult(void *arg)
+{
+	struct ut_grp_arg	*ga = arg;
+	struct umem_wal_tx	*tx;
+	int			 i, rc = 0;
+
+	for (i = 0; i < ga->ga_nr; i++) {
+		tx = ga->ga_txa->ta_tx_ptrs[ga->ga_start + i];
+
+		rc = bio_wal_reserve(ga->ga_args->bua_mc, &tx->utx_id);
+		if (rc)
+			break;
+
+		rc = bio_wal_commit(ga->ga_args->bua_mc, tx, NULL);
+		if (rc)
+			break;
+	}
+	ga->ga_rc = rc;
+}
+
+static int
+ut_replay_grp(uint64_t tx_id, struct umem_action *act, void *arg)
+{
+	struct ut_tx_array	*txa = arg;
+	struct umem_wal_tx	*tx;
+	struct ut_fake_tx	*fake_tx;
+	int			 i;
+
+	/* Transactions from different ULTs are interleaved in WAL, lookup by ID */
+	if (tx_id != txa->ta_replay_tx) {
+		for (i = 0; i < txa->ta_tx_nr; i++) {
+			if (txa->ta_tx_ptrs[i]->utx_id == tx_id)
+				break;
+		}
+		assert_true(i < txa->ta_tx_nr);
+
+		txa->ta_tx_idx = i;
+		tx = txa->ta_tx_ptrs[i];
+		fake_tx = (struct ut_fake_tx *)&tx->utx_private;
+		fake_tx->ft_act_idx = 0;
+
+		txa->ta_replay_tx = tx_id;
+		txa->ta_replayed_nr++;
+	} else {
+		tx = txa->ta_tx_ptrs[txa->ta_tx_idx];
+	}
+
+	return ut_replay_one(tx_id, act, (void *)tx);
+}
+
+/* Commit from @ult_nr concurrent ULTs, return the IOPS */
+static uint64_t
+ut_grp_commit(struct bio_ut_args *args, unsigned int ult_nr, unsigned int tx_per_ult)
+{
+	uint64_t		 meta_sz = (128ULL << 20);	/* 128 MB */
+	struct ut_tx_array	*txa;
+	struct umem_wal_tx	*tx;
+	struct ut_grp_arg	*ga;
+	ABT_thread		*threads;
+	ABT_xstream		 xstream;
+	ABT_pool		 pool;
+	uint64_t		 start, elapsed;
+	int			 i, tx_nr = ult_nr * tx_per_ult, rc;
+
+	rc = ut_mc_init(args, meta_sz, meta_sz, meta_sz);
+	assert_rc_equal(rc, 0);
+
+	txa = ut_txa_alloc(tx_nr);
+	assert_non_null(txa);
+
+	for (i = 0; i < tx_nr; i++) {
+		tx = txa->ta_tx_ptrs[i];
+
+		ut_tx_add_action(tx, UMEM_ACT_COPY);
+		ut_tx_add_action(tx, UMEM_ACT_ASSIGN);
+		ut_tx_add_action(tx, UMEM_ACT_SET_BITS);
+	}
+
+	D_ALLOC_ARRAY(ga, ult_nr);
+	assert_non_null(ga);
+	D_ALLOC_ARRAY(threads, ult_nr);
+	assert_non_null(threads);
+
+	rc = ABT_xstream_self(&xstream);
+	assert_int_equal(rc, ABT_SUCCESS);
+	rc = ABT_xstream_get_main_pools(xstream, 1, &pool);
+	assert_int_equal(rc, ABT_SUCCESS);
+
+	start = daos_getutime();
+	for (i = 0; i < ult_nr; i++) {
+		ga[i].ga_args = args;
+		ga[i].ga_txa = txa;
+		ga[i].ga_start = i * tx_per_ult;
+		ga[i].ga_nr = tx_per_ult;
+
+		rc = ABT_thread_create(pool, ut_grp_commit_ult, &ga[i], ABT_THREAD_ATTR_NULL,
+				       &threads[i]);
+		assert_int_equal(rc, ABT_SUCCESS);
+	}
+
+	for (i = 0; i < ult_nr; i++) {
+		rc = ABT_thread_free(&threads[i]);
+		assert_int_equal(rc, ABT_SUCCESS);
+		assert_rc_equal(ga[i].ga_rc, 0);
+	}
+	elapsed = daos_getutime() - start;
+
+	rc = bio_mc_close(args->bua_mc);
+	assert_rc_equal(rc, 0);
+
+	rc = bio_mc_open(args->bua_xs_ctxt, args->bua_pool_id, 0, &args->bua_mc);
+	assert_rc_equal(rc, 0);
+
+	txa->ta_replay_nr = tx_nr;
+	rc = bio_wal_replay(args->bua_mc, NULL, ut_replay_grp, txa);
+	assert_rc_equal(rc, 0);
+	assert_int_equal(txa->ta_replayed_nr, txa->ta_replay_nr);
+
+	D_FREE(threads);
+	D_FREE(ga);
+	ut_txa_free(txa);
+	ut_mc_fini(args);
+
+	return elapsed ? (uint64_t)tx_nr * 1000000 / elapsed : 0;
+}
+
+static void
+wal_ut_grp_commit(void **state)
+{
+	struct bio_ut_args	*args = *state;
+	unsigned int		 ult_nrs[] = { 1, 4, 16, 64 };
+	unsigned int		 grp_max = bio_wal_grp_max, tx_per_ult = 32;
+	uint64_t		 iops_single, iops_grp;
+	int			 i;
+
+	for (i = 0; i < ARRAY_SIZE(ult_nrs); i++) {
+		bio_wal_grp_max = 1;
+		iops_single = ut_grp_commit(args, ult_nrs[i], tx_per_ult);
+
+		bio_wal_grp_max = grp_max > 1 ? grp_max : 32;
+		iops_grp = ut_grp_commit(args, ult_nrs[i], tx_per_ult);
+
+		print_message("ULTs:%-3u IOPS no group commit:"DF_U64", group commit:"DF_U64"\n",
+			      ult_nrs[i], iops_single, iops_grp);
+	}
+	bio_wal_grp_max = grp_max;
+}
+
 static const struct CMUnitTest wal_uts[] = {
 	{ "single tx commit/replay", wal_ut_single, NULL, NULL},
 	{ "single tx with many acts", wal_ut_many_acts, NULL, NULL},
@@ -880,6 +1076,8 @@ static const struct CMUnitTest wal_uts[] = {
 	{ "wal log wraps once", wal_ut_wrap, NULL, NULL},
 	{ "wal log wraps many", wal_ut_wrap_many, NULL, NULL},
 	{ "holes on replay", wal_ut_holes, NULL, NULL},
+	{ "group commit from concurrent ULTs", wal_ut_grp_commit, NULL, NULL},
+	{ "pipelined replay stats", wal_ut_replay_stats, NULL, NULL},
 };
 
 static int
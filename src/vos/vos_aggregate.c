@@ -16,6 +16,8 @@
 #include "vos_policy.h"
 
 unsigned int vos_agg_nvme_thresh = VOS_MW_NVME_THRESH;
+unsigned int vos_defrag_thresh = VOS_DEFRAG_THRESH;
+unsigned int vos_agg_parts = 1;
 
 /*
  * EV tree sorted iterator returns logical entry in extent start order, and
@@ -143,6 +145,8 @@ struct agg_merge_window {
 	/* I/O context for transferring data on flush */
 	struct agg_io_context		 mw_io_ctxt;
 	uint16_t			 mw_csum_type;
+	/* Heat key of current akey, for the hot_cold policy */
+	uint64_t			 mw_heat_key;
 };
 
 struct vos_agg_credits {
@@ -151,6 +155,24 @@ struct vos_agg_credits {
 	uint32_t	vac_creds_merge;	/* # of merging operations */
 };
 
+/*
+ * Control shared by the partitions of a parallel aggregation. Objects are
+ * partitioned by OID range of the object index, each partition runs in its own
+ * ULT with its own merge window and credits. Only partition 0 calls the yield function (rate
+ * control), other partitions follow the mode it returned: in slack mode, each
+ * pass through the rate control lets one waiting partition run its credits.
+ */
+struct agg_part_ctl {
+	ABT_mutex		apc_lock;
+	ABT_cond		apc_cond;
+	/* Bumped on every pass through the rate control */
+	uint64_t		apc_gen;
+	/* Last rate control result: 0 tight, 1 slack, -1 abort */
+	int			apc_mode;
+	/* Number of helper partitions still running */
+	int			apc_running;
+};
+
 #define EV_TRACE_MAX 1024
 struct vos_agg_param {
 	vos_iter_entry_t        ap_evt_trace[EV_TRACE_MAX];
@@ -162,6 +184,8 @@ struct vos_agg_param {
 	/* Boundary for aggregatable write filter */
 	daos_epoch_t		ap_filter_epoch;
 	uint32_t		ap_flags;
+	/* Remaining NVMe blocks could be relocated for defrag in this pass */
+	uint32_t		ap_defrag_blks;
 	unsigned int ap_discard : 1, ap_csum_err : 1, ap_nospc_err : 1, ap_in_progress : 1,
 	    ap_discard_obj : 1;
 	struct umem_instance	*ap_umm;
@@ -174,6 +198,10 @@ struct vos_agg_param {
 	bool			 ap_skip_akey;
 	bool			 ap_skip_dkey;
 	bool			 ap_skip_obj;
+	/* Running in a helper ULT, paced by the caller's rate control */
+	bool			 ap_part_helper;
+	/* Parallel aggregation, NULL for single partition */
+	struct agg_part_ctl	*ap_part_ctl;
 };
 
 static inline void
@@ -312,6 +340,45 @@ need_aggregate(daos_handle_t ih, struct vos_agg_param *agg_param, vos_iter_desc_
 	return agg_needed;
 }
 
+/* Publish the rate control result to the other partitions */
+static void
+agg_part_pace(struct agg_part_ctl *ctl, int rc)
+{
+	ABT_mutex_lock(ctl->apc_lock);
+	ctl->apc_mode = rc < 0 ? -1 : rc;
+	ctl->apc_gen++;
+	if (ctl->apc_mode > 0)
+		ABT_cond_signal(ctl->apc_cond);
+	else
+		ABT_cond_broadcast(ctl->apc_cond);
+	ABT_mutex_unlock(ctl->apc_lock);
+}
+
+/* Yield of a helper partition, returns true on abort */
+static bool
+agg_part_yield(struct vos_agg_param *agg_param)
+{
+	struct agg_part_ctl	*ctl = agg_param->ap_part_ctl;
+	uint64_t		 gen;
+	int			 mode;
+
+	ABT_mutex_lock(ctl->apc_lock);
+	gen = ctl->apc_gen;
+	while (ctl->apc_mode > 0 && ctl->apc_gen == gen)
+		ABT_cond_wait(ctl->apc_cond, ctl->apc_lock);
+	mode = ctl->apc_mode;
+	ABT_mutex_unlock(ctl->apc_lock);
+
+	if (mode < 0)
+		return true;
+
+	if (mode == 0)
+		bio_yield(agg_param->ap_umm);
+	credits_set(&agg_param->ap_credits, mode == 0);
+
+	return false;
+}
+
 static inline bool
 vos_aggregate_yield(struct vos_agg_param *agg_param)
 {
@@ -327,7 +394,13 @@ vos_aggregate_yield(struct vos_agg_param *agg_param)
 		return false;
 	}
 
+	if (agg_param->ap_part_helper)
+		return agg_part_yield(agg_param);
+
 	rc = agg_param->ap_yield_func(agg_param->ap_yield_arg);
+	if (agg_param->ap_part_ctl != NULL)
+		agg_part_pace(agg_param->ap_part_ctl, rc);
+
 	/* Abort */
 	if (rc < 0)
 		return true;
@@ -487,6 +560,12 @@ vos_agg_akey(daos_handle_t ih, vos_iter_entry_t *entry,
 	if (merge_window_status(&agg_param->ap_window) != MW_CLOSED)
 		D_ASSERTF(false, "Merge window isn't closed.\n");
 
+	if (vos_hdl2cont(agg_param->ap_coh)->vc_pool->vp_heat != NULL)
+		agg_param->ap_window.mw_heat_key = vos_heat_key(&agg_param->ap_oid,
+								&entry->ie_key);
+	else
+		agg_param->ap_window.mw_heat_key = VOS_HEAT_KEY_NONE;
+
 	return 0;
 }
 
@@ -975,16 +1054,17 @@ process_physical:
 }
 
 static int
-reserve_segment(struct vos_object *obj, struct agg_io_context *io,
-		daos_size_t size, bio_addr_t *addr)
+reserve_segment(struct vos_object *obj, struct agg_merge_window *mw,
+		daos_size_t size, uint16_t src_media, bio_addr_t *addr)
 {
-	uint64_t	off, now;
-	uint16_t	media;
-	int		rc;
+	struct agg_io_context	*io = &mw->mw_io_ctxt;
+	uint64_t		 off, now;
+	uint16_t		 media;
+	int			 rc;
 
 	memset(addr, 0, sizeof(*addr));
 	media = vos_policy_media_select(vos_obj2pool(obj), DAOS_IOD_ARRAY, size,
-					VOS_IOS_AGGREGATION);
+					VOS_IOS_AGGREGATION, mw->mw_heat_key);
 
 	if (media == DAOS_MEDIA_SCM) {
 		off = vos_reserve_scm(obj->obj_cont, io->ic_rsrvd_scm, size);
@@ -997,6 +1077,7 @@ reserve_segment(struct vos_object *obj, struct agg_io_context *io,
 			return -DER_NOSPACE;
 		}
 		bio_addr_set(addr, media, off);
+		vos_policy_tier_account(vos_obj2pool(obj), src_media, media, size);
 		return 0;
 	}
 
@@ -1015,6 +1096,7 @@ reserve_segment(struct vos_object *obj, struct agg_io_context *io,
 			size, DP_RC(rc));
 	} else {
 		bio_addr_set(addr, media, off);
+		vos_policy_tier_account(vos_obj2pool(obj), src_media, media, size);
 	}
 
 	return rc;
@@ -1193,7 +1275,8 @@ fill_one_segment(daos_handle_t ih, struct agg_merge_window *mw,
 	}
 	D_ASSERT(seg_size == read_size);
 
-	rc = reserve_segment(obj, io, seg_size, &ent_in->ei_addr);
+	phy_ent = mw->mw_lgc_ents[lgc_seg->ls_idx_start].le_phy_ent;
+	rc = reserve_segment(obj, mw, seg_size, phy_ent->pe_addr.ba_type, &ent_in->ei_addr);
 	if (rc) {
 		DL_CDEBUG(rc == -DER_NOSPACE, DB_EPC, DLOG_ERR, rc,
 			  "Reserve " DF_U64 " segment error", seg_size);
@@ -1622,24 +1705,32 @@ free_removal_records(struct agg_merge_window *mw, d_list_t *head, bool top)
 }
 
 static inline bool
-need_merge(daos_handle_t ih, uint16_t src_media, int lgc_cnt, daos_size_t seg_size)
+need_merge(daos_handle_t ih, struct agg_merge_window *mw, uint16_t src_media, bool hole,
+	   int lgc_cnt, daos_size_t seg_size)
 {
 	struct vos_obj_iter	*oiter = vos_hdl2oiter(ih);
-	struct vos_object	*obj = oiter->it_obj;
+	struct vos_pool		*pool = vos_obj2pool(oiter->it_obj);
 	unsigned int		 seg_blks, nvme_blks;
 	uint16_t		 tgt_media;
 
 	D_ASSERTF(lgc_cnt > 0 && seg_size > 0, "lgc_cnt=%d seg_size=" DF_U64 "\n", lgc_cnt,
 		  seg_size);
-	if (lgc_cnt == 1)
+	/* The hot_cold policy may relocate a single record to another tier */
+	if (lgc_cnt == 1 && (hole || pool->vp_heat == NULL))
 		return false;
 
-	tgt_media = vos_policy_media_select(vos_obj2pool(obj), DAOS_IOD_ARRAY,
-					    seg_size, VOS_IOS_AGGREGATION);
-	/* Some data can be migrated from SCM to NVMe to alleviate SCM pressure */
+	tgt_media = vos_policy_media_select(pool, DAOS_IOD_ARRAY, seg_size,
+					    VOS_IOS_AGGREGATION, mw->mw_heat_key);
+	/*
+	 * Some data can be migrated from SCM to NVMe to alleviate SCM pressure, or
+	 * promoted from NVMe to SCM by the hot_cold policy.
+	 */
 	if (src_media != tgt_media)
 		return true;
 
+	if (lgc_cnt == 1)
+		return false;
+
 	/*
 	 * Only trigger SCM to SCM data migration when there are enough amount of
 	 * SCM records accumulated.
@@ -1661,6 +1752,50 @@ need_merge(daos_handle_t ih, uint16_t src_media, int lgc_cnt, daos_size_t seg_si
 	return (lgc_cnt >= VOS_EVT_ORDER) || (seg_blks == (nvme_blks * vos_agg_nvme_thresh));
 }
 
+/*
+ * Relocate the merge window when any NVMe record in it is sandwiched by two
+ * small free extents, freeing the record will coalesce the three fragments into
+ * a larger free extent, and the relocated data will be packed sequentially by
+ * the aggregation I/O stream hint.
+ */
+static bool
+need_defrag(struct vos_agg_param *agg_param)
+{
+	struct agg_merge_window	*mw = &agg_param->ap_window;
+	struct vos_container	*cont = vos_hdl2cont(agg_param->ap_coh);
+	struct vea_space_info	*vsi = cont->vc_pool->vp_vea_info;
+	struct vos_agg_metrics	*vam;
+	struct agg_phy_ent	*phy_ent;
+	uint64_t		 win_blks = 0;
+	daos_size_t		 size;
+	bool			 found = false;
+
+	if (!(agg_param->ap_flags & VOS_AGG_FL_DEFRAG) || vsi == NULL)
+		return false;
+
+	d_list_for_each_entry(phy_ent, &mw->mw_phy_ents, pe_link) {
+		if (phy_ent->pe_addr.ba_type != DAOS_MEDIA_NVME ||
+		    bio_addr_is_hole(&phy_ent->pe_addr))
+			continue;
+
+		size = evt_extent_width(&phy_ent->pe_rect.rc_ex) * mw->mw_rsize;
+		win_blks += vos_byte2blkcnt(size);
+		if (!found)
+			found = vea_defrag_candidate(vsi, vos_byte2blkoff(phy_ent->pe_addr.ba_off),
+						     vos_byte2blkcnt(size));
+	}
+
+	if (!found || win_blks > agg_param->ap_defrag_blks)
+		return false;
+
+	agg_param->ap_defrag_blks -= win_blks;
+	vam = agg_cont2metrics(cont);
+	if (vam && vam->vam_defrag_size)
+		d_tm_inc_counter(vam->vam_defrag_size, win_blks << VOS_BLK_SHIFT);
+
+	return true;
+}
+
 /*
  * General rules for deciding if a merge window needs be flushed or skipped:
  *
@@ -1673,6 +1808,8 @@ need_merge(daos_handle_t ih, uint16_t src_media, int lgc_cnt, daos_size_t seg_si
  *    larger SCM record, or merging small NVMe records to a larger NVMe record), make
  *    a trade-off between VOS tree condensing and data relocating (which consumes CPU
  *    & storage bandwidth, yet likely to generate more fragmentations).
+ * 5. If online defrag is requested, relocate the NVMe records which are blocking
+ *    small free fragments from being coalesced.
  */
 static bool
 need_flush(daos_handle_t ih, struct vos_agg_param *agg_param, bool last)
@@ -1711,7 +1848,8 @@ need_flush(daos_handle_t ih, struct vos_agg_param *agg_param, bool last)
 			return true;
 
 		if (i == 0 || (hole != bio_addr_is_hole(&phy_ent->pe_addr))) {
-			if (i && need_merge(ih, src_media, lgc_cnt, seg_width * mw->mw_rsize))
+			if (i && need_merge(ih, mw, src_media, hole, lgc_cnt,
+					    seg_width * mw->mw_rsize))
 				return true;
 
 			src_media = phy_ent->pe_addr.ba_type;
@@ -1735,7 +1873,10 @@ need_flush(daos_handle_t ih, struct vos_agg_param *agg_param, bool last)
 		hole = bio_addr_is_hole(&phy_ent->pe_addr);
 	}
 
-	if (lgc_cnt && need_merge(ih, src_media, lgc_cnt, seg_width * mw->mw_rsize))
+	if (lgc_cnt && need_merge(ih, mw, src_media, hole, lgc_cnt, seg_width * mw->mw_rsize))
+		return true;
+
+	if (need_defrag(agg_param))
 		return true;
 
 	clear_merge_window(mw);
@@ -2616,6 +2757,9 @@ struct agg_data {
 	vos_iter_param_t	ad_iter_param;
 	struct vos_agg_param	ad_agg_param;
 	struct vos_iter_anchors	ad_anchors;
+	/* ULT running a helper partition, ABT_THREAD_NULL if none */
+	ABT_thread		ad_ult;
+	int			ad_rc;
 };
 
 int
@@ -2630,17 +2774,169 @@ vos_aggregate_exit(daos_handle_t coh)
 	aggregate_exit(vos_hdl2cont(coh), AGG_MODE_AGGREGATE);
 }
 
+/* Aggregate the objects of one partition */
+static void
+agg_part_run(struct agg_data *ad)
+{
+	struct vos_agg_param	*agg_param = &ad->ad_agg_param;
+	int			 rc;
+
+	rc = vos_iterate(&ad->ad_iter_param, VOS_ITER_OBJ, true, &ad->ad_anchors,
+			 vos_aggregate_pre_cb, vos_aggregate_post_cb, agg_param, NULL);
+	if (rc != 0 || agg_param->ap_nospc_err)
+		close_merge_window(&agg_param->ap_window, rc);
+	else if (agg_param->ap_csum_err)
+		close_merge_window(&agg_param->ap_window, -DER_CSUM);
+
+	ad->ad_rc = rc;
+}
+
+static void
+agg_part_ult(void *arg)
+{
+	struct agg_data		*ad = arg;
+	struct agg_part_ctl	*ctl = ad->ad_agg_param.ap_part_ctl;
+
+	agg_part_run(ad);
+
+	ABT_mutex_lock(ctl->apc_lock);
+	ctl->apc_running--;
+	ABT_cond_broadcast(ctl->apc_cond);
+	ABT_mutex_unlock(ctl->apc_lock);
+}
+
+/* Create a helper ULT on the caller's xstream, it needs a deep stack like the caller */
+static int
+agg_part_ult_create(struct agg_data *ad)
+{
+#if VOS_STANDALONE
+	ABT_thread_attr		 attr;
+	ABT_thread		 self;
+	ABT_pool		 pool;
+	int			 rc;
+
+	rc = ABT_thread_self(&self);
+	if (rc == ABT_SUCCESS)
+		rc = ABT_thread_get_last_pool(self, &pool);
+	if (rc != ABT_SUCCESS)
+		return dss_abterr2der(rc);
+
+	rc = ABT_thread_attr_create(&attr);
+	if (rc != ABT_SUCCESS)
+		return dss_abterr2der(rc);
+
+	rc = ABT_thread_attr_set_stacksize(attr, DSS_DEEP_STACK_SZ);
+	if (rc == ABT_SUCCESS)
+		rc = ABT_thread_create(pool, agg_part_ult, ad, attr, &ad->ad_ult);
+	ABT_thread_attr_free(&attr);
+
+	return rc != ABT_SUCCESS ? dss_abterr2der(rc) : 0;
+#else
+	return dss_ult_create(agg_part_ult, ad, DSS_XS_SELF, 0, DSS_DEEP_STACK_SZ, &ad->ad_ult);
+#endif
+}
+
+static void
+agg_part_start(struct agg_data *ad)
+{
+	struct agg_part_ctl	*ctl = ad->ad_agg_param.ap_part_ctl;
+	int			 rc;
+
+	ad->ad_ult = ABT_THREAD_NULL;
+	ad->ad_agg_param.ap_part_helper = true;
+	ctl->apc_running++;
+
+	rc = agg_part_ult_create(ad);
+	if (rc != 0) {
+		/* Partition will be aggregated by the caller once its own is done */
+		D_DEBUG(DB_EPC, "Failed to create aggregation ULT, "DF_RC"\n", DP_RC(rc));
+		ad->ad_agg_param.ap_part_helper = false;
+		ctl->apc_running--;
+		ad->ad_ult = ABT_THREAD_NULL;
+	}
+}
+
+/*
+ * Wait for the helper partitions, keep calling the rate control on their
+ * behalf until all of them are done.
+ */
+static void
+agg_part_wait(struct agg_data *ads, uint32_t part_nr)
+{
+	struct vos_agg_param	*agg_param = &ads[0].ad_agg_param;
+	struct agg_part_ctl	*ctl = agg_param->ap_part_ctl;
+	uint32_t		 i;
+	int			 rc;
+
+	for (i = 1; i < part_nr; i++) {
+		if (ads[i].ad_ult == ABT_THREAD_NULL)
+			agg_part_run(&ads[i]);
+	}
+
+	ABT_mutex_lock(ctl->apc_lock);
+	while (ctl->apc_running > 0) {
+		if (agg_param->ap_yield_func == NULL || ctl->apc_mode < 0) {
+			ABT_cond_wait(ctl->apc_cond, ctl->apc_lock);
+			continue;
+		}
+		ABT_mutex_unlock(ctl->apc_lock);
+		rc = agg_param->ap_yield_func(agg_param->ap_yield_arg);
+		agg_part_pace(ctl, rc);
+		ABT_mutex_lock(ctl->apc_lock);
+	}
+	ABT_mutex_unlock(ctl->apc_lock);
+
+	for (i = 1; i < part_nr; i++) {
+		if (ads[i].ad_ult != ABT_THREAD_NULL)
+			ABT_thread_free(&ads[i].ad_ult);
+	}
+}
+
+static int
+agg_part_ctl_init(struct agg_part_ctl *ctl)
+{
+	int	rc;
+
+	rc = ABT_mutex_create(&ctl->apc_lock);
+	if (rc != ABT_SUCCESS)
+		return dss_abterr2der(rc);
+
+	rc = ABT_cond_create(&ctl->apc_cond);
+	if (rc != ABT_SUCCESS) {
+		ABT_mutex_free(&ctl->apc_lock);
+		return dss_abterr2der(rc);
+	}
+
+	return 0;
+}
+
+static void
+agg_part_ctl_fini(struct agg_part_ctl *ctl)
+{
+	ABT_cond_free(&ctl->apc_cond);
+	ABT_mutex_free(&ctl->apc_lock);
+}
+
 int
 vos_aggregate(daos_handle_t coh, daos_epoch_range_t *epr,
 	      int (*yield_func)(void *arg), void *yield_arg, uint32_t flags)
 {
 	struct vos_container	*cont = vos_hdl2cont(coh);
+	struct agg_part_ctl	 ctl = { 0 };
+	struct agg_data		*ads;
 	struct agg_data		*ad;
 	uint64_t		 feats;
+	daos_epoch_t		 filter_epoch;
 	daos_epoch_t		 agg_write;
 	bool			 has_agg_write;
+	uint32_t		 defrag_blks = 0;
+	uint32_t		 part_nr = vos_agg_parts;
+	uint32_t		 i;
 	int			 rc;
 	bool			 run_agg = false;
+	bool			 csum_err = false;
+	bool			 in_progress = false;
+	bool			 failed = false;
 
 	D_DEBUG(DB_TRACE, "epr: %lu -> %lu\n", epr->epr_lo, epr->epr_hi);
 	D_ASSERT(epr != NULL);
@@ -2648,9 +2944,14 @@ vos_aggregate(daos_handle_t coh, daos_epoch_range_t *epr,
 		  "epr_lo:"DF_U64", epr_hi:"DF_U64"\n",
 		  epr->epr_lo, epr->epr_hi);
 
-	D_ALLOC_PTR(ad);
-	if (ad == NULL)
-		return -DER_NOMEM;
+	if (part_nr > 1 && agg_part_ctl_init(&ctl) != 0)
+		part_nr = 1;
+
+	D_ALLOC_ARRAY(ads, part_nr);
+	if (ads == NULL) {
+		rc = -DER_NOMEM;
+		goto fini_ctl;
+	}
 
 	rc = aggregate_enter(cont, AGG_MODE_AGGREGATE, epr);
 	if (rc)
@@ -2661,52 +2962,89 @@ vos_aggregate(daos_handle_t coh, daos_epoch_range_t *epr,
 	 *  the scan would be a noop anyway.
 	 */
 	if (flags & VOS_AGG_FL_FORCE_SCAN)
-		ad->ad_agg_param.ap_filter_epoch = epr->epr_lo;
+		filter_epoch = epr->epr_lo;
 	else
-		ad->ad_agg_param.ap_filter_epoch = cont->vc_cont_df->cd_hae;
+		filter_epoch = cont->vc_cont_df->cd_hae;
 
 	feats = dbtree_feats_get(&cont->vc_cont_df->cd_obj_root);
 	has_agg_write = vos_feats_agg_time_get(feats, &agg_write);
-	if (has_agg_write && agg_write <= ad->ad_agg_param.ap_filter_epoch)
+	if (has_agg_write && agg_write <= filter_epoch)
 		goto update_hae;
 
-	/* Set iteration parameters */
-	ad->ad_iter_param.ip_hdl = coh;
-	ad->ad_iter_param.ip_epr = *epr;
-	/*
-	 * Iterate in epoch reserve order for SV tree, so that we can know for
-	 * sure the first returned recx in SV tree has highest epoch and can't
-	 * be aggregated.
-	 */
-	ad->ad_iter_param.ip_epc_expr = VOS_IT_EPC_RR;
-	/* EV tree iterator returns all sorted logical rectangles */
-	ad->ad_iter_param.ip_flags = VOS_IT_PUNCHED | VOS_IT_RECX_COVERED;
-	ad->ad_iter_param.ip_filter_cb = vos_agg_filter;
-	ad->ad_iter_param.ip_filter_arg = &ad->ad_agg_param;
+	if (flags & VOS_AGG_FL_DEFRAG) {
+		struct vea_space_info	*vsi = cont->vc_pool->vp_vea_info;
 
-	/* Set aggregation parameters */
-	ad->ad_agg_param.ap_umm = &cont->vc_pool->vp_umm;
-	ad->ad_agg_param.ap_coh = coh;
-	credits_set(&ad->ad_agg_param.ap_credits, true);
-	ad->ad_agg_param.ap_discard = 0;
-	ad->ad_agg_param.ap_yield_func = yield_func;
-	ad->ad_agg_param.ap_yield_arg = yield_arg;
+		if (vsi != NULL && vea_frag_index(vsi) >= vos_defrag_thresh)
+			defrag_blks = VOS_DEFRAG_MAX_BLKS;
+		else
+			flags &= ~VOS_AGG_FL_DEFRAG;
+	}
+
+	for (i = 0; i < part_nr; i++) {
+		ad = &ads[i];
+		ad->ad_agg_param.ap_filter_epoch = filter_epoch;
+
+		/* Set iteration parameters */
+		ad->ad_iter_param.ip_hdl = coh;
+		ad->ad_iter_param.ip_epr = *epr;
+		/*
+		 * Iterate in epoch reserve order for SV tree, so that we can know for
+		 * sure the first returned recx in SV tree has highest epoch and can't
+		 * be aggregated.
+		 */
+		ad->ad_iter_param.ip_epc_expr = VOS_IT_EPC_RR;
+		/* EV tree iterator returns all sorted logical rectangles */
+		ad->ad_iter_param.ip_flags = VOS_IT_PUNCHED | VOS_IT_RECX_COVERED | VOS_IT_FOR_PURGE;
+		ad->ad_iter_param.ip_filter_cb = vos_agg_filter;
+		ad->ad_iter_param.ip_filter_arg = &ad->ad_agg_param;
+
+		/* Set aggregation parameters */
+		ad->ad_agg_param.ap_umm = &cont->vc_pool->vp_umm;
+		ad->ad_agg_param.ap_coh = coh;
+		credits_set(&ad->ad_agg_param.ap_credits, true);
+		ad->ad_agg_param.ap_discard = 0;
+		ad->ad_agg_param.ap_yield_func = yield_func;
+		ad->ad_agg_param.ap_yield_arg = yield_arg;
+		merge_window_init(&ad->ad_agg_param.ap_window);
+		ad->ad_agg_param.ap_flags = flags;
+		/* Defrag budget is shared by all partitions */
+		ad->ad_agg_param.ap_defrag_blks = defrag_blks / part_nr;
+		if (part_nr > 1) {
+			ad->ad_agg_param.ap_part_ctl = &ctl;
+			/* Each partition iterates its own OID range of the object index */
+			ad->ad_iter_param.ip_part_id = i;
+			ad->ad_iter_param.ip_part_nr = part_nr;
+		}
+	}
 	run_agg = true;
-	merge_window_init(&ad->ad_agg_param.ap_window);
-	ad->ad_agg_param.ap_flags = flags;
 
-	ad->ad_iter_param.ip_flags |= VOS_IT_FOR_PURGE;
-	rc = vos_iterate(&ad->ad_iter_param, VOS_ITER_OBJ, true, &ad->ad_anchors,
-			 vos_aggregate_pre_cb, vos_aggregate_post_cb,
-			 &ad->ad_agg_param, NULL);
-	if (rc != 0 || ad->ad_agg_param.ap_nospc_err) {
-		close_merge_window(&ad->ad_agg_param.ap_window, rc);
+	for (i = 1; i < part_nr; i++)
+		agg_part_start(&ads[i]);
+
+	agg_part_run(&ads[0]);
+
+	if (part_nr > 1)
+		agg_part_wait(ads, part_nr);
+
+	for (i = 0; i < part_nr; i++) {
+		ad = &ads[i];
+		if (ad->ad_rc != 0 || ad->ad_agg_param.ap_nospc_err) {
+			if (!failed)
+				rc = ad->ad_rc;
+			failed = true;
+		}
+		if (ad->ad_agg_param.ap_csum_err)
+			csum_err = true;
+		if (ad->ad_agg_param.ap_in_progress)
+			in_progress = true;
+	}
+
+	if (failed) {
 		goto exit;
-	} else if (ad->ad_agg_param.ap_csum_err) {
+	} else if (csum_err) {
 		rc = -DER_CSUM;	/* Inform caller the csum error */
-		close_merge_window(&ad->ad_agg_param.ap_window, rc);
 		/* HAE needs be updated for csum error case */
-	} else if (ad->ad_agg_param.ap_in_progress) {
+	} else if (in_progress) {
 		/* Don't update HAE when there were in-progress entries. Otherwise,
 		 * we will never aggregate anything in those subtrees until there is
 		 * a new write.
@@ -2727,11 +3065,16 @@ update_hae:
 exit:
 	aggregate_exit(cont, AGG_MODE_AGGREGATE);
 
-	if (run_agg && merge_window_status(&ad->ad_agg_param.ap_window) != MW_CLOSED)
-		D_ASSERTF(false, "Merge window resource leaked.\n");
+	for (i = 0; run_agg && i < part_nr; i++) {
+		if (merge_window_status(&ads[i].ad_agg_param.ap_window) != MW_CLOSED)
+			D_ASSERTF(false, "Merge window resource leaked.\n");
+	}
 
 free_agg_data:
-	D_FREE(ad);
+	D_FREE(ads);
+fini_ctl:
+	if (part_nr > 1)
+		agg_part_ctl_fini(&ctl);
 
 	return rc;
 }
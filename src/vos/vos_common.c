@@ -138,6 +138,10 @@ vos_bio_addr_free(struct vos_pool *pool, bio_addr_t *addr, daos_size_t nob)
 		blk_off = vos_byte2blkoff(addr->ba_off);
 		blk_cnt = vos_byte2blkcnt(nob);
 
+		/* GC batches the frees of a transaction, see gc_nvme_free() */
+		if (pool->vp_gc_frees != NULL)
+			return gc_nvme_free(pool, blk_off, blk_cnt);
+
 		rc = vea_free(pool->vp_vea_info, blk_off, blk_cnt);
 		if (rc)
 			D_ERROR("Error on block ["DF_U64", %u] free. "DF_RC"\n",
@@ -523,6 +527,47 @@ vos_tls_init(int tags, int xs_id, int tgt_id)
 		if (rc)
 			D_WARN("Failed to create vos obj cnt: "DF_RC"\n", DP_RC(rc));
 
+		rc = d_tm_add_metric(&tls->vtl_obj_cache_hit, D_TM_COUNTER,
+				     "Number of object holds served from the object cache",
+				     NULL, "io/obj_cache/hit/tgt_%u", tgt_id);
+		if (rc)
+			D_WARN("Failed to create obj cache hit counter: "DF_RC"\n", DP_RC(rc));
+
+		rc = d_tm_add_metric(&tls->vtl_obj_cache_miss, D_TM_COUNTER,
+				     "Number of object holds loading the object from the OI table",
+				     NULL, "io/obj_cache/miss/tgt_%u", tgt_id);
+		if (rc)
+			D_WARN("Failed to create obj cache miss counter: "DF_RC"\n", DP_RC(rc));
+
+		rc = d_tm_add_metric(&tls->vtl_ilog_cache_hit, D_TM_COUNTER,
+				     "Number of ilog fetches resolved from the visibility cache",
+				     NULL, "io/ilog_cache/hit/tgt_%u", tgt_id);
+		if (rc)
+			D_WARN("Failed to create ilog cache hit counter: "DF_RC"\n", DP_RC(rc));
+
+		rc = d_tm_add_metric(&tls->vtl_ilog_cache_miss, D_TM_COUNTER,
+				     "Number of ilog fetches missing the visibility cache",
+				     NULL, "io/ilog_cache/miss/tgt_%u", tgt_id);
+		if (rc)
+			D_WARN("Failed to create ilog cache miss counter: "DF_RC"\n", DP_RC(rc));
+
+		rc = d_tm_add_metric(&tls->vtl_ts_evict, D_TM_COUNTER,
+				     "Number of timestamp cache entries evicted for lack of space",
+				     NULL, "io/ts/evict/tgt_%u", tgt_id);
+		if (rc)
+			D_WARN("Failed to create ts evict counter: "DF_RC"\n", DP_RC(rc));
+
+		rc = d_tm_add_metric(&tls->vtl_ts_tier_hit, D_TM_COUNTER,
+				     "Number of timestamp entries restored from the precise tier",
+				     NULL, "io/ts/tier_hit/tgt_%u", tgt_id);
+		if (rc)
+			D_WARN("Failed to create ts tier hit counter: "DF_RC"\n", DP_RC(rc));
+
+		rc = d_tm_add_metric(&tls->vtl_ts_restart, D_TM_COUNTER,
+				     "Number of read timestamp conflicts forcing a restart",
+				     NULL, "io/ts/restart/tgt_%u", tgt_id);
+		if (rc)
+			D_WARN("Failed to create ts restart counter: "DF_RC"\n", DP_RC(rc));
 	}
 
 	rc = d_tm_add_metric(&tls->vtl_lru_alloc_size, D_TM_GAUGE,
@@ -613,9 +658,32 @@ vos_mod_init(void)
 	D_INFO("Set aggregate NVMe record threshold to %u blocks (blk_sz:%lu).\n",
 	       vos_agg_nvme_thresh, VOS_BLK_SZ);
 
+	d_getenv_int("DAOS_VOS_DEFRAG_THRESH", &vos_defrag_thresh);
+	if (vos_defrag_thresh > 100)
+		vos_defrag_thresh = VOS_DEFRAG_THRESH;
+	D_INFO("Set NVMe defrag fragmentation index threshold to %u%%.\n", vos_defrag_thresh);
+
+	d_getenv_int("DAOS_VOS_AGG_PARTS", &vos_agg_parts);
+	if (vos_agg_parts == 0 || vos_agg_parts > VOS_AGG_PARTS_MAX)
+		vos_agg_parts = 1;
+	D_INFO("Set aggregation partitions per container to %u.\n", vos_agg_parts);
+
+	/* 0 disables the bulk GC mode */
+	d_getenv_int("DAOS_VOS_GC_BULK_CREDS", &vos_gc_bulk_creds);
+	if (vos_gc_bulk_creds > VOS_GC_CREDS_MAX)
+		vos_gc_bulk_creds = VOS_GC_CREDS_MAX;
+	D_INFO("Set GC bulk mode credits to %u.\n", vos_gc_bulk_creds);
+
+	/* 0 disables the ilog visibility cache */
+	d_getenv_int("DAOS_VOS_ILOG_CACHE", &vos_ilog_cache_size);
+	D_INFO("Set ilog visibility cache size to %u.\n", vos_ilog_cache_size);
+
 	d_getenv_bool("DAOS_DKEY_PUNCH_PROPAGATE", &vos_dkey_punch_propagate);
 	D_INFO("DKEY punch propagation is %s\n", vos_dkey_punch_propagate ? "enabled" : "disabled");
 
+	d_getenv_bool("DAOS_VEA_ALLOC_CACHE", &vos_vea_alloc_cache);
+	D_INFO("VEA allocation cache is %s\n", vos_vea_alloc_cache ? "enabled" : "disabled");
+
 
 	return rc;
 }
@@ -631,7 +699,8 @@ vos_metrics_count(void)
 {
 	return vea_metrics_count() +
 	       (sizeof(struct vos_agg_metrics) + sizeof(struct vos_space_metrics) +
-		sizeof(struct vos_chkpt_metrics)) / sizeof(struct d_tm_node_t *);
+		sizeof(struct vos_chkpt_metrics) + sizeof(struct vos_tier_metrics)) /
+		   sizeof(struct d_tm_node_t *);
 }
 
 static void
@@ -647,6 +716,7 @@ vos_metrics_free(void *data)
 #define VOS_AGG_DIR	"vos_aggregation"
 #define VOS_SPACE_DIR	"vos_space"
 #define VOS_RH_DIR	"vos_rehydration"
+#define VOS_TIER_DIR	"vos_tier"
 
 static inline char *
 agg_op2str(unsigned int agg_op)
@@ -670,6 +740,7 @@ vos_metrics_alloc(const char *path, int tgt_id)
 	struct vos_agg_metrics		*vam;
 	struct vos_space_metrics	*vsm;
 	struct vos_rh_metrics		*brm;
+	struct vos_tier_metrics		*vtm;
 	char				desc[40];
 	int				i, rc;
 
@@ -688,6 +759,7 @@ vos_metrics_alloc(const char *path, int tgt_id)
 	vam = &vp_metrics->vp_agg_metrics;
 	vsm = &vp_metrics->vp_space_metrics;
 	brm = &vp_metrics->vp_rh_metrics;
+	vtm = &vp_metrics->vp_tier_metrics;
 
 	/* VOS aggregation EPR scan duration */
 	rc = d_tm_add_metric(&vam->vam_epr_dur, D_TM_DURATION | D_TM_CLOCK_THREAD_CPUTIME,
@@ -759,6 +831,12 @@ vos_metrics_alloc(const char *path, int tgt_id)
 	if (rc)
 		D_WARN("Failed to create 'merged_size' telemetry : "DF_RC"\n", DP_RC(rc));
 
+	/* VOS aggregation total relocated size for NVMe defrag */
+	rc = d_tm_add_metric(&vam->vam_defrag_size, D_TM_COUNTER, "total defrag relocated size",
+			     "bytes", "%s/%s/defrag_size/tgt_%u", path, VOS_AGG_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'defrag_size' telemetry : "DF_RC"\n", DP_RC(rc));
+
 	/* Metrics related to VOS checkpointing */
 	vos_chkpt_metrics_init(&vp_metrics->vp_chkpt_metrics, path, tgt_id);
 
@@ -777,6 +855,37 @@ vos_metrics_alloc(const char *path, int tgt_id)
 	/* Initialize the vos_space_metrics timeout counter */
 	vsm->vsm_last_update_ts = 0;
 
+	/* Initialize metrics for tier placement */
+	rc = d_tm_add_metric(&vtm->vtm_scm_hit, D_TM_COUNTER, "Fetched extents on SCM", NULL,
+			     "%s/%s/scm_hit/tgt_%u", path, VOS_TIER_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'scm_hit' telemetry : "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&vtm->vtm_nvme_hit, D_TM_COUNTER, "Fetched extents on NVME", NULL,
+			     "%s/%s/nvme_hit/tgt_%u", path, VOS_TIER_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'nvme_hit' telemetry : "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&vtm->vtm_scm_placed, D_TM_COUNTER, "Data placed on SCM", "bytes",
+			     "%s/%s/scm_placed/tgt_%u", path, VOS_TIER_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'scm_placed' telemetry : "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&vtm->vtm_nvme_placed, D_TM_COUNTER, "Data placed on NVME", "bytes",
+			     "%s/%s/nvme_placed/tgt_%u", path, VOS_TIER_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'nvme_placed' telemetry : "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&vtm->vtm_promoted, D_TM_COUNTER, "Data promoted to SCM", "bytes",
+			     "%s/%s/promoted/tgt_%u", path, VOS_TIER_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'promoted' telemetry : "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&vtm->vtm_demoted, D_TM_COUNTER, "Data demoted to NVME", "bytes",
+			     "%s/%s/demoted/tgt_%u", path, VOS_TIER_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'demoted' telemetry : "DF_RC"\n", DP_RC(rc));
+
 	/* Initialize metrics for vos file rehydration */
 	rc = d_tm_add_metric(&brm->vrh_size, D_TM_GAUGE, "WAL replay size", "bytes",
 			     "%s/%s/replay_size/tgt_%u", path, VOS_RH_DIR, tgt_id);
@@ -803,6 +912,16 @@ vos_metrics_alloc(const char *path, int tgt_id)
 	if (rc)
 		D_WARN("Failed to create 'replay_transactions' telemetry : "DF_RC"\n", DP_RC(rc));
 
+	rc = d_tm_add_metric(&brm->vrh_io_wait, D_TM_GAUGE, "WAL replay I/O wait time", "us",
+			     "%s/%s/replay_io_wait/tgt_%u", path, VOS_RH_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'replay_io_wait' telemetry : "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&brm->vrh_bw, D_TM_GAUGE, "WAL replay throughput", "MB/s",
+			     "%s/%s/replay_throughput/tgt_%u", path, VOS_RH_DIR, tgt_id);
+	if (rc)
+		D_WARN("Failed to create 'replay_throughput' telemetry : "DF_RC"\n", DP_RC(rc));
+
 	return vp_metrics;
 }
 
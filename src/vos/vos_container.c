@@ -185,7 +185,11 @@ cont_free_internal(struct vos_container *cont)
 	if (cont->vc_dtx_array)
 		lrua_array_free(cont->vc_dtx_array);
 
+	if (cont->vc_ilog_cache)
+		ilog_vis_cache_destroy(cont->vc_ilog_cache);
+
 	D_ASSERT(d_list_empty(&cont->vc_dtx_act_list));
+	D_ASSERT(d_list_empty(&cont->vc_obj_list));
 
 	dbtree_close(cont->vc_btr_hdl);
 
@@ -382,6 +386,7 @@ vos_cont_open(daos_handle_t poh, uuid_t co_uuid, daos_handle_t *coh)
 		cont->vc_cmt_dtx_indexed = 0;
 	cont->vc_cmt_dtx_reindex_pos = cont->vc_cont_df->cd_dtx_committed_head;
 	D_INIT_LIST_HEAD(&cont->vc_dtx_act_list);
+	D_INIT_LIST_HEAD(&cont->vc_obj_list);
 	cont->vc_dtx_committed_count = 0;
 	cont->vc_solo_dtx_epoch = d_hlc_get();
 	gc_check_cont(cont);
@@ -408,6 +413,15 @@ vos_cont_open(daos_handle_t poh, uuid_t co_uuid, daos_handle_t *coh)
 		D_GOTO(exit, rc);
 	}
 
+	if (vos_ilog_cache_size != 0) {
+		rc = ilog_vis_cache_create(vos_ilog_cache_size, &cont->vc_ilog_cache);
+		if (rc != 0) {
+			D_ERROR("Failed to create ilog visibility cache: rc = "DF_RC"\n",
+				DP_RC(rc));
+			D_GOTO(exit, rc);
+		}
+	}
+
 	rc = dbtree_create_inplace_ex(VOS_BTR_DTX_ACT_TABLE, 0,
 				      DTX_BTREE_ORDER, &uma,
 				      &cont->vc_dtx_active_btr,
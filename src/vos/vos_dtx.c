@@ -335,6 +335,56 @@ static btr_ops_t dtx_active_btr_ops = {
 	.to_rec_update	= dtx_act_ent_update,
 };
 
+static struct vos_dtx_cmt_slab *
+dtx_cmt_slab_alloc(uint32_t nr)
+{
+	struct vos_dtx_cmt_slab	*slab;
+
+	D_ALLOC(slab, offsetof(struct vos_dtx_cmt_slab, dcs_ents[nr]));
+	if (slab != NULL) {
+		/* Held by the allocator until dtx_cmt_slab_put() */
+		slab->dcs_ref = 1;
+		slab->dcs_nr = nr;
+	}
+
+	return slab;
+}
+
+static inline void
+dtx_cmt_slab_put(struct vos_dtx_cmt_slab *slab)
+{
+	D_ASSERT(slab->dcs_ref > 0);
+	if (--slab->dcs_ref == 0)
+		D_FREE(slab);
+}
+
+/* Get a committed DTX entry from @slab, fallback to allocate it individually */
+static struct vos_dtx_cmt_ent *
+dtx_cmt_ent_get(struct vos_dtx_cmt_slab *slab)
+{
+	struct vos_dtx_cmt_ent	*dce;
+
+	if (slab == NULL || slab->dcs_used == slab->dcs_nr) {
+		D_ALLOC_PTR(dce);
+		return dce;
+	}
+
+	dce = &slab->dcs_ents[slab->dcs_used++];
+	dce->dce_slab = slab;
+	slab->dcs_ref++;
+
+	return dce;
+}
+
+static inline void
+dtx_cmt_ent_put(struct vos_dtx_cmt_ent *dce)
+{
+	if (dce->dce_slab != NULL)
+		dtx_cmt_slab_put(dce->dce_slab);
+	else
+		D_FREE(dce);
+}
+
 static int
 dtx_cmt_ent_alloc(struct btr_instance *tins, d_iov_t *key_iov,
 		  d_iov_t *val_iov, struct btr_record *rec, d_iov_t *val_out)
@@ -356,7 +406,7 @@ dtx_cmt_ent_free(struct btr_instance *tins, struct btr_record *rec,
 	D_ASSERT(dce != NULL);
 
 	rec->rec_off = UMOFF_NULL;
-	D_FREE(dce);
+	dtx_cmt_ent_put(dce);
 
 	return 0;
 }
@@ -405,7 +455,7 @@ dtx_cmt_ent_update(struct btr_instance *tins, struct btr_record *rec,
 
 	if (dce_old->dce_invalid) {
 		rec->rec_off = umem_ptr2off(&tins->ti_umm, dce_new);
-		D_FREE(dce_old);
+		dtx_cmt_ent_put(dce_old);
 	} else if (!dce_old->dce_reindex) {
 		D_ASSERTF(dce_new->dce_reindex, "Repeatedly commit DTX "DF_DTI"\n",
 			  DP_DTI(&DCE_XID(dce_new)));
@@ -753,8 +803,9 @@ dtx_rec_release(struct vos_container *cont, struct vos_dtx_act_ent *dae,
 
 static int
 vos_dtx_commit_one(struct vos_container *cont, struct dtx_id *dti, daos_epoch_t epoch,
-		   daos_epoch_t cmt_time, struct vos_dtx_cmt_ent **dce_p,
-		   struct vos_dtx_act_ent **dae_p, bool *rm_cos, bool *fatal)
+		   daos_epoch_t cmt_time, struct vos_dtx_cmt_slab *slab,
+		   struct vos_dtx_cmt_ent **dce_p, struct vos_dtx_act_ent **dae_p, bool *rm_cos,
+		   bool *fatal)
 {
 	struct vos_tls			*tls = vos_tls_get(false);
 	struct vos_dtx_act_ent		*dae = NULL;
@@ -817,7 +868,7 @@ vos_dtx_commit_one(struct vos_container *cont, struct dtx_id *dti, daos_epoch_t
 			D_GOTO(out, rc = -DER_ALREADY);
 	}
 
-	D_ALLOC_PTR(dce);
+	dce = dtx_cmt_ent_get(slab);
 	if (dce == NULL)
 		D_GOTO(out, rc = -DER_NOMEM);
 
@@ -867,8 +918,8 @@ out:
 	if (rc != -DER_ALREADY && rc != -DER_NONEXIST)
 		DL_CDEBUG(rc != 0, DLOG_ERR, DB_IO, rc, "Commit the DTX " DF_DTI, DP_DTI(dti));
 
-	if (rc != 0)
-		D_FREE(dce);
+	if (rc != 0 && dce != NULL)
+		dtx_cmt_ent_put(dce);
 
 	if (rm_cos != NULL && (rc == 0 || rc == -DER_NONEXIST))
 		*rm_cos = true;
@@ -1939,6 +1990,7 @@ vos_dtx_commit_internal(struct vos_container *cont, struct dtx_id dtis[],
 	struct umem_instance		*umm = vos_cont2umm(cont);
 	struct vos_dtx_blob_df		*dbd;
 	struct vos_dtx_blob_df		*dbd_prev;
+	struct vos_dtx_cmt_slab		*slab = NULL;
 	umem_off_t			 dbd_off;
 	uint64_t			 cmt_time = daos_gettime_coarse();
 	int				 committed = 0;
@@ -1950,6 +2002,12 @@ vos_dtx_commit_internal(struct vos_container *cont, struct dtx_id dtis[],
 	bool				 fatal = false;
 	bool				 allocated = false;
 
+	/* Allocate the DRAM committed entries for the batch together, it is fine to fallback
+	 * to allocate them individually on failure.
+	 */
+	if (count > 1)
+		slab = dtx_cmt_slab_alloc(count);
+
 	dbd = umem_off2ptr(umm, cont_df->cd_dtx_committed_tail);
 	if (dbd == NULL)
 		goto new_blob;
@@ -1969,7 +2027,7 @@ again:
 	     i++, cur++) {
 		struct vos_dtx_cmt_ent	*dce = NULL;
 
-		rc = vos_dtx_commit_one(cont, &dtis[cur], epoch, cmt_time, &dce,
+		rc = vos_dtx_commit_one(cont, &dtis[cur], epoch, cmt_time, slab, &dce,
 					daes != NULL ? &daes[cur] : NULL,
 					rm_cos != NULL ? &rm_cos[cur] : NULL, &fatal);
 		if (dces != NULL)
@@ -1987,16 +2045,18 @@ again:
 		if (rc1 == 0)
 			rc1 = rc;
 
-		if (dce != NULL) {
-			rc = umem_tx_xadd_ptr(umm, &dbd->dbd_committed_data[j],
-					      sizeof(struct vos_dtx_cmt_ent_df),
-					      UMEM_XADD_NO_SNAPSHOT);
-			if (rc != 0)
-				D_GOTO(out, fatal = true);
-
+		if (dce != NULL)
 			memcpy(&dbd->dbd_committed_data[j++], &dce->dce_base,
 			       sizeof(struct vos_dtx_cmt_ent_df));
-		}
+	}
+
+	/* The slots are appended contiguously, add them to the transaction in one range. */
+	if (j > dbd->dbd_count) {
+		rc = umem_tx_xadd_ptr(umm, &dbd->dbd_committed_data[dbd->dbd_count],
+				      sizeof(struct vos_dtx_cmt_ent_df) * (j - dbd->dbd_count),
+				      UMEM_XADD_NO_SNAPSHOT);
+		if (rc != 0)
+			D_GOTO(out, fatal = true);
 	}
 
 	if (!allocated) {
@@ -2063,6 +2123,9 @@ new_blob:
 	goto again;
 
 out:
+	if (slab != NULL)
+		dtx_cmt_slab_put(slab);
+
 	return fatal ? rc : (committed > 0 ? committed : rc1);
 }
 
@@ -2782,6 +2845,7 @@ vos_dtx_cmt_reindex(daos_handle_t coh)
 	struct umem_instance		*umm;
 	struct vos_container		*cont;
 	struct vos_dtx_cmt_ent		*dce;
+	struct vos_dtx_cmt_slab		*slab = NULL;
 	struct vos_dtx_blob_df		*dbd;
 	d_iov_t				 kiov;
 	d_iov_t				 riov;
@@ -2802,6 +2866,9 @@ vos_dtx_cmt_reindex(daos_handle_t coh)
 	D_ASSERTF(dbd->dbd_magic == DTX_CMT_BLOB_MAGIC,
 		  "Corrupted committed DTX blob (2) %x\n", dbd->dbd_magic);
 
+	if (dbd->dbd_count > 1)
+		slab = dtx_cmt_slab_alloc(dbd->dbd_count);
+
 	for (i = 0; i < dbd->dbd_count; i++) {
 		if (daos_is_zero_dti(&dbd->dbd_committed_data[i].dce_xid) ||
 		    dbd->dbd_committed_data[i].dce_epoch == 0) {
@@ -2809,7 +2876,7 @@ vos_dtx_cmt_reindex(daos_handle_t coh)
 			continue;
 		}
 
-		D_ALLOC_PTR(dce);
+		dce = dtx_cmt_ent_get(slab);
 		if (dce == NULL)
 			D_GOTO(out, rc = -DER_NOMEM);
 
@@ -2822,7 +2889,7 @@ vos_dtx_cmt_reindex(daos_handle_t coh)
 		rc = dbtree_upsert(cont->vc_dtx_committed_hdl, BTR_PROBE_EQ,
 				   DAOS_INTENT_UPDATE, &kiov, &riov, NULL);
 		if (rc != 0) {
-			D_FREE(dce);
+			dtx_cmt_ent_put(dce);
 			goto out;
 		}
 
@@ -2830,7 +2897,7 @@ vos_dtx_cmt_reindex(daos_handle_t coh)
 		 * Related re-index logic can stop.
 		 */
 		if (dce->dce_exist) {
-			D_FREE(dce);
+			dtx_cmt_ent_put(dce);
 			D_GOTO(out, rc = 1);
 		}
 	}
@@ -2841,6 +2908,9 @@ vos_dtx_cmt_reindex(daos_handle_t coh)
 	cont->vc_cmt_dtx_reindex_pos = dbd->dbd_next;
 
 out:
+	if (slab != NULL)
+		dtx_cmt_slab_put(slab);
+
 	if (rc > 0) {
 		cont->vc_cmt_dtx_reindex_pos = UMOFF_NULL;
 		cont->vc_cmt_dtx_indexed = 1;
@@ -19,7 +19,29 @@ enum {
 	GC_CREDS_MIN	= 1,	/**< minimum credits for vos_gc_run/pool() */
 	GC_CREDS_SLACK	= 8,	/**< credits for slack mode */
 	GC_CREDS_TIGHT	= 32,	/**< credits for tight mode */
-	GC_CREDS_MAX	= 4096,	/**< maximum credits for vos_gc_run/pool() */
+	GC_CREDS_MAX	= VOS_GC_CREDS_MAX, /**< maximum credits for vos_gc_run/pool() */
+};
+
+/** credits per transaction while reclaiming objects or containers, 0 disables */
+unsigned int vos_gc_bulk_creds = VOS_GC_BULK_CREDS;
+
+/** Max number of NVMe extents batched by a GC transaction */
+#define GC_FREES_MAX	256
+
+/** NVMe extent released by GC */
+struct vos_gc_ext {
+	uint64_t	ge_blk_off;
+	uint32_t	ge_blk_cnt;
+};
+
+/**
+ * NVMe extents released by the running GC transaction. They are sorted and
+ * merged before being returned to VEA, so draining a large evtree costs a
+ * few vea_free() calls instead of one per record.
+ */
+struct vos_gc_frees {
+	uint32_t		gf_nr;
+	struct vos_gc_ext	gf_exts[GC_FREES_MAX];
 };
 
 /**
@@ -495,6 +517,106 @@ gc_get_item(struct vos_gc *gc, struct vos_pool *pool,
 	return &bag->bag_items[bag->bag_item_first];
 }
 
+/**
+ * Check if the pool has objects or containers to be reclaimed, GC switches
+ * to bulk mode and frees more records per transaction for them.
+ */
+static bool
+gc_pool_bulk(struct vos_pool *pool)
+{
+	struct vos_container	*cont;
+
+	if (vos_gc_bulk_creds == 0)
+		return false;
+
+	if (gc_get_item(&gc_table[GC_CONT], pool, NULL) != NULL ||
+	    gc_get_item(&gc_table[GC_OBJ], pool, NULL) != NULL)
+		return true;
+
+	if (d_list_empty(&pool->vp_gc_cont))
+		return false;
+
+	cont = d_list_entry(pool->vp_gc_cont.next, struct vos_container, vc_gc_link);
+	return gc_get_item(&gc_table[GC_OBJ], pool, cont) != NULL;
+}
+
+static int
+gc_ext_cmp(const void *a, const void *b)
+{
+	const struct vos_gc_ext	*ea = a;
+	const struct vos_gc_ext	*eb = b;
+
+	if (ea->ge_blk_off < eb->ge_blk_off)
+		return -1;
+	return ea->ge_blk_off > eb->ge_blk_off;
+}
+
+/** Sort & merge the batched NVMe extents, then return them to VEA */
+static int
+gc_nvme_flush(struct vos_pool *pool, struct vos_gc_frees *frees)
+{
+	struct vos_gc_ext	*ext;
+	uint64_t		 blk_off;
+	uint64_t		 blk_cnt;
+	uint32_t		 i;
+	int			 rc = 0;
+
+	if (frees->gf_nr == 0)
+		return 0;
+
+	qsort(frees->gf_exts, frees->gf_nr, sizeof(*ext), gc_ext_cmp);
+
+	blk_off = frees->gf_exts[0].ge_blk_off;
+	blk_cnt = frees->gf_exts[0].ge_blk_cnt;
+	for (i = 1; i <= frees->gf_nr; i++) {
+		ext = i < frees->gf_nr ? &frees->gf_exts[i] : NULL;
+		if (ext != NULL && ext->ge_blk_off == blk_off + blk_cnt &&
+		    blk_cnt + ext->ge_blk_cnt <= UINT32_MAX) {
+			blk_cnt += ext->ge_blk_cnt;
+			continue;
+		}
+
+		rc = vea_free(pool->vp_vea_info, blk_off, blk_cnt);
+		if (rc) {
+			D_ERROR("Error on block ["DF_U64", "DF_U64"] free. "DF_RC"\n",
+				blk_off, blk_cnt, DP_RC(rc));
+			break;
+		}
+
+		if (ext != NULL) {
+			blk_off = ext->ge_blk_off;
+			blk_cnt = ext->ge_blk_cnt;
+		}
+	}
+	D_DEBUG(DB_TRACE, "GC freed %u NVMe extents\n", frees->gf_nr);
+
+	frees->gf_nr = 0;
+	return rc;
+}
+
+/**
+ * Batch NVMe extent released by GC, it's called by vos_bio_addr_free() while
+ * the GC transaction is running.
+ */
+int
+gc_nvme_free(struct vos_pool *pool, uint64_t blk_off, uint32_t blk_cnt)
+{
+	struct vos_gc_frees	*frees = pool->vp_gc_frees;
+	int			 rc;
+
+	D_ASSERT(frees != NULL);
+	if (frees->gf_nr == GC_FREES_MAX) {
+		rc = gc_nvme_flush(pool, frees);
+		if (rc)
+			return rc;
+	}
+
+	frees->gf_exts[frees->gf_nr].ge_blk_off = blk_off;
+	frees->gf_exts[frees->gf_nr].ge_blk_cnt = blk_cnt;
+	frees->gf_nr++;
+	return 0;
+}
+
 static int
 gc_drain_item(struct vos_gc *gc, struct vos_pool *pool, daos_handle_t coh,
 	      struct vos_gc_item *item, int *credits, bool *empty)
@@ -666,6 +788,7 @@ gc_reclaim_pool(struct vos_pool *pool, int *credits, bool *empty_ret)
 {
 	struct vos_container	*cont = gc_get_container(pool);
 	struct vos_gc		*gc    = &gc_table[0]; /* start from akey */
+	struct vos_gc_frees	*frees = NULL;
 	int			 creds = *credits;
 	int			 rc;
 
@@ -687,6 +810,12 @@ gc_reclaim_pool(struct vos_pool *pool, int *credits, bool *empty_ret)
 		return rc;
 	}
 
+	/* NVMe extents are freed one by one if the allocation failed */
+	D_ASSERT(pool->vp_gc_frees == NULL);
+	if (pool->vp_vea_info != NULL)
+		D_ALLOC_PTR(frees);
+	pool->vp_gc_frees = frees;
+
 	*empty_ret = false;
 	while (creds > 0) {
 		struct vos_gc_item *item;
@@ -766,6 +895,18 @@ gc_reclaim_pool(struct vos_pool *pool, int *credits, bool *empty_ret)
 		"pool="DF_UUID", creds origin=%d, current=%d, rc=%s\n",
 		DP_UUID(pool->vp_id), *credits, creds, d_errstr(rc));
 
+	/* Must be done before tx end, which may yield */
+	pool->vp_gc_frees = NULL;
+	if (frees != NULL) {
+		if (rc >= 0) {
+			int	rc1 = gc_nvme_flush(pool, frees);
+
+			if (rc1)
+				rc = rc1;
+		}
+		D_FREE(frees);
+	}
+
 	rc = umem_tx_end(&pool->vp_umm, rc);
 	if (rc == 0)
 		*credits = creds;
@@ -1070,12 +1211,20 @@ vos_gc_pool_tight(daos_handle_t poh, int *credits)
 }
 
 struct vos_gc_param {
+	struct vos_pool		*vgc_pool;
 	struct umem_instance	*vgc_umm;
 	int			(*vgc_yield_func)(void *arg);
 	void			*vgc_yield_arg;
 	uint32_t		 vgc_credits;
 };
 
+/** Credits for tight mode, large batches are used to reclaim objects or containers */
+static inline uint32_t
+gc_tight_creds(struct vos_pool *pool)
+{
+	return gc_pool_bulk(pool) ? vos_gc_bulk_creds : GC_CREDS_TIGHT;
+}
+
 static inline bool
 vos_gc_yield(void *arg)
 {
@@ -1086,7 +1235,7 @@ vos_gc_yield(void *arg)
 	D_ASSERT(vos_dth_get(false) == NULL);
 
 	if (param->vgc_yield_func == NULL) {
-		param->vgc_credits = GC_CREDS_TIGHT;
+		param->vgc_credits = gc_tight_creds(param->vgc_pool);
 		bio_yield(param->vgc_umm);
 		return false;
 	}
@@ -1096,7 +1245,7 @@ vos_gc_yield(void *arg)
 		return true;
 
 	/* rc == 0: tight mode; rc == 1: slack mode */
-	param->vgc_credits = (rc == 0) ? GC_CREDS_TIGHT : GC_CREDS_SLACK;
+	param->vgc_credits = (rc == 0) ? gc_tight_creds(param->vgc_pool) : GC_CREDS_SLACK;
 
 	return false;
 }
@@ -1117,6 +1266,7 @@ vos_gc_pool(daos_handle_t poh, int credits, int (*yield_func)(void *arg),
 
 	vos_space_update_metrics(pool);
 
+	param.vgc_pool		= pool;
 	param.vgc_umm		= &pool->vp_umm;
 	param.vgc_yield_func	= yield_func;
 	param.vgc_yield_arg	= yield_arg;
@@ -12,6 +12,8 @@
 
 #include "vos_internal.h"
 
+unsigned int vos_ilog_cache_size = VOS_ILOG_CACHE_SIZE;
+
 static int
 vos_ilog_status_get(struct umem_instance *umm, uint32_t tx_id,
 		    daos_epoch_t epoch, uint32_t intent, bool retry, void *args)
@@ -90,6 +92,8 @@ vos_ilog_del(struct umem_instance *umm, umem_off_t ilog_off, uint32_t tx_id,
 void
 vos_ilog_desc_cbs_init(struct ilog_desc_cbs *cbs, daos_handle_t coh)
 {
+	struct vos_container	*cont = vos_hdl2cont(coh);
+
 	cbs->dc_log_status_cb	= vos_ilog_status_get;
 	cbs->dc_log_status_args	= (void *)(unsigned long)coh.cookie;
 	cbs->dc_is_same_tx_cb = vos_ilog_is_same_tx;
@@ -98,6 +102,7 @@ vos_ilog_desc_cbs_init(struct ilog_desc_cbs *cbs, daos_handle_t coh)
 	cbs->dc_log_add_args = NULL;
 	cbs->dc_log_del_cb = vos_ilog_del;
 	cbs->dc_log_del_args = (void *)(unsigned long)coh.cookie;
+	cbs->dc_vis_cache = cont != NULL ? cont->vc_ilog_cache : NULL;
 }
 
 /** Returns true if the entry is covered by a punch */
@@ -258,16 +263,72 @@ vos_parse_ilog(struct vos_ilog_info *info, const daos_epoch_range_t *epr,
 	return 0;
 }
 
+/** Fill \a info from the cached visibility of a log, see vos_parse_ilog */
+static void
+vos_ilog_vis2info(const struct ilog_vis *vis, const struct vos_punch_record *punch,
+		  struct vos_ilog_info *info)
+{
+	struct vos_punch_record	floor_punch;
+
+	if (info->ii_uncommitted < vis->iv_latest.id_epoch)
+		info->ii_uncommitted = 0;
+
+	info->ii_empty = false;
+	info->ii_create = vis->iv_create;
+	if (vis->iv_punch_minor != 0) {
+		floor_punch.pr_epc = vis->iv_floor;
+		floor_punch.pr_minor_epc = vis->iv_punch_minor;
+		info->ii_prior_punch = floor_punch;
+		if (vos_epc_punched(info->ii_prior_any_punch.pr_epc,
+				    info->ii_prior_any_punch.pr_minor_epc, &floor_punch))
+			info->ii_prior_any_punch = floor_punch;
+	}
+
+	if (vos_epc_punched(info->ii_prior_punch.pr_epc,
+			    info->ii_prior_punch.pr_minor_epc, punch))
+		info->ii_prior_punch = *punch;
+	if (vos_epc_punched(info->ii_prior_any_punch.pr_epc,
+			    info->ii_prior_any_punch.pr_minor_epc, punch))
+		info->ii_prior_any_punch = *punch;
+}
+
 static int
 vos_ilog_fetch_internal(struct umem_instance *umm, daos_handle_t coh, uint32_t intent,
 			struct ilog_df *ilog, const daos_epoch_range_t *epr, daos_epoch_t bound,
 			bool has_cond, const struct vos_punch_record *punched,
 			const struct vos_ilog_info *parent, struct vos_ilog_info *info)
 {
+	struct vos_container	*cont = vos_hdl2cont(coh);
+	struct ilog_vis_cache	*cache = NULL;
 	struct ilog_desc_cbs	 cbs;
+	struct ilog_vis		 vis;
 	struct vos_punch_record	 punch = {0};
+	bool			 cached = false;
 	int			 rc;
 
+	if (punched != NULL)
+		punch = *punched;
+	if (parent != NULL)
+		punch = parent->ii_prior_punch;
+
+	/* Only plain visibility fetches can be resolved from the cache, and
+	 * only if the parent punch doesn't reach the entries it was resolved
+	 * from.
+	 */
+	if (cont != NULL && epr->epr_lo == 0)
+		cache = cont->vc_ilog_cache;
+	if (cache != NULL) {
+		cached = ilog_vis_cache_lookup(cache, umm, ilog, &vis) &&
+			 epr->epr_hi >= vis.iv_latest.id_epoch &&
+			 !vos_epc_punched(vis.iv_floor, vis.iv_floor_minor, &punch);
+		d_tm_inc_counter(cached ? vos_tls_get(cont->vc_pool->vp_sysdb)->vtl_ilog_cache_hit :
+				 vos_tls_get(cont->vc_pool->vp_sysdb)->vtl_ilog_cache_miss, 1);
+		if (cached) {
+			rc = 0;
+			goto init;
+		}
+	}
+
 	vos_ilog_desc_cbs_init(&cbs, coh);
 	rc = ilog_fetch(umm, ilog, &cbs, intent, has_cond, &info->ii_entries);
 	if (rc == -DER_NONEXIST)
@@ -288,17 +349,24 @@ init:
 	info->ii_prior_punch.pr_minor_epc = 0;
 	info->ii_prior_any_punch.pr_epc = 0;
 	info->ii_prior_any_punch.pr_minor_epc = 0;
-	if (punched != NULL)
-		punch = *punched;
 	if (parent != NULL) {
 		info->ii_prior_any_punch = parent->ii_prior_any_punch;
-		punch = parent->ii_prior_punch;
 		info->ii_uncommitted = parent->ii_uncommitted;
 	}
 
+	if (cached) {
+		vos_ilog_vis2info(&vis, &punch, info);
+		return 0;
+	}
+
 	if (rc == 0)
 		rc = vos_parse_ilog(info, epr, bound, &punch);
 
+	/* Nothing is cached while the log may still roll back */
+	if (rc == 0 && cache != NULL && !umem_tx_inprogress(umm) &&
+	    ilog_vis_resolve(&info->ii_entries, &vis))
+		ilog_vis_cache_insert(cache, ilog, &vis);
+
 	return rc;
 }
 
@@ -115,6 +115,12 @@ enum {
  * 256 blocks as default value since the default DFS chunk size is 1MB.
  */
 #define VOS_MW_NVME_THRESH	256		/* 256 * VOS_BLK_SZ = 1MB */
+#define VOS_DEFRAG_THRESH	50		/* NVMe free space fragmentation index */
+#define VOS_ILOG_CACHE_SIZE	1024		/* Slots of ilog visibility cache */
+#define VOS_DEFRAG_MAX_BLKS	16384		/* 16384 * VOS_BLK_SZ = 64MB per pass */
+#define VOS_AGG_PARTS_MAX	16		/* Max aggregation partitions per container */
+#define VOS_GC_BULK_CREDS	256		/* GC credits per transaction in bulk mode */
+#define VOS_GC_CREDS_MAX	4096		/* Max GC credits per transaction */
 
 /*
  * Aggregation/Discard ULT yield when certain amount of credits consumed.
@@ -141,7 +147,12 @@ enum {
 #define VOS_NOSPC_ERROR_INTVL	60	/* seconds */
 
 extern unsigned int vos_agg_nvme_thresh;
+extern unsigned int vos_defrag_thresh;
+extern unsigned int vos_agg_parts;
+extern unsigned int vos_gc_bulk_creds;
+extern unsigned int vos_ilog_cache_size;
 extern bool vos_dkey_punch_propagate;
+extern bool vos_vea_alloc_cache;
 
 static inline uint32_t vos_byte2blkcnt(uint64_t bytes)
 {
@@ -186,6 +197,7 @@ struct vos_agg_metrics {
 	struct d_tm_node_t	*vam_del_ev;		/* Deleted EV records */
 	struct d_tm_node_t	*vam_merge_recs;	/* Total merged EV records */
 	struct d_tm_node_t	*vam_merge_size;	/* Total merged size */
+	struct d_tm_node_t	*vam_defrag_size;	/* Total relocated size for defrag */
 };
 
 /*
@@ -197,6 +209,8 @@ struct vos_chkpt_metrics {
 	struct d_tm_node_t	*vcm_dirty_chunks;
 	struct d_tm_node_t	*vcm_iovs_copied;
 	struct d_tm_node_t	*vcm_wal_purged;
+	struct d_tm_node_t	*vcm_dirtied_bytes;
+	struct d_tm_node_t	*vcm_chkpt_bytes;
 };
 
 void vos_chkpt_metrics_init(struct vos_chkpt_metrics *vc_metrics, const char *path, int tgt_id);
@@ -207,6 +221,16 @@ struct vos_space_metrics {
 	uint64_t		 vsm_last_update_ts;	/* Timeout counter */
 };
 
+/* VOS Pool metrics for tier placement */
+struct vos_tier_metrics {
+	struct d_tm_node_t	*vtm_scm_hit;		/* Fetched extents on SCM */
+	struct d_tm_node_t	*vtm_nvme_hit;		/* Fetched extents on NVMe */
+	struct d_tm_node_t	*vtm_scm_placed;	/* Bytes allocated on SCM */
+	struct d_tm_node_t	*vtm_nvme_placed;	/* Bytes allocated on NVMe */
+	struct d_tm_node_t	*vtm_promoted;		/* Bytes moved from NVMe to SCM */
+	struct d_tm_node_t	*vtm_demoted;		/* Bytes moved from SCM to NVMe */
+};
+
 /* VOS Pool metrics for vos file rehydration */
 struct vos_rh_metrics {
 	struct d_tm_node_t	*vrh_size;		/* WAL replay size */
@@ -214,6 +238,8 @@ struct vos_rh_metrics {
 	struct d_tm_node_t	*vrh_count;		/* Total replay count */
 	struct d_tm_node_t	*vrh_entries;		/* Total replayed entry count */
 	struct d_tm_node_t	*vrh_tx_cnt;		/* Total replayed TX count */
+	struct d_tm_node_t	*vrh_io_wait;		/* WAL replay I/O wait time */
+	struct d_tm_node_t	*vrh_bw;		/* WAL replay throughput */
 };
 
 struct vos_pool_metrics {
@@ -222,6 +248,7 @@ struct vos_pool_metrics {
 	struct vos_space_metrics vp_space_metrics;
 	struct vos_chkpt_metrics vp_chkpt_metrics;
 	struct vos_rh_metrics	 vp_rh_metrics;
+	struct vos_tier_metrics	 vp_tier_metrics;
 	/* TODO: add more metrics for VOS */
 };
 
@@ -260,6 +287,8 @@ struct vos_pool {
 	d_list_t		vp_gc_link;
 	/** List of open containers with objects in gc pool */
 	d_list_t		vp_gc_cont;
+	/** NVMe extents freed by the running GC transaction, see gc_nvme_free */
+	struct vos_gc_frees	*vp_gc_frees;
 	/** address of durable-format pool in SCM */
 	struct vos_pool_df	*vp_pool_df;
 	/** Dummy data I/O context */
@@ -280,6 +309,8 @@ struct vos_pool {
 	uint32_t		 vp_dtx_committed_count;
 	/** Tiering policy */
 	struct policy_desc_t	vp_policy_desc;
+	/** Access heat of objects/akeys, only for the hot_cold policy */
+	struct vos_heat_tab	*vp_heat;
 	/** Space (in percentage) reserved for rebuild */
 	unsigned int		vp_space_rb;
 };
@@ -312,6 +343,10 @@ struct vos_container {
 	uint32_t		vc_dtx_committed_count;
 	/** Index for timestamp lookup */
 	uint32_t		*vc_ts_idx;
+	/** Resolved visibility of stable incarnation logs */
+	struct ilog_vis_cache	*vc_ilog_cache;
+	/** Objects of this container in the object cache */
+	d_list_t		vc_obj_list;
 	/** Direct pointer to the VOS container */
 	struct vos_cont_df	*vc_cont_df;
 	/** Set if container has objects to garbage collect */
@@ -408,14 +443,30 @@ struct vos_dtx_act_ent {
 #define DAE_MBS_INLINE(dae)	((dae)->dae_base.dae_mbs_inline)
 #define DAE_MBS_OFF(dae)	((dae)->dae_base.dae_mbs_off)
 
+struct vos_dtx_cmt_slab;
+
 struct vos_dtx_cmt_ent {
 	struct vos_dtx_cmt_ent_df	 dce_base;
+	/* The slab this entry is carved from, NULL if allocated individually */
+	struct vos_dtx_cmt_slab		*dce_slab;
 
 	uint32_t			 dce_reindex:1,
 					 dce_exist:1,
 					 dce_invalid:1;
 };
 
+/*
+ * Committed DTX entries for one commit batch or one re-indexed committed blob
+ * are allocated together. They are committed at about the same time, so are
+ * stored in the same committed blob and released together by DTX aggregation.
+ */
+struct vos_dtx_cmt_slab {
+	uint32_t			 dcs_ref;
+	uint32_t			 dcs_used;
+	uint32_t			 dcs_nr;
+	struct vos_dtx_cmt_ent		 dcs_ents[0];
+};
+
 #define DCE_XID(dce)		((dce)->dce_base.dce_xid)
 #define DCE_EPOCH(dce)		((dce)->dce_base.dce_epoch)
 #define DCE_CMT_TIME(dce)	((dce)->dce_base.dce_cmt_time)
@@ -1315,6 +1366,8 @@ int
 gc_add_item(struct vos_pool *pool, daos_handle_t coh,
 	    enum vos_gc_type type, umem_off_t item_off, uint64_t args);
 int
+gc_nvme_free(struct vos_pool *pool, uint64_t blk_off, uint32_t blk_cnt);
+int
 vos_gc_pool_tight(daos_handle_t poh, int *credits);
 void
 gc_reserve_space(daos_size_t *rsrvd);
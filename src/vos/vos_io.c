@@ -732,6 +732,9 @@ iod_fetch(struct vos_io_context *ioc, struct bio_iov *biov)
 	if (ioc->ic_size_fetch)
 		return 0;
 
+	if (!bio_addr_is_hole(&biov->bi_addr))
+		vos_policy_tier_hit(vos_cont2pool(ioc->ic_cont), biov->bi_addr.ba_type);
+
 	bsgl = bio_iod_sgl(ioc->ic_biod, ioc->ic_sgl_at);
 	D_ASSERT(bsgl != NULL);
 	iov_nr = bsgl->bs_nr;
@@ -1258,6 +1261,9 @@ fetch_value:
 	if (ioc->ic_read_ts_only || ioc->ic_check_existence)
 		goto out; /* skip value fetch */
 
+	if (ioc->ic_cont->vc_pool->vp_heat != NULL)
+		vos_heat_record(ioc->ic_cont->vc_pool, vos_heat_key(&ioc->ic_oid, &iod->iod_name));
+
 	if (iod->iod_type == DAOS_IOD_SINGLE) {
 		rc = akey_fetch_single(toh, &val_epr, &iod->iod_size, ioc);
 		goto out;
@@ -2173,7 +2179,9 @@ akey_update_begin(struct vos_io_context *ioc)
 {
 	struct dcs_csum_info	*iod_csums = vos_csum_at(ioc->ic_iod_csums, ioc->ic_sgl_at);
 	struct dcs_csum_info	*recx_csum;
+	struct vos_pool		*pool = vos_cont2pool(ioc->ic_cont);
 	daos_iod_t *iod = &ioc->ic_iods[ioc->ic_sgl_at];
+	uint64_t heat_key = VOS_HEAT_KEY_NONE;
 	int i, rc;
 
 	if (iod->iod_type == DAOS_IOD_SINGLE && iod->iod_nr != 1) {
@@ -2181,6 +2189,11 @@ akey_update_begin(struct vos_io_context *ioc)
 		return -DER_IO_INVAL;
 	}
 
+	if (pool->vp_heat != NULL) {
+		heat_key = vos_heat_key(&ioc->ic_oid, &iod->iod_name);
+		vos_heat_record(pool, heat_key);
+	}
+
 	for (i = 0; i < iod->iod_nr; i++) {
 		daos_size_t size;
 		uint16_t media;
@@ -2188,8 +2201,8 @@ akey_update_begin(struct vos_io_context *ioc)
 		size = (iod->iod_type == DAOS_IOD_SINGLE) ? iod->iod_size :
 				iod->iod_recxs[i].rx_nr * iod->iod_size;
 
-		media = vos_policy_media_select(vos_cont2pool(ioc->ic_cont),
-					 iod->iod_type, size, VOS_IOS_GENERIC);
+		media = vos_policy_media_select(pool, iod->iod_type, size,
+						VOS_IOS_GENERIC, heat_key);
 
 		if (iod->iod_type == DAOS_IOD_SINGLE) {
 			rc = vos_reserve_single(ioc, media, size);
@@ -2204,6 +2217,8 @@ akey_update_begin(struct vos_io_context *ioc)
 		}
 		if (rc)
 			return rc;
+
+		vos_policy_tier_account(pool, DAOS_MEDIA_MAX, media, size);
 	}
 	return 0;
 }
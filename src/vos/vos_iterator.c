@@ -425,6 +425,49 @@ vos_iter_fetch(daos_handle_t ih, vos_iter_entry_t *it_entry,
 	return rc;
 }
 
+int
+vos_iter_fetch_batch(daos_handle_t ih, vos_iter_entry_t *ents,
+		     daos_anchor_t *anchors, uint32_t *nr)
+{
+	struct vos_iterator *iter = vos_hdl2iter(ih);
+	struct dtx_handle   *old;
+	bool		     is_sysdb = !!iter->it_for_sysdb;
+	uint32_t	     cnt = 0;
+	int		     rc;
+
+	rc = iter_verify_state(iter);
+	if (rc) {
+		*nr = 0;
+		return rc;
+	}
+
+	D_ASSERT(iter->it_ops != NULL);
+
+	old = vos_dth_get(is_sysdb);
+	vos_dth_set(iter->it_dth, is_sysdb);
+	while (cnt < *nr) {
+		rc = iter->it_ops->iop_fetch(iter, &ents[cnt],
+					     anchors != NULL ? &anchors[cnt] : NULL);
+		if (rc != 0)
+			break;
+		cnt++;
+
+		rc = iter->it_ops->iop_next(iter, NULL);
+		if (rc == 0)
+			continue;
+
+		if (rc == -DER_NONEXIST)
+			iter->it_state = VOS_ITS_END;
+		else
+			iter->it_state = VOS_ITS_NONE;
+		break;
+	}
+	vos_dth_set(old, is_sysdb);
+
+	*nr = cnt;
+	return rc;
+}
+
 int
 vos_iter_copy(daos_handle_t ih, vos_iter_entry_t *it_entry,
 	      d_iov_t *iov_out)
@@ -707,6 +750,112 @@ vos_iter_cb(vos_iter_cb_t iter_cb, daos_handle_t ih, vos_iter_entry_t *iter_ent,
 	return rc;
 }
 
+/** Number of entries fetched at a time by batched iteration, see VOS_IT_BATCH */
+#define VOS_ITER_BATCH_NR	32
+
+struct vos_iter_batch {
+	vos_iter_entry_t	ib_ents[VOS_ITER_BATCH_NR];
+	daos_anchor_t		ib_anchors[VOS_ITER_BATCH_NR];
+};
+
+/**
+ * Batched version of the iteration loop in vos_iterate_internal(), it's only
+ * for non-recursive iteration without post callback. Entries are fetched in
+ * batches and \a cb is called for each of them, the cursor is reprobed from
+ * the anchor of the last handled entry if the callback yielded or deleted it.
+ *
+ * \a finish is set if the callback asked for reprobe from an upper level.
+ */
+static int
+vos_iterate_batch(daos_handle_t ih, vos_iter_type_t type, vos_iter_param_t *param,
+		  struct vos_iter_anchors *anchors, daos_anchor_t *anchor,
+		  vos_iter_cb_t cb, void *arg, bool *finish)
+{
+	struct vos_iterator	*iter = vos_hdl2iter(ih);
+	struct vos_iter_batch	*batch;
+	unsigned int		 acts;
+	uint32_t		 probe_flags;
+	uint32_t		 nr;
+	uint32_t		 i;
+	int			 fetch_rc;
+	int			 rc = 0;
+
+	D_ALLOC_PTR(batch);
+	if (batch == NULL)
+		return -DER_NOMEM;
+
+	while (1) {
+		nr = VOS_ITER_BATCH_NR;
+		fetch_rc = vos_iter_fetch_batch(ih, batch->ib_ents, batch->ib_anchors, &nr);
+		/* no filter callback for batched iteration */
+		D_ASSERT(fetch_rc <= 0);
+
+		probe_flags = VOS_ITER_PROBE_NEXT;
+		for (i = 0; i < nr; i++) {
+			/* keep the anchor on the current entry as the unbatched iteration */
+			*anchor = batch->ib_anchors[i];
+			acts = 0;
+			anchors->ia_probe_level = 0;
+			rc = vos_iter_cb(cb, ih, &batch->ib_ents[i], type, param, arg, &acts);
+			if (rc != 0)
+				goto out;
+
+			if (anchors->ia_probe_level != 0) {
+				if (anchors->ia_probe_level != iter->it_type) {
+					*finish = true;
+					goto out;
+				}
+				acts |= VOS_ITER_CB_YIELD;
+			}
+
+			if (acts & (VOS_ITER_CB_EXIT | VOS_ITER_CB_ABORT))
+				goto out;
+
+			if (acts & VOS_ITER_CB_RESTART) {
+				daos_anchor_set_zero(anchor);
+				probe_flags = 0;
+				break;
+			}
+
+			/* the rest entries may reference stale records */
+			if (acts & (VOS_ITER_CB_YIELD | VOS_ITER_CB_DELETE))
+				break;
+		}
+
+		if (i == nr) {
+			if (fetch_rc == -DER_NONEXIST) {
+				daos_anchor_set_eof(anchor);
+				rc = 0;
+				break;
+			}
+
+			if (fetch_rc != 0) {
+				VOS_TX_TRACE_FAIL(fetch_rc, "Failed to fetch batch (type=%d): "
+						  DF_RC"\n", type, DP_RC(fetch_rc));
+				rc = fetch_rc;
+				break;
+			}
+			/* the cursor is still valid, continue with the next batch */
+			continue;
+		}
+
+		rc = vos_iter_probe_ex(ih, anchor, probe_flags);
+		if (rc == -DER_NONEXIST || rc == -DER_AGAIN) {
+			daos_anchor_set_eof(anchor);
+			rc = 0;
+			break;
+		}
+		if (rc != 0) {
+			VOS_TX_TRACE_FAIL(rc, "Failed to probe iterator (type=%d): "DF_RC"\n",
+					  type, DP_RC(rc));
+			break;
+		}
+	}
+out:
+	D_FREE(batch);
+	return rc;
+}
+
 #define JUMP_TO_STAGE(rc, next_label, probe_label, abort_label)				\
 	do {										\
 		switch (rc) {								\
@@ -804,6 +953,16 @@ probe:
 		JUMP_TO_STAGE(rc, next, probe, out);
 	}
 
+	if ((param->ip_flags & VOS_IT_BATCH) && !recursive && post_cb == NULL &&
+	    param->ip_filter_cb == NULL) {
+		bool	finish = false;
+
+		rc = vos_iterate_batch(ih, type, param, anchors, anchor, pre_cb, arg, &finish);
+		if (finish)
+			goto finish;
+		goto out;
+	}
+
 	while (1) {
 		rc = vos_iter_fetch(ih, &iter_ent, anchor);
 		if (rc != 0) {
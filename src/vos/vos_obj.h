@@ -23,6 +23,8 @@
 #include "vos_ts.h"
 
 #define LRU_CACHE_BITS 16
+/** The object cache adapts to the working set from 2^LRU_CACHE_MIN_BITS */
+#define LRU_CACHE_MIN_BITS 12
 
 /* Internal container handle structure */
 struct vos_container;
@@ -47,6 +49,8 @@ struct vos_object {
 	struct vos_obj_df		*obj_df;
 	/** backref to container */
 	struct vos_container		*obj_cont;
+	/** link to vos_container::vc_obj_list, for cached objects only */
+	d_list_t			obj_cont_link;
 	/** nobody should access this object */
 	bool				obj_zombie;
 	/** Object is in discard */
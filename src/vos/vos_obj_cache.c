@@ -11,9 +11,10 @@
  *
  * LRU cache implementation:
  * Simple LRU based object cache for Object index table
- * Uses a hashtable and a doubly linked list to set and get
- * entries. The size of both hashtable and linked list are
- * fixed length.
+ * Uses a hashtable and a CLOCK ring to set and get entries.
+ * The cache is per xstream so it needs no locking, its size
+ * adapts to the object working set and cached objects are
+ * also linked to their container for eviction on close.
  *
  * Author: Vishwanath Venkatesan <vishwanath.venkatesan@intel.com>
  */
@@ -76,6 +77,7 @@ obj_lop_alloc(void *key, unsigned int ksize, void *args,
 		D_GOTO(failed, rc = -DER_NOMEM);
 
 	init_object(obj, lkey->olk_oid, cont);
+	d_list_add_tail(&obj->obj_cont_link, &cont->vc_obj_list);
 	d_tm_inc_gauge(tls->vtl_obj_cnt, 1);
 	*llink_p = &obj->obj_llink;
 	rc = 0;
@@ -132,6 +134,7 @@ obj_lop_free(struct daos_llink *llink)
 	obj = container_of(llink, struct vos_object, obj_llink);
 	tls = vos_tls_get(obj->obj_cont->vc_pool->vp_sysdb);
 	d_tm_dec_gauge(tls->vtl_obj_cnt, 1);
+	d_list_del(&obj->obj_cont_link);
 	clean_object(obj);
 	D_FREE(obj);
 }
@@ -163,8 +166,17 @@ vos_obj_cache_create(int32_t cache_size, struct daos_lru_cache **occ)
 	D_DEBUG(DB_TRACE, "Creating an object cache %d\n", (1 << cache_size));
 	rc = daos_lru_cache_create(cache_size, D_HASH_FT_NOLOCK,
 				   &obj_lru_ops, occ);
-	if (rc)
+	if (rc) {
 		D_ERROR("Error in creating lru cache: "DF_RC"\n", DP_RC(rc));
+		return rc;
+	}
+
+	rc = daos_lru_cache_adapt(*occ, min(cache_size, LRU_CACHE_MIN_BITS));
+	if (rc) {
+		D_ERROR("Error in adapting lru cache: "DF_RC"\n", DP_RC(rc));
+		daos_lru_cache_destroy(*occ);
+		*occ = NULL;
+	}
 	return rc;
 }
 
@@ -191,7 +203,20 @@ obj_cache_evict_cond(struct daos_llink *llink, void *args)
 void
 vos_obj_cache_evict(struct daos_lru_cache *cache, struct vos_container *cont)
 {
-	daos_lru_cache_evict(cache, obj_cache_evict_cond, cont);
+	struct vos_object	*obj;
+	struct vos_object	*tmp;
+
+	if (cont == NULL) {
+		daos_lru_cache_evict(cache, obj_cache_evict_cond, NULL);
+		return;
+	}
+
+	/* All objects of the container are cached by the xstream it's opened
+	 * on, so only walk them instead of the whole cache.  The caller holds
+	 * the container so it can't go away with its last object.
+	 */
+	d_list_for_each_entry_safe(obj, tmp, &cont->vc_obj_list, obj_cont_link)
+		daos_lru_cache_evict_one(cache, &obj->obj_llink);
 }
 
 /**
@@ -366,6 +391,7 @@ vos_obj_hold(struct daos_lru_cache *occ, struct vos_container *cont,
 	}
 
 	if (obj->obj_df) {
+		d_tm_inc_counter(vos_tls_get(cont->vc_pool->vp_sysdb)->vtl_obj_cache_hit, 1);
 		D_DEBUG(DB_TRACE, "looking up object ilog");
 		if (create || intent == DAOS_INTENT_PUNCH)
 			vos_ilog_ts_ignore(vos_obj2umm(obj),
@@ -377,6 +403,7 @@ vos_obj_hold(struct daos_lru_cache *occ, struct vos_container *cont,
 	}
 
 	 /* newly cached object */
+	d_tm_inc_counter(vos_tls_get(cont->vc_pool->vp_sysdb)->vtl_obj_cache_miss, 1);
 	D_DEBUG(DB_TRACE, "%s Got empty obj "DF_UOID" epr="DF_X64"-"DF_X64"\n",
 		create ? "find/create" : "find", DP_UOID(oid), epr->epr_lo,
 		epr->epr_hi);
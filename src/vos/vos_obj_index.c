@@ -36,8 +36,38 @@ struct vos_oi_iter {
 	daos_epoch_t		 oit_punched;
 	/** cached iterator flags */
 	uint32_t		 oit_flags;
+	/** OID prefix range [lo, hi) of the iterated partition, see oi_part_prefix */
+	uint32_t		 oit_part_lo;
+	uint32_t		 oit_part_hi;
 };
 
+/*
+ * OI keys are sorted by memcmp() on daos_unit_oid_t, so the first two bytes of
+ * the key are the most significant ones. Split the OI into partitions by this
+ * 16 bits prefix, each partition is a contiguous key range of the btree which
+ * can be located by a single probe.
+ */
+#define OI_PART_BITS	16
+#define OI_PART_MAX	(1U << OI_PART_BITS)
+
+static inline uint32_t
+oi_part_prefix(const daos_unit_oid_t *oid)
+{
+	const uint8_t	*key = (const uint8_t *)oid;
+
+	return ((uint32_t)key[0] << 8) | key[1];
+}
+
+static inline void
+oi_part_key(daos_unit_oid_t *oid, uint32_t prefix)
+{
+	uint8_t	*key = (uint8_t *)oid;
+
+	memset(oid, 0, sizeof(*oid));
+	key[0] = prefix >> 8;
+	key[1] = prefix & 0xff;
+}
+
 static int
 oi_hkey_size(void)
 {
@@ -551,6 +581,19 @@ oi_iter_prep(vos_iter_type_t type, vos_iter_param_t *param,
 	oiter->oit_iter.it_filter_cb = param->ip_filter_cb;
 	oiter->oit_iter.it_filter_arg = param->ip_filter_arg;
 	oiter->oit_flags = param->ip_flags;
+	oiter->oit_part_lo = 0;
+	oiter->oit_part_hi = OI_PART_MAX;
+	if (param->ip_part_nr > 1) {
+		if (param->ip_part_id >= param->ip_part_nr || param->ip_part_nr > OI_PART_MAX) {
+			D_ERROR("Invalid OI partition %u/%u\n", param->ip_part_id,
+				param->ip_part_nr);
+			D_GOTO(exit, rc = -DER_INVAL);
+		}
+		oiter->oit_part_lo = (uint64_t)param->ip_part_id * OI_PART_MAX /
+				     param->ip_part_nr;
+		oiter->oit_part_hi = (uint64_t)(param->ip_part_id + 1) * OI_PART_MAX /
+				     param->ip_part_nr;
+	}
 	if (param->ip_flags & VOS_IT_FOR_PURGE)
 		oiter->oit_iter.it_for_purge = 1;
 	if (param->ip_flags & VOS_IT_FOR_DISCARD)
@@ -602,6 +645,12 @@ oi_iter_match_probe(struct vos_iterator *iter, daos_anchor_t *anchor, uint32_t f
 		D_ASSERT(iov.iov_len == sizeof(struct vos_obj_df));
 		obj = (struct vos_obj_df *)iov.iov_buf;
 
+		/* Reached the end of the partition */
+		if (oi_part_prefix(&obj->vo_id) >= oiter->oit_part_hi) {
+			rc = -DER_NONEXIST;
+			goto failed;
+		}
+
 		if (iter->it_filter_cb != NULL && (flags & VOS_ITER_PROBE_AGAIN) == 0) {
 			desc.id_type = VOS_ITER_OBJ;
 			desc.id_oid = obj->vo_id;
@@ -666,15 +715,27 @@ oi_iter_probe(struct vos_iterator *iter, daos_anchor_t *anchor, uint32_t flags)
 {
 	struct vos_oi_iter	*oiter = iter2oiter(iter);
 	dbtree_probe_opc_t	 next_opc;
-	dbtree_probe_opc_t	 opc;
 	int			 rc;
 
 	D_ASSERT(iter->it_type == VOS_ITER_OBJ);
 
 	next_opc = (flags & VOS_ITER_PROBE_NEXT) ? BTR_PROBE_GT : BTR_PROBE_GE;
-	opc = vos_anchor_is_zero(anchor) ? BTR_PROBE_FIRST : next_opc;
-	rc = dbtree_iter_probe(oiter->oit_hdl, opc, vos_iter_intent(iter), NULL,
-			       anchor);
+	if (!vos_anchor_is_zero(anchor)) {
+		rc = dbtree_iter_probe(oiter->oit_hdl, next_opc, vos_iter_intent(iter), NULL,
+				       anchor);
+	} else if (oiter->oit_part_lo != 0) {
+		daos_unit_oid_t	oid;
+		d_iov_t		key;
+
+		/* Start from the first object of the partition */
+		oi_part_key(&oid, oiter->oit_part_lo);
+		d_iov_set(&key, &oid, sizeof(oid));
+		rc = dbtree_iter_probe(oiter->oit_hdl, BTR_PROBE_GE, vos_iter_intent(iter), &key,
+				       NULL);
+	} else {
+		rc = dbtree_iter_probe(oiter->oit_hdl, BTR_PROBE_FIRST, vos_iter_intent(iter),
+				       NULL, anchor);
+	}
 	if (rc)
 		D_GOTO(out, rc);
 
@@ -12,6 +12,116 @@
 #include <daos_srv/policy.h>
 #include "vos_policy.h"
 
+/* Heat table */
+
+#define HEAT_CNT_BITS	16
+#define HEAT_CNT_MASK	((1U << HEAT_CNT_BITS) - 1)
+
+static inline uint32_t
+heat_period(struct vos_heat_tab *vht)
+{
+	return (daos_gettime_coarse() / vht->vht_half_life) & HEAT_CNT_MASK;
+}
+
+/* Decay the counter of @slot to period @now */
+static inline uint32_t
+heat_decay(uint32_t slot, uint32_t now)
+{
+	uint32_t	elapsed = (now - (slot >> HEAT_CNT_BITS)) & HEAT_CNT_MASK;
+	uint32_t	cnt = slot & HEAT_CNT_MASK;
+
+	return elapsed >= HEAT_CNT_BITS ? 0 : cnt >> elapsed;
+}
+
+int
+vos_heat_init(struct vos_pool *pool)
+{
+	struct vos_heat_tab	*vht = pool->vp_heat;
+	struct policy_desc_t	*pd = &pool->vp_policy_desc;
+
+	if (pd->policy != DAOS_MEDIA_POLICY_HOT_COLD) {
+		vos_heat_fini(pool);
+		return 0;
+	}
+
+	if (vht == NULL) {
+		D_ALLOC_PTR(vht);
+		if (vht == NULL)
+			return -DER_NOMEM;
+
+		D_ALLOC_ARRAY(vht->vht_slots, 1U << VOS_HEAT_SLOTS_SHIFT);
+		if (vht->vht_slots == NULL) {
+			D_FREE(vht);
+			return -DER_NOMEM;
+		}
+		vht->vht_mask = (1U << VOS_HEAT_SLOTS_SHIFT) - 1;
+		pool->vp_heat = vht;
+	}
+
+	vht->vht_hot = pd->params[1] > 0 ? pd->params[1] : VOS_HEAT_HOT_DEF;
+	vht->vht_half_life = pd->params[2] > 0 ? pd->params[2] : VOS_HEAT_HALF_LIFE_DEF;
+
+	D_DEBUG(DB_MGMT, "Pool "DF_UUID" hot_cold policy, hot:%u, half life:%us\n",
+		DP_UUID(pool->vp_id), vht->vht_hot, vht->vht_half_life);
+	return 0;
+}
+
+void
+vos_heat_fini(struct vos_pool *pool)
+{
+	struct vos_heat_tab	*vht = pool->vp_heat;
+
+	if (vht == NULL)
+		return;
+
+	D_FREE(vht->vht_slots);
+	D_FREE(vht);
+	pool->vp_heat = NULL;
+}
+
+uint64_t
+vos_heat_key(daos_unit_oid_t *oid, daos_key_t *akey)
+{
+	uint64_t	key;
+
+	key = d_hash_mix64(oid->id_pub.lo ^ d_hash_mix64(oid->id_pub.hi + oid->id_shard));
+	if (akey != NULL && akey->iov_len != 0)
+		key = d_hash_murmur64(akey->iov_buf, akey->iov_len, key);
+
+	/* VOS_HEAT_KEY_NONE is reserved */
+	return key == VOS_HEAT_KEY_NONE ? 1 : key;
+}
+
+void
+vos_heat_record(struct vos_pool *pool, uint64_t heat_key)
+{
+	struct vos_heat_tab	*vht = pool->vp_heat;
+	uint32_t		*slot;
+	uint32_t		 now, cnt;
+
+	if (vht == NULL || heat_key == VOS_HEAT_KEY_NONE)
+		return;
+
+	slot = &vht->vht_slots[heat_key & vht->vht_mask];
+	now = heat_period(vht);
+	cnt = heat_decay(*slot, now);
+	if (cnt < HEAT_CNT_MASK)
+		cnt++;
+
+	*slot = (now << HEAT_CNT_BITS) | cnt;
+}
+
+uint32_t
+vos_heat_get(struct vos_pool *pool, uint64_t heat_key)
+{
+	struct vos_heat_tab	*vht = pool->vp_heat;
+
+	if (vht == NULL || heat_key == VOS_HEAT_KEY_NONE)
+		return 0;
+
+	return heat_decay(vht->vht_slots[heat_key & vht->vht_mask], heat_period(vht));
+}
+
 /* policy functions definitions */
 
 /* policy based on io size
@@ -23,7 +133,8 @@
  * If parameters are 0, default thresholds are used.
  */
 static enum daos_media_type_t
-policy_io_size(struct vos_pool *pool, daos_iod_type_t type, daos_size_t size)
+policy_io_size(struct vos_pool *pool, daos_iod_type_t type, daos_size_t size,
+	       enum vos_io_stream ios, uint64_t heat_key)
 {
 	uint32_t		scm_threshold;
 
@@ -42,20 +153,89 @@ policy_io_size(struct vos_pool *pool, daos_iod_type_t type, daos_size_t size)
  */
 static enum daos_media_type_t
 policy_write_intensivity(struct vos_pool *pool, daos_iod_type_t type,
-			daos_size_t size)
+			 daos_size_t size, enum vos_io_stream ios, uint64_t heat_key)
 {
 	return DAOS_MEDIA_NVME;
 }
 
+/* policy based on access heat of object/akey
+ *
+ * New data is placed by size like the io_size policy (params[0] is the SCM
+ * threshold), the placement is revised when aggregation relocates the data:
+ * - Extents of a hot akey (heat >= params[1]) are kept on or promoted to SCM,
+ *   as long as they are smaller than VOS_POLICY_OPTANE_THRESHOLD;
+ * - Extents of a cold akey are moved to NVMe regardless of their size, which
+ *   frees SCM for the hot working set.
+ * params[2] is the heat half-life in seconds.
+ */
+static enum daos_media_type_t
+policy_hot_cold(struct vos_pool *pool, daos_iod_type_t type, daos_size_t size,
+		enum vos_io_stream ios, uint64_t heat_key)
+{
+	struct vos_heat_tab	*vht = pool->vp_heat;
+
+	if (pool->vp_vea_info == NULL)
+		return DAOS_MEDIA_SCM;
+
+	if (ios != VOS_IOS_AGGREGATION || vht == NULL || heat_key == VOS_HEAT_KEY_NONE)
+		return policy_io_size(pool, type, size, ios, heat_key);
+
+	if (vos_heat_get(pool, heat_key) < vht->vht_hot)
+		return DAOS_MEDIA_NVME;
+
+	return size < VOS_POLICY_OPTANE_THRESHOLD ? DAOS_MEDIA_SCM : DAOS_MEDIA_NVME;
+}
+
 /* policy functions table */
 static enum daos_media_type_t
 (*vos_policies[DAOS_MEDIA_POLICY_MAX])(struct vos_pool*, daos_iod_type_t,
-				      daos_size_t) = {policy_io_size,
-						      policy_write_intensivity};
+				      daos_size_t, enum vos_io_stream,
+				      uint64_t) = {policy_io_size,
+						   policy_write_intensivity,
+						   policy_hot_cold};
 
 enum daos_media_type_t
 vos_policy_media_select(struct vos_pool *pool, daos_iod_type_t type,
-			daos_size_t size, enum vos_io_stream ios)
+			daos_size_t size, enum vos_io_stream ios,
+			uint64_t heat_key)
+{
+	return vos_policies[pool->vp_policy_desc.policy](pool, type, size, ios,
+							 heat_key);
+}
+
+/*
+ * Account the space allocated on @tgt_media, @src_media is DAOS_MEDIA_MAX for new
+ * data. Tier metrics are only maintained by the hot_cold policy.
+ */
+void
+vos_policy_tier_account(struct vos_pool *pool, uint16_t src_media, uint16_t tgt_media,
+			daos_size_t size)
 {
-	return vos_policies[pool->vp_policy_desc.policy](pool, type, size);
+	struct vos_tier_metrics	*vtm;
+
+	if (pool->vp_heat == NULL || pool->vp_metrics == NULL)
+		return;
+
+	vtm = &pool->vp_metrics->vp_tier_metrics;
+	if (tgt_media == DAOS_MEDIA_SCM) {
+		d_tm_inc_counter(vtm->vtm_scm_placed, size);
+		if (src_media == DAOS_MEDIA_NVME)
+			d_tm_inc_counter(vtm->vtm_promoted, size);
+	} else {
+		d_tm_inc_counter(vtm->vtm_nvme_placed, size);
+		if (src_media == DAOS_MEDIA_SCM)
+			d_tm_inc_counter(vtm->vtm_demoted, size);
+	}
+}
+
+void
+vos_policy_tier_hit(struct vos_pool *pool, uint16_t media)
+{
+	struct vos_tier_metrics	*vtm;
+
+	if (pool->vp_heat == NULL || pool->vp_metrics == NULL)
+		return;
+
+	vtm = &pool->vp_metrics->vp_tier_metrics;
+	d_tm_inc_counter(media == DAOS_MEDIA_SCM ? vtm->vtm_scm_hit : vtm->vtm_nvme_hit, 1);
 }
@@ -21,8 +21,46 @@
 #define VOS_POLICY_SCM_SHIFT		(12)  /* 4k */
 #define VOS_POLICY_SCM_THRESHOLD	(1ULL << VOS_POLICY_SCM_SHIFT)
 
+/* Heat tracking for the hot_cold policy */
+#define VOS_HEAT_SLOTS_SHIFT		(16)  /* 64k slots, 256KB per pool */
+#define VOS_HEAT_HOT_DEF		(8)
+#define VOS_HEAT_HALF_LIFE_DEF		(60)  /* seconds */
+/* Heat key of an unknown object/akey, size based placement is used */
+#define VOS_HEAT_KEY_NONE		(0)
+
+/*
+ * Per-pool DRAM table of decaying access counters. Each slot packs a 16 bits
+ * period stamp and a 16 bits counter, the counter is halved on each elapsed
+ * half-life period. Slots are indexed by the hash of object ID & akey, hash
+ * collisions are tolerated since the heat is only a placement hint.
+ */
+struct vos_heat_tab {
+	uint32_t		*vht_slots;
+	uint32_t		 vht_mask;
+	uint32_t		 vht_half_life;
+	uint32_t		 vht_hot;
+};
+
+int
+vos_heat_init(struct vos_pool *pool);
+void
+vos_heat_fini(struct vos_pool *pool);
+uint64_t
+vos_heat_key(daos_unit_oid_t *oid, daos_key_t *akey);
+void
+vos_heat_record(struct vos_pool *pool, uint64_t heat_key);
+uint32_t
+vos_heat_get(struct vos_pool *pool, uint64_t heat_key);
+
 enum daos_media_type_t
 vos_policy_media_select(struct vos_pool *pool, daos_iod_type_t type,
-			daos_size_t size, enum vos_io_stream ios);
+			daos_size_t size, enum vos_io_stream ios,
+			uint64_t heat_key);
+
+void
+vos_policy_tier_account(struct vos_pool *pool, uint16_t src_media,
+			uint16_t tgt_media, daos_size_t size);
+void
+vos_policy_tier_hit(struct vos_pool *pool, uint16_t media);
 
 #endif /* __VOS_POLICY_H__ */
@@ -24,6 +24,7 @@
 #include <sys/resource.h>
 #include "vos_layout.h"
 #include "vos_internal.h"
+#include "vos_policy.h"
 #include <errno.h>
 #include <unistd.h>
 #include <string.h>
@@ -32,6 +33,9 @@
 #include <daos_pool.h>
 #include <daos_srv/policy.h>
 
+/* Serve NVMe space reservations from per size class runs */
+bool vos_vea_alloc_cache = true;
+
 static void
 vos_iod2bsgl(struct umem_store *store, struct umem_store_iod *iod, struct bio_sglist *bsgl)
 {
@@ -354,6 +358,9 @@ vos_wal_replay(struct umem_store *store,
 		d_tm_inc_counter(vrm->vrh_entries, wrs.wrs_entries);
 		d_tm_inc_counter(vrm->vrh_tx_cnt, wrs.wrs_tx_cnt);
 		d_tm_inc_counter(vrm->vrh_count, 1);
+		d_tm_set_gauge(vrm->vrh_io_wait, wrs.wrs_io_wait);
+		if (wrs.wrs_tm > 0)
+			d_tm_set_gauge(vrm->vrh_bw, wrs.wrs_sz / wrs.wrs_tm);
 	}
 	return rc;
 }
@@ -414,6 +421,19 @@ vos_chkpt_metrics_init(struct vos_chkpt_metrics *vc_metrics, const char *path, i
 	if (rc)
 		D_WARN("failed to create checkpoint_wal_purged metric: "DF_RC"\n", DP_RC(rc));
 
+	rc = d_tm_add_metric(&vc_metrics->vcm_dirtied_bytes, D_TM_STATS_GAUGE,
+			     "Bytes dirtied by transactions since last checkpoint", "bytes",
+			     "%s/%s/dirtied_bytes/tgt_%d", path, CHKPT_TELEMETRY_DIR, tgt_id);
+	if (rc)
+		D_WARN("failed to create checkpoint_dirtied_bytes metric: "DF_RC"\n", DP_RC(rc));
+
+	rc = d_tm_add_metric(&vc_metrics->vcm_chkpt_bytes, D_TM_STATS_GAUGE,
+			     "Bytes written by the checkpoint", "bytes",
+			     "%s/%s/checkpointed_bytes/tgt_%d", path, CHKPT_TELEMETRY_DIR, tgt_id);
+	if (rc)
+		D_WARN("failed to create checkpoint_checkpointed_bytes metric: "DF_RC"\n",
+		       DP_RC(rc));
+
 }
 
 void
@@ -485,7 +505,7 @@ vos_pool_checkpoint(daos_handle_t poh)
 	struct bio_wal_info            wal_info;
 	int                            rc;
 	uint64_t                       purge_size = 0;
-	struct umem_cache_chkpt_stats  stats;
+	struct umem_cache_chkpt_stats  stats = { 0 };
 	struct vos_chkpt_metrics      *chkpt_metrics = NULL;
 
 	pool = vos_hdl2pool(poh);
@@ -536,6 +556,8 @@ vos_pool_checkpoint(daos_handle_t poh)
 			d_tm_set_gauge(chkpt_metrics->vcm_dirty_chunks, stats.uccs_nr_dchunks);
 			d_tm_set_gauge(chkpt_metrics->vcm_iovs_copied, stats.uccs_nr_iovs);
 			d_tm_set_gauge(chkpt_metrics->vcm_wal_purged, purge_size);
+			d_tm_set_gauge(chkpt_metrics->vcm_dirtied_bytes, stats.uccs_dirtied_bytes);
+			d_tm_set_gauge(chkpt_metrics->vcm_chkpt_bytes, stats.uccs_chkpt_bytes);
 		}
 	}
 	return rc;
@@ -784,6 +806,7 @@ pool_hop_free(struct d_ulink *hlink)
 		vos_pmemobj_close(pool->vp_uma.uma_pool);
 
 	vos_dedup_fini(pool);
+	vos_heat_fini(pool);
 
 	if (pool->vp_dummy_ioctxt) {
 		rc = bio_ioctxt_close(pool->vp_dummy_ioctxt);
@@ -1264,6 +1287,7 @@ pool_open(void *ph, struct vos_pool_df *pool_df, unsigned int flags, void *metri
 		unmap_ctxt.vnc_unmap = vos_blob_unmap_cb;
 		unmap_ctxt.vnc_data = vos_data_ioctxt(pool);
 		unmap_ctxt.vnc_ext_flush = flags & VOS_POF_EXTERNAL_FLUSH;
+		unmap_ctxt.vnc_alloc_cache = vos_vea_alloc_cache;
 		rc = vea_load(&pool->vp_umm, vos_txd_get(flags & VOS_POF_SYSDB),
 			      &pool_df->pd_vea_df, &unmap_ctxt, vea_metrics, &pool->vp_vea_info);
 		if (rc) {
@@ -1573,7 +1597,7 @@ vos_pool_ctl(daos_handle_t poh, enum vos_pool_opc opc, void *param)
 		for (i = 0; i < DAOS_MEDIA_POLICY_PARAMS_MAX; i++)
 			pool->vp_policy_desc.params[i] = p->params[i];
 
-		break;
+		return vos_heat_init(pool);
 	case VOS_PO_CTL_SET_SPACE_RB:
 		if (param == NULL)
 			return -DER_INVAL;
@@ -228,7 +228,8 @@ estimate_space(struct vos_pool *pool, daos_key_t *dkey, unsigned int iod_nr,
 		if (iod->iod_type == DAOS_IOD_SINGLE) {
 			size = iod->iod_size;
 			media = vos_policy_media_select(pool, iod->iod_type,
-							size, VOS_IOS_GENERIC);
+							size, VOS_IOS_GENERIC,
+							VOS_HEAT_KEY_NONE);
 
 			/* Single value record */
 			if (media == DAOS_MEDIA_SCM) {
@@ -250,7 +251,8 @@ estimate_space(struct vos_pool *pool, daos_key_t *dkey, unsigned int iod_nr,
 
 			size = recx->rx_nr * iod->iod_size;
 			media = vos_policy_media_select(pool, iod->iod_type,
-							size, VOS_IOS_GENERIC);
+							size, VOS_IOS_GENERIC,
+							VOS_HEAT_KEY_NONE);
 
 			/* Extent */
 			if (media == DAOS_MEDIA_SCM)
@@ -417,5 +419,7 @@ vos_space_update_metrics(struct vos_pool *pool)
 
 		nvme_used = (va.va_tot_blks - va.va_free_blks) * va.va_blk_sz;
 		d_tm_set_gauge(vpm->vp_space_metrics.vsm_nvme_used, nvme_used);
+		/* Refresh the free space fragmentation index gauge */
+		vea_frag_index(pool->vp_vea_info);
 	}
 }
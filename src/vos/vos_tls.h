@@ -66,6 +66,13 @@ struct vos_tls {
 	struct d_tm_node_t		 *vtl_obj_cnt;
 	struct d_tm_node_t		 *vtl_dtx_cmt_ent_cnt;
 	struct d_tm_node_t		 *vtl_lru_alloc_size;
+	struct d_tm_node_t		 *vtl_obj_cache_hit;
+	struct d_tm_node_t		 *vtl_obj_cache_miss;
+	struct d_tm_node_t		 *vtl_ilog_cache_hit;
+	struct d_tm_node_t		 *vtl_ilog_cache_miss;
+	struct d_tm_node_t		 *vtl_ts_evict;
+	struct d_tm_node_t		 *vtl_ts_tier_hit;
+	struct d_tm_node_t		 *vtl_ts_restart;
 };
 
 struct bio_xs_context *vos_xsctxt_get(void);
@@ -29,15 +29,189 @@ static const uint32_t type_counts[] = {
 #define DKEY_MISS_SIZE (1 << 16)
 #define AKEY_MISS_SIZE (1 << 16)
 
+/** Each cache is split in sub arrays that are allocated as the working set
+ *  grows and released once they go cold.
+ */
+#define TS_SUB_ARRAY_NR	16
+
 #define TS_TRACE(action, entry, idx, type)				\
 	D_DEBUG(DB_TRACE, "%s %s at idx %d(%p), read.hi="DF_U64		\
 		" read.lo="DF_U64"\n", action, type_strs[type], idx,	\
 		(entry)->te_record_ptr, (entry)->te_ts.tp_ts_rh,	\
 		(entry)->te_ts.tp_ts_rl)
 
+static inline struct vos_ts_tier_slot *
+ts_tier_find(struct vos_ts_info *info, uint64_t hash)
+{
+	struct vos_ts_tier_slot	*set;
+
+	set = &info->ti_tier[(hash & info->ti_tier_mask) * 2];
+	if (set[0].ts_hash == hash)
+		return &set[0];
+	if (set[1].ts_hash == hash)
+		return &set[1];
+
+	return NULL;
+}
+
+/** Merge a tier slot into the negative entry covering its object/key */
+static inline void
+ts_tier_merge(struct vos_ts_info *info, struct vos_ts_tier_slot *slot)
+{
+	struct vos_ts_entry	*neg_entry;
+
+	neg_entry = &info->ti_misses[slot->ts_hash & info->ti_cache_mask];
+	vos_ts_rl_update(neg_entry, slot->ts_rl, &slot->ts_tx_rl);
+	vos_ts_rh_update(neg_entry, slot->ts_rh, &slot->ts_tx_rh);
+	slot->ts_hash = 0;
+}
+
+/** Save the read timestamps of an evicted entry in the precise tier.  The
+ *  slot displaced to make room is merged into its negative entry.
+ */
+static void
+ts_tier_store(struct vos_ts_info *info, struct vos_ts_entry *entry)
+{
+	struct vos_ts_entry	*neg_entry = entry->te_negative;
+	struct vos_ts_tier_slot	*slot;
+	struct vos_ts_tier_slot	*set;
+
+	slot = ts_tier_find(info, entry->te_hash);
+	if (slot == NULL) {
+		/** Nothing the negative entry doesn't already cover */
+		if (entry->te_ts.tp_ts_rl <= neg_entry->te_ts.tp_ts_rl &&
+		    entry->te_ts.tp_ts_rh <= neg_entry->te_ts.tp_ts_rh)
+			return;
+
+		set = &info->ti_tier[(entry->te_hash & info->ti_tier_mask) * 2];
+		if (set[0].ts_hash == 0)
+			slot = &set[0];
+		else if (set[1].ts_hash == 0)
+			slot = &set[1];
+		else
+			slot = set[0].ts_rh < set[1].ts_rh ? &set[0] : &set[1];
+
+		if (slot->ts_hash != 0)
+			ts_tier_merge(info, slot);
+
+		slot->ts_hash = entry->te_hash;
+		vos_ts_copy(&slot->ts_rl, &slot->ts_tx_rl, entry->te_ts.tp_ts_rl,
+			    &entry->te_ts.tp_tx_rl);
+		vos_ts_copy(&slot->ts_rh, &slot->ts_tx_rh, entry->te_ts.tp_ts_rh,
+			    &entry->te_ts.tp_tx_rh);
+		return;
+	}
+
+	/** Same rule as vos_ts_rl_update, the latest reader owns the time */
+	if (entry->te_ts.tp_ts_rl >= slot->ts_rl)
+		vos_ts_copy(&slot->ts_rl, &slot->ts_tx_rl, entry->te_ts.tp_ts_rl,
+			    &entry->te_ts.tp_tx_rl);
+	if (entry->te_ts.tp_ts_rh >= slot->ts_rh)
+		vos_ts_copy(&slot->ts_rh, &slot->ts_tx_rh, entry->te_ts.tp_ts_rh,
+			    &entry->te_ts.tp_tx_rh);
+}
+
+/** Raise the timestamps of a new entry to those saved in the precise tier.
+ *  The slot is kept since other objects/keys may share the hash.
+ */
+static void
+ts_tier_load(struct vos_ts_info *info, struct vos_ts_entry *entry)
+{
+	struct vos_ts_tier_slot	*slot;
+
+	slot = ts_tier_find(info, entry->te_hash);
+	if (slot == NULL)
+		return;
+
+	if (slot->ts_rl > entry->te_ts.tp_ts_rl)
+		vos_ts_copy(&entry->te_ts.tp_ts_rl, &entry->te_ts.tp_tx_rl,
+			    slot->ts_rl, &slot->ts_tx_rl);
+	if (slot->ts_rh > entry->te_ts.tp_ts_rh)
+		vos_ts_copy(&entry->te_ts.tp_ts_rh, &entry->te_ts.tp_tx_rh,
+			    slot->ts_rh, &slot->ts_tx_rh);
+
+	if (info->ti_tls != NULL)
+		d_tm_inc_counter(info->ti_tls->vtl_ts_tier_hit, 1);
+}
+
+void
+vos_ts_tier_fold(struct vos_ts_info *info, uint64_t hash)
+{
+	struct vos_ts_tier_slot	*slot;
+
+	if (hash == 0)
+		return;
+
+	slot = ts_tier_find(info, hash);
+	if (slot != NULL)
+		ts_tier_merge(info, slot);
+}
+
+static void
+ts_trim(struct vos_ts_info *info, uint64_t since)
+{
+	struct lru_array	*array = info->ti_array;
+
+	if (lrua_array_trim(array, since))
+		D_DEBUG(DB_TRACE, "Shrunk %s cache to %u sub arrays\n",
+			type_strs[info->ti_type], array->la_sub_alloc);
+}
+
+void
+vos_ts_trim_deferred(struct vos_ts_table *ts_table)
+{
+	struct vos_ts_info	*info;
+	int			 i;
+
+	D_ASSERT(ts_table->tt_live_sets == 0);
+
+	for (i = 0; i < VOS_TS_TYPE_COUNT; i++) {
+		info = &ts_table->tt_type_info[i];
+		if (!info->ti_trim_pending)
+			continue;
+
+		info->ti_trim_pending = false;
+		ts_trim(info, info->ti_trim_stamp);
+	}
+	ts_table->tt_trim_pending = false;
+}
+
+/** Close the sizing window of a type once it has seen as many allocations as
+ *  a sub array holds.  Caches only grow when they would otherwise evict, so a
+ *  window without evictions or growth means the working set fits and the
+ *  last sub array can be released if it stayed cold.  Live timestamp sets
+ *  hold pointers to entries, so the release waits until none is left.
+ */
+static void
+ts_adapt(struct vos_ts_info *info)
+{
+	struct lru_array	*array = info->ti_array;
+	struct vos_ts_table	*ts_table = info->ti_table;
+
+	if (++info->ti_window_allocs < info->ti_count / TS_SUB_ARRAY_NR)
+		return;
+
+	if (array->la_evicted == info->ti_window_evicted &&
+	    array->la_sub_alloc <= info->ti_window_subs && array->la_sub_alloc > 1) {
+		if (ts_table->tt_live_sets == 0) {
+			ts_trim(info, info->ti_window_stamp);
+		} else if (!info->ti_trim_pending) {
+			info->ti_trim_pending = true;
+			info->ti_trim_stamp = info->ti_window_stamp;
+			ts_table->tt_trim_pending = true;
+		}
+	}
+
+	info->ti_window_allocs = 0;
+	info->ti_window_subs = array->la_sub_alloc;
+	info->ti_window_evicted = array->la_evicted;
+	info->ti_window_stamp = array->la_stamp;
+}
+
 /** The entry is being evicted either because there is no space in the cache or
- *  the item it represents has been removed.  In either case, update the
- *  corresponding negative entry.
+ *  the item it represents has been removed.  In either case, save its read
+ *  timestamps in the precise tier or, failing that, update the corresponding
+ *  negative entry.
  */
 static bool
 ts_update_on_evict(struct vos_ts_table *ts_table, struct vos_ts_entry *entry)
@@ -69,6 +243,11 @@ ts_update_on_evict(struct vos_ts_table *ts_table, struct vos_ts_entry *entry)
 	}
 
 	dest = &entry->te_negative->te_w_cache;
+	if (entry->te_info->ti_tier != NULL && entry->te_hash != 0) {
+		ts_tier_store(entry->te_info, entry);
+		goto update_w_cache;
+	}
+
 	vos_ts_rl_update(entry->te_negative, entry->te_ts.tp_ts_rl,
 			 &entry->te_ts.tp_tx_rl);
 	vos_ts_rh_update(entry->te_negative, entry->te_ts.tp_ts_rh,
@@ -120,6 +299,18 @@ static const struct lru_callbacks lru_cbs = {
 	.lru_on_free = vos_lru_ts_free,
 };
 
+static void
+ts_info_free(struct vos_ts_info *info, struct vos_tls *tls)
+{
+	lrua_array_free(info->ti_array);
+
+	if (info->ti_tier == NULL)
+		return;
+
+	vos_lru_free_track(tls, sizeof(*info->ti_tier) * info->ti_count);
+	D_FREE(info->ti_tier);
+}
+
 int
 vos_ts_table_alloc(struct vos_ts_table **ts_tablep, struct vos_tls *tls)
 {
@@ -200,11 +391,24 @@ vos_ts_table_alloc(struct vos_ts_table **ts_tablep, struct vos_tls *tls)
 			}
 		}
 
-		rc = lrua_array_alloc(&info->ti_array, info->ti_count, 1,
-				      sizeof(struct vos_ts_entry), 0, &lru_cbs,
-				      info);
+		rc = lrua_array_alloc(&info->ti_array, info->ti_count,
+				      TS_SUB_ARRAY_NR, sizeof(struct vos_ts_entry),
+				      LRU_FLAG_EVICT_ADAPTIVE, &lru_cbs, info);
 		if (rc != 0)
 			goto cleanup;
+		info->ti_window_subs = info->ti_array->la_sub_alloc;
+
+		if (miss_size == 0)
+			continue;
+
+		/** One tier slot per cache entry */
+		D_ALLOC_ARRAY(info->ti_tier, info->ti_count);
+		if (info->ti_tier == NULL) {
+			rc = -DER_NOMEM;
+			goto cleanup;
+		}
+		info->ti_tier_mask = info->ti_count / 2 - 1;
+		vos_lru_alloc_track(tls, sizeof(*info->ti_tier) * info->ti_count);
 	}
 
 	*ts_tablep = ts_table;
@@ -213,7 +417,7 @@ vos_ts_table_alloc(struct vos_ts_table **ts_tablep, struct vos_tls *tls)
 
 cleanup:
 	for (i = 0; i < VOS_TS_TYPE_COUNT; i++)
-		lrua_array_free(ts_table->tt_type_info[i].ti_array);
+		ts_info_free(&ts_table->tt_type_info[i], tls);
 	if (tls != NULL)
 		d_tm_dec_gauge(tls->vtl_lru_alloc_size,
 			       sizeof(*ts_table->tt_misses) *
@@ -232,7 +436,7 @@ vos_ts_table_free(struct vos_ts_table **ts_tablep, struct vos_tls *tls)
 	int			 i;
 
 	for (i = 0; i < VOS_TS_TYPE_COUNT; i++)
-		lrua_array_free(ts_table->tt_type_info[i].ti_array);
+		ts_info_free(&ts_table->tt_type_info[i], tls);
 
 	if (tls != NULL)
 		d_tm_dec_gauge(tls->vtl_lru_alloc_size,
@@ -246,16 +450,20 @@ vos_ts_table_free(struct vos_ts_table **ts_tablep, struct vos_tls *tls)
 
 void
 vos_ts_evict_lru(struct vos_ts_table *ts_table, struct vos_ts_entry **entryp,
-		 uint32_t *idx, uint32_t hash_idx, uint32_t type)
+		 uint32_t *idx, uint32_t hash_idx, uint64_t hash, uint32_t type)
 {
 	struct vos_ts_entry	*entry;
 	struct vos_ts_entry	*neg_entry = NULL;
 	struct vos_ts_info	*info = &ts_table->tt_type_info[type];
+	uint64_t		 evicted = info->ti_array->la_evicted;
 	int			 rc;
 
-	rc = lrua_alloc(ts_table->tt_type_info[type].ti_array, idx, &entry);
+	rc = lrua_alloc(info->ti_array, idx, &entry);
 	D_ASSERT(rc == 0); /** autoeviction and no allocation */
 
+	if (info->ti_array->la_evicted != evicted && info->ti_tls != NULL)
+		d_tm_inc_counter(info->ti_tls->vtl_ts_evict, 1);
+
 	if (info->ti_cache_mask)
 		neg_entry = &info->ti_misses[hash_idx];
 
@@ -280,12 +488,18 @@ vos_ts_evict_lru(struct vos_ts_table *ts_table, struct vos_ts_entry **entryp,
 		entry->te_w_cache = neg_entry->te_w_cache;
 	}
 
+	entry->te_hash = hash;
+	if (info->ti_tier != NULL && hash != 0)
+		ts_tier_load(info, entry);
+
 	/** Set the lower bounds for the entry */
 	entry->te_record_ptr = idx;
 	TS_TRACE("Allocated", entry, *idx, type);
 
 	D_ASSERT(type == info->ti_type);
 
+	ts_adapt(info);
+
 	*entryp = entry;
 }
 
@@ -324,6 +538,12 @@ vos_ts_set_allocate(struct vos_ts_set **ts_set, uint64_t flags,
 		(*ts_set)->ts_in_tx = true;
 		uuid_copy((*ts_set)->ts_tx_id.dti_uuid, tx_id->dti_uuid);
 		(*ts_set)->ts_tx_id.dti_hlc = tx_id->dti_hlc;
+		/** Only sets in a transaction hold entries, always looked up in
+		 *  the table of the current xstream.
+		 */
+		(*ts_set)->ts_table = vos_ts_table_get(false);
+		if ((*ts_set)->ts_table != NULL)
+			(*ts_set)->ts_table->tt_live_sets++;
 	} /* ts_in_tx is false by default */
 	vos_ts_set_append_cflags(*ts_set, cflags);
 
@@ -357,9 +577,12 @@ vos_ts_set_upgrade(struct vos_ts_set *ts_set)
 		D_ASSERT(i != 0); /** no negative lookup on container */
 		D_ASSERT(set_entry->se_create_idx != NULL);
 
+		/** The full hash is unknown, tier slots were already folded
+		 *  into the negative entry when it was looked up.
+		 */
 		hash_idx = entry - info->ti_misses;
 		vos_ts_evict_lru(ts_table, &entry, set_entry->se_create_idx,
-				 hash_idx, info->ti_type);
+				 hash_idx, 0, info->ti_type);
 		set_entry->se_entry = entry;
 	}
 }
@@ -381,9 +604,8 @@ vos_ts_check_conflict(daos_epoch_t read_time, const struct dtx_id *read_id,
 	return uuid_compare(read_id->dti_uuid, write_id->dti_uuid) != 0;
 }
 
-bool
-vos_ts_check_read_conflict(struct vos_ts_set *ts_set, int idx,
-			   daos_epoch_t write_time)
+static bool
+ts_check_read_conflict(struct vos_ts_set *ts_set, int idx, daos_epoch_t write_time)
 {
 	struct vos_ts_set_entry	*se;
 	struct vos_ts_entry	*entry;
@@ -431,3 +653,19 @@ vos_ts_check_read_conflict(struct vos_ts_set *ts_set, int idx,
 				     &entry->te_negative->te_ts.tp_tx_rh, write_time,
 				     &ts_set->ts_tx_id);
 }
+
+bool
+vos_ts_check_read_conflict(struct vos_ts_set *ts_set, int idx,
+			   daos_epoch_t write_time)
+{
+	struct vos_ts_info	*info;
+
+	if (!ts_check_read_conflict(ts_set, idx, write_time))
+		return false;
+
+	info = ts_set->ts_entries[idx].se_entry->te_info;
+	if (info->ti_tls != NULL)
+		d_tm_inc_counter(info->ti_tls->vtl_ts_restart, 1);
+
+	return true;
+}
@@ -20,6 +20,22 @@
 struct vos_ts_table;
 struct vos_ts_entry;
 
+/** Read timestamps of an evicted object/key, kept so that recreating its
+ *  entry does not fall back to the shared negative entry.
+ */
+struct vos_ts_tier_slot {
+	/** Hash identifying the object/key (see vos_ts_get_hash), 0 if unused */
+	uint64_t	ts_hash;
+	/** Low read time */
+	daos_epoch_t	ts_rl;
+	/** High read time */
+	daos_epoch_t	ts_rh;
+	/** Tx id of the low read, lets the reader write at the same epoch */
+	struct dtx_id	ts_tx_rl;
+	/** Tx id of the high read */
+	struct dtx_id	ts_tx_rh;
+};
+
 struct vos_ts_info {
 	/** The LRU array */
 	struct lru_array	*ti_array;
@@ -35,6 +51,22 @@ struct vos_ts_info {
 	uint32_t		ti_cache_mask;
 	/** Number of entries in cache for type (for testing) */
 	uint32_t		ti_count;
+	/** Mask for the sets of the precise tier, 2 slots per set */
+	uint32_t		ti_tier_mask;
+	/** Precise tier of evicted entries, NULL if the type has none */
+	struct vos_ts_tier_slot	*ti_tier;
+	/** Allocations in the current sizing window */
+	uint32_t		ti_window_allocs;
+	/** Allocated sub arrays at the start of the window */
+	uint32_t		ti_window_subs;
+	/** Eviction count at the start of the window */
+	uint64_t		ti_window_evicted;
+	/** Access stamp at the start of the window */
+	uint64_t		ti_window_stamp;
+	/** Access stamp a deferred trim checks the last sub array against */
+	uint64_t		ti_trim_stamp;
+	/** Trim is deferred until no timestamp set is live */
+	bool			ti_trim_pending;
 };
 
 struct vos_ts_pair {
@@ -61,6 +93,8 @@ struct vos_ts_entry {
 	uint32_t		*te_record_ptr;
 	/** Corresponding negative entry, if applicable */
 	struct vos_ts_entry	*te_negative;
+	/** Hash of the object/key, 0 if unknown */
+	uint64_t		 te_hash;
 	/** The timestamps for the entry */
 	struct vos_ts_pair	 te_ts;
 	/** Write timestamps for epoch bound check */
@@ -122,6 +156,8 @@ struct vos_ts_set {
 	uint32_t		 ts_set_size;
 	/** Number of initialized entries */
 	uint32_t		 ts_init_count;
+	/** Table the set is counted live in */
+	struct vos_ts_table	*ts_table;
 	/** timestamp entries */
 	struct vos_ts_set_entry	 ts_entries[0];
 };
@@ -154,6 +190,12 @@ struct vos_ts_table {
 	struct dtx_id		tt_tx_rh;
 	/** Negative entry cache */
 	struct vos_ts_entry	*tt_misses;
+	/** Number of live timestamp sets.  Sets hold pointers to entries, so
+	 *  sub arrays are only trimmed while there is none.
+	 */
+	uint32_t		tt_live_sets;
+	/** Some type has a trim deferred until no set is live */
+	bool			tt_trim_pending;
 	/** Timestamp table pointers for a type */
 	struct vos_ts_info	tt_type_info[VOS_TS_TYPE_COUNT];
 };
@@ -286,14 +328,27 @@ vos_ts_lookup(struct vos_ts_set *ts_set, uint32_t *idx, bool reset,
 /** Internal function to evict LRU and initialize an entry */
 void
 vos_ts_evict_lru(struct vos_ts_table *ts_table, struct vos_ts_entry **new_entry,
-		 uint32_t *idx, uint32_t hash_idx, uint32_t new_type);
+		 uint32_t *idx, uint32_t hash_idx, uint64_t hash, uint32_t new_type);
+
+/** Internal function to move the precise tier timestamps of a missing
+ *  object/key to its negative entry
+ */
+void
+vos_ts_tier_fold(struct vos_ts_info *info, uint64_t hash);
+
+/** Internal function to calculate the hash of an object/key within its parent */
+static inline uint64_t
+vos_ts_get_hash(uint64_t hash, uint64_t parent_idx)
+{
+	return hash + (parent_idx * 17);
+}
 
 /** Internal function to calculate index of negative entry */
 static uint32_t
 vos_ts_get_hash_idx(struct vos_ts_info *info, uint64_t hash,
 		    uint64_t parent_idx)
 {
-	return (hash + (parent_idx * 17)) & info->ti_cache_mask;
+	return vos_ts_get_hash(hash, parent_idx) & info->ti_cache_mask;
 }
 
 /** Allocate a new entry in the set.   Lookup should be called first and this
@@ -328,7 +383,8 @@ vos_ts_alloc(struct vos_ts_set *ts_set, uint32_t *idx, uint64_t hash)
 	 */
 	hash_idx = vos_ts_get_hash_idx(info, hash, hash_offset);
 
-	vos_ts_evict_lru(ts_table, &new_entry, idx, hash_idx, info->ti_type);
+	vos_ts_evict_lru(ts_table, &new_entry, idx, hash_idx,
+			 vos_ts_get_hash(hash, hash_offset), info->ti_type);
 
 	set_entry.se_entry = new_entry;
 
@@ -386,6 +442,9 @@ vos_ts_get_negative(struct vos_ts_set *ts_set, uint64_t hash, bool reset)
 
 	hash_idx = vos_ts_get_hash_idx(info, hash, hash_offset);
 
+	if (info->ti_tier != NULL)
+		vos_ts_tier_fold(info, vos_ts_get_hash(hash, hash_offset));
+
 	set_entry.se_entry = &info->ti_misses[hash_idx];
 
 	ts_set->ts_entries[ts_set->ts_init_count++] = set_entry;
@@ -663,6 +722,25 @@ vos_ts_set_allocate(struct vos_ts_set **ts_set, uint64_t flags,
 void
 vos_ts_set_upgrade(struct vos_ts_set *ts_set);
 
+/** Internal API: Run the trims deferred while timestamp sets were live */
+void
+vos_ts_trim_deferred(struct vos_ts_table *ts_table);
+
+/** Internal API: The set no longer references any entry */
+static inline void
+vos_ts_set_release(struct vos_ts_set *ts_set)
+{
+	struct vos_ts_table	*ts_table;
+
+	if (ts_set == NULL || ts_set->ts_table == NULL)
+		return;
+
+	ts_table = ts_set->ts_table;
+	D_ASSERT(ts_table->tt_live_sets > 0);
+	if (--ts_table->tt_live_sets == 0 && ts_table->tt_trim_pending)
+		vos_ts_trim_deferred(ts_table);
+}
+
 /** Free an allocated timestamp set
  *
  * Implemented as a macro to improve logging.
@@ -670,7 +748,11 @@ vos_ts_set_upgrade(struct vos_ts_set *ts_set);
  * \param[in]	ts_set	Set to free
  */
 
-#define vos_ts_set_free(ts_set) D_FREE(ts_set)
+#define vos_ts_set_free(ts_set)			\
+	do {					\
+		vos_ts_set_release(ts_set);	\
+		D_FREE(ts_set);			\
+	} while (0)
 
 /** Internal API to copy timestamp */
 static inline void